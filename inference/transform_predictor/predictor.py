@@ -22,10 +22,8 @@ from bigquery_ml_utils.inference.xgboost_predictor import predictor as bqml_xgbo
 import tensorflow as tf
 from bigquery_ml_utils.tensorflow_ops.load_module import load_module
 
-gen_date_ops = load_module("_date_ops.so")
-gen_datetime_ops = load_module("_datetime_ops.so")
-gen_time_ops = load_module("_time_ops.so")
-gen_timestamp_ops = load_module("_timestamp_ops.so")
+# Registers the custom ops the TRANSFORM SavedModel may use.
+gen_ops = load_module("_bigquery_ml_utils_ops.so")
 
 
 class Predictor:
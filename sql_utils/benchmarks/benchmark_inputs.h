@@ -0,0 +1,113 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef THIRD_PARTY_PY_BIGQUERY_ML_UTILS_SQL_UTILS_BENCHMARKS_BENCHMARK_INPUTS_H_
+#define THIRD_PARTY_PY_BIGQUERY_ML_UTILS_SQL_UTILS_BENCHMARKS_BENCHMARK_INPUTS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sql_utils/public/functions/date_time_util.h"
+#include "sql_utils/public/functions/datetime.pb.h"
+#include "sql_utils/public/types/timestamp_util.h"
+#include "absl/time/time.h"
+#include "benchmark/benchmark.h"
+
+namespace bigquery_ml_utils {
+namespace benchmarks {
+
+// Number of values processed by each benchmark iteration.  Large enough to
+// amortize per-call setup, small enough for the inputs to stay in cache.
+inline constexpr int kNumInputs = 4096;
+
+// Seed for the input generators, so that every run measures the same inputs.
+inline constexpr uint64_t kSeed = 20231111;
+
+// 1950-01-01 and 2050-01-01 as days since the epoch.
+inline constexpr int32_t kRecentDatesBegin = -7305;
+inline constexpr int32_t kRecentDatesEnd = 29220;
+
+// Returns dates as days since the epoch.  Like typical tables, nine in ten
+// dates are between 1950 and 2050; the others cover the whole DATE range.
+inline std::vector<int32_t> MakeDates(int n = kNumInputs) {
+  std::mt19937_64 rng(kSeed);
+  std::uniform_int_distribution<int32_t> recent(kRecentDatesBegin,
+                                                kRecentDatesEnd - 1);
+  std::uniform_int_distribution<int32_t> any(types::kDateMin,
+                                             types::kDateMax);
+  std::vector<int32_t> dates(n);
+  for (int32_t& date : dates) {
+    date = rng() % 10 == 0 ? any(rng) : recent(rng);
+  }
+  return dates;
+}
+
+// Returns timestamps as microseconds since the epoch, distributed like
+// MakeDates() with a uniformly random time of day.  With <sorted>, the
+// timestamps are in increasing order, like the event times of a log.
+inline std::vector<int64_t> MakeTimestamps(bool sorted, int n = kNumInputs) {
+  std::mt19937_64 rng(kSeed);
+  std::uniform_int_distribution<int64_t> time_of_day(
+      0, int64_t{24} * 60 * 60 * 1000000 - 1);
+  std::vector<int64_t> timestamps;
+  timestamps.reserve(n);
+  for (int32_t date : MakeDates(n)) {
+    timestamps.push_back(int64_t{date} * 24 * 60 * 60 * 1000000 +
+                         time_of_day(rng));
+  }
+  if (sorted) std::sort(timestamps.begin(), timestamps.end());
+  return timestamps;
+}
+
+// Returns intervals for the Add benchmarks.  Most are small, like the
+// "+ 1 DAY" or "- 3 MONTH" of typical queries.
+inline std::vector<int64_t> MakeIntervals(int n = kNumInputs) {
+  std::mt19937_64 rng(kSeed + 1);
+  std::uniform_int_distribution<int64_t> small(-31, 31);
+  std::uniform_int_distribution<int64_t> large(-1000, 1000);
+  std::vector<int64_t> intervals(n);
+  for (int64_t& interval : intervals) {
+    interval = rng() % 4 == 0 ? large(rng) : small(rng);
+  }
+  return intervals;
+}
+
+// Time zones of the timestamp benchmarks, selected by a benchmark argument: a
+// zone without transitions and one with daylight saving time.
+inline constexpr const char* kTimeZones[] = {"UTC", "America/Los_Angeles"};
+
+inline absl::TimeZone BenchmarkTimeZone(int64_t index) {
+  absl::TimeZone timezone;
+  if (!functions::MakeTimeZone(kTimeZones[index], &timezone).ok()) {
+    timezone = absl::UTCTimeZone();
+  }
+  return timezone;
+}
+
+// Returns <parts> as the values of a benchmark argument, for ArgsProduct().
+inline std::vector<int64_t> PartArgs(
+    std::initializer_list<functions::DateTimestampPart> parts) {
+  return std::vector<int64_t>(parts.begin(), parts.end());
+}
+
+}  // namespace benchmarks
+}  // namespace bigquery_ml_utils
+
+#endif  // THIRD_PARTY_PY_BIGQUERY_ML_UTILS_SQL_UTILS_BENCHMARKS_BENCHMARK_INPUTS_H_
@@ -0,0 +1,496 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmarks of the DATE and TIMESTAMP functions in date_time_util.h.  Each
+// function is measured per DateTimestampPart, both through the scalar
+// function called once per value and through its batch variant.  The
+// timestamp benchmarks also take the time zone and whether the input is
+// sorted as arguments.  Formatting is measured per format string.
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "sql_utils/benchmarks/benchmark_inputs.h"
+#include "sql_utils/public/functions/date_time_util.h"
+#include "sql_utils/public/functions/datetime.pb.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "benchmark/benchmark.h"
+
+namespace bigquery_ml_utils {
+namespace benchmarks {
+namespace {
+
+using functions::DateTimestampPart;
+
+const std::vector<int64_t>& DateExtractParts() {
+  static const auto* parts = new std::vector<int64_t>(PartArgs(
+      {functions::YEAR, functions::ISOYEAR, functions::QUARTER,
+       functions::MONTH, functions::WEEK, functions::ISOWEEK, functions::DAY,
+       functions::DAYOFWEEK, functions::DAYOFYEAR}));
+  return *parts;
+}
+
+const std::vector<int64_t>& DateAddParts() {
+  static const auto* parts = new std::vector<int64_t>(
+      PartArgs({functions::DAY, functions::WEEK, functions::MONTH,
+                functions::QUARTER, functions::YEAR}));
+  return *parts;
+}
+
+const std::vector<int64_t>& DateDiffParts() {
+  static const auto* parts = new std::vector<int64_t>(PartArgs(
+      {functions::DAY, functions::WEEK, functions::ISOWEEK, functions::MONTH,
+       functions::QUARTER, functions::YEAR, functions::ISOYEAR}));
+  return *parts;
+}
+
+const std::vector<int64_t>& DateTruncParts() {
+  static const auto* parts = new std::vector<int64_t>(PartArgs(
+      {functions::DAY, functions::WEEK, functions::WEEK_MONDAY,
+       functions::ISOWEEK, functions::MONTH, functions::QUARTER,
+       functions::YEAR, functions::ISOYEAR}));
+  return *parts;
+}
+
+const std::vector<int64_t>& TimestampExtractParts() {
+  static const auto* parts = new std::vector<int64_t>(PartArgs(
+      {functions::MICROSECOND, functions::SECOND, functions::MINUTE,
+       functions::HOUR, functions::DAY, functions::DAYOFWEEK, functions::WEEK,
+       functions::MONTH, functions::YEAR, functions::DATE}));
+  return *parts;
+}
+
+// Parts of a fixed length of time, the only ones TIMESTAMP_ADD and
+// TIMESTAMP_DIFF accept.
+const std::vector<int64_t>& TimestampAddParts() {
+  static const auto* parts = new std::vector<int64_t>(
+      PartArgs({functions::MICROSECOND, functions::MILLISECOND,
+                functions::SECOND, functions::MINUTE, functions::HOUR,
+                functions::DAY}));
+  return *parts;
+}
+
+const std::vector<int64_t>& TimestampTruncParts() {
+  static const auto* parts = new std::vector<int64_t>(PartArgs(
+      {functions::SECOND, functions::MINUTE, functions::HOUR, functions::DAY,
+       functions::WEEK, functions::MONTH, functions::YEAR}));
+  return *parts;
+}
+
+const std::vector<int64_t> kTimeZoneArgs = {0, 1};
+const std::vector<int64_t> kSortedArgs = {0, 1};
+
+DateTimestampPart PartArg(const benchmark::State& state) {
+  return static_cast<DateTimestampPart>(state.range(0));
+}
+
+// Labels a benchmark with the part, time zone and sortedness arguments it
+// has, in that order.
+void SetLabel(benchmark::State& state, int num_args) {
+  std::string label = functions::DateTimestampPart_Name(PartArg(state));
+  if (num_args > 1) absl::StrAppend(&label, " ", kTimeZones[state.range(1)]);
+  if (num_args > 2 && state.range(2) != 0) absl::StrAppend(&label, " sorted");
+  state.SetLabel(label);
+}
+
+void SetItemsProcessed(benchmark::State& state, int64_t num_inputs) {
+  state.SetItemsProcessed(state.iterations() * num_inputs);
+}
+
+// DATE functions.
+
+void BM_ExtractFromDate(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int32_t> dates = MakeDates();
+  for (auto _ : state) {
+    for (int32_t date : dates) {
+      int32_t output;
+      benchmark::DoNotOptimize(functions::ExtractFromDate(part, date, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, dates.size());
+}
+BENCHMARK(BM_ExtractFromDate)->ArgsProduct({DateExtractParts()});
+
+void BM_ExtractFromDates(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int32_t> dates = MakeDates();
+  std::vector<int32_t> output(dates.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functions::ExtractFromDates(
+        part, dates, absl::MakeSpan(output), /*errors=*/nullptr));
+    benchmark::ClobberMemory();
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, dates.size());
+}
+BENCHMARK(BM_ExtractFromDates)->ArgsProduct({DateExtractParts()});
+
+void BM_AddDate(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int32_t> dates = MakeDates();
+  const std::vector<int64_t> intervals = MakeIntervals();
+  for (auto _ : state) {
+    for (size_t i = 0; i < dates.size(); i++) {
+      int32_t output;
+      benchmark::DoNotOptimize(
+          functions::AddDate(dates[i], part, intervals[i], &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, dates.size());
+}
+BENCHMARK(BM_AddDate)->ArgsProduct({DateAddParts()});
+
+void BM_AddDates(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int32_t> dates = MakeDates();
+  const std::vector<int64_t> intervals = MakeIntervals();
+  std::vector<int32_t> output(dates.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functions::AddDates(
+        dates, part, intervals, absl::MakeSpan(output), /*errors=*/nullptr));
+    benchmark::ClobberMemory();
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, dates.size());
+}
+BENCHMARK(BM_AddDates)->ArgsProduct({DateAddParts()});
+
+void BM_DiffDates(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int32_t> dates1 = MakeDates();
+  const std::vector<int32_t> dates2(dates1.rbegin(), dates1.rend());
+  for (auto _ : state) {
+    for (size_t i = 0; i < dates1.size(); i++) {
+      int32_t output;
+      benchmark::DoNotOptimize(
+          functions::DiffDates(dates1[i], dates2[i], part, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, dates1.size());
+}
+BENCHMARK(BM_DiffDates)->ArgsProduct({DateDiffParts()});
+
+void BM_DiffDatesBatch(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int32_t> dates1 = MakeDates();
+  const std::vector<int32_t> dates2(dates1.rbegin(), dates1.rend());
+  std::vector<int32_t> output(dates1.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functions::DiffDates(
+        dates1, dates2, part, absl::MakeSpan(output), /*errors=*/nullptr));
+    benchmark::ClobberMemory();
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, dates1.size());
+}
+BENCHMARK(BM_DiffDatesBatch)->ArgsProduct({DateDiffParts()});
+
+void BM_TruncateDate(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int32_t> dates = MakeDates();
+  for (auto _ : state) {
+    for (int32_t date : dates) {
+      int32_t output;
+      benchmark::DoNotOptimize(functions::TruncateDate(date, part, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, dates.size());
+}
+BENCHMARK(BM_TruncateDate)->ArgsProduct({DateTruncParts()});
+
+void BM_TruncateDates(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int32_t> dates = MakeDates();
+  std::vector<int32_t> output(dates.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functions::TruncateDates(
+        dates, part, absl::MakeSpan(output), /*errors=*/nullptr));
+    benchmark::ClobberMemory();
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, dates.size());
+}
+BENCHMARK(BM_TruncateDates)->ArgsProduct({DateTruncParts()});
+
+// TIMESTAMP functions.
+
+void BM_ExtractFromTimestamp(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(1));
+  const std::vector<int64_t> timestamps =
+      MakeTimestamps(/*sorted=*/state.range(2) != 0);
+  for (auto _ : state) {
+    for (int64_t timestamp : timestamps) {
+      int32_t output;
+      benchmark::DoNotOptimize(functions::ExtractFromTimestamp(
+          part, timestamp, functions::kMicroseconds, timezone, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetLabel(state, 3);
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_ExtractFromTimestamp)
+    ->ArgsProduct({TimestampExtractParts(), kTimeZoneArgs, kSortedArgs});
+
+void BM_ExtractFromTimestamps(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(1));
+  const std::vector<int64_t> timestamps =
+      MakeTimestamps(/*sorted=*/state.range(2) != 0);
+  std::vector<int32_t> output(timestamps.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functions::ExtractFromTimestamps(
+        part, timestamps, functions::kMicroseconds, timezone,
+        absl::MakeSpan(output), /*errors=*/nullptr));
+    benchmark::ClobberMemory();
+  }
+  SetLabel(state, 3);
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_ExtractFromTimestamps)
+    ->ArgsProduct({TimestampExtractParts(), kTimeZoneArgs, kSortedArgs});
+
+// Extracts the parts of a typical feature transform from each timestamp, with
+// one ExtractPartsFromTimestamp() call per timestamp.
+void BM_ExtractPartsFromTimestamp(benchmark::State& state) {
+  constexpr DateTimestampPart kParts[] = {
+      functions::YEAR, functions::MONTH, functions::DAYOFWEEK, functions::HOUR,
+      functions::ISOWEEK};
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(0));
+  const std::vector<int64_t> timestamps = MakeTimestamps(/*sorted=*/false);
+  int32_t output[std::size(kParts)];
+  for (auto _ : state) {
+    for (int64_t timestamp : timestamps) {
+      benchmark::DoNotOptimize(functions::ExtractPartsFromTimestamp(
+          kParts, timestamp, functions::kMicroseconds, timezone,
+          absl::MakeSpan(output)));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetLabel(kTimeZones[state.range(0)]);
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_ExtractPartsFromTimestamp)->ArgsProduct({kTimeZoneArgs});
+
+void BM_AddTimestamp(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(1));
+  const std::vector<int64_t> timestamps = MakeTimestamps(/*sorted=*/false);
+  const std::vector<int64_t> intervals = MakeIntervals();
+  for (auto _ : state) {
+    for (size_t i = 0; i < timestamps.size(); i++) {
+      int64_t output;
+      benchmark::DoNotOptimize(
+          functions::AddTimestamp(timestamps[i], functions::kMicroseconds,
+                                  timezone, part, intervals[i], &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetLabel(state, 2);
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_AddTimestamp)->ArgsProduct({TimestampAddParts(), kTimeZoneArgs});
+
+void BM_AddTimestamps(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(1));
+  const std::vector<int64_t> timestamps = MakeTimestamps(/*sorted=*/false);
+  const std::vector<int64_t> intervals = MakeIntervals();
+  std::vector<int64_t> output(timestamps.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functions::AddTimestamps(
+        timestamps, functions::kMicroseconds, timezone, part, intervals,
+        absl::MakeSpan(output), /*errors=*/nullptr));
+    benchmark::ClobberMemory();
+  }
+  SetLabel(state, 2);
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_AddTimestamps)
+    ->ArgsProduct({TimestampAddParts(), kTimeZoneArgs});
+
+void BM_TimestampDiff(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int64_t> timestamps1 = MakeTimestamps(/*sorted=*/false);
+  const std::vector<int64_t> timestamps2(timestamps1.rbegin(),
+                                         timestamps1.rend());
+  for (auto _ : state) {
+    for (size_t i = 0; i < timestamps1.size(); i++) {
+      int64_t output;
+      benchmark::DoNotOptimize(
+          functions::TimestampDiff(timestamps1[i], timestamps2[i],
+                                   functions::kMicroseconds, part, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, timestamps1.size());
+}
+BENCHMARK(BM_TimestampDiff)->ArgsProduct({TimestampAddParts()});
+
+void BM_DiffTimestamps(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const std::vector<int64_t> timestamps1 = MakeTimestamps(/*sorted=*/false);
+  const std::vector<int64_t> timestamps2(timestamps1.rbegin(),
+                                         timestamps1.rend());
+  std::vector<int64_t> output(timestamps1.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functions::DiffTimestamps(
+        timestamps1, timestamps2, functions::kMicroseconds, part,
+        absl::MakeSpan(output), /*errors=*/nullptr));
+    benchmark::ClobberMemory();
+  }
+  SetLabel(state, 1);
+  SetItemsProcessed(state, timestamps1.size());
+}
+BENCHMARK(BM_DiffTimestamps)->ArgsProduct({TimestampAddParts()});
+
+void BM_TimestampTrunc(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(1));
+  const std::vector<int64_t> timestamps =
+      MakeTimestamps(/*sorted=*/state.range(2) != 0);
+  for (auto _ : state) {
+    for (int64_t timestamp : timestamps) {
+      int64_t output;
+      benchmark::DoNotOptimize(
+          functions::TimestampTrunc(timestamp, timezone, part, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetLabel(state, 3);
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_TimestampTrunc)
+    ->ArgsProduct({TimestampTruncParts(), kTimeZoneArgs, kSortedArgs});
+
+void BM_TruncateTimestamps(benchmark::State& state) {
+  const DateTimestampPart part = PartArg(state);
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(1));
+  const std::vector<int64_t> timestamps =
+      MakeTimestamps(/*sorted=*/state.range(2) != 0);
+  std::vector<int64_t> output(timestamps.size());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(functions::TruncateTimestamps(
+        timestamps, timezone, part, absl::MakeSpan(output),
+        /*errors=*/nullptr));
+    benchmark::ClobberMemory();
+  }
+  SetLabel(state, 3);
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_TruncateTimestamps)
+    ->ArgsProduct({TimestampTruncParts(), kTimeZoneArgs, kSortedArgs});
+
+// Formatting.
+
+void BM_ConvertDateToString(benchmark::State& state) {
+  const std::vector<int32_t> dates = MakeDates();
+  std::string output;
+  for (auto _ : state) {
+    for (int32_t date : dates) {
+      output.clear();
+      benchmark::DoNotOptimize(functions::ConvertDateToString(date, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  SetItemsProcessed(state, dates.size());
+}
+BENCHMARK(BM_ConvertDateToString);
+
+void BM_ConvertTimestampToString(benchmark::State& state) {
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(0));
+  const std::vector<int64_t> timestamps = MakeTimestamps(/*sorted=*/false);
+  std::string output;
+  for (auto _ : state) {
+    for (int64_t timestamp : timestamps) {
+      output.clear();
+      benchmark::DoNotOptimize(
+          functions::ConvertTimestampMicrosToStringWithTruncation(
+              timestamp, timezone, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetLabel(kTimeZones[state.range(0)]);
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_ConvertTimestampToString)->ArgsProduct({kTimeZoneArgs});
+
+constexpr const char* kDateFormats[] = {
+    "%Y-%m-%d", "%F", "%d/%m/%Y", "%Y%m%d", "%A, %B %e, %Y", "%G-W%V-%u",
+};
+
+constexpr const char* kTimestampFormats[] = {
+    "%Y-%m-%d %H:%M:%S",    "%Y-%m-%dT%H:%M:%E6S%Ez", "%c",
+    "%d/%m/%Y %I:%M:%S %p", "%s",                     "%F %T %Z",
+};
+
+void BM_FormatDateToString(benchmark::State& state) {
+  const char* format = kDateFormats[state.range(0)];
+  const std::vector<int32_t> dates = MakeDates();
+  std::string output;
+  for (auto _ : state) {
+    for (int32_t date : dates) {
+      output.clear();
+      benchmark::DoNotOptimize(
+          functions::FormatDateToString(format, date, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetLabel(format);
+  SetItemsProcessed(state, dates.size());
+}
+BENCHMARK(BM_FormatDateToString)->DenseRange(0, std::size(kDateFormats) - 1);
+
+void BM_FormatTimestampToString(benchmark::State& state) {
+  const char* format = kTimestampFormats[state.range(0)];
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(1));
+  const std::vector<int64_t> timestamps = MakeTimestamps(/*sorted=*/false);
+  std::string output;
+  for (auto _ : state) {
+    for (int64_t timestamp : timestamps) {
+      output.clear();
+      benchmark::DoNotOptimize(functions::FormatTimestampToString(
+          format, timestamp, timezone, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetLabel(absl::StrCat(format, " ", kTimeZones[state.range(1)]));
+  SetItemsProcessed(state, timestamps.size());
+}
+BENCHMARK(BM_FormatTimestampToString)
+    ->ArgsProduct({benchmark::CreateDenseRange(
+                       0, std::size(kTimestampFormats) - 1, /*step=*/1),
+                   kTimeZoneArgs});
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace bigquery_ml_utils
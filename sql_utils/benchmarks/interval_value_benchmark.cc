@@ -0,0 +1,129 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmarks of parsing and formatting INTERVAL values in interval_value.h.
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "sql_utils/benchmarks/benchmark_inputs.h"
+#include "sql_utils/public/functions/datetime.pb.h"
+#include "sql_utils/public/interval_value.h"
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace bigquery_ml_utils {
+namespace benchmarks {
+namespace {
+
+// Returns intervals with a mix of year-month, day and time parts, like the
+// differences between the timestamps of benchmark_inputs.h.
+std::vector<IntervalValue> MakeIntervalValues() {
+  std::mt19937_64 rng(kSeed);
+  std::uniform_int_distribution<int64_t> months(-240, 240);
+  std::uniform_int_distribution<int64_t> days(-400, 400);
+  std::uniform_int_distribution<int64_t> micros(
+      -int64_t{24} * 60 * 60 * 1000000, int64_t{24} * 60 * 60 * 1000000);
+  std::vector<IntervalValue> values;
+  values.reserve(kNumInputs);
+  for (int i = 0; i < kNumInputs; i++) {
+    // Most intervals only have some of the parts.
+    const uint64_t parts = rng() % 8;
+    absl::StatusOr<IntervalValue> value = IntervalValue::FromMonthsDaysMicros(
+        parts & 1 ? months(rng) : 0, parts & 2 ? days(rng) : 0,
+        parts & 4 ? micros(rng) : 0);
+    if (value.ok()) values.push_back(*value);
+  }
+  return values;
+}
+
+void BM_IntervalToString(benchmark::State& state) {
+  const std::vector<IntervalValue> values = MakeIntervalValues();
+  for (auto _ : state) {
+    for (const IntervalValue& value : values) {
+      benchmark::DoNotOptimize(value.ToString());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_IntervalToString);
+
+void BM_IntervalToISO8601(benchmark::State& state) {
+  const std::vector<IntervalValue> values = MakeIntervalValues();
+  for (auto _ : state) {
+    for (const IntervalValue& value : values) {
+      benchmark::DoNotOptimize(value.ToISO8601());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_IntervalToISO8601);
+
+void BM_IntervalParseFromString(benchmark::State& state) {
+  std::vector<std::string> strings;
+  for (const IntervalValue& value : MakeIntervalValues()) {
+    strings.push_back(value.ToString());
+  }
+  for (auto _ : state) {
+    for (const std::string& string : strings) {
+      benchmark::DoNotOptimize(IntervalValue::ParseFromString(string));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_IntervalParseFromString);
+
+void BM_IntervalParseFromISO8601(benchmark::State& state) {
+  std::vector<std::string> strings;
+  for (const IntervalValue& value : MakeIntervalValues()) {
+    strings.push_back(value.ToISO8601());
+  }
+  for (auto _ : state) {
+    for (const std::string& string : strings) {
+      benchmark::DoNotOptimize(IntervalValue::ParseFromISO8601(string));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_IntervalParseFromISO8601);
+
+// Parses the string of an INTERVAL literal with a single datetime field, like
+// INTERVAL '36' HOUR.
+void BM_IntervalParseFromStringWithPart(benchmark::State& state) {
+  const auto part = static_cast<functions::DateTimestampPart>(state.range(0));
+  std::mt19937_64 rng(kSeed);
+  std::uniform_int_distribution<int64_t> value(-10000, 10000);
+  std::vector<std::string> strings;
+  for (int i = 0; i < kNumInputs; i++) {
+    strings.push_back(absl::StrCat(value(rng)));
+  }
+  for (auto _ : state) {
+    for (const std::string& string : strings) {
+      benchmark::DoNotOptimize(IntervalValue::ParseFromString(string, part));
+    }
+  }
+  state.SetLabel(functions::DateTimestampPart_Name(part));
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_IntervalParseFromStringWithPart)
+    ->ArgsProduct({PartArgs({functions::YEAR, functions::MONTH, functions::DAY,
+                             functions::HOUR, functions::SECOND})});
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace bigquery_ml_utils
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmarks of parsing DATE and TIMESTAMP strings, with the format strings of
+// PARSE_DATE() and PARSE_TIMESTAMP() in parse_date_time.h and with the
+// canonical format of CAST in date_time_util.h.  The inputs are the values of
+// benchmark_inputs.h formatted with the format string being measured.
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "sql_utils/benchmarks/benchmark_inputs.h"
+#include "sql_utils/public/functions/date_time_util.h"
+#include "sql_utils/public/functions/parse_date_time.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "benchmark/benchmark.h"
+
+namespace bigquery_ml_utils {
+namespace benchmarks {
+namespace {
+
+constexpr const char* kDateFormats[] = {
+    "%Y-%m-%d", "%F", "%d/%m/%Y", "%Y%m%d", "%A, %B %e, %Y", "%b %d %Y",
+};
+
+constexpr const char* kTimestampFormats[] = {
+    "%Y-%m-%d %H:%M:%S",    "%Y-%m-%dT%H:%M:%E6S%Ez", "%c",
+    "%d/%m/%Y %I:%M:%S %p", "%s",                     "%F %T %Ez",
+};
+
+std::vector<std::string> FormatDates(const char* format) {
+  std::vector<std::string> strings;
+  for (int32_t date : MakeDates()) {
+    std::string output;
+    if (functions::FormatDateToString(format, date, &output).ok()) {
+      strings.push_back(std::move(output));
+    }
+  }
+  return strings;
+}
+
+std::vector<std::string> FormatTimestamps(const char* format,
+                                          absl::TimeZone timezone) {
+  std::vector<std::string> strings;
+  for (int64_t timestamp : MakeTimestamps(/*sorted=*/false)) {
+    std::string output;
+    if (functions::FormatTimestampToString(format, timestamp, timezone,
+                                           &output)
+            .ok()) {
+      strings.push_back(std::move(output));
+    }
+  }
+  return strings;
+}
+
+void BM_ParseStringToDate(benchmark::State& state) {
+  const char* format = kDateFormats[state.range(0)];
+  const std::vector<std::string> strings = FormatDates(format);
+  for (auto _ : state) {
+    for (const std::string& string : strings) {
+      int32_t output;
+      benchmark::DoNotOptimize(functions::ParseStringToDate(
+          format, string, /*parse_version2=*/true, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetLabel(format);
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_ParseStringToDate)->DenseRange(0, std::size(kDateFormats) - 1);
+
+// Parses dates formatted as "%d/%m/%Y" with "%Y-%m-%d", which fails on every
+// input, like SAFE.PARSE_DATE() on a dirty column.  With state.range(0), uses
+// TryParseStringToDate() instead of ParseStringToDate().
+void BM_ParseStringToDateFailure(benchmark::State& state) {
+  const bool try_parse = state.range(0) != 0;
+  const std::vector<std::string> strings = FormatDates("%d/%m/%Y");
+  for (auto _ : state) {
+    for (const std::string& string : strings) {
+      int32_t output;
+      if (try_parse) {
+        benchmark::DoNotOptimize(functions::TryParseStringToDate(
+            "%Y-%m-%d", string, /*parse_version2=*/true, &output));
+      } else {
+        benchmark::DoNotOptimize(functions::ParseStringToDate(
+            "%Y-%m-%d", string, /*parse_version2=*/true, &output));
+      }
+    }
+  }
+  state.SetLabel(try_parse ? "TryParse" : "Parse");
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_ParseStringToDateFailure)->DenseRange(0, 1);
+
+void BM_ParseStringToTimestamp(benchmark::State& state) {
+  const char* format = kTimestampFormats[state.range(0)];
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(1));
+  const std::vector<std::string> strings = FormatTimestamps(format, timezone);
+  for (auto _ : state) {
+    for (const std::string& string : strings) {
+      int64_t output;
+      benchmark::DoNotOptimize(functions::ParseStringToTimestamp(
+          format, string, timezone, /*parse_version2=*/true, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetLabel(absl::StrCat(format, " ", kTimeZones[state.range(1)]));
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_ParseStringToTimestamp)
+    ->ArgsProduct({benchmark::CreateDenseRange(
+                       0, std::size(kTimestampFormats) - 1, /*step=*/1),
+                   {0, 1}});
+
+void BM_ConvertStringToDate(benchmark::State& state) {
+  const std::vector<std::string> strings = FormatDates("%Y-%m-%d");
+  for (auto _ : state) {
+    for (const std::string& string : strings) {
+      int32_t output;
+      benchmark::DoNotOptimize(functions::ConvertStringToDate(string, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_ConvertStringToDate);
+
+void BM_ConvertStringToTimestamp(benchmark::State& state) {
+  const absl::TimeZone timezone = BenchmarkTimeZone(state.range(0));
+  const std::vector<std::string> strings =
+      FormatTimestamps("%Y-%m-%d %H:%M:%E6S%Ez", timezone);
+  for (auto _ : state) {
+    for (const std::string& string : strings) {
+      int64_t output;
+      benchmark::DoNotOptimize(functions::ConvertStringToTimestamp(
+          string, timezone, functions::kMicroseconds, &output));
+      benchmark::DoNotOptimize(output);
+    }
+  }
+  state.SetLabel(kTimeZones[state.range(0)]);
+  state.SetItemsProcessed(state.iterations() * strings.size());
+}
+BENCHMARK(BM_ConvertStringToTimestamp)->DenseRange(0, 1);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace bigquery_ml_utils
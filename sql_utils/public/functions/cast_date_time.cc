@@ -65,6 +65,8 @@ namespace functions {
 namespace {
 
 using cast_date_time_internal::DateTimeFormatElement;
+using cast_date_time_internal::DateTimeParsePlan;
+using cast_date_time_internal::DigitCountRange;
 using cast_date_time_internal::FormatElementCategory;
 using cast_date_time_internal::FormatElementType;
 using cast_date_time_internal::GetDateTimeFormatElements;
@@ -493,7 +495,7 @@ bool IsSupportedForParsing(const DateTimeFormatElement& format_element) {
 // For example, "YYY", standalone, matches 1-3 digits, but in the context of
 // "YYYMM", "YYY" must match exactly 3 digits.
 absl::StatusOr<std::vector<bool>> ComputeElementPrecedesDigits(
-    std::vector<DateTimeFormatElement> format_elements) {
+    const std::vector<DateTimeFormatElement>& format_elements) {
   std::vector<bool> element_precedes_digits;
   element_precedes_digits.resize(format_elements.size(), false);
   for (int i = static_cast<int>(element_precedes_digits.size()) - 2; i >= 0;
@@ -549,13 +551,6 @@ absl::StatusOr<std::vector<bool>> ComputeElementPrecedesDigits(
   return element_precedes_digits;
 }
 
-// This struct specifies the range of number of digits that an element can
-// parse.
-struct DigitCountRange {
-  int min = 0;
-  int max = 0;
-};
-
 // Returns a vector of DigitCountRange objects <digit_count_ranges> where
 // <digit_count_ranges[i]> indicates the range of number of digits to parse for
 // <format_elements[i]>. For elements that do not parse digits (e.g. "-") or
@@ -753,12 +748,14 @@ size_t ParseWithFormatElementOfTypeTZH(absl::string_view timestamp_string,
 }
 
 // This function conducts the parsing for <timestamp_string> with
-// <format_elements>.
+// <format_elements>, whose <plan> has been computed by
+// ComputeDateTimeParsePlan. The year and month that the format does not
+// specify are taken from <defaults>, the current time at <default_timezone>.
 absl::Status ParseTimeWithFormatElements(
     const std::vector<DateTimeFormatElement>& format_elements,
-    absl::string_view timestamp_string, const absl::TimeZone default_timezone,
-    const absl::Time current_timestamp, TimestampScale scale,
-    absl::Time* timestamp) {
+    const DateTimeParsePlan& plan, absl::string_view timestamp_string,
+    const absl::TimeZone default_timezone, const absl::CivilSecond& defaults,
+    TimestampScale scale, absl::Time* timestamp) {
   // The number of format elements from <format_elements> that have been
   // successfully processed so far.
   size_t processed_format_element_count = 0;
@@ -766,11 +763,8 @@ absl::Status ParseTimeWithFormatElements(
   // parsed so far.
   size_t timestamp_str_parsed_length = 0;
 
-  absl::TimeZone::CivilInfo now_info = default_timezone.At(current_timestamp);
-  absl::CivilSecond cs_now = now_info.cs;
-
-  int year = static_cast<int>(cs_now.year());
-  int month = cs_now.month();
+  int year = static_cast<int>(defaults.year());
+  int month = defaults.month();
   int mday = 1;
   int hour = 0;
   int min = 0;
@@ -779,16 +773,14 @@ absl::Status ParseTimeWithFormatElements(
   bool afternoon = false;
   absl::Duration subseconds = absl::ZeroDuration();
 
-  // Indicates whether TZH or TZM appears in the format string.
-  bool timezone_specified_in_format = false;
-
   bool positive_timezone_offset = true;
   int timezone_offset_hour = 0;
   int timezone_offset_min = 0;
 
   bool error_in_parsing = false;
-  SQL_ASSIGN_OR_RETURN(const std::vector<DigitCountRange> digit_count_ranges,
-                       ComputeDigitCountRanges(format_elements));
+  const std::vector<DigitCountRange>& digit_count_ranges =
+      plan.digit_count_ranges;
+  SQL_RET_CHECK_EQ(digit_count_ranges.size(), format_elements.size());
 
   // Skips leading whitespaces.
   timestamp_str_parsed_length +=
@@ -992,7 +984,6 @@ absl::Status ParseTimeWithFormatElements(
       //   - for input "-09", the sign and hour value of output time zone are
       //     "-09".
       case FormatElementType::kTZH: {
-        timezone_specified_in_format = true;
         parsed_length = ParseWithFormatElementOfTypeTZH(
             timestamp_str_to_parse, digit_count_range,
             &positive_timezone_offset, &timezone_offset_hour);
@@ -1001,7 +992,6 @@ absl::Status ParseTimeWithFormatElements(
       // Parses for the minute value of the time zone offset. For example, for
       // input "13", the minute value of output time zone is 13.
       case FormatElementType::kTZM:
-        timezone_specified_in_format = true;
         parsed_length = ParseInt(timestamp_str_to_parse,
                                  /*min_width=*/digit_count_range.min,
                                  /*max_width=*/digit_count_range.max, /*min=*/0,
@@ -1074,14 +1064,20 @@ absl::Status ParseTimeWithFormatElements(
            << "Invalid result from year, month, day values after parsing";
   }
 
-  absl::TimeZone timezone;
-  if (timezone_specified_in_format) {
-    SQL_RETURN_IF_ERROR(MakeTimeZone(
-        absl::StrFormat("%c%02d%02d", positive_timezone_offset ? '+' : '-',
-                        timezone_offset_hour, timezone_offset_min),
-        &timezone));
-  } else {
-    timezone = default_timezone;
+  absl::TimeZone timezone = default_timezone;
+  if (plan.has_timezone_element) {
+    // Builds the fixed offset time zone directly rather than formatting the
+    // offset for MakeTimeZone to parse it back.
+    const int offset_minutes = timezone_offset_hour * 60 + timezone_offset_min;
+    if (!IsValidTimeZone(offset_minutes)) {
+      return MakeEvalError() << "Invalid time zone: "
+                             << absl::StrFormat(
+                                    "%c%02d%02d",
+                                    positive_timezone_offset ? '+' : '-',
+                                    timezone_offset_hour, timezone_offset_min);
+    }
+    timezone = absl::FixedTimeZone(
+        (positive_timezone_offset ? offset_minutes : -offset_minutes) * 60);
   }
   *timestamp = timezone.At(cs).pre + subseconds;
   if (!IsValidTime(*timestamp)) {
@@ -1090,6 +1086,20 @@ absl::Status ParseTimeWithFormatElements(
   return absl::OkStatus();
 }
 
+absl::Status ParseTimeWithFormatElements(
+    const std::vector<DateTimeFormatElement>& format_elements,
+    absl::string_view timestamp_string, const absl::TimeZone default_timezone,
+    const absl::Time current_timestamp, TimestampScale scale,
+    absl::Time* timestamp) {
+  SQL_ASSIGN_OR_RETURN(
+      const DateTimeParsePlan plan,
+      cast_date_time_internal::ComputeDateTimeParsePlan(format_elements));
+  return ParseTimeWithFormatElements(format_elements, plan, timestamp_string,
+                                     default_timezone,
+                                     default_timezone.At(current_timestamp).cs,
+                                     scale, timestamp);
+}
+
 // Returns an error if more than one format element in the target category exist
 // in the format string, i.e. the value of <category> in
 // <category_to_elements_map> contains more than one item. For example, you
@@ -1316,11 +1326,12 @@ absl::Status ValidateDateTimeFormatElements(
 // The result <timestamp> is always at microseconds precision.
 absl::Status ParseTimeWithFormatElements(
     const std::vector<DateTimeFormatElement>& format_elements,
-    absl::string_view timestamp_string, const absl::TimeZone default_timezone,
-    const absl::Time current_timestamp, int64_t* timestamp_micros) {
+    const DateTimeParsePlan& plan, absl::string_view timestamp_string,
+    const absl::TimeZone default_timezone, const absl::CivilSecond& defaults,
+    int64_t* timestamp_micros) {
   absl::Time base_time;
   SQL_RETURN_IF_ERROR(ParseTimeWithFormatElements(
-      format_elements, timestamp_string, default_timezone, current_timestamp,
+      format_elements, plan, timestamp_string, default_timezone, defaults,
       kMicroseconds, &base_time));
 
   if (!ConvertTimeToTimestamp(base_time, timestamp_micros)) {
@@ -1419,6 +1430,35 @@ absl::Status ValidateDatetimeDateTimeFormatElementsForFormatting(
   return absl::OkStatus();
 }
 
+// Computes the defaults of ParseTimeWithFormatElements for parsing a DATE or
+// DATETIME. We use <current_date_utc_ts> (constructed with <current_date>
+// and "UTC") as <current_timestamp> and "UTC" as <default_timezone>, so the
+// <current_year> and <current_date> used in ParseTimeWithFormatElements
+// function would be the same as year and month in <current_date>.
+absl::Status CurrentDateDefaults(int32_t current_date,
+                                 absl::CivilSecond* defaults) {
+  absl::Time current_date_utc_ts;
+  SQL_RETURN_IF_ERROR(ConvertDateToTimestamp(current_date, absl::UTCTimeZone(),
+                                             &current_date_utc_ts));
+  *defaults = absl::UTCTimeZone().At(current_date_utc_ts).cs;
+  return absl::OkStatus();
+}
+
+// Casts every row of a batch with <cast>, which casts row <row> into its
+// second argument. Rows that fail are reset to the default value of OutputT
+// and their status is passed on to <errors>.
+template <typename OutputT, typename CastFn>
+void CastRows(const CastFn& cast, absl::Span<OutputT> output,
+              ErrorSink* errors) {
+  for (int64_t row = 0; row < static_cast<int64_t>(output.size()); ++row) {
+    absl::Status status = cast(row, &output[row]);
+    if (ABSL_PREDICT_FALSE(!status.ok())) {
+      output[row] = OutputT();
+      if (errors != nullptr) errors->OnError(row, std::move(status));
+    }
+  }
+}
+
 }  // namespace
 
 namespace cast_date_time_internal {
@@ -1724,6 +1764,20 @@ absl::StatusOr<std::vector<DateTimeFormatElement>> GetDateTimeFormatElements(
   return format_elements;
 }
 
+absl::StatusOr<DateTimeParsePlan> ComputeDateTimeParsePlan(
+    const std::vector<DateTimeFormatElement>& format_elements) {
+  DateTimeParsePlan plan;
+  SQL_ASSIGN_OR_RETURN(plan.digit_count_ranges,
+                       ComputeDigitCountRanges(format_elements));
+  for (const DateTimeFormatElement& format_element : format_elements) {
+    if (format_element.type == FormatElementType::kTZH ||
+        format_element.type == FormatElementType::kTZM) {
+      plan.has_timezone_element = true;
+    }
+  }
+  return plan;
+}
+
 // Takes a format model vector and rewrites it to be a format element string
 // that can be correctly formatted by FormatTime. Any elements that are not
 // supported by FormatTime will be formatted manually in this function. Any
@@ -1832,22 +1886,25 @@ absl::StatusOr<std::string> FromDateTimeFormatElementToFormatString(
   }
 }
 
-absl::StatusOr<std::string> ResolveFormatString(
+// Appends the output of <format_element> for <base_time> to <out>. <info> is
+// <base_time> at <timezone>, computed once for all the elements of a format.
+absl::Status AppendResolvedFormatString(
     const DateTimeFormatElement& format_element, absl::Time base_time,
-    absl::TimeZone timezone) {
-  const absl::TimeZone::CivilInfo info = timezone.At(base_time);
+    absl::TimeZone timezone, const absl::TimeZone::CivilInfo& info,
+    std::string* out) {
   SQL_ASSIGN_OR_RETURN(
       const std::string format_string,
       FromDateTimeFormatElementToFormatString(format_element, info));
   // We do not need to go through steps of calling FormatTime function and
   // resolving casing for literal format elements.
   if (format_element.category == FormatElementCategory::kLiteral) {
-    return format_string;
+    out->append(format_string);
+    return absl::OkStatus();
   }
 
-  // The following resolves casing for format elements.
-  std::string resolved_string =
-      absl::FormatTime(format_string, base_time, timezone);
+  // The following resolves casing for format elements, in place in <out>.
+  const size_t start = out->size();
+  out->append(absl::FormatTime(format_string, base_time, timezone));
 
   switch (format_element.format_casing_type) {
     case FormatCasingType::kFormatCasingTypeUnspecified:
@@ -1858,31 +1915,44 @@ absl::StatusOr<std::string> ResolveFormatString(
     // capitalized and all subsequent letters being lowercase, so we do not need
     // any extra processing here.
     case FormatCasingType::kOnlyFirstLetterUppercase:
-      return resolved_string;
+      break;
     case FormatCasingType::kAllLettersUppercase:
-      return absl::AsciiStrToUpper(resolved_string);
+      for (size_t i = start; i < out->size(); ++i) {
+        (*out)[i] = absl::ascii_toupper((*out)[i]);
+      }
+      break;
     case FormatCasingType::kAllLettersLowercase:
-      return absl::AsciiStrToLower(resolved_string);
+      for (size_t i = start; i < out->size(); ++i) {
+        (*out)[i] = absl::ascii_tolower((*out)[i]);
+      }
+      break;
   }
+  return absl::OkStatus();
 }
 
-absl::StatusOr<std::string> FromCastFormatTimestampToStringInternal(
+// Writes the output of <format_elements> for <base_time> into <out>. <out> is
+// left unchanged on error.
+absl::Status FromCastFormatTimestampToStringInternal(
     absl::Span<const DateTimeFormatElement> format_elements,
-    absl::Time base_time, absl::TimeZone timezone) {
+    absl::Time base_time, absl::TimeZone timezone, std::string* out) {
   if (!IsValidTime(base_time)) {
     return MakeEvalError() << "Invalid timestamp value: "
                            << absl::ToUnixMicros(base_time);
   }
   absl::TimeZone normalized_timezone =
       internal_functions::GetNormalizedTimeZone(base_time, timezone);
-  std::string updated_format_string;
+  const absl::TimeZone::CivilInfo info = normalized_timezone.At(base_time);
+  // The output is built in a per-thread buffer and swapped into <out> on
+  // success, so that the buffers of the thread and of <out> are reused by the
+  // following calls.
+  thread_local std::string buffer;
+  buffer.clear();
   for (const DateTimeFormatElement& format_element : format_elements) {
-    SQL_ASSIGN_OR_RETURN(
-        std::string str_format,
-        ResolveFormatString(format_element, base_time, normalized_timezone));
-    absl::StrAppend(&updated_format_string, str_format);
+    SQL_RETURN_IF_ERROR(AppendResolvedFormatString(
+        format_element, base_time, normalized_timezone, info, &buffer));
   }
-  return updated_format_string;
+  out->swap(buffer);
+  return absl::OkStatus();
 }
 
 }  // namespace cast_date_time_internal
@@ -1895,20 +1965,46 @@ absl::StatusOr<StringToTimestampCaster> StringToTimestampCaster::Create(
                        GetDateTimeFormatElements(format_string));
   SQL_RETURN_IF_ERROR(
       ValidateDateTimeFormatElementsForTimestampType(format_elements));
+  SQL_ASSIGN_OR_RETURN(
+      auto plan,
+      cast_date_time_internal::ComputeDateTimeParsePlan(format_elements));
 
-  return StringToTimestampCaster(std::move(format_elements));
+  return StringToTimestampCaster(std::move(format_elements), std::move(plan));
 }
 
 absl::Status StringToTimestampCaster::Cast(absl::string_view timestamp_string,
                                            absl::TimeZone default_timezone,
                                            absl::Time current_timestamp,
                                            int64_t* timestamp_micros) const {
+  return CastWithDefaults(timestamp_string, default_timezone,
+                          default_timezone.At(current_timestamp).cs,
+                          timestamp_micros);
+}
+
+absl::Status StringToTimestampCaster::CastBatch(
+    absl::Span<const absl::string_view> timestamp_strings,
+    absl::TimeZone default_timezone, absl::Time current_timestamp,
+    absl::Span<int64_t> timestamps_micros, ErrorSink* errors) const {
+  SQL_RET_CHECK_EQ(timestamp_strings.size(), timestamps_micros.size());
+  const absl::CivilSecond defaults = default_timezone.At(current_timestamp).cs;
+  CastRows(
+      [&](int64_t row, int64_t* out) {
+        return CastWithDefaults(timestamp_strings[row], default_timezone,
+                                defaults, out);
+      },
+      timestamps_micros, errors);
+  return absl::OkStatus();
+}
+
+absl::Status StringToTimestampCaster::CastWithDefaults(
+    absl::string_view timestamp_string, absl::TimeZone default_timezone,
+    const absl::CivilSecond& defaults, int64_t* timestamp_micros) const {
   if (!IsWellFormedUTF8(timestamp_string)) {
     return MakeEvalError() << "Input string is not valid UTF-8";
   }
 
-  return ParseTimeWithFormatElements(format_elements_, timestamp_string,
-                                     default_timezone, current_timestamp,
+  return ParseTimeWithFormatElements(format_elements_, plan_, timestamp_string,
+                                     default_timezone, defaults,
                                      timestamp_micros);
 }
 
@@ -1985,8 +2081,11 @@ absl::StatusOr<StringToDateCaster> StringToDateCaster::Create(
                        GetDateTimeFormatElements(format_string));
   SQL_RETURN_IF_ERROR(
       ValidateDateTimeFormatElementsForDateType(format_elements));
+  SQL_ASSIGN_OR_RETURN(
+      auto plan,
+      cast_date_time_internal::ComputeDateTimeParsePlan(format_elements));
 
-  return StringToDateCaster(std::move(format_elements));
+  return StringToDateCaster(std::move(format_elements), std::move(plan));
 }
 
 absl::Status StringToDateCaster::Cast(absl::string_view date_string,
@@ -1995,17 +2094,36 @@ absl::Status StringToDateCaster::Cast(absl::string_view date_string,
   if (!IsWellFormedUTF8(date_string)) {
     return MakeEvalError() << "Input string is not valid UTF-8";
   }
+  absl::CivilSecond defaults;
+  SQL_RETURN_IF_ERROR(CurrentDateDefaults(current_date, &defaults));
+  return CastWithDefaults(date_string, defaults, date);
+}
+
+absl::Status StringToDateCaster::CastBatch(
+    absl::Span<const absl::string_view> date_strings, int32_t current_date,
+    absl::Span<int32_t> dates, ErrorSink* errors) const {
+  SQL_RET_CHECK_EQ(date_strings.size(), dates.size());
+  absl::CivilSecond defaults;
+  const absl::Status defaults_status =
+      CurrentDateDefaults(current_date, &defaults);
+  CastRows(
+      [&](int64_t row, int32_t* out) -> absl::Status {
+        if (!IsWellFormedUTF8(date_strings[row])) {
+          return MakeEvalError() << "Input string is not valid UTF-8";
+        }
+        SQL_RETURN_IF_ERROR(defaults_status);
+        return CastWithDefaults(date_strings[row], defaults, out);
+      },
+      dates, errors);
+  return absl::OkStatus();
+}
 
-  absl::Time current_date_utc_ts;
+absl::Status StringToDateCaster::CastWithDefaults(
+    absl::string_view date_string, const absl::CivilSecond& defaults,
+    int32_t* date) const {
   int64_t timestamp;
-  SQL_RETURN_IF_ERROR(ConvertDateToTimestamp(current_date, absl::UTCTimeZone(),
-                                             &current_date_utc_ts));
-  // We use <current_date_utc_ts> (constructed with <current_date> and "UTC")
-  // as <current_timestamp> and "UTC" as <default_timezone>, so the
-  // <current_year> and <current_date> used in ParseTimeWithFormatElements
-  // function would be the same as year and month in <current_date>.
   SQL_RETURN_IF_ERROR(ParseTimeWithFormatElements(
-      format_elements_, date_string, absl::UTCTimeZone(), current_date_utc_ts,
+      format_elements_, plan_, date_string, absl::UTCTimeZone(), defaults,
       &timestamp));
   SQL_RETURN_IF_ERROR(ExtractFromTimestamp(DATE, timestamp, kMicroseconds,
                                            absl::UTCTimeZone(), date));
@@ -2033,8 +2151,11 @@ absl::StatusOr<StringToTimeCaster> StringToTimeCaster::Create(
                        GetDateTimeFormatElements(format_string));
   SQL_RETURN_IF_ERROR(
       ValidateDateTimeFormatElementsForTimeType(format_elements));
+  SQL_ASSIGN_OR_RETURN(
+      auto plan,
+      cast_date_time_internal::ComputeDateTimeParsePlan(format_elements));
 
-  return StringToTimeCaster(std::move(format_elements));
+  return StringToTimeCaster(std::move(format_elements), std::move(plan));
 }
 
 absl::Status StringToTimeCaster::Cast(absl::string_view time_string,
@@ -2053,14 +2174,26 @@ absl::Status StringToTimeCaster::Cast(absl::string_view time_string,
   // final output since we derive default values for time parts from
   // "00:00:00:000000000".
   SQL_RETURN_IF_ERROR(ParseTimeWithFormatElements(
-      format_elements_, time_string, absl::UTCTimeZone(),
-      /*current_timestamp=*/absl::UnixEpoch(), scale, &timestamp));
+      format_elements_, plan_, time_string, absl::UTCTimeZone(),
+      /*defaults=*/absl::CivilSecond(1970, 1, 1), scale, &timestamp));
   SQL_RETURN_IF_ERROR(
       ConvertTimestampToTime(timestamp, absl::UTCTimeZone(), scale, time));
 
   return absl::OkStatus();
 }
 
+absl::Status StringToTimeCaster::CastBatch(
+    absl::Span<const absl::string_view> time_strings, TimestampScale scale,
+    absl::Span<TimeValue> times, ErrorSink* errors) const {
+  SQL_RET_CHECK_EQ(time_strings.size(), times.size());
+  CastRows(
+      [&](int64_t row, TimeValue* out) {
+        return Cast(time_strings[row], scale, out);
+      },
+      times, errors);
+  return absl::OkStatus();
+}
+
 absl::StatusOr<StringToDatetimeCaster> StringToDatetimeCaster::Create(
     absl::string_view format_string) {
   SQL_RETURN_IF_ERROR(ConductBasicFormatStringChecks(format_string));
@@ -2068,8 +2201,11 @@ absl::StatusOr<StringToDatetimeCaster> StringToDatetimeCaster::Create(
                        GetDateTimeFormatElements(format_string));
   SQL_RETURN_IF_ERROR(
       ValidateDateTimeFormatElementsForDatetimeType(format_elements));
+  SQL_ASSIGN_OR_RETURN(
+      auto plan,
+      cast_date_time_internal::ComputeDateTimeParsePlan(format_elements));
 
-  return StringToDatetimeCaster(std::move(format_elements));
+  return StringToDatetimeCaster(std::move(format_elements), std::move(plan));
 }
 
 absl::Status StringToDatetimeCaster::Cast(absl::string_view datetime_string,
@@ -2082,17 +2218,40 @@ absl::Status StringToDatetimeCaster::Cast(absl::string_view datetime_string,
 
   SQL_RET_CHECK(scale == kMicroseconds || scale == kNanoseconds)
       << "Only kNanoseconds or kMicroseconds scale is supported";
-  absl::Time current_date_utc_ts;
+  absl::CivilSecond defaults;
+  SQL_RETURN_IF_ERROR(CurrentDateDefaults(current_date, &defaults));
+  return CastWithDefaults(datetime_string, scale, defaults, datetime);
+}
+
+absl::Status StringToDatetimeCaster::CastBatch(
+    absl::Span<const absl::string_view> datetime_strings, TimestampScale scale,
+    int32_t current_date, absl::Span<DatetimeValue> datetimes,
+    ErrorSink* errors) const {
+  SQL_RET_CHECK_EQ(datetime_strings.size(), datetimes.size());
+  absl::CivilSecond defaults;
+  const absl::Status defaults_status =
+      CurrentDateDefaults(current_date, &defaults);
+  CastRows(
+      [&](int64_t row, DatetimeValue* out) -> absl::Status {
+        if (!IsWellFormedUTF8(datetime_strings[row])) {
+          return MakeEvalError() << "Input string is not valid UTF-8";
+        }
+        SQL_RET_CHECK(scale == kMicroseconds || scale == kNanoseconds)
+            << "Only kNanoseconds or kMicroseconds scale is supported";
+        SQL_RETURN_IF_ERROR(defaults_status);
+        return CastWithDefaults(datetime_strings[row], scale, defaults, out);
+      },
+      datetimes, errors);
+  return absl::OkStatus();
+}
+
+absl::Status StringToDatetimeCaster::CastWithDefaults(
+    absl::string_view datetime_string, TimestampScale scale,
+    const absl::CivilSecond& defaults, DatetimeValue* datetime) const {
   absl::Time timestamp;
-  SQL_RETURN_IF_ERROR(ConvertDateToTimestamp(current_date, absl::UTCTimeZone(),
-                                             &current_date_utc_ts));
-  // We use <current_date_utc_ts> (constructed with <current_date> and "UTC")
-  // as <current_timestamp> and "UTC" as <default_timezone>, so the
-  // <current_year> and <current_date> used in ParseTimeWithFormatElements
-  // function would be the same as year and month in <current_date>.
   SQL_RETURN_IF_ERROR(ParseTimeWithFormatElements(
-      format_elements_, datetime_string, absl::UTCTimeZone(),
-      current_date_utc_ts, scale, &timestamp));
+      format_elements_, plan_, datetime_string, absl::UTCTimeZone(), defaults,
+      scale, &timestamp));
   SQL_RETURN_IF_ERROR(
       ConvertTimestampToDatetime(timestamp, absl::UTCTimeZone(), datetime));
   return absl::OkStatus();
@@ -2168,10 +2327,17 @@ absl::Status DateToStringCaster::Cast(int32_t date, std::string* out) const {
   // Treats it as a timestamp at midnight on that date and invokes the
   // format_timestamp function.
   int64_t date_timestamp = static_cast<int64_t>(date) * kNaiveNumMicrosPerDay;
-  SQL_ASSIGN_OR_RETURN(
-      *out, cast_date_time_internal::FromCastFormatTimestampToStringInternal(
-                format_elements_, MakeTime(date_timestamp, kMicroseconds),
-                absl::UTCTimeZone()));
+  return cast_date_time_internal::FromCastFormatTimestampToStringInternal(
+      format_elements_, MakeTime(date_timestamp, kMicroseconds),
+      absl::UTCTimeZone(), out);
+}
+
+absl::Status DateToStringCaster::CastBatch(absl::Span<const int32_t> dates,
+                                           absl::Span<std::string> out,
+                                           ErrorSink* errors) const {
+  SQL_RET_CHECK_EQ(dates.size(), out.size());
+  CastRows([&](int64_t row, std::string* str) { return Cast(dates[row], str); },
+           out, errors);
   return absl::OkStatus();
 }
 
@@ -2204,9 +2370,17 @@ absl::Status DatetimeToStringCaster::Cast(const DatetimeValue& datetime,
       absl::UTCTimeZone().At(datetime.ConvertToCivilSecond()).pre;
   datetime_in_utc += absl::Nanoseconds(datetime.Nanoseconds());
 
-  SQL_ASSIGN_OR_RETURN(
-      *out, cast_date_time_internal::FromCastFormatTimestampToStringInternal(
-                format_elements_, datetime_in_utc, absl::UTCTimeZone()));
+  return cast_date_time_internal::FromCastFormatTimestampToStringInternal(
+      format_elements_, datetime_in_utc, absl::UTCTimeZone(), out);
+}
+
+absl::Status DatetimeToStringCaster::CastBatch(
+    absl::Span<const DatetimeValue> datetimes, absl::Span<std::string> out,
+    ErrorSink* errors) const {
+  SQL_RET_CHECK_EQ(datetimes.size(), out.size());
+  CastRows(
+      [&](int64_t row, std::string* str) { return Cast(datetimes[row], str); },
+      out, errors);
   return absl::OkStatus();
 }
 
@@ -2242,9 +2416,16 @@ absl::Status TimeToStringCaster::Cast(const TimeValue& time,
           .pre;
   time_in_epoch_day += absl::Nanoseconds(time.Nanoseconds());
 
-  SQL_ASSIGN_OR_RETURN(
-      *out, cast_date_time_internal::FromCastFormatTimestampToStringInternal(
-                format_elements_, time_in_epoch_day, absl::UTCTimeZone()));
+  return cast_date_time_internal::FromCastFormatTimestampToStringInternal(
+      format_elements_, time_in_epoch_day, absl::UTCTimeZone(), out);
+}
+
+absl::Status TimeToStringCaster::CastBatch(absl::Span<const TimeValue> times,
+                                           absl::Span<std::string> out,
+                                           ErrorSink* errors) const {
+  SQL_RET_CHECK_EQ(times.size(), out.size());
+  CastRows([&](int64_t row, std::string* str) { return Cast(times[row], str); },
+           out, errors);
   return absl::OkStatus();
 }
 
@@ -2267,19 +2448,27 @@ absl::StatusOr<TimestampToStringCaster> TimestampToStringCaster::Create(
 absl::Status TimestampToStringCaster::Cast(int64_t timestamp_micros,
                                            absl::TimeZone timezone,
                                            std::string* out) const {
-  SQL_ASSIGN_OR_RETURN(
-      *out, cast_date_time_internal::FromCastFormatTimestampToStringInternal(
-                format_elements_, MakeTime(timestamp_micros, kMicroseconds),
-                timezone));
-  return absl::OkStatus();
+  return cast_date_time_internal::FromCastFormatTimestampToStringInternal(
+      format_elements_, MakeTime(timestamp_micros, kMicroseconds), timezone,
+      out);
 }
 
 absl::Status TimestampToStringCaster::Cast(absl::Time timestamp,
                                            absl::TimeZone timezone,
                                            std::string* out) const {
-  SQL_ASSIGN_OR_RETURN(
-      *out, cast_date_time_internal::FromCastFormatTimestampToStringInternal(
-                format_elements_, timestamp, timezone));
+  return cast_date_time_internal::FromCastFormatTimestampToStringInternal(
+      format_elements_, timestamp, timezone, out);
+}
+
+absl::Status TimestampToStringCaster::CastBatch(
+    absl::Span<const int64_t> timestamps_micros, absl::TimeZone timezone,
+    absl::Span<std::string> out, ErrorSink* errors) const {
+  SQL_RET_CHECK_EQ(timestamps_micros.size(), out.size());
+  CastRows(
+      [&](int64_t row, std::string* str) {
+        return Cast(timestamps_micros[row], timezone, str);
+      },
+      out, errors);
   return absl::OkStatus();
 }
 
@@ -22,7 +22,11 @@
 #include <utility>
 #include <vector>
 
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/civil_time.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "sql_utils/base/status.h"
 #include "sql_utils/public/functions/date_time_util.h"
 #include "sql_utils/public/type.pb.h"
@@ -332,6 +336,29 @@ struct DateTimeFormatElement {
 absl::StatusOr<std::vector<DateTimeFormatElement>> GetDateTimeFormatElements(
     absl::string_view format_str);
 
+// This struct specifies the range of number of digits that an element can
+// parse.
+struct DigitCountRange {
+  int min = 0;
+  int max = 0;
+};
+
+// The facts about a format that parsing needs besides its elements. They do
+// not depend on the parsed string, so the StringTo*Caster classes compute
+// them once in Create() rather than for every string they cast.
+struct DateTimeParsePlan {
+  // <digit_count_ranges[i]> is the range of digits parsed for the i-th
+  // format element.
+  std::vector<DigitCountRange> digit_count_ranges;
+  // Whether a TZH or TZM element is present, in which case the parsed offset
+  // replaces the default time zone.
+  bool has_timezone_element = false;
+};
+
+// Returns an error if any of <format_elements> is not supported for parsing.
+absl::StatusOr<DateTimeParsePlan> ComputeDateTimeParsePlan(
+    const std::vector<DateTimeFormatElement>& format_elements);
+
 }  // namespace cast_date_time_internal
 
 class StringToDateCaster {
@@ -343,13 +370,28 @@ class StringToDateCaster {
   absl::Status Cast(absl::string_view date_string, int32_t current_date,
                     int32_t* date) const;
 
+  // Casts every string of <date_strings> into <dates>. The defaults derived
+  // from <current_date> are computed once for the whole batch. Rows that fail
+  // are set to 0 and reported to <errors> (which may be null), as for the
+  // batch functions of date_time_util.h. Only returns an error if the spans
+  // have different sizes.
+  absl::Status CastBatch(absl::Span<const absl::string_view> date_strings,
+                         int32_t current_date, absl::Span<int32_t> dates,
+                         ErrorSink* errors) const;
+
  private:
+  absl::Status CastWithDefaults(absl::string_view date_string,
+                                const absl::CivilSecond& defaults,
+                                int32_t* date) const;
+
   explicit StringToDateCaster(
       std::vector<cast_date_time_internal::DateTimeFormatElement>&&
-          format_elements)
-      : format_elements_(std::move(format_elements)) {}
+          format_elements,
+      cast_date_time_internal::DateTimeParsePlan&& plan)
+      : format_elements_(std::move(format_elements)), plan_(std::move(plan)) {}
 
   std::vector<cast_date_time_internal::DateTimeFormatElement> format_elements_;
+  cast_date_time_internal::DateTimeParsePlan plan_;
 };
 
 class StringToTimeCaster {
@@ -361,13 +403,22 @@ class StringToTimeCaster {
   absl::Status Cast(absl::string_view time_string, TimestampScale scale,
                     TimeValue* time) const;
 
+  // Casts every string of <time_strings> into <times>. Rows that fail are set
+  // to the default TimeValue and reported to <errors> (which may be null).
+  // Only returns an error if the spans have different sizes.
+  absl::Status CastBatch(absl::Span<const absl::string_view> time_strings,
+                         TimestampScale scale, absl::Span<TimeValue> times,
+                         ErrorSink* errors) const;
+
  private:
   explicit StringToTimeCaster(
       std::vector<cast_date_time_internal::DateTimeFormatElement>&&
-          format_elements)
-      : format_elements_(std::move(format_elements)) {}
+          format_elements,
+      cast_date_time_internal::DateTimeParsePlan&& plan)
+      : format_elements_(std::move(format_elements)), plan_(std::move(plan)) {}
 
   std::vector<cast_date_time_internal::DateTimeFormatElement> format_elements_;
+  cast_date_time_internal::DateTimeParsePlan plan_;
 };
 
 class StringToDatetimeCaster {
@@ -379,13 +430,30 @@ class StringToDatetimeCaster {
   absl::Status Cast(absl::string_view datetime_string, TimestampScale scale,
                     int32_t current_date, DatetimeValue* datetime) const;
 
+  // Casts every string of <datetime_strings> into <datetimes>. The defaults
+  // derived from <current_date> are computed once for the whole batch. Rows
+  // that fail are set to the default DatetimeValue and reported to <errors>
+  // (which may be null). Only returns an error if the spans have different
+  // sizes.
+  absl::Status CastBatch(absl::Span<const absl::string_view> datetime_strings,
+                         TimestampScale scale, int32_t current_date,
+                         absl::Span<DatetimeValue> datetimes,
+                         ErrorSink* errors) const;
+
  private:
+  absl::Status CastWithDefaults(absl::string_view datetime_string,
+                                TimestampScale scale,
+                                const absl::CivilSecond& defaults,
+                                DatetimeValue* datetime) const;
+
   explicit StringToDatetimeCaster(
       std::vector<cast_date_time_internal::DateTimeFormatElement>&&
-          format_elements)
-      : format_elements_(std::move(format_elements)) {}
+          format_elements,
+      cast_date_time_internal::DateTimeParsePlan&& plan)
+      : format_elements_(std::move(format_elements)), plan_(std::move(plan)) {}
 
   std::vector<cast_date_time_internal::DateTimeFormatElement> format_elements_;
+  cast_date_time_internal::DateTimeParsePlan plan_;
 };
 
 class StringToTimestampCaster {
@@ -399,13 +467,31 @@ class StringToTimestampCaster {
                     absl::Time current_timestamp,
                     int64_t* timestamp_micros) const;
 
+  // Casts every string of <timestamp_strings> into <timestamps_micros>. The
+  // defaults derived from <current_timestamp> at <default_timezone> are
+  // computed once for the whole batch. Rows that fail are set to 0 and
+  // reported to <errors> (which may be null). Only returns an error if the
+  // spans have different sizes.
+  absl::Status CastBatch(absl::Span<const absl::string_view> timestamp_strings,
+                         absl::TimeZone default_timezone,
+                         absl::Time current_timestamp,
+                         absl::Span<int64_t> timestamps_micros,
+                         ErrorSink* errors) const;
+
  private:
+  absl::Status CastWithDefaults(absl::string_view timestamp_string,
+                                absl::TimeZone default_timezone,
+                                const absl::CivilSecond& defaults,
+                                int64_t* timestamp_micros) const;
+
   explicit StringToTimestampCaster(
       std::vector<cast_date_time_internal::DateTimeFormatElement>&&
-          format_elements)
-      : format_elements_(std::move(format_elements)) {}
+          format_elements,
+      cast_date_time_internal::DateTimeParsePlan&& plan)
+      : format_elements_(std::move(format_elements)), plan_(std::move(plan)) {}
 
   std::vector<cast_date_time_internal::DateTimeFormatElement> format_elements_;
+  cast_date_time_internal::DateTimeParsePlan plan_;
 };
 
 class DateToStringCaster {
@@ -416,6 +502,12 @@ class DateToStringCaster {
   // Cast the date to string using the format string.
   absl::Status Cast(int32_t date, std::string* out) const;
 
+  // Casts every date of <dates> into <out>, reusing the buffers of its
+  // strings. Rows that fail are set to "" and reported to <errors> (which may
+  // be null). Only returns an error if the spans have different sizes.
+  absl::Status CastBatch(absl::Span<const int32_t> dates,
+                         absl::Span<std::string> out, ErrorSink* errors) const;
+
  private:
   explicit DateToStringCaster(
       std::vector<cast_date_time_internal::DateTimeFormatElement>&&
@@ -433,6 +525,13 @@ class DatetimeToStringCaster {
   // Cast the datetime to string using the format string.
   absl::Status Cast(const DatetimeValue& datetime, std::string* out) const;
 
+  // Casts every datetime of <datetimes> into <out>, reusing the buffers of
+  // its strings. Rows that fail are set to "" and reported to <errors>
+  // (which may be null). Only returns an error if the spans have different
+  // sizes.
+  absl::Status CastBatch(absl::Span<const DatetimeValue> datetimes,
+                         absl::Span<std::string> out, ErrorSink* errors) const;
+
  private:
   explicit DatetimeToStringCaster(
       std::vector<cast_date_time_internal::DateTimeFormatElement>&&
@@ -450,6 +549,12 @@ class TimeToStringCaster {
   // Cast the time to string using the format string.
   absl::Status Cast(const TimeValue& time, std::string* out) const;
 
+  // Casts every time of <times> into <out>, reusing the buffers of its
+  // strings. Rows that fail are set to "" and reported to <errors> (which may
+  // be null). Only returns an error if the spans have different sizes.
+  absl::Status CastBatch(absl::Span<const TimeValue> times,
+                         absl::Span<std::string> out, ErrorSink* errors) const;
+
  private:
   explicit TimeToStringCaster(
       std::vector<cast_date_time_internal::DateTimeFormatElement>&&
@@ -470,6 +575,14 @@ class TimestampToStringCaster {
   absl::Status Cast(absl::Time timestamp, absl::TimeZone timezone,
                     std::string* out) const;
 
+  // Casts every timestamp of <timestamps_micros> at <timezone> into <out>,
+  // reusing the buffers of its strings. Rows that fail are set to "" and
+  // reported to <errors> (which may be null). Only returns an error if the
+  // spans have different sizes.
+  absl::Status CastBatch(absl::Span<const int64_t> timestamps_micros,
+                         absl::TimeZone timezone, absl::Span<std::string> out,
+                         ErrorSink* errors) const;
+
  private:
   explicit TimestampToStringCaster(
       std::vector<cast_date_time_internal::DateTimeFormatElement>&&
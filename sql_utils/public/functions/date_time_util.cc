@@ -16,6 +16,7 @@
 
 #include "sql_utils/public/functions/date_time_util.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -24,6 +25,7 @@
 #include <memory>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "sql_utils/base/logging.h"
 #include "sql_utils/common/errors.h"
@@ -55,6 +57,8 @@ namespace bigquery_ml_utils {
 namespace functions {
 namespace {
 
+using date_time_util_internal::CivilDayFieldsFromDays;
+using date_time_util_internal::DaysFromCivil;
 using date_time_util_internal::GetIsoWeek;
 using date_time_util_internal::GetIsoYear;
 using date_time_util_internal::NextWeekdayOrToday;
@@ -80,7 +84,14 @@ enum NewOrLegacyTimestampType {
 const absl::CivilDay kEpochDay = absl::CivilDay(1970, 1, 1);
 
 absl::CivilDay EpochDaysToCivilDay(int32_t days_since_epoch) {
-  return kEpochDay + days_since_epoch;
+  if (ABSL_PREDICT_FALSE(
+          days_since_epoch < date_time_util_internal::kMinCivilFieldsDays ||
+          days_since_epoch > date_time_util_internal::kMaxCivilFieldsDays)) {
+    return kEpochDay + days_since_epoch;
+  }
+  const date_time_util_internal::CivilDayFields fields =
+      CivilDayFieldsFromDays(days_since_epoch);
+  return absl::CivilDay(fields.year, fields.month, fields.day);
 }
 
 int DaysPerMonth(int year, int month) {
@@ -103,7 +114,13 @@ bool IsValidDate(int32_t date) {
 }
 
 static int32_t CivilDayToEpochDays(absl::CivilDay day) {
-  return static_cast<int32_t>(day - kEpochDay);
+  if (ABSL_PREDICT_FALSE(
+          day.year() < date_time_util_internal::kMinCivilFieldsYear ||
+          day.year() > date_time_util_internal::kMaxCivilFieldsYear)) {
+    return static_cast<int32_t>(day - kEpochDay);
+  }
+  return DaysFromCivil(static_cast<int32_t>(day.year()), day.month(),
+                       day.day());
 }
 
 static bool IsValidCivilDay(absl::CivilDay day) {
@@ -1087,6 +1104,36 @@ static void NarrowTimestampIfPossible(int64_t* timestamp,
   }
 }
 
+// Appends the SQL defined format of a time zone with the given UTC offset in
+// <seconds>, 'UTC[+/-HHMM]', to <out>. Requires that the offset is minute
+// aligned.
+static absl::Status AppendSqlTimeZone(int seconds, std::string* out) {
+  absl::StrAppend(out, "UTC");
+  if (seconds != 0) {
+    const char sign = (seconds < 0 ? '-' : '+');
+    int minutes = seconds / 60;
+    seconds %= 60;
+    if (sign == '-') {
+      if (seconds > 0) {
+        seconds -= 60;
+        minutes += 1;
+      }
+      seconds = -seconds;
+      minutes = -minutes;
+    }
+    int hours = minutes / 60;
+    minutes %= 60;
+    out->push_back(sign);
+    SQL_RET_CHECK_EQ(seconds, 0);
+    if (minutes != 0) {
+      absl::StrAppend(out, absl::StrFormat("%02d%02d", hours, minutes));
+    } else {
+      absl::StrAppend(out, absl::StrFormat("%d", hours));
+    }
+  }
+  return absl::OkStatus();
+}
+
 static absl::Status FormatTimestampToStringInternal(
     absl::string_view format_string, absl::Time base_time,
     absl::TimeZone timezone,
@@ -1161,14 +1208,14 @@ static absl::StatusOr<absl::Weekday> GetFirstWeekDayOfWeek(
   }
 }
 
+// Extracts <part> from <info>, the civil time of <base_time> in <timezone>.
 // Does not do bounds checking. base_time (in the given timezone)
 // must be guaranteed valid.
-static absl::Status ExtractFromTimestampInternal(DateTimestampPart part,
-                                                 absl::Time base_time,
-                                                 absl::TimeZone timezone,
-                                                 int32_t* output) {
-  const absl::TimeZone::CivilInfo info = timezone.At(base_time);
-
+static absl::Status ExtractFromCivilInfo(DateTimestampPart part,
+                                         const absl::TimeZone::CivilInfo& info,
+                                         absl::Time base_time,
+                                         absl::TimeZone timezone,
+                                         int32_t* output) {
   switch (part) {
     case YEAR:
       // Given contract of this method, year must be 'small'.
@@ -1268,6 +1315,16 @@ static absl::Status ExtractFromTimestampInternal(DateTimestampPart part,
   return absl::OkStatus();
 }
 
+// Does not do bounds checking. base_time (in the given timezone)
+// must be guaranteed valid.
+static absl::Status ExtractFromTimestampInternal(DateTimestampPart part,
+                                                 absl::Time base_time,
+                                                 absl::TimeZone timezone,
+                                                 int32_t* output) {
+  return ExtractFromCivilInfo(part, timezone.At(base_time), base_time,
+                              timezone, output);
+}
+
 static absl::Status MakeAddDateOverflowError(int32_t date,
                                              DateTimestampPart part,
                                              int64_t interval) {
@@ -2219,6 +2276,392 @@ absl::Status FormatTimestampToString(absl::string_view format_string,
                                          out);
 }
 
+namespace internal_functions {
+
+// Appends the non-negative <value> to <out> as a decimal number, zero padded
+// to at least <width> digits.
+static void AppendZeroPadded(int64_t value, int width, std::string* out) {
+  char buffer[20];
+  char* const end = buffer + sizeof(buffer);
+  char* p = end;
+  do {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (end - p < width) *--p = '0';
+  out->append(p, end - p);
+}
+
+// Appends the UTC <offset> in seconds as '+HHMM', or '+HH:MM' if <with_colon>,
+// the same way absl::FormatTime() renders %z and %Ez.
+static void AppendOffset(int offset, bool with_colon, std::string* out) {
+  char sign = '+';
+  if (offset < 0) {
+    offset = -offset;
+    sign = '-';
+  }
+  const int minutes = offset / 60 % 60;
+  const int hours = offset / 60 / 60;
+  // Sub-minute negative offsets are rendered with a positive sign.
+  if (hours == 0 && minutes == 0) sign = '+';
+  out->push_back(sign);
+  AppendZeroPadded(hours, 2, out);
+  if (with_colon) out->push_back(':');
+  AppendZeroPadded(minutes, 2, out);
+}
+
+// Returns true if absl::FormatTime() renders %F as %Y-%m-%d with the year not
+// padded. The C library strftime() handles %F, and some versions pad the year
+// to four digits, in which case %F is formatted through absl::FormatTime().
+static bool IsPercentFUnpadded() {
+  static const bool unpadded =
+      absl::FormatTime("%F",
+                       absl::FromCivil(absl::CivilDay(1, 2, 3),
+                                       absl::UTCTimeZone()),
+                       absl::UTCTimeZone()) == "1-02-03";
+  return unpadded;
+}
+
+FormatProgram FormatProgram::Compile(
+    absl::string_view format_string,
+    const ExpansionOptions& expansion_options) {
+  FormatProgram program;
+  program.format_string_ = std::string(format_string);
+  program.expansion_options_ = expansion_options;
+
+  std::vector<FormatStep>& steps = program.steps_;
+  auto add_step = [&steps](FormatStep::Kind kind, int subsecond_digits = 0) {
+    steps.push_back(
+        {.kind = kind, .subsecond_digits = subsecond_digits, .text = {}});
+  };
+  auto add_literal = [&steps](absl::string_view text) {
+    if (steps.empty() || steps.back().kind != FormatStep::kLiteral) {
+      steps.push_back(
+          {.kind = FormatStep::kLiteral, .subsecond_digits = 0, .text = {}});
+    }
+    absl::StrAppend(&steps.back().text, text);
+  };
+  auto add_element = [&steps](absl::string_view element) {
+    steps.push_back({.kind = FormatStep::kElement,
+                     .subsecond_digits = 0,
+                     .text = std::string(element)});
+  };
+
+  const size_t size = format_string.size();
+  size_t pos = 0;
+  while (pos < size) {
+    const size_t pct = format_string.find('%', pos);
+    if (pct == absl::string_view::npos) {
+      add_literal(format_string.substr(pos));
+      break;
+    }
+    if (pct != pos) add_literal(format_string.substr(pos, pct - pos));
+    // A single trailing '%' is output as is.
+    if (pct + 1 == size) {
+      add_literal("%");
+      break;
+    }
+    pos = pct + 2;
+    switch (format_string[pct + 1]) {
+      case '%':
+        add_literal("%");
+        continue;
+      case 'Y':
+        add_step(FormatStep::kYear);
+        continue;
+      case 'y':
+        add_step(FormatStep::kYearTwoDigits);
+        continue;
+      case 'm':
+        add_step(FormatStep::kMonth);
+        continue;
+      case 'd':
+        add_step(FormatStep::kDay);
+        continue;
+      case 'e':
+        add_step(FormatStep::kDaySpacePadded);
+        continue;
+      case 'j':
+        add_step(FormatStep::kDayOfYear);
+        continue;
+      case 'F':
+        if (IsPercentFUnpadded()) {
+          add_step(FormatStep::kDate);
+        } else {
+          add_element("%F");
+        }
+        continue;
+      case 'H':
+        add_step(FormatStep::kHour);
+        continue;
+      case 'M':
+        add_step(FormatStep::kMinute);
+        continue;
+      case 'S':
+        add_step(FormatStep::kSecond);
+        continue;
+      case 'T':
+        add_step(FormatStep::kTime);
+        continue;
+      case 'z':
+        add_step(FormatStep::kOffset);
+        continue;
+      case 'Z':
+        add_step(FormatStep::kSqlTimeZone);
+        continue;
+      case 'Q':
+        if (expansion_options.expand_quarter) {
+          add_step(FormatStep::kQuarter);
+        } else {
+          add_element("%Q");
+        }
+        continue;
+      case 'J':
+        // %J is rejected when expanded, report that from the generic routine.
+        if (expansion_options.expand_iso_dayofyear) return program;
+        add_element("%J");
+        continue;
+      case 'E': {
+        const absl::string_view rest = format_string.substr(pos);
+        if (absl::StartsWith(rest, "z")) {
+          add_step(FormatStep::kOffsetWithColon);
+          pos += 1;
+        } else if (absl::StartsWith(rest, "4Y")) {
+          add_step(FormatStep::kYearFourDigits);
+          pos += 2;
+        } else if (absl::StartsWith(rest, "*S")) {
+          add_step(FormatStep::kSecondWithTrimmed);
+          pos += 2;
+        } else if (rest.size() >= 2 && absl::ascii_isdigit(rest[0]) &&
+                   rest[1] == 'S') {
+          add_step(FormatStep::kSecondWithDigits, rest[0] - '0');
+          pos += 2;
+        } else if (!rest.empty() && absl::ascii_isalpha(rest[0]) &&
+                   rest[0] != 'Q' && rest[0] != 'Z' && rest[0] != 'J') {
+          add_element(format_string.substr(pct, 3));
+          pos += 1;
+        } else {
+          return program;
+        }
+        continue;
+      }
+      case 'O':
+        if (pos < size && absl::ascii_isalpha(format_string[pos]) &&
+            format_string[pos] != 'Q' && format_string[pos] != 'Z' &&
+            format_string[pos] != 'J') {
+          add_element(format_string.substr(pct, 3));
+          pos += 1;
+          continue;
+        }
+        return program;
+      default:
+        if (absl::ascii_isalpha(format_string[pct + 1])) {
+          add_element(format_string.substr(pct, 2));
+          continue;
+        }
+        return program;
+    }
+  }
+  program.compiled_ = true;
+  return program;
+}
+
+absl::Status FormatProgram::Run(absl::Time base_time, absl::TimeZone timezone,
+                                std::string* out) const {
+  if (!compiled_) {
+    return FormatTimestampToStringInternal(format_string_, base_time, timezone,
+                                           expansion_options_, out);
+  }
+  if (!IsValidTime(base_time)) {
+    return MakeEvalError() << "Invalid timestamp value: "
+                           << absl::ToUnixMicros(base_time);
+  }
+  out->clear();
+  const absl::TimeZone normalized_timezone =
+      GetNormalizedTimeZone(base_time, timezone);
+  const absl::TimeZone::CivilInfo info = normalized_timezone.At(base_time);
+  const absl::CivilSecond& cs = info.cs;
+  for (const FormatStep& step : steps_) {
+    switch (step.kind) {
+      case FormatStep::kLiteral:
+        out->append(step.text);
+        break;
+      case FormatStep::kYear:
+        absl::StrAppend(out, cs.year());
+        break;
+      case FormatStep::kYearFourDigits:
+        AppendZeroPadded(cs.year(), 4, out);
+        break;
+      case FormatStep::kYearTwoDigits:
+        AppendZeroPadded(cs.year() % 100, 2, out);
+        break;
+      case FormatStep::kQuarter:
+        AppendZeroPadded((cs.month() - 1) / 3 + 1, 1, out);
+        break;
+      case FormatStep::kMonth:
+        AppendZeroPadded(cs.month(), 2, out);
+        break;
+      case FormatStep::kDay:
+        AppendZeroPadded(cs.day(), 2, out);
+        break;
+      case FormatStep::kDaySpacePadded:
+        if (cs.day() < 10) out->push_back(' ');
+        AppendZeroPadded(cs.day(), 1, out);
+        break;
+      case FormatStep::kDayOfYear:
+        AppendZeroPadded(absl::GetYearDay(absl::CivilDay(cs)), 3, out);
+        break;
+      case FormatStep::kDate:
+        absl::StrAppend(out, cs.year(), "-");
+        AppendZeroPadded(cs.month(), 2, out);
+        out->push_back('-');
+        AppendZeroPadded(cs.day(), 2, out);
+        break;
+      case FormatStep::kHour:
+        AppendZeroPadded(cs.hour(), 2, out);
+        break;
+      case FormatStep::kMinute:
+        AppendZeroPadded(cs.minute(), 2, out);
+        break;
+      case FormatStep::kSecond:
+        AppendZeroPadded(cs.second(), 2, out);
+        break;
+      case FormatStep::kSecondWithDigits: {
+        AppendZeroPadded(cs.second(), 2, out);
+        if (step.subsecond_digits > 0) {
+          int64_t subsecond = absl::ToInt64Nanoseconds(info.subsecond);
+          for (int i = step.subsecond_digits; i < 9; ++i) subsecond /= 10;
+          out->push_back('.');
+          AppendZeroPadded(subsecond, step.subsecond_digits, out);
+        }
+        break;
+      }
+      case FormatStep::kSecondWithTrimmed: {
+        AppendZeroPadded(cs.second(), 2, out);
+        int64_t subsecond = absl::ToInt64Nanoseconds(info.subsecond);
+        if (subsecond != 0) {
+          int digits = 9;
+          while (subsecond % 10 == 0) {
+            subsecond /= 10;
+            --digits;
+          }
+          out->push_back('.');
+          AppendZeroPadded(subsecond, digits, out);
+        }
+        break;
+      }
+      case FormatStep::kTime:
+        AppendZeroPadded(cs.hour(), 2, out);
+        out->push_back(':');
+        AppendZeroPadded(cs.minute(), 2, out);
+        out->push_back(':');
+        AppendZeroPadded(cs.second(), 2, out);
+        break;
+      case FormatStep::kOffset:
+        AppendOffset(info.offset, /*with_colon=*/false, out);
+        break;
+      case FormatStep::kOffsetWithColon:
+        AppendOffset(info.offset, /*with_colon=*/true, out);
+        break;
+      case FormatStep::kSqlTimeZone:
+        SQL_RETURN_IF_ERROR(AppendSqlTimeZone(info.offset, out));
+        break;
+      case FormatStep::kElement:
+        absl::StrAppend(out, absl::FormatTime(step.text, base_time,
+                                              normalized_timezone));
+        break;
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace internal_functions
+
+absl::StatusOr<DateFormatter> DateFormatter::Create(
+    absl::string_view format_string,
+    const FormatDateTimestampOptions& format_options) {
+  std::string date_format_string;
+  SanitizeDateFormat(format_string, &date_format_string);
+  return DateFormatter(internal_functions::FormatProgram::Compile(
+      date_format_string, {.truncate_tz = false,
+                           .expand_quarter = format_options.expand_Q,
+                           .expand_iso_dayofyear = format_options.expand_J}));
+}
+
+absl::Status DateFormatter::Format(int32_t date, std::string* out) const {
+  if (!IsValidDate(date)) {
+    return MakeEvalError() << "Invalid date value: " << date;
+  }
+  // Treats it as a timestamp at midnight on that date.
+  int64_t date_timestamp = static_cast<int64_t>(date) * kNaiveNumMicrosPerDay;
+  return program_.Run(MakeTime(date_timestamp, kMicroseconds),
+                      absl::UTCTimeZone(), out);
+}
+
+absl::StatusOr<DatetimeFormatter> DatetimeFormatter::Create(
+    absl::string_view format_string,
+    const FormatDateTimestampOptions& format_options) {
+  std::string datetime_format_string;
+  SanitizeDatetimeFormat(format_string, &datetime_format_string);
+  return DatetimeFormatter(internal_functions::FormatProgram::Compile(
+      datetime_format_string,
+      {.truncate_tz = false,
+       .expand_quarter = format_options.expand_Q,
+       .expand_iso_dayofyear = format_options.expand_J}));
+}
+
+absl::Status DatetimeFormatter::Format(const DatetimeValue& datetime,
+                                       std::string* out) const {
+  if (!datetime.IsValid()) {
+    return MakeEvalError() << "Invalid datetime value: "
+                           << datetime.DebugString();
+  }
+  absl::Time datetime_in_utc =
+      absl::UTCTimeZone().At(datetime.ConvertToCivilSecond()).pre;
+  datetime_in_utc += absl::Nanoseconds(datetime.Nanoseconds());
+  return program_.Run(datetime_in_utc, absl::UTCTimeZone(), out);
+}
+
+absl::StatusOr<TimeFormatter> TimeFormatter::Create(
+    absl::string_view format_string) {
+  std::string time_format_string;
+  SanitizeTimeFormat(format_string, &time_format_string);
+  // TIME does not support %Q or %J.
+  return TimeFormatter(internal_functions::FormatProgram::Compile(
+      time_format_string, {.truncate_tz = false,
+                           .expand_quarter = false,
+                           .expand_iso_dayofyear = false}));
+}
+
+absl::Status TimeFormatter::Format(const TimeValue& time,
+                                   std::string* out) const {
+  if (!time.IsValid()) {
+    return MakeEvalError() << "Invalid time value: " << time.DebugString();
+  }
+  absl::Time time_in_epoch_day =
+      absl::UTCTimeZone()
+          .At(absl::CivilSecond(1970, 1, 1, time.Hour(), time.Minute(),
+                                time.Second()))
+          .pre;
+  time_in_epoch_day += absl::Nanoseconds(time.Nanoseconds());
+  return program_.Run(time_in_epoch_day, absl::UTCTimeZone(), out);
+}
+
+absl::StatusOr<TimestampFormatter> TimestampFormatter::Create(
+    absl::string_view format_string,
+    const FormatDateTimestampOptions& format_options) {
+  return TimestampFormatter(internal_functions::FormatProgram::Compile(
+      format_string, {.truncate_tz = false,
+                      .expand_quarter = format_options.expand_Q,
+                      .expand_iso_dayofyear = format_options.expand_J}));
+}
+
+absl::Status TimestampFormatter::Format(int64_t timestamp,
+                                        absl::TimeZone timezone,
+                                        std::string* out) const {
+  return program_.Run(MakeTime(timestamp, kMicroseconds), timezone, out);
+}
+
 absl::Status ConvertTimestampToString(absl::Time input, TimestampScale scale,
                                       absl::TimeZone timezone,
                                       std::string* output) {
@@ -2532,12 +2975,9 @@ absl::Status ExtractFromTimestamp(DateTimestampPart part, absl::Time base_time,
   return ExtractFromTimestamp(part, base_time, timezone, output);
 }
 
-absl::Status ExtractFromDate(DateTimestampPart part, int32_t date,
-                             int32_t* output) {
-  if (!IsValidDate(date)) {
-    return MakeEvalError() << "Invalid date value: " << date;
-  }
-  absl::CivilDay day = EpochDaysToCivilDay(date);
+// Extracts <part> from <day>, which must be a valid date.
+static absl::Status ExtractFromCivilDay(DateTimestampPart part,
+                                        absl::CivilDay day, int32_t* output) {
   switch (part) {
     case YEAR:
       // Year for valid dates fits into int32_t
@@ -2604,6 +3044,14 @@ absl::Status ExtractFromDate(DateTimestampPart part, int32_t date,
   return absl::OkStatus();
 }
 
+absl::Status ExtractFromDate(DateTimestampPart part, int32_t date,
+                             int32_t* output) {
+  if (!IsValidDate(date)) {
+    return MakeEvalError() << "Invalid date value: " << date;
+  }
+  return ExtractFromCivilDay(part, EpochDaysToCivilDay(date), output);
+}
+
 absl::Status ExtractFromTime(DateTimestampPart part, const TimeValue& time,
                              int32_t* output) {
   if (!time.IsValid()) {
@@ -2757,6 +3205,56 @@ absl::Status ExtractFromDatetime(DateTimestampPart part,
   return absl::OkStatus();
 }
 
+absl::Status ExtractPartsFromDate(absl::Span<const DateTimestampPart> parts,
+                                  int32_t date, absl::Span<int32_t> output) {
+  SQL_RET_CHECK_EQ(parts.size(), output.size());
+  if (!IsValidDate(date)) {
+    return MakeEvalError() << "Invalid date value: " << date;
+  }
+  const absl::CivilDay day = EpochDaysToCivilDay(date);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    SQL_RETURN_IF_ERROR(ExtractFromCivilDay(parts[i], day, &output[i]));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ExtractPartsFromTimestamp(
+    absl::Span<const DateTimestampPart> parts, int64_t timestamp,
+    TimestampScale scale, absl::TimeZone timezone,
+    absl::Span<int32_t> output) {
+  SQL_RET_CHECK_EQ(parts.size(), output.size());
+  if (!IsValidTimestamp(timestamp, scale)) {
+    return MakeEvalError() << "Invalid timestamp value: " << timestamp;
+  }
+  const absl::Time base_time = MakeTime(timestamp, scale);
+  const absl::TimeZone::CivilInfo info = timezone.At(base_time);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    SQL_RETURN_IF_ERROR(
+        ExtractFromCivilInfo(parts[i], info, base_time, timezone, &output[i]));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ExtractPartsFromTime(absl::Span<const DateTimestampPart> parts,
+                                  const TimeValue& time,
+                                  absl::Span<int32_t> output) {
+  SQL_RET_CHECK_EQ(parts.size(), output.size());
+  for (size_t i = 0; i < parts.size(); ++i) {
+    SQL_RETURN_IF_ERROR(ExtractFromTime(parts[i], time, &output[i]));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ExtractPartsFromDatetime(absl::Span<const DateTimestampPart> parts,
+                                      const DatetimeValue& datetime,
+                                      absl::Span<int32_t> output) {
+  SQL_RET_CHECK_EQ(parts.size(), output.size());
+  for (size_t i = 0; i < parts.size(); ++i) {
+    SQL_RETURN_IF_ERROR(ExtractFromDatetime(parts[i], datetime, &output[i]));
+  }
+  return absl::OkStatus();
+}
+
 absl::Status ExtractTimeFromDatetime(const DatetimeValue& datetime,
                                      TimeValue* time) {
   if (!datetime.IsValid()) {
@@ -4497,6 +4995,763 @@ absl::Status DateBucket(int32_t input_date,
   return absl::OkStatus();
 }
 
+namespace {
+
+constexpr int64_t kMicrosPerSecond = 1000000;
+constexpr int64_t kMicrosPerDay = 24 * 60 * 60 * kMicrosPerSecond;
+
+// Floor division for a positive <divisor>.
+int64_t FloorDiv(int64_t value, int64_t divisor) {
+  return value / divisor - (value % divisor < 0);
+}
+
+// Returns the first day of the week containing <date> for weeks starting on
+// <first_day_of_week> (0 for Sunday to 6 for Saturday).  Same as
+// PrevWeekdayOrToday(), without the civil time conversions.
+int32_t TruncateToWeek(int32_t date, int32_t first_day_of_week) {
+  return date -
+         (CivilDayFieldsFromDays(date).weekday - first_day_of_week + 7) % 7;
+}
+
+// Returns true and sets <offset_seconds> if <timezone> has the same UTC
+// offset at all times, in which case civil times in <timezone> can be
+// computed with plain arithmetic on the timestamp.
+bool GetFixedUtcOffset(absl::TimeZone timezone, int64_t* offset_seconds) {
+  absl::TimeZone::CivilTransition transition;
+  if (timezone.NextTransition(absl::InfinitePast(), &transition)) {
+    return false;
+  }
+  *offset_seconds = timezone.At(absl::UnixEpoch()).offset;
+  return true;
+}
+
+// Returns the microseconds per unit of a DateTimestampPart that is a fixed
+// length of time at MICROSECOND precision, or 0 for any other part.
+int64_t FixedPartMicros(DateTimestampPart part) {
+  switch (part) {
+    case DAY:
+      return kMicrosPerDay;
+    case HOUR:
+      return 60 * 60 * kMicrosPerSecond;
+    case MINUTE:
+      return 60 * kMicrosPerSecond;
+    case SECOND:
+      return kMicrosPerSecond;
+    case MILLISECOND:
+      return 1000;
+    case MICROSECOND:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+// Evaluates row <row> with the scalar function <scalar>.  If it fails, the
+// output is zeroed and the status is passed on to <errors>.
+template <typename OutputT, typename ScalarFn>
+void EvaluateRow(int64_t row, const ScalarFn& scalar,
+                 absl::Span<OutputT> output, ErrorSink* errors) {
+  absl::Status status = scalar(row, &output[row]);
+  if (ABSL_PREDICT_FALSE(!status.ok())) {
+    output[row] = OutputT();
+    if (errors != nullptr) errors->OnError(row, std::move(status));
+  }
+}
+
+// Evaluates every row with the scalar function <scalar>.
+template <typename OutputT, typename ScalarFn>
+void EvaluateRows(const ScalarFn& scalar, absl::Span<OutputT> output,
+                  ErrorSink* errors) {
+  for (int64_t row = 0; row < static_cast<int64_t>(output.size()); ++row) {
+    EvaluateRow(row, scalar, output, errors);
+  }
+}
+
+// Evaluates every row with <fast>, which returns the result for a row and
+// clears <*ok> instead of branching for rows it cannot compute (invalid
+// inputs, overflow, ...).  It must still return some value for those rows,
+// so it should substitute a valid input rather than read out of range.  If
+// any row was not ok, only those rows are evaluated again with <scalar>,
+// which computes them or reports their error.
+template <typename OutputT, typename FastFn, typename ScalarFn>
+void EvaluateRows(const FastFn& fast, const ScalarFn& scalar,
+                  absl::Span<OutputT> output, ErrorSink* errors) {
+  const int64_t num_rows = output.size();
+  bool all_ok = true;
+  for (int64_t row = 0; row < num_rows; ++row) {
+    bool ok;
+    output[row] = fast(row, &ok);
+    all_ok &= ok;
+  }
+  if (ABSL_PREDICT_TRUE(all_ok)) return;
+  for (int64_t row = 0; row < num_rows; ++row) {
+    bool ok;
+    fast(row, &ok);
+    if (!ok) EvaluateRow(row, scalar, output, errors);
+  }
+}
+
+// Evaluates <field> on the civil day of every date in <dates>, or on the
+// date itself if <field> takes an int32_t.
+template <typename FieldFn>
+void ExtractDateField(absl::Span<const int32_t> dates, const FieldFn& field,
+                      absl::Span<int32_t> output, ErrorSink* errors,
+                      DateTimestampPart part) {
+  EvaluateRows(
+      [&](int64_t row, bool* ok) {
+        const int32_t date = dates[row];
+        *ok = IsValidDate(date);
+        return field(*ok ? date : 0);
+      },
+      [&](int64_t row, int32_t* out) {
+        return ExtractFromDate(part, dates[row], out);
+      },
+      output, errors);
+}
+
+// Calls <run> with a function computing <part> from a date, for the parts of
+// DATE extraction that are plain civil date fields.  Returns false if <part>
+// is not one of them.
+template <typename RunFn>
+bool WithDateFieldFn(DateTimestampPart part, const RunFn& run) {
+  switch (part) {
+    case YEAR:
+      run([](int32_t date) { return CivilDayFieldsFromDays(date).year; });
+      return true;
+    case QUARTER:
+      run([](int32_t date) {
+        return (CivilDayFieldsFromDays(date).month - 1) / 3 + 1;
+      });
+      return true;
+    case MONTH:
+      run([](int32_t date) { return CivilDayFieldsFromDays(date).month; });
+      return true;
+    case DAY:
+      run([](int32_t date) { return CivilDayFieldsFromDays(date).day; });
+      return true;
+    case DAYOFWEEK:
+      run([](int32_t date) {
+        return CivilDayFieldsFromDays(date).weekday + 1;
+      });
+      return true;
+    case DAYOFYEAR:
+      run([](int32_t date) {
+        return CivilDayFieldsFromDays(date).day_of_year;
+      });
+      return true;
+    default:
+      return false;
+  }
+}
+
+absl::Status AddDatesImpl(absl::Span<const int32_t> dates,
+                          DateTimestampPart part,
+                          absl::Span<const int64_t> intervals, bool subtract,
+                          absl::Span<int32_t> output, ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(dates.size(), output.size());
+  SQL_RET_CHECK_EQ(intervals.size(), output.size());
+  auto scalar = [&](int64_t row, int32_t* out) {
+    return subtract ? SubDate(dates[row], part, intervals[row], out)
+                    : AddDate(dates[row], part, intervals[row], out);
+  };
+  if (part != DAY && part != WEEK) {
+    EvaluateRows(scalar, output, errors);
+    return absl::OkStatus();
+  }
+  const int64_t days_per_unit = part == WEEK ? 7 : 1;
+  EvaluateRows(
+      [&](int64_t row, bool* ok) {
+        const int32_t date = dates[row];
+        int64_t interval = intervals[row];
+        // Like the scalar functions, only accept intervals that fit into an
+        // int32_t once negated for subtraction.
+        const bool interval_ok =
+            interval >= int64_t{std::numeric_limits<int32_t>::lowest()} +
+                            subtract &&
+            interval <= int64_t{std::numeric_limits<int32_t>::max()} + subtract;
+        interval = interval_ok ? (subtract ? -interval : interval) : 0;
+        const int64_t result = date + interval * days_per_unit;
+        *ok = IsValidDate(date) && interval_ok &&
+              result >= types::kDateMin && result <= types::kDateMax;
+        return static_cast<int32_t>(result);
+      },
+      scalar, output, errors);
+  return absl::OkStatus();
+}
+
+absl::Status AddTimestampsImpl(absl::Span<const int64_t> timestamps,
+                               TimestampScale scale, absl::TimeZone timezone,
+                               DateTimestampPart part,
+                               absl::Span<const int64_t> intervals,
+                               bool subtract, absl::Span<int64_t> output,
+                               ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(timestamps.size(), output.size());
+  SQL_RET_CHECK_EQ(intervals.size(), output.size());
+  auto scalar = [&](int64_t row, int64_t* out) {
+    return subtract ? SubTimestamp(timestamps[row], scale, timezone, part,
+                                   intervals[row], out)
+                    : AddTimestamp(timestamps[row], scale, timezone, part,
+                                   intervals[row], out);
+  };
+  // DAY is always 24 hours for timestamp arithmetic, so all of these parts
+  // are a fixed number of microseconds regardless of <timezone>.
+  const int64_t unit = FixedPartMicros(part);
+  if (scale != kMicroseconds || unit == 0) {
+    EvaluateRows(scalar, output, errors);
+    return absl::OkStatus();
+  }
+  // Any interval larger than this overflows the timestamp range.
+  const int64_t max_interval = (types::kTimestampMax - types::kTimestampMin) /
+                               unit;
+  EvaluateRows(
+      [&](int64_t row, bool* ok) {
+        const int64_t timestamp = timestamps[row];
+        int64_t interval = intervals[row];
+        const bool interval_ok =
+            interval >= -max_interval && interval <= max_interval;
+        interval = interval_ok ? (subtract ? -interval : interval) : 0;
+        const int64_t result = timestamp + interval * unit;
+        *ok = IsValidTimestamp(timestamp, kMicroseconds) && interval_ok &&
+              IsValidTimestamp(result, kMicroseconds);
+        return result;
+      },
+      scalar, output, errors);
+  return absl::OkStatus();
+}
+
+// Truncates <timestamps> to a <part> that does not have a fixed length.
+// The result only depends on the local day, so rows are computed with
+// TimestampTrunc() and then reused for the instants that share the offset and
+// the local <part> of the last computed row.  Sorted input only recomputes at
+// each <part> boundary and time zone transition.
+void TruncateTimestampsToCalendarPart(absl::Span<const int64_t> timestamps,
+                                      absl::TimeZone timezone,
+                                      DateTimestampPart part,
+                                      absl::Span<int64_t> output,
+                                      ErrorSink* errors) {
+  int64_t fixed_offset_seconds = 0;
+  const bool fixed = GetFixedUtcOffset(timezone, &fixed_offset_seconds);
+  const std::shared_ptr<const TimeZoneOffsetIndex> index =
+      fixed ? nullptr : TimeZoneOffsetIndex::ForTimeZone(timezone);
+  int32_t hint = 0;
+  int64_t bucket_start = 0;
+  int64_t bucket_end = 0;
+  int64_t bucket_result = 0;
+  EvaluateRows(
+      [&](int64_t row, int64_t* out) -> absl::Status {
+        const int64_t timestamp = timestamps[row];
+        if (timestamp >= bucket_start && timestamp < bucket_end) {
+          *out = bucket_result;
+          return absl::OkStatus();
+        }
+        SQL_RETURN_IF_ERROR(TimestampTrunc(timestamp, timezone, part, out));
+        int64_t offset_seconds = fixed_offset_seconds;
+        int64_t start = types::kTimestampMin;
+        int64_t end = types::kTimestampMax + 1;
+        if (!fixed) {
+          int64_t interval_start;
+          int64_t interval_end;
+          offset_seconds =
+              index->OffsetAt(FloorDiv(timestamp, kMicrosPerSecond), &hint,
+                              &interval_start, &interval_end);
+          start = std::max(start, interval_start * kMicrosPerSecond);
+          end = std::min(end, interval_end * kMicrosPerSecond);
+        }
+        const int64_t offset_micros = offset_seconds * kMicrosPerSecond;
+        const int32_t date = static_cast<int32_t>(
+            FloorDiv(timestamp + offset_micros, kMicrosPerDay));
+        int32_t first;
+        int32_t last;
+        if (TruncateDate(date, part, &first).ok() &&
+            LastDayOfDate(first, part, &last).ok()) {
+          bucket_start = std::max(start, first * kMicrosPerDay - offset_micros);
+          bucket_end = std::min(
+              end, (int64_t{last} + 1) * kMicrosPerDay - offset_micros);
+          bucket_result = *out;
+        }
+        return absl::OkStatus();
+      },
+      output, errors);
+}
+
+// Sets <next> to the start of the <part> after the one starting at
+// <datetime>, i.e. the first datetime that does not truncate to <datetime>.
+absl::Status NextDatetimeBucket(const DatetimeValue& datetime,
+                                DateTimestampPart part, DatetimeValue* next) {
+  if (FixedPartMicros(part) != 0) {
+    return AddDatetime(datetime, part, 1, next);
+  }
+  int32_t last;
+  SQL_RETURN_IF_ERROR(LastDayOfDatetime(datetime, part, &last));
+  return ConstructDatetime(last + 1, TimeValue::FromHMSAndMicros(0, 0, 0, 0),
+                           next);
+}
+
+}  // namespace
+
+absl::Status ExtractFromDates(DateTimestampPart part,
+                              absl::Span<const int32_t> dates,
+                              absl::Span<int32_t> output, ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(dates.size(), output.size());
+  const bool fast = WithDateFieldFn(part, [&](const auto& field) {
+    ExtractDateField(dates, field, output, errors, part);
+  });
+  if (!fast) {
+    EvaluateRows(
+        [&](int64_t row, int32_t* out) {
+          return ExtractFromDate(part, dates[row], out);
+        },
+        output, errors);
+  }
+  return absl::OkStatus();
+}
+
+absl::Status AddDates(absl::Span<const int32_t> dates, DateTimestampPart part,
+                      absl::Span<const int64_t> intervals,
+                      absl::Span<int32_t> output, ErrorSink* errors) {
+  return AddDatesImpl(dates, part, intervals, /*subtract=*/false, output,
+                      errors);
+}
+
+absl::Status SubDates(absl::Span<const int32_t> dates, DateTimestampPart part,
+                      absl::Span<const int64_t> intervals,
+                      absl::Span<int32_t> output, ErrorSink* errors) {
+  return AddDatesImpl(dates, part, intervals, /*subtract=*/true, output,
+                      errors);
+}
+
+absl::Status DiffDates(absl::Span<const int32_t> dates1,
+                       absl::Span<const int32_t> dates2,
+                       DateTimestampPart part, absl::Span<int32_t> output,
+                       ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(dates1.size(), output.size());
+  SQL_RET_CHECK_EQ(dates2.size(), output.size());
+  auto run = [&](const auto& diff) {
+    EvaluateRows(
+        [&](int64_t row, bool* ok) {
+          const int32_t date1 = dates1[row];
+          const int32_t date2 = dates2[row];
+          *ok = IsValidDate(date1) && IsValidDate(date2);
+          return diff(*ok ? date1 : 0, *ok ? date2 : 0);
+        },
+        [&](int64_t row, int32_t* out) {
+          return DiffDates(dates1[row], dates2[row], part, out);
+        },
+        output, errors);
+  };
+  switch (part) {
+    case DAY:
+      run([](int32_t date1, int32_t date2) { return date1 - date2; });
+      break;
+    case WEEK:
+    case WEEK_MONDAY:
+    case WEEK_TUESDAY:
+    case WEEK_WEDNESDAY:
+    case WEEK_THURSDAY:
+    case WEEK_FRIDAY:
+    case WEEK_SATURDAY:
+    case ISOWEEK: {
+      SQL_ASSIGN_OR_RETURN(const absl::Weekday weekday,
+                           GetFirstWeekDayOfWeek(part));
+      const int32_t first_day_of_week =
+          internal_functions::DayOfWeekIntegerSunToSat1To7(weekday) - 1;
+      run([first_day_of_week](int32_t date1, int32_t date2) {
+        return (TruncateToWeek(date1, first_day_of_week) -
+                TruncateToWeek(date2, first_day_of_week)) /
+               7;
+      });
+      break;
+    }
+    case YEAR:
+      run([](int32_t date1, int32_t date2) {
+        return CivilDayFieldsFromDays(date1).year -
+               CivilDayFieldsFromDays(date2).year;
+      });
+      break;
+    case QUARTER:
+    case MONTH: {
+      const int32_t months_per_unit = part == QUARTER ? 3 : 1;
+      run([months_per_unit](int32_t date1, int32_t date2) {
+        const date_time_util_internal::CivilDayFields fields1 =
+            CivilDayFieldsFromDays(date1);
+        const date_time_util_internal::CivilDayFields fields2 =
+            CivilDayFieldsFromDays(date2);
+        return (fields1.year * 12 + fields1.month - 1) / months_per_unit -
+               (fields2.year * 12 + fields2.month - 1) / months_per_unit;
+      });
+      break;
+    }
+    default:
+      EvaluateRows(
+          [&](int64_t row, int32_t* out) {
+            return DiffDates(dates1[row], dates2[row], part, out);
+          },
+          output, errors);
+      break;
+  }
+  return absl::OkStatus();
+}
+
+absl::Status TruncateDates(absl::Span<const int32_t> dates,
+                           DateTimestampPart part, absl::Span<int32_t> output,
+                           ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(dates.size(), output.size());
+  auto run = [&](const auto& truncate) {
+    EvaluateRows(
+        [&](int64_t row, bool* ok) {
+          const int32_t date = dates[row];
+          const int32_t result = truncate(IsValidDate(date) ? date : 0);
+          *ok = IsValidDate(date) && IsValidDate(result);
+          return result;
+        },
+        [&](int64_t row, int32_t* out) {
+          return TruncateDate(dates[row], part, out);
+        },
+        output, errors);
+  };
+  switch (part) {
+    case DAY:
+      run([](int32_t date) { return date; });
+      break;
+    case WEEK:
+    case WEEK_MONDAY:
+    case WEEK_TUESDAY:
+    case WEEK_WEDNESDAY:
+    case WEEK_THURSDAY:
+    case WEEK_FRIDAY:
+    case WEEK_SATURDAY:
+    case ISOWEEK: {
+      SQL_ASSIGN_OR_RETURN(const absl::Weekday weekday,
+                           GetFirstWeekDayOfWeek(part));
+      const int32_t first_day_of_week =
+          internal_functions::DayOfWeekIntegerSunToSat1To7(weekday) - 1;
+      run([first_day_of_week](int32_t date) {
+        return TruncateToWeek(date, first_day_of_week);
+      });
+      break;
+    }
+    case MONTH:
+      run([](int32_t date) {
+        return date - CivilDayFieldsFromDays(date).day + 1;
+      });
+      break;
+    case QUARTER:
+      run([](int32_t date) {
+        const date_time_util_internal::CivilDayFields fields =
+            CivilDayFieldsFromDays(date);
+        return DaysFromCivil(fields.year, (fields.month - 1) / 3 * 3 + 1, 1);
+      });
+      break;
+    case YEAR:
+      run([](int32_t date) {
+        return date - CivilDayFieldsFromDays(date).day_of_year + 1;
+      });
+      break;
+    default: {
+      // ISOYEAR does not start on a fixed day of the year, so keep the bounds
+      // of the last computed year instead; sorted dates only leave it at the
+      // next year.
+      int32_t bucket_first = 0;
+      int32_t bucket_last = -1;
+      EvaluateRows(
+          [&](int64_t row, int32_t* out) -> absl::Status {
+            const int32_t date = dates[row];
+            if (date >= bucket_first && date <= bucket_last) {
+              *out = bucket_first;
+              return absl::OkStatus();
+            }
+            SQL_RETURN_IF_ERROR(TruncateDate(date, part, out));
+            int32_t last;
+            if (LastDayOfDate(*out, part, &last).ok()) {
+              bucket_first = *out;
+              bucket_last = last;
+            }
+            return absl::OkStatus();
+          },
+          output, errors);
+      break;
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status DecomposeDates(absl::Span<const int32_t> dates,
+                            absl::Span<int32_t> years,
+                            absl::Span<int32_t> months,
+                            absl::Span<int32_t> days,
+                            absl::Span<int32_t> days_of_week,
+                            ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(dates.size(), years.size());
+  SQL_RET_CHECK_EQ(dates.size(), months.size());
+  SQL_RET_CHECK_EQ(dates.size(), days.size());
+  SQL_RET_CHECK_EQ(dates.size(), days_of_week.size());
+  const int64_t num_rows = dates.size();
+  bool all_ok = true;
+  for (int64_t row = 0; row < num_rows; ++row) {
+    const bool ok = IsValidDate(dates[row]);
+    const date_time_util_internal::CivilDayFields fields =
+        CivilDayFieldsFromDays(ok ? dates[row] : 0);
+    years[row] = ok ? fields.year : 0;
+    months[row] = ok ? fields.month : 0;
+    days[row] = ok ? fields.day : 0;
+    days_of_week[row] = ok ? fields.weekday + 1 : 0;
+    all_ok &= ok;
+  }
+  if (ABSL_PREDICT_TRUE(all_ok) || errors == nullptr) {
+    return absl::OkStatus();
+  }
+  for (int64_t row = 0; row < num_rows; ++row) {
+    if (!IsValidDate(dates[row])) {
+      errors->OnError(row, MakeEvalError()
+                               << "Invalid date value: " << dates[row]);
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ExtractFromTimestamps(DateTimestampPart part,
+                                   absl::Span<const int64_t> timestamps,
+                                   TimestampScale scale,
+                                   absl::TimeZone timezone,
+                                   absl::Span<int32_t> output,
+                                   ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(timestamps.size(), output.size());
+  auto scalar = [&](int64_t row, int32_t* out) {
+    return ExtractFromTimestamp(part, timestamps[row], scale, timezone, out);
+  };
+  if (scale != kMicroseconds) {
+    EvaluateRows(scalar, output, errors);
+    return absl::OkStatus();
+  }
+  // The civil time is the local timestamp, i.e. the timestamp plus the UTC
+  // offset at that time, split into days since the epoch and microseconds
+  // since midnight.
+  auto extract = [&](const auto& to_local) {
+    auto run = [&](const auto& field) {
+      EvaluateRows(
+          [&](int64_t row, bool* ok) {
+            const int64_t timestamp = timestamps[row];
+            *ok = IsValidTimestamp(timestamp, kMicroseconds);
+            const int64_t local = to_local(*ok ? timestamp : 0);
+            const int64_t date = FloorDiv(local, kMicrosPerDay);
+            return field(static_cast<int32_t>(date),
+                         local - date * kMicrosPerDay, ok);
+          },
+          scalar, output, errors);
+    };
+    const int64_t unit = FixedPartMicros(part);
+    switch (part) {
+      case HOUR:
+      case MINUTE:
+      case SECOND:
+      case MILLISECOND:
+      case MICROSECOND: {
+        const int64_t units_per_parent =
+            part == HOUR ? 24 : (part == MILLISECOND || part == MICROSECOND)
+                                    ? kMicrosPerSecond / unit
+                                    : 60;
+        run([unit, units_per_parent](int32_t, int64_t time_of_day, bool*) {
+          return static_cast<int32_t>(time_of_day / unit % units_per_parent);
+        });
+        break;
+      }
+      case DATE:
+        run([](int32_t date, int64_t, bool* ok) {
+          *ok = *ok && IsValidDate(date);
+          return date;
+        });
+        break;
+      default: {
+        const bool fast = WithDateFieldFn(part, [&](const auto& field) {
+          run([&field](int32_t date, int64_t, bool*) { return field(date); });
+        });
+        if (!fast) EvaluateRows(scalar, output, errors);
+        break;
+      }
+    }
+  };
+  int64_t offset_seconds;
+  if (GetFixedUtcOffset(timezone, &offset_seconds)) {
+    const int64_t offset_micros = offset_seconds * kMicrosPerSecond;
+    extract([offset_micros](int64_t timestamp) {
+      return timestamp + offset_micros;
+    });
+  } else {
+    const std::shared_ptr<const TimeZoneOffsetIndex> index =
+        TimeZoneOffsetIndex::ForTimeZone(timezone);
+    int32_t hint = 0;
+    extract([&index, &hint](int64_t timestamp) {
+      return timestamp +
+             index->OffsetAt(FloorDiv(timestamp, kMicrosPerSecond), &hint) *
+                 kMicrosPerSecond;
+    });
+  }
+  return absl::OkStatus();
+}
+
+absl::Status AddTimestamps(absl::Span<const int64_t> timestamps,
+                           TimestampScale scale, absl::TimeZone timezone,
+                           DateTimestampPart part,
+                           absl::Span<const int64_t> intervals,
+                           absl::Span<int64_t> output, ErrorSink* errors) {
+  return AddTimestampsImpl(timestamps, scale, timezone, part, intervals,
+                           /*subtract=*/false, output, errors);
+}
+
+absl::Status SubTimestamps(absl::Span<const int64_t> timestamps,
+                           TimestampScale scale, absl::TimeZone timezone,
+                           DateTimestampPart part,
+                           absl::Span<const int64_t> intervals,
+                           absl::Span<int64_t> output, ErrorSink* errors) {
+  return AddTimestampsImpl(timestamps, scale, timezone, part, intervals,
+                           /*subtract=*/true, output, errors);
+}
+
+absl::Status DiffTimestamps(absl::Span<const int64_t> timestamps1,
+                            absl::Span<const int64_t> timestamps2,
+                            TimestampScale scale, DateTimestampPart part,
+                            absl::Span<int64_t> output, ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(timestamps1.size(), output.size());
+  SQL_RET_CHECK_EQ(timestamps2.size(), output.size());
+  auto scalar = [&](int64_t row, int64_t* out) {
+    return TimestampDiff(timestamps1[row], timestamps2[row], scale, part, out);
+  };
+  const int64_t unit = FixedPartMicros(part);
+  if (scale != kMicroseconds || unit == 0) {
+    EvaluateRows(scalar, output, errors);
+    return absl::OkStatus();
+  }
+  // The difference between two valid timestamps cannot overflow, and integer
+  // division truncates toward zero like absl::IDivDuration().
+  EvaluateRows(
+      [&](int64_t row, bool* ok) {
+        const int64_t timestamp1 = timestamps1[row];
+        const int64_t timestamp2 = timestamps2[row];
+        *ok = IsValidTimestamp(timestamp1, kMicroseconds) &&
+              IsValidTimestamp(timestamp2, kMicroseconds);
+        return *ok ? (timestamp1 - timestamp2) / unit : 0;
+      },
+      scalar, output, errors);
+  return absl::OkStatus();
+}
+
+absl::Status TruncateTimestamps(absl::Span<const int64_t> timestamps,
+                                absl::TimeZone timezone,
+                                DateTimestampPart part,
+                                absl::Span<int64_t> output, ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(timestamps.size(), output.size());
+  auto scalar = [&](int64_t row, int64_t* out) {
+    return TimestampTrunc(timestamps[row], timezone, part, out);
+  };
+  const int64_t unit = FixedPartMicros(part);
+  if (unit == 0) {
+    TruncateTimestampsToCalendarPart(timestamps, timezone, part, output,
+                                     errors);
+    return absl::OkStatus();
+  }
+  // Sub-minute truncation does not depend on <timezone>; larger fixed-length
+  // parts can be truncated with arithmetic in a fixed-offset <timezone>.
+  int64_t offset_seconds = 0;
+  if (unit < 60 * kMicrosPerSecond ||
+      GetFixedUtcOffset(timezone, &offset_seconds)) {
+    const int64_t offset_micros = offset_seconds * kMicrosPerSecond;
+    EvaluateRows(
+        [&](int64_t row, bool* ok) {
+          const int64_t timestamp = timestamps[row];
+          const bool valid = IsValidTimestamp(timestamp, kMicroseconds);
+          const int64_t local = (valid ? timestamp : 0) + offset_micros;
+          const int64_t result = FloorDiv(local, unit) * unit - offset_micros;
+          *ok = valid && IsValidTimestamp(result, kMicroseconds);
+          return result;
+        },
+        scalar, output, errors);
+    return absl::OkStatus();
+  }
+  // Otherwise HOUR and MINUTE are truncated with the offset at the timestamp,
+  // like TimestampTrunc().  DAY is only truncated this way if midnight has the
+  // same offset and is the only instant with its civil time, which leaves
+  // days with a nearby transition to the scalar path.
+  const std::shared_ptr<const TimeZoneOffsetIndex> index =
+      TimeZoneOffsetIndex::ForTimeZone(timezone);
+  int32_t hint = 0;
+  int32_t result_hint = 0;
+  // The instants [bucket_start, bucket_end) share the offset and the truncated
+  // local time of the last computed row, so they truncate to the same result.
+  // Sorted input only leaves the bucket at the next <part> boundary.
+  int64_t bucket_start = 0;
+  int64_t bucket_end = 0;
+  int64_t bucket_result = 0;
+  EvaluateRows(
+      [&](int64_t row, bool* ok) {
+        const int64_t timestamp = timestamps[row];
+        if (timestamp >= bucket_start && timestamp < bucket_end) {
+          *ok = true;
+          return bucket_result;
+        }
+        const bool valid = IsValidTimestamp(timestamp, kMicroseconds);
+        int64_t interval_start = 0;
+        int64_t interval_end = 0;
+        const int64_t offset_micros =
+            valid ? index->OffsetAt(FloorDiv(timestamp, kMicrosPerSecond),
+                                    &hint, &interval_start, &interval_end) *
+                        kMicrosPerSecond
+                  : 0;
+        const int64_t local = (valid ? timestamp : 0) + offset_micros;
+        const int64_t result = FloorDiv(local, unit) * unit - offset_micros;
+        *ok = valid && IsValidTimestamp(result, kMicroseconds);
+        if (*ok && part == DAY) {
+          const int64_t result_seconds = result / kMicrosPerSecond;
+          *ok = index->OffsetAt(result_seconds, &result_hint) *
+                        kMicrosPerSecond ==
+                    offset_micros &&
+                index->HasUniqueCivilTime(result_seconds, &result_hint);
+        }
+        if (*ok) {
+          bucket_start = std::max(result, interval_start * kMicrosPerSecond);
+          bucket_end = std::min({result + unit, interval_end * kMicrosPerSecond,
+                                 types::kTimestampMax + 1});
+          bucket_result = result;
+        }
+        return result;
+      },
+      scalar, output, errors);
+  return absl::OkStatus();
+}
+
+absl::Status TruncateDatetimes(absl::Span<const DatetimeValue> datetimes,
+                               DateTimestampPart part,
+                               absl::Span<DatetimeValue> output,
+                               ErrorSink* errors) {
+  SQL_RET_CHECK_EQ(datetimes.size(), output.size());
+  // Packed datetimes sort like the datetimes they encode, so the datetimes
+  // that truncate to the result of the last computed row are a range of packed
+  // values, up to the start of the next <part>.  NANOSECOND truncation keeps
+  // the sub-microsecond digits that packing drops, so it is never cached.
+  int64_t bucket_start = 0;
+  int64_t bucket_end = 0;
+  DatetimeValue bucket_result;
+  EvaluateRows(
+      [&](int64_t row, DatetimeValue* out) -> absl::Status {
+        const DatetimeValue& datetime = datetimes[row];
+        const int64_t packed = datetime.Packed64DatetimeMicros();
+        if (packed >= bucket_start && packed < bucket_end &&
+            datetime.IsValid()) {
+          *out = bucket_result;
+          return absl::OkStatus();
+        }
+        SQL_RETURN_IF_ERROR(TruncateDatetime(datetime, part, out));
+        DatetimeValue next;
+        if (part != NANOSECOND && NextDatetimeBucket(*out, part, &next).ok()) {
+          bucket_start = out->Packed64DatetimeMicros();
+          bucket_end = next.Packed64DatetimeMicros();
+          bucket_result = *out;
+        }
+        return absl::OkStatus();
+      },
+      output, errors);
+  return absl::OkStatus();
+}
+
 namespace internal_functions {
 
 // Expand "%Z" in <format_string> to the SQL-defined format:
@@ -4549,30 +5804,8 @@ absl::Status ExpandPercentZQJ(absl::string_view format_string,
               (absl::ToCivilMonth(base_time, timezone).month() - 1) / 3 + 1));
     } else if (format_string[pct + 1] == 'Z') {
       // Handle %Z, computing the SQL defined timezone format.
-      absl::StrAppend(expanded_format_string, "UTC");
-      if (int seconds = timezone.At(base_time).offset) {
-        const char sign = (seconds < 0 ? '-' : '+');
-        int minutes = seconds / 60;
-        seconds %= 60;
-        if (sign == '-') {
-          if (seconds > 0) {
-            seconds -= 60;
-            minutes += 1;
-          }
-          seconds = -seconds;
-          minutes = -minutes;
-        }
-        int hours = minutes / 60;
-        minutes %= 60;
-        expanded_format_string->push_back(sign);
-        SQL_RET_CHECK_EQ(seconds, 0);
-        if (minutes != 0) {
-          absl::StrAppend(expanded_format_string,
-                          absl::StrFormat("%02d%02d", hours, minutes));
-        } else {
-          absl::StrAppend(expanded_format_string, absl::StrFormat("%d", hours));
-        }
-      }
+      SQL_RETURN_IF_ERROR(AppendSqlTimeZone(timezone.At(base_time).offset,
+                                            expanded_format_string));
     } else if (expansion_options.expand_iso_dayofyear &&
                format_string[pct + 1] == 'J') {
       return MakeEvalError() << "Format element %J not supported yet";
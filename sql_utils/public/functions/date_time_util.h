@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "google/protobuf/timestamp.pb.h"
 #include "google/type/date.pb.h"
@@ -32,6 +33,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/time/civil_time.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 
 // SQL dates are represented as an int32_t value, indicating the offset
 // in days from the epoch 1970-01-01.  SQL dates are not timezone aware,
@@ -464,6 +466,26 @@ absl::Status ExtractFromDatetime(DateTimestampPart part,
                                  const DatetimeValue& datetime,
                                  int32_t* output);
 
+// Extract each of <parts> into the corresponding element of <output>, which
+// must have the same size, like calling the ExtractFrom* functions above once
+// per part.  The DATE and TIMESTAMP versions convert the input to civil time
+// only once, so they are cheaper than the separate calls.  Returns the error
+// of the first part that fails.
+absl::Status ExtractPartsFromDate(absl::Span<const DateTimestampPart> parts,
+                                  int32_t date, absl::Span<int32_t> output);
+
+absl::Status ExtractPartsFromTimestamp(
+    absl::Span<const DateTimestampPart> parts, int64_t timestamp,
+    TimestampScale scale, absl::TimeZone timezone, absl::Span<int32_t> output);
+
+absl::Status ExtractPartsFromTime(absl::Span<const DateTimestampPart> parts,
+                                  const TimeValue& time,
+                                  absl::Span<int32_t> output);
+
+absl::Status ExtractPartsFromDatetime(absl::Span<const DateTimestampPart> parts,
+                                      const DatetimeValue& datetime,
+                                      absl::Span<int32_t> output);
+
 // Extracts a TIME from the given DATETIME value. Returns error
 // status if the input DATETIME value is invalid.
 absl::Status ExtractTimeFromDatetime(const DatetimeValue& datetime,
@@ -1103,6 +1125,102 @@ absl::Status DateBucket(int32_t input_date,
                         bigquery_ml_utils::IntervalValue bucket_width,
                         int32_t origin_date, int32_t* output_date);
 
+// Receives the per-row failures of the batch functions below.  OnError() is
+// called once for each failing row, in increasing <row> order, with the same
+// status the corresponding scalar function would have returned for that row.
+class ErrorSink {
+ public:
+  virtual ~ErrorSink() = default;
+  virtual void OnError(int64_t row, absl::Status error) = 0;
+};
+
+// Batch variants of the scalar functions above.  Each computes
+// output[i] from the i-th element of every input span, with the same
+// semantics as the scalar function.  The common parts are evaluated in
+// branch-light loops over the whole column; rows that fail are reset to 0
+// (or an invalid DatetimeValue) in <output> and reported to <errors> (which
+// may be null to drop them) instead of stopping the batch.  The returned
+// status is only an error if the span sizes do not match.
+
+// Batch variant of ExtractFromDate().
+absl::Status ExtractFromDates(DateTimestampPart part,
+                              absl::Span<const int32_t> dates,
+                              absl::Span<int32_t> output, ErrorSink* errors);
+
+// Batch variant of AddDate().
+absl::Status AddDates(absl::Span<const int32_t> dates, DateTimestampPart part,
+                      absl::Span<const int64_t> intervals,
+                      absl::Span<int32_t> output, ErrorSink* errors);
+
+// Batch variant of SubDate().
+absl::Status SubDates(absl::Span<const int32_t> dates, DateTimestampPart part,
+                      absl::Span<const int64_t> intervals,
+                      absl::Span<int32_t> output, ErrorSink* errors);
+
+// Batch variant of DiffDates().
+absl::Status DiffDates(absl::Span<const int32_t> dates1,
+                       absl::Span<const int32_t> dates2,
+                       DateTimestampPart part, absl::Span<int32_t> output,
+                       ErrorSink* errors);
+
+// Batch variant of TruncateDate().
+absl::Status TruncateDates(absl::Span<const int32_t> dates,
+                           DateTimestampPart part, absl::Span<int32_t> output,
+                           ErrorSink* errors);
+
+// Decomposes each of <dates> into its year, month, day of the month and day
+// of the week, with the same values as ExtractFromDate() for YEAR, MONTH, DAY
+// and DAYOFWEEK, in a single pass without per-row branches.
+absl::Status DecomposeDates(absl::Span<const int32_t> dates,
+                            absl::Span<int32_t> years,
+                            absl::Span<int32_t> months,
+                            absl::Span<int32_t> days,
+                            absl::Span<int32_t> days_of_week,
+                            ErrorSink* errors);
+
+// Batch variant of ExtractFromTimestamp().
+absl::Status ExtractFromTimestamps(DateTimestampPart part,
+                                   absl::Span<const int64_t> timestamps,
+                                   TimestampScale scale,
+                                   absl::TimeZone timezone,
+                                   absl::Span<int32_t> output,
+                                   ErrorSink* errors);
+
+// Batch variant of AddTimestamp().
+absl::Status AddTimestamps(absl::Span<const int64_t> timestamps,
+                           TimestampScale scale, absl::TimeZone timezone,
+                           DateTimestampPart part,
+                           absl::Span<const int64_t> intervals,
+                           absl::Span<int64_t> output, ErrorSink* errors);
+
+// Batch variant of SubTimestamp().
+absl::Status SubTimestamps(absl::Span<const int64_t> timestamps,
+                           TimestampScale scale, absl::TimeZone timezone,
+                           DateTimestampPart part,
+                           absl::Span<const int64_t> intervals,
+                           absl::Span<int64_t> output, ErrorSink* errors);
+
+// Batch variant of TimestampDiff().
+absl::Status DiffTimestamps(absl::Span<const int64_t> timestamps1,
+                            absl::Span<const int64_t> timestamps2,
+                            TimestampScale scale, DateTimestampPart part,
+                            absl::Span<int64_t> output, ErrorSink* errors);
+
+// Batch variant of TimestampTrunc() for MICROSECOND precision timestamps.
+// Like TruncateDates() and TruncateDatetimes(), it reuses the result of the
+// previous row while the input stays within the same <part>, so sorted input
+// is mostly truncated once per <part> instead of once per row.
+absl::Status TruncateTimestamps(absl::Span<const int64_t> timestamps,
+                                absl::TimeZone timezone,
+                                DateTimestampPart part,
+                                absl::Span<int64_t> output, ErrorSink* errors);
+
+// Batch variant of TruncateDatetime().
+absl::Status TruncateDatetimes(absl::Span<const DatetimeValue> datetimes,
+                               DateTimestampPart part,
+                               absl::Span<DatetimeValue> output,
+                               ErrorSink* errors);
+
 // The namespace 'internal_functions' includes the internal implementation
 // details and is not part of the public api.
 namespace internal_functions {
@@ -1139,7 +1257,126 @@ void GetSignHourAndMinuteTimeZoneOffset(const absl::TimeZone::CivilInfo& info,
 absl::TimeZone GetNormalizedTimeZone(absl::Time base_time,
                                      absl::TimeZone timezone);
 
+// A single step of a compiled format string.
+struct FormatStep {
+  enum Kind {
+    kLiteral,            // <text> as is
+    kYear,               // %Y
+    kYearFourDigits,     // %E4Y
+    kYearTwoDigits,      // %y
+    kQuarter,            // %Q
+    kMonth,              // %m
+    kDay,                // %d
+    kDaySpacePadded,     // %e
+    kDayOfYear,          // %j
+    kDate,               // %F
+    kHour,               // %H
+    kMinute,             // %M
+    kSecond,             // %S
+    kSecondWithDigits,   // %E#S, with <subsecond_digits> digits
+    kSecondWithTrimmed,  // %E*S
+    kTime,               // %T
+    kOffset,             // %z
+    kOffsetWithColon,    // %Ez
+    kSqlTimeZone,        // %Z
+    kElement,            // any other format element <text>, as absl::FormatTime
+  };
+  Kind kind;
+  int subsecond_digits = 0;
+  std::string text;
+};
+
+// A format string for FormatTimestampToString() which has been split into a
+// flat list of FormatSteps once, so that formatting many values with the same
+// format string does not rescan it for every value. Format strings which can
+// not be split unambiguously are kept as is and formatted through
+// FormatTimestampToString(). Either way the output is identical.
+class FormatProgram {
+ public:
+  FormatProgram() = default;
+
+  static FormatProgram Compile(absl::string_view format_string,
+                               const ExpansionOptions& expansion_options);
+
+  absl::Status Run(absl::Time base_time, absl::TimeZone timezone,
+                   std::string* out) const;
+
+ private:
+  // False if <format_string_> must be formatted with the generic routine.
+  bool compiled_ = false;
+  std::string format_string_;
+  ExpansionOptions expansion_options_ = {};
+  std::vector<FormatStep> steps_;
+};
+
 }  // namespace internal_functions
+
+// Format strings compiled once for FormatDateToString(),
+// FormatDatetimeToString(), FormatTimeToString() and FormatTimestampToString(),
+// analogous to the casters in cast_date_time.h. Each Format() call produces the
+// same result as the corresponding function called with the same format string.
+class DateFormatter {
+ public:
+  static absl::StatusOr<DateFormatter> Create(
+      absl::string_view format_string,
+      const FormatDateTimestampOptions& format_options = {.expand_Q = true,
+                                                          .expand_J = false});
+
+  absl::Status Format(int32_t date, std::string* out) const;
+
+ private:
+  explicit DateFormatter(internal_functions::FormatProgram program)
+      : program_(std::move(program)) {}
+
+  internal_functions::FormatProgram program_;
+};
+
+class DatetimeFormatter {
+ public:
+  static absl::StatusOr<DatetimeFormatter> Create(
+      absl::string_view format_string,
+      const FormatDateTimestampOptions& format_options = {.expand_Q = true,
+                                                          .expand_J = false});
+
+  absl::Status Format(const DatetimeValue& datetime, std::string* out) const;
+
+ private:
+  explicit DatetimeFormatter(internal_functions::FormatProgram program)
+      : program_(std::move(program)) {}
+
+  internal_functions::FormatProgram program_;
+};
+
+class TimeFormatter {
+ public:
+  static absl::StatusOr<TimeFormatter> Create(absl::string_view format_string);
+
+  absl::Status Format(const TimeValue& time, std::string* out) const;
+
+ private:
+  explicit TimeFormatter(internal_functions::FormatProgram program)
+      : program_(std::move(program)) {}
+
+  internal_functions::FormatProgram program_;
+};
+
+class TimestampFormatter {
+ public:
+  static absl::StatusOr<TimestampFormatter> Create(
+      absl::string_view format_string,
+      const FormatDateTimestampOptions& format_options = {.expand_Q = true,
+                                                          .expand_J = false});
+
+  absl::Status Format(int64_t timestamp, absl::TimeZone timezone,
+                      std::string* out) const;
+
+ private:
+  explicit TimestampFormatter(internal_functions::FormatProgram program)
+      : program_(std::move(program)) {}
+
+  internal_functions::FormatProgram program_;
+};
+
 }  // namespace functions
 }  // namespace bigquery_ml_utils
 
@@ -0,0 +1,222 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Checks that DateFormatter and TimestampFormatter, which compile their format
+// string into a FormatProgram, produce the same output and errors as
+// FormatDateToString() and FormatTimestampToString().
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sql_utils/public/functions/date_time_util.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/civil_time.h"
+#include "absl/time/time.h"
+
+namespace bigquery_ml_utils {
+namespace functions {
+namespace {
+
+// Each element that FormatProgram compiles, alone and combined with literals.
+constexpr absl::string_view kCompiledFormats[] = {
+    "%Y-%m-%d",
+    "%E4Y",
+    "%y",
+    "%Q",
+    "%e",
+    "[%e]",
+    "%j",
+    "%F",
+    "%F %T",
+    "%H:%M:%S",
+    "%E0S",
+    "%E1S",
+    "%E3S",
+    "%E6S",
+    "%E9S",
+    "%E*S",
+    "%z",
+    "%Ez",
+    "%Z",
+    "%c",
+    "%A, %B %d",
+    "%a %b %p %I %u %w %U %W %V %G %g",
+    "%Ec %Ey %OH %Om",
+    "%%Y %%",
+    "literal text",
+    "",
+    "%",
+    "%Y%",
+    "%J",
+};
+
+// Format strings that FormatProgram leaves to the generic routine.
+constexpr absl::string_view kFallbackFormats[] = {
+    "%E12S", "%E#S", "%E", "%Y %E", "%EQ", "%EZ", "%EJ", "%OQ", "%OZ", "%OJ",
+    "%O",    "%O1",  "%1", "%Y %!",
+};
+
+std::vector<absl::string_view> AllFormats() {
+  std::vector<absl::string_view> formats(std::begin(kCompiledFormats),
+                                         std::end(kCompiledFormats));
+  formats.insert(formats.end(), std::begin(kFallbackFormats),
+                 std::end(kFallbackFormats));
+  return formats;
+}
+
+constexpr FormatDateTimestampOptions kOptions[] = {
+    {.expand_Q = true, .expand_J = false},
+    {.expand_Q = false, .expand_J = false},
+    {.expand_Q = true, .expand_J = true},
+};
+
+int64_t Micros(absl::CivilSecond civil_second, int64_t subsecond_micros) {
+  return absl::ToUnixMicros(
+             absl::FromCivil(civil_second, absl::UTCTimeZone())) +
+         subsecond_micros;
+}
+
+// Timestamps with each number of significant subsecond digits, before and
+// after the Unix epoch, and at both ends of the supported range, whose years
+// also probe the padding of %F and %Y.
+std::vector<int64_t> Timestamps() {
+  return {
+      Micros(absl::CivilSecond(1, 1, 1, 0, 0, 0), 0),
+      Micros(absl::CivilSecond(9, 2, 3, 4, 5, 6), 7),
+      Micros(absl::CivilSecond(987, 6, 5, 4, 3, 2), 100000),
+      Micros(absl::CivilSecond(1969, 12, 31, 23, 59, 59), 999999),
+      0,
+      -1,
+      Micros(absl::CivilSecond(1970, 1, 1, 0, 0, 1), 500),
+      Micros(absl::CivilSecond(2008, 12, 25, 15, 30, 0), 120000),
+      Micros(absl::CivilSecond(2023, 3, 12, 9, 59, 59), 123456),
+      Micros(absl::CivilSecond(2024, 2, 29, 12, 0, 0), 10),
+      Micros(absl::CivilSecond(9999, 12, 31, 23, 59, 59), 999999),
+  };
+}
+
+// Time zones with whole, fractional, negative and sub-minute UTC offsets, and
+// with daylight saving time transitions.
+std::vector<absl::TimeZone> TimeZones() {
+  std::vector<absl::TimeZone> time_zones = {
+      absl::UTCTimeZone(),
+      absl::FixedTimeZone(5 * 3600 + 30 * 60),
+      absl::FixedTimeZone(-(3 * 3600 + 30 * 60)),
+      absl::FixedTimeZone(-(9 * 3600 + 30 * 60 + 15)),
+      absl::FixedTimeZone(45),
+      absl::FixedTimeZone(-45),
+  };
+  for (const char* name :
+       {"America/Los_Angeles", "America/St_Johns", "Asia/Kolkata",
+        "Australia/Eucla", "Africa/Monrovia", "Europe/Amsterdam"}) {
+    absl::TimeZone time_zone;
+    EXPECT_TRUE(absl::LoadTimeZone(name, &time_zone)) << name;
+    time_zones.push_back(time_zone);
+  }
+  return time_zones;
+}
+
+void ExpectSameResult(const absl::Status& status, const std::string& out,
+                      const absl::Status& expected_status,
+                      const std::string& expected_out) {
+  EXPECT_EQ(status, expected_status);
+  if (expected_status.ok()) {
+    EXPECT_EQ(out, expected_out);
+  }
+}
+
+TEST(DateFormatterTest, FormatMatchesFormatDateToString) {
+  std::vector<int32_t> dates;
+  for (int64_t timestamp : Timestamps()) {
+    dates.push_back(static_cast<int32_t>(
+        absl::ToCivilDay(absl::FromUnixMicros(timestamp), absl::UTCTimeZone()) -
+        absl::CivilDay(1970, 1, 1)));
+  }
+  for (absl::string_view format : AllFormats()) {
+    for (const FormatDateTimestampOptions& options : kOptions) {
+      SCOPED_TRACE(testing::Message()
+                   << "format: \"" << format << "\" expand_Q: "
+                   << options.expand_Q << " expand_J: " << options.expand_J);
+      absl::StatusOr<DateFormatter> formatter =
+          DateFormatter::Create(format, options);
+      ASSERT_TRUE(formatter.ok()) << formatter.status();
+      for (int32_t date : dates) {
+        SCOPED_TRACE(testing::Message() << "date: " << date);
+        std::string expected_out;
+        const absl::Status expected_status =
+            FormatDateToString(format, date, options, &expected_out);
+        std::string out = "previous";
+        ExpectSameResult(formatter->Format(date, &out), out, expected_status,
+                         expected_out);
+      }
+    }
+  }
+}
+
+TEST(TimestampFormatterTest, FormatMatchesFormatTimestampToString) {
+  const std::vector<int64_t> timestamps = Timestamps();
+  const std::vector<absl::TimeZone> time_zones = TimeZones();
+  for (absl::string_view format : AllFormats()) {
+    for (const FormatDateTimestampOptions& options : kOptions) {
+      SCOPED_TRACE(testing::Message()
+                   << "format: \"" << format << "\" expand_Q: "
+                   << options.expand_Q << " expand_J: " << options.expand_J);
+      absl::StatusOr<TimestampFormatter> formatter =
+          TimestampFormatter::Create(format, options);
+      ASSERT_TRUE(formatter.ok()) << formatter.status();
+      for (const absl::TimeZone& time_zone : time_zones) {
+        for (int64_t timestamp : timestamps) {
+          SCOPED_TRACE(testing::Message() << "time zone: " << time_zone.name()
+                                          << " timestamp: " << timestamp);
+          std::string expected_out;
+          const absl::Status expected_status = FormatTimestampToString(
+              format, timestamp, time_zone, options, &expected_out);
+          std::string out = "previous";
+          ExpectSameResult(formatter->Format(timestamp, time_zone, &out), out,
+                           expected_status, expected_out);
+        }
+      }
+    }
+  }
+}
+
+TEST(TimestampFormatterTest, FormatRejectsInvalidTimestamps) {
+  absl::StatusOr<TimestampFormatter> formatter =
+      TimestampFormatter::Create("%Y-%m-%d %H:%M:%E6S");
+  ASSERT_TRUE(formatter.ok()) << formatter.status();
+  const int64_t max_timestamp =
+      Micros(absl::CivilSecond(9999, 12, 31, 23, 59, 59), 999999);
+  for (int64_t timestamp : {max_timestamp + 1, Micros(absl::CivilSecond(
+                                                   1, 1, 1, 0, 0, 0), -1)}) {
+    std::string expected_out;
+    const absl::Status expected_status = FormatTimestampToString(
+        "%Y-%m-%d %H:%M:%E6S", timestamp, absl::UTCTimeZone(),
+        {.expand_Q = true, .expand_J = false}, &expected_out);
+    EXPECT_FALSE(expected_status.ok());
+    std::string out;
+    EXPECT_EQ(formatter->Format(timestamp, absl::UTCTimeZone(), &out),
+              expected_status);
+  }
+}
+
+}  // namespace
+}  // namespace functions
+}  // namespace bigquery_ml_utils
@@ -17,6 +17,8 @@
 #ifndef THIRD_PARTY_PY_BIGQUERY_ML_UTILS_SQL_UTILS_PUBLIC_FUNCTIONS_DATE_TIME_UTIL_INTERNAL_H_
 #define THIRD_PARTY_PY_BIGQUERY_ML_UTILS_SQL_UTILS_PUBLIC_FUNCTIONS_DATE_TIME_UTIL_INTERNAL_H_
 
+#include <cstdint>
+
 #include "absl/time/civil_time.h"
 
 namespace bigquery_ml_utils {
@@ -85,6 +87,96 @@ int GetIsoWeek(absl::CivilDay day);
 // Ruturns true if the given year is a leap year, false otherwise.
 bool IsLeapYear(int64_t year);
 
+// Conversions between days since 1970-01-01 and civil dates using the
+// algorithms of C. Neri and L. Schneider, "Euclidean affine functions and
+// their application to calendar algorithms" (2022).  They only use integer
+// multiplications, shifts and comparisons, without branches or table lookups,
+// so loops over columns of dates can be vectorized by the compiler.  Both are
+// exact for the years kMinCivilFieldsYear to kMaxCivilFieldsYear.
+
+// The inputs are shifted by a whole number of 400 year cycles so that all the
+// intermediate values are unsigned.
+inline constexpr uint32_t kCivilFieldsCycles = 82;
+inline constexpr uint32_t kCivilFieldsYearShift = 400 * kCivilFieldsCycles;
+// Days from 0000-03-01, the start of the computational year 0, to 1970-01-01,
+// plus the shift.
+inline constexpr uint32_t kCivilFieldsDayShift =
+    719468 + 146097 * kCivilFieldsCycles;
+
+inline constexpr int32_t kMinCivilFieldsYear = -32767;
+inline constexpr int32_t kMaxCivilFieldsYear = 32767;
+
+// The fields of a civil date.
+struct CivilDayFields {
+  int32_t year;
+  int32_t month;        // 1 to 12
+  int32_t day;          // 1 to 31
+  int32_t day_of_year;  // 1 to 366
+  int32_t weekday;      // 0 (Sunday) to 6 (Saturday)
+};
+
+// Returns the days since 1970-01-01 of <year>-<month>-<day>.  Requires a valid
+// <month> and <day>.
+inline constexpr int32_t DaysFromCivil(int32_t year, int32_t month,
+                                       int32_t day) {
+  // Count from March so that the leap day is the last day of the year.
+  const uint32_t is_jan_or_feb = month <= 2;
+  const uint32_t y =
+      static_cast<uint32_t>(year) + kCivilFieldsYearShift - is_jan_or_feb;
+  const uint32_t m = static_cast<uint32_t>(month) + 12 * is_jan_or_feb;
+  const uint32_t century = y / 100;
+  const uint32_t year_days = 1461 * y / 4 - century + century / 4;
+  const uint32_t month_days = (979 * m - 2919) / 32;
+  return static_cast<int32_t>(year_days + month_days +
+                              static_cast<uint32_t>(day) - 1 -
+                              kCivilFieldsDayShift);
+}
+
+inline constexpr int32_t kMinCivilFieldsDays =
+    DaysFromCivil(kMinCivilFieldsYear, 1, 1);
+inline constexpr int32_t kMaxCivilFieldsDays =
+    DaysFromCivil(kMaxCivilFieldsYear, 12, 31);
+
+// Returns the fields of the date <days> since 1970-01-01, which must be
+// between kMinCivilFieldsDays and kMaxCivilFieldsDays.
+inline CivilDayFields CivilDayFieldsFromDays(int32_t days) {
+  const uint32_t n = static_cast<uint32_t>(days) + kCivilFieldsDayShift;
+  // Century and day of the century.
+  const uint32_t n_1 = 4 * n + 3;
+  const uint32_t century = n_1 / 146097;
+  const uint32_t century_day = n_1 % 146097 / 4;
+  // Year of the century and day of the year, counted from March 1.
+  const uint64_t p_2 = uint64_t{2939745} * (4 * century_day + 3);
+  const uint32_t century_year = static_cast<uint32_t>(p_2 >> 32);
+  const uint32_t year_day =
+      static_cast<uint32_t>(p_2 & 0xffffffff) / 2939745 / 4;
+  // Month, counted from March, and day of the month.
+  const uint32_t n_3 = 2141 * year_day + 197913;
+  const uint32_t month = n_3 >> 16;
+  const uint32_t month_day = (n_3 & 0xffff) / 2141;
+  // Map the computational year starting in March back to January.
+  const uint32_t is_jan_or_feb = year_day >= 306;
+  const int32_t year = static_cast<int32_t>(100 * century + century_year -
+                                            kCivilFieldsYearShift +
+                                            is_jan_or_feb);
+  const int32_t is_leap =
+      (year & 3) == 0 && ((year % 100 != 0) | ((year & 15) == 0));
+
+  CivilDayFields fields;
+  fields.year = year;
+  fields.month = static_cast<int32_t>(month - 12 * is_jan_or_feb);
+  fields.day = static_cast<int32_t>(month_day + 1);
+  // January 1 is 306 days after March 1, which is day 60 of the year, plus
+  // the leap day.
+  fields.day_of_year = is_jan_or_feb
+                           ? static_cast<int32_t>(year_day) - 305
+                           : static_cast<int32_t>(year_day) + 60 + is_leap;
+  // kCivilFieldsDayShift shifts the epoch, a Thursday, by a multiple of 7
+  // plus 1.
+  fields.weekday = static_cast<int32_t>((n + 3) % 7);
+  return fields;
+}
+
 }  // namespace date_time_util_internal
 }  // namespace functions
 }  // namespace bigquery_ml_utils
@@ -25,11 +25,12 @@
 #include <limits>
 #include <optional>
 #include <string>
-#include <vector>
 
 #include "absl/base/optimization.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "sql_utils/base/logging.h"
 #include "sql_utils/base/ret_check.h"
@@ -104,11 +105,13 @@ static const char* ParseOffset(const char* dp, const char* end_of_data,
   return dp;
 }
 
-static const char* ParseZone(const char* dp, std::string* zone,
+static const char* ParseZone(const char* dp, absl::string_view* zone,
                              const char* end) {
-  zone->clear();
+  *zone = absl::string_view();
   if (dp != nullptr) {
-    while (dp < end && !absl::ascii_isspace(*dp)) zone->push_back(*dp++);
+    const char* start = dp;
+    while (dp < end && !absl::ascii_isspace(*dp)) ++dp;
+    *zone = absl::string_view(start, dp - start);
     if (zone->empty()) dp = nullptr;
   }
   return dp;
@@ -129,6 +132,19 @@ static const char* ParseSubSecondsIfStartingWithPoint(
   return dp;
 }
 
+// NUL-terminated copies of the input for strptime(3), reused by all the parses
+// of a thread.  Once they have grown to the length of the inputs, parsing a
+// batch does not allocate for them.
+struct ParseScratch {
+  std::string data_copy;
+  std::string weekday_copy;
+};
+
+static ParseScratch& ThreadParseScratch() {
+  thread_local ParseScratch scratch;
+  return scratch;
+}
+
 // Parses a string into a struct tm using strptime(3).
 static const char* ParseTM(const char* dp, const char* fmt, struct tm* tm) {
   if (dp != nullptr) {
@@ -240,8 +256,9 @@ struct DateParseContext {
   bool non_iso_week_present = false;
 
   // Only includes new format elements enabled via the 'parse_version2'
-  // flag.
-  std::vector<ParseElementInfo> elements;
+  // flag.  Formats rarely have more than a few of them, so they are stored
+  // inline.
+  absl::InlinedVector<ParseElementInfo, 8> elements;
 };
 
 // Takes a list of ISO format elements and canonicalizes it.  Must be called
@@ -479,15 +496,14 @@ absl::Status ParseWeekdayFromElement(const ParseElementInfo& weekday_element,
 
   // Use strptime to figure out the day of week.  Strings must be null
   // terminated, so we construct such strings here.
-  const std::string data_copy_str(
-      weekday_element.data, weekday_element.end_of_data - weekday_element.data);
-  const std::string fmt_copy_str =
-      absl::StrCat("%", std::string(&weekday_element.fmt, 1));
+  std::string& data_copy_str = ThreadParseScratch().weekday_copy;
+  data_copy_str.assign(weekday_element.data,
+                       weekday_element.end_of_data - weekday_element.data);
+  const char fmt_copy_str[] = {'%', weekday_element.fmt, '\0'};
 
   // Use ParseTM (strptime) to parse the day of the week.
   struct tm parsed_tm;
-  const char* dp =
-      ParseTM(data_copy_str.c_str(), fmt_copy_str.c_str(), &parsed_tm);
+  const char* dp = ParseTM(data_copy_str.c_str(), fmt_copy_str, &parsed_tm);
   // If ParseTM returns nullptr, that indicates an error.
   SQL_RET_CHECK_NE(dp, nullptr)
       << "\nfmt: " << weekday_element.fmt << "\ndata: " << weekday_element.data
@@ -957,15 +973,23 @@ static absl::Status UpdateYearMonthDayIfNeeded(
                                             date_parse_context);
 }
 
+// Returned instead of a descriptive error when the caller only needs to know
+// that parsing failed, as the TryParse* functions do.  Unlike the errors built
+// with MakeEvalError(), a status without a message does not allocate.
+static absl::Status ParseFailure() {
+  return absl::Status(absl::StatusCode::kOutOfRange, "");
+}
+
 // This function generally uses strptime() to handle each format element,
 // but supports additional format element extensions and a few behavior
 // deviations for SQL semantics.
 // 'format' and 'timestamp_string' do not need to be null-terminated.
+// Without 'error_messages', most failures return ParseFailure().
 static absl::Status ParseTime(absl::string_view format,
                               absl::string_view timestamp_string,
                               const absl::TimeZone default_timezone,
                               TimestampScale scale, bool parse_version2,
-                              absl::Time* timestamp) {
+                              bool error_messages, absl::Time* timestamp) {
   // The unparsed input.  Note that data and end_of_data can be nullptr
   // for an empty string_view.
 
@@ -973,7 +997,7 @@ static absl::Status ParseTime(absl::string_view format,
   const char* end_of_data = data + timestamp_string.length();
   bool read_copy = false;
   const char* original_data_copy_position;
-  std::string data_copy_str;
+  std::string& data_copy_str = ThreadParseScratch().data_copy;
 
   // If the last byte of the 'timestamp_string' is a nul-byte then we ignore it.
   if (data != end_of_data) {
@@ -1052,6 +1076,7 @@ static absl::Status ParseTime(absl::string_view format,
         ++data;
         ++fmt;
       } else {
+        if (!error_messages) return ParseFailure();
         return MakeEvalError() << "Mismatch between format character '" << *fmt
                                << "' and string character '" << *data << "'";
       }
@@ -1061,6 +1086,7 @@ static absl::Status ParseTime(absl::string_view format,
     const char* percent = fmt;
     if (++fmt == end_of_fmt) {
       // The format string cannot end with a single '%'.
+      if (!error_messages) return ParseFailure();
       return MakeEvalError() << "Format string cannot end with a single '%'";
     }
 
@@ -1187,6 +1213,7 @@ static absl::Status ParseTime(absl::string_view format,
       case 'z':
         data = ParseOffset(data, end_of_data, '\0', &timezone_offset_minutes);
         if (!IsValidTimeZone(timezone_offset_minutes)) {
+          if (!error_messages) return ParseFailure();
           return MakeEvalError()
                  << "Timezone offset out of valid range -14:00 to +14:00: "
                  << TimeZoneOffsetToString(timezone_offset_minutes);
@@ -1194,7 +1221,7 @@ static absl::Status ParseTime(absl::string_view format,
         saw_timezone_offset = true;
         continue;
       case 'Z': {
-        std::string timezone_string;
+        absl::string_view timezone_string;
         data = ParseZone(data, &timezone_string, end_of_data);
         // The input time zone string overrides the default time zone.
         SQL_RETURN_IF_ERROR(MakeTimeZone(timezone_string, &timezone));
@@ -1235,6 +1262,7 @@ static absl::Status ParseTime(absl::string_view format,
           }
           data = ParseOffset(data, end_of_data, ':', &timezone_offset_minutes);
           if (!IsValidTimeZone(timezone_offset_minutes)) {
+            if (!error_messages) return ParseFailure();
             return MakeEvalError()
                    << "Timezone offset out of valid range -14:00 to +14:00: "
                    << TimeZoneOffsetToString(timezone_offset_minutes);
@@ -1522,7 +1550,7 @@ static absl::Status ParseTime(absl::string_view format,
     // pass it to strptime().
     if (!read_copy) {
       read_copy = true;
-      data_copy_str = std::string(data, end_of_data - data);
+      data_copy_str.assign(data, end_of_data - data);
       original_data_copy_position = data;
     }
 
@@ -1559,6 +1587,7 @@ static absl::Status ParseTime(absl::string_view format,
       }
       if (++fmt == end_of_fmt) {
         // The format string cannot end with a single '%'.
+        if (!error_messages) return ParseFailure();
         return MakeEvalError() << "Format string cannot end with a single '%'";
       }
       if (*fmt == 'n' || *fmt == 't') {
@@ -1575,6 +1604,7 @@ static absl::Status ParseTime(absl::string_view format,
   }
 
   if (data != end_of_data || fmt != end_of_fmt) {
+    if (!error_messages) return ParseFailure();
     return MakeEvalError() << "Failed to parse input string "
                            << ToStringLiteral(timestamp_string);
   }
@@ -1582,6 +1612,7 @@ static absl::Status ParseTime(absl::string_view format,
   // We must consume the entire input string and there must not be trailing
   // garbage or it is an error.
   if (data != end_of_data) {
+    if (!error_messages) return ParseFailure();
     return MakeEvalError() << "Illegal non-space trailing data '" << *data
                            << "' in string "
                            << ToStringLiteral(timestamp_string);
@@ -1592,6 +1623,7 @@ static absl::Status ParseTime(absl::string_view format,
   if (saw_percent_s) {
     *timestamp = absl::FromUnixSeconds(percent_s_time);
     if (!IsValidTime(*timestamp)) {
+      if (!error_messages) return ParseFailure();
       return MakeEvalError() << "Invalid result from parsing function";
     }
 
@@ -1634,11 +1666,13 @@ static absl::Status ParseTime(absl::string_view format,
   // ParseTime() fails if any normalization was done.  That is,
   // parsing "Sep 31" will not produce the equivalent of "Oct 1".
   if (tc.normalized) {
+    if (!error_messages) return ParseFailure();
     return MakeEvalError() << "Out-of-range datetime field in parsing function";
   }
 
   *timestamp = tc.pre - absl::Minutes(timezone_offset_minutes) + subseconds;
   if (!IsValidTime(*timestamp)) {
+    if (!error_messages) return ParseFailure();
     return MakeEvalError() << "Invalid result from parsing function";
   }
 
@@ -1648,7 +1682,8 @@ static absl::Status ParseTime(absl::string_view format,
 // Validates that <format_string> does not have any <invalid_elements>.
 static absl::Status ValidateParseFormat(absl::string_view format_string,
                                         absl::string_view target_type_name,
-                                        const char* invalid_elements) {
+                                        const char* invalid_elements,
+                                        bool error_messages) {
   const char* cur = format_string.data();
   const char* end = cur + format_string.size();
 
@@ -1666,6 +1701,7 @@ static absl::Status ValidateParseFormat(absl::string_view format_string,
 
     // Returns error if the format is any of the <invalid_elements>
     if (strchr(invalid_elements, *cur)) {
+      if (!error_messages) return ParseFailure();
       return MakeEvalError() << "Invalid format: %" << *cur
                              << " is not allowed for the " << target_type_name
                              << " type.";
@@ -1693,6 +1729,7 @@ static absl::Status ValidateParseFormat(absl::string_view format_string,
           ++prev;
         }
         element.push_back(*cur);
+        if (!error_messages) return ParseFailure();
         return MakeEvalError() << "Invalid format: %" << element
                                << " is not allowed for the " << target_type_name
                                << " type.";
@@ -1700,6 +1737,7 @@ static absl::Status ValidateParseFormat(absl::string_view format_string,
     } else if (*prev == 'O') {
       // Check %O extensions.
       if (strchr(invalid_elements, *cur)) {
+        if (!error_messages) return ParseFailure();
         return MakeEvalError() << "Invalid format: %O" << *cur
                                << " is not allowed for the " << target_type_name
                                << " type.";
@@ -1712,32 +1750,39 @@ static absl::Status ValidateParseFormat(absl::string_view format_string,
 // Validates the <format_string> to only allow format elements applicable to the
 // DATE type.  Returns error for non-DATE related formats such as
 // Hour/Minute/Second/Timezone etc.
-static absl::Status ValidateDateFormat(absl::string_view format_string) {
-  return ValidateParseFormat(format_string, "DATE", "cHIklMPpRrSsTXZz");
+static absl::Status ValidateDateFormat(absl::string_view format_string,
+                                       bool error_messages = true) {
+  return ValidateParseFormat(format_string, "DATE", "cHIklMPpRrSsTXZz",
+                             error_messages);
 }
 
 // Similar to ValidateDateFormat, but return error for non-TIME related formats
 // such as Year/Month/Week/Day/Timezone etc..
-static absl::Status ValidateTimeFormat(absl::string_view format_string) {
+static absl::Status ValidateTimeFormat(absl::string_view format_string,
+                                       bool error_messages = true) {
   return ValidateParseFormat(format_string, "TIME",
-                             "AaBbhCcDdeFGgjmsUuVWwxYyZz");
+                             "AaBbhCcDdeFGgjmsUuVWwxYyZz", error_messages);
 }
 
 // Similar to ValidateDateFormat, but return error for format elements for
 // timezones.
-static absl::Status ValidateDatetimeFormat(absl::string_view format_string) {
-  return ValidateParseFormat(format_string, "DATETIME", "Zz");
+static absl::Status ValidateDatetimeFormat(absl::string_view format_string,
+                                           bool error_messages = true) {
+  return ValidateParseFormat(format_string, "DATETIME", "Zz", error_messages);
 }
 
 // The result timestamp is always at microseconds precision.
 static absl::Status ParseTime(absl::string_view format,
                               absl::string_view timestamp_string,
                               const absl::TimeZone default_timezone,
-                              bool parse_version2, int64_t* timestamp) {
+                              bool parse_version2, bool error_messages,
+                              int64_t* timestamp) {
   absl::Time base_time;
   SQL_RETURN_IF_ERROR(ParseTime(format, timestamp_string, default_timezone,
-                            kMicroseconds, parse_version2, &base_time));
+                            kMicroseconds, parse_version2, error_messages,
+                            &base_time));
   if (!ConvertTimeToTimestamp(base_time, timestamp)) {
+    if (!error_messages) return ParseFailure();
     return MakeEvalError() << "Invalid result from parsing function";
   }
   return absl::OkStatus();
@@ -1750,15 +1795,16 @@ static absl::Status ParseTime(absl::string_view format,
 // a timestamp then extracts the date part.
 static absl::Status ParseDate(absl::string_view format,
                               absl::string_view date_string,
-                              bool parse_version2, int32_t* date) {
+                              bool parse_version2, bool error_messages,
+                              int32_t* date) {
   // Validates if the <format> has any unsupported DATE formats.
-  SQL_RETURN_IF_ERROR(ValidateDateFormat(format));
+  SQL_RETURN_IF_ERROR(ValidateDateFormat(format, error_messages));
 
-  // Invoke the ParseStringToTimestamp() to parse the <date_string> to a
+  // Invoke the ParseTime() to parse the <date_string> to a
   // timestamp then extracts the date part.
   int64_t timestamp;
-  SQL_RETURN_IF_ERROR(ParseStringToTimestamp(
-      format, date_string, absl::UTCTimeZone(), &timestamp, parse_version2));
+  SQL_RETURN_IF_ERROR(ParseTime(format, date_string, absl::UTCTimeZone(),
+                                parse_version2, error_messages, &timestamp));
   SQL_RETURN_IF_ERROR(ExtractFromTimestamp(DATE, timestamp, kMicroseconds,
                                        absl::UTCTimeZone(), date));
   return absl::OkStatus();
@@ -1771,7 +1817,7 @@ absl::Status ParseStringToTimestamp(absl::string_view format_string,
                                     const absl::TimeZone default_timezone,
                                     bool parse_version2, int64_t* timestamp) {
   return ParseTime(format_string, timestamp_string, default_timezone,
-                   parse_version2, timestamp);
+                   parse_version2, /*error_messages=*/true, timestamp);
 }
 
 // deprecated
@@ -1809,7 +1855,8 @@ absl::Status ParseStringToTimestamp(absl::string_view format_string,
                                     bool parse_version2,
                                     absl::Time* timestamp) {
   SQL_RETURN_IF_ERROR(ParseTime(format_string, timestamp_string, default_timezone,
-                            kNanoseconds, parse_version2, timestamp));
+                            kNanoseconds, parse_version2,
+                            /*error_messages=*/true, timestamp));
   return absl::OkStatus();
 }
 
@@ -1848,33 +1895,89 @@ absl::Status ParseStringToTimestamp(absl::string_view format_string,
 absl::Status ParseStringToDate(absl::string_view format_string,
                                absl::string_view date_string,
                                bool parse_version2, int32_t* date) {
-  return ParseDate(format_string, date_string, parse_version2, date);
+  return ParseDate(format_string, date_string, parse_version2,
+                   /*error_messages=*/true, date);
 }
 
-absl::Status ParseStringToTime(absl::string_view format_string,
-                               absl::string_view time_string,
-                               TimestampScale scale,
-                               TimeValue* time) {
+namespace {
+
+absl::Status ParseTimeValue(absl::string_view format_string,
+                            absl::string_view time_string, TimestampScale scale,
+                            bool error_messages, TimeValue* time) {
   SQL_CHECK(scale == kNanoseconds || scale == kMicroseconds);
-  SQL_RETURN_IF_ERROR(ValidateTimeFormat(format_string));
+  SQL_RETURN_IF_ERROR(ValidateTimeFormat(format_string, error_messages));
 
   absl::Time base_time;
   SQL_RETURN_IF_ERROR(ParseTime(format_string, time_string, absl::UTCTimeZone(),
-                            scale, /*parse_version2=*/true, &base_time));
+                            scale, /*parse_version2=*/true, error_messages,
+                            &base_time));
   return ConvertTimestampToTime(base_time, absl::UTCTimeZone(), scale, time);
 }
 
+absl::Status ParseDatetimeValue(absl::string_view format_string,
+                                absl::string_view datetime_string,
+                                TimestampScale scale, bool parse_version2,
+                                bool error_messages, DatetimeValue* datetime) {
+  SQL_CHECK(scale == kNanoseconds || scale == kMicroseconds);
+  SQL_RETURN_IF_ERROR(ValidateDatetimeFormat(format_string, error_messages));
+
+  absl::Time base_time;
+  SQL_RETURN_IF_ERROR(ParseTime(format_string, datetime_string,
+                            absl::UTCTimeZone(), scale, parse_version2,
+                            error_messages, &base_time));
+  return ConvertTimestampToDatetime(base_time, absl::UTCTimeZone(), datetime);
+}
+
+}  // namespace
+
+absl::Status ParseStringToTime(absl::string_view format_string,
+                               absl::string_view time_string,
+                               TimestampScale scale,
+                               TimeValue* time) {
+  return ParseTimeValue(format_string, time_string, scale,
+                        /*error_messages=*/true, time);
+}
+
 absl::Status ParseStringToDatetime(absl::string_view format_string,
                                    absl::string_view datetime_string,
                                    TimestampScale scale, bool parse_version2,
                                    DatetimeValue* datetime) {
-  SQL_CHECK(scale == kNanoseconds || scale == kMicroseconds);
-  SQL_RETURN_IF_ERROR(ValidateDatetimeFormat(format_string));
+  return ParseDatetimeValue(format_string, datetime_string, scale,
+                            parse_version2, /*error_messages=*/true, datetime);
+}
 
-  absl::Time base_time;
-  SQL_RETURN_IF_ERROR(ParseTime(format_string, datetime_string, absl::UTCTimeZone(),
-                            scale, parse_version2, &base_time));
-  return ConvertTimestampToDatetime(base_time, absl::UTCTimeZone(), datetime);
+bool TryParseStringToTimestamp(absl::string_view format_string,
+                               absl::string_view timestamp_string,
+                               absl::TimeZone default_timezone,
+                               bool parse_version2, int64_t* timestamp) {
+  return ParseTime(format_string, timestamp_string, default_timezone,
+                   parse_version2, /*error_messages=*/false, timestamp)
+      .ok();
+}
+
+bool TryParseStringToDate(absl::string_view format_string,
+                          absl::string_view date_string, bool parse_version2,
+                          int32_t* date) {
+  return ParseDate(format_string, date_string, parse_version2,
+                   /*error_messages=*/false, date)
+      .ok();
+}
+
+bool TryParseStringToTime(absl::string_view format_string,
+                          absl::string_view time_string, TimestampScale scale,
+                          TimeValue* time) {
+  return ParseTimeValue(format_string, time_string, scale,
+                        /*error_messages=*/false, time)
+      .ok();
+}
+
+bool TryParseStringToDatetime(absl::string_view format_string,
+                              absl::string_view datetime_string,
+                              TimestampScale scale, bool parse_version2,
+                              DatetimeValue* datetime) {
+  return ParseDatetimeValue(format_string, datetime_string, scale,
+                            parse_version2, /*error_messages=*/false, datetime)
+      .ok();
 }
 
 }  // namespace functions
@@ -153,6 +153,28 @@ absl::Status ParseStringToDatetime(absl::string_view format_string,
                                    TimestampScale scale, bool parse_version2,
                                    DatetimeValue* datetime);
 
+// Like the ParseStringTo* functions above, but only report whether parsing
+// succeeded.  Most failures do not build an error message, so these are
+// cheaper when failures are expected, like for the SAFE. variants of the
+// PARSE functions.  The output is unspecified when they return false.
+bool TryParseStringToTimestamp(absl::string_view format_string,
+                               absl::string_view timestamp_string,
+                               absl::TimeZone default_timezone,
+                               bool parse_version2, int64_t* timestamp);
+
+bool TryParseStringToDate(absl::string_view format_string,
+                          absl::string_view date_string, bool parse_version2,
+                          int32_t* date);
+
+bool TryParseStringToTime(absl::string_view format_string,
+                          absl::string_view time_string, TimestampScale scale,
+                          TimeValue* time);
+
+bool TryParseStringToDatetime(absl::string_view format_string,
+                              absl::string_view datetime_string,
+                              TimestampScale scale, bool parse_version2,
+                              DatetimeValue* datetime);
+
 }  // namespace functions
 }  // namespace bigquery_ml_utils
 
@@ -16,7 +16,17 @@
 
 #include "sql_utils/public/time_zone_util.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
 #include "sql_utils/common/errors.h"
+#include "absl/base/const_init.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/civil_time.h"
 
 namespace bigquery_ml_utils {
 
@@ -46,4 +56,100 @@ absl::Status FindTimeZoneByName(absl::string_view timezone_name,
   return MakeEvalError() << "Invalid time zone: " << timezone_name;
 }
 
+std::shared_ptr<const TimeZoneOffsetIndex> TimeZoneOffsetIndex::ForTimeZone(
+    absl::TimeZone timezone) {
+  static absl::Mutex mu(absl::kConstInit);
+  static auto* indexes = new absl::flat_hash_map<
+      std::string, std::shared_ptr<const TimeZoneOffsetIndex>>();
+  absl::MutexLock lock(&mu);
+  std::shared_ptr<const TimeZoneOffsetIndex>& index =
+      (*indexes)[timezone.name()];
+  if (index == nullptr) {
+    index = std::make_shared<const TimeZoneOffsetIndex>(timezone);
+  }
+  return index;
+}
+
+TimeZoneOffsetIndex::TimeZoneOffsetIndex(absl::TimeZone timezone)
+    : timezone_(timezone) {
+  const absl::TimeZone utc = absl::UTCTimeZone();
+  const absl::Time window_start =
+      absl::FromCivil(absl::CivilSecond(1900, 1, 1, 0, 0, 0), utc);
+  const absl::Time window_end =
+      absl::FromCivil(absl::CivilSecond(2100, 1, 1, 0, 0, 0), utc);
+  window_end_ = absl::ToUnixSeconds(window_end);
+
+  starts_.push_back(absl::ToUnixSeconds(window_start));
+  offsets_.push_back(timezone.At(window_start).offset);
+  absl::Time time = window_start;
+  absl::TimeZone::CivilTransition transition;
+  while (timezone.NextTransition(time, &transition)) {
+    time = timezone.At(transition.to).trans;
+    if (time >= window_end) break;
+    const int32_t offset = timezone.At(time).offset;
+    max_offset_change_ = std::max<int64_t>(max_offset_change_,
+                                           std::abs(offset - offsets_.back()));
+    starts_.push_back(absl::ToUnixSeconds(time));
+    offsets_.push_back(offset);
+  }
+}
+
+int32_t TimeZoneOffsetIndex::FindInterval(int64_t unix_seconds,
+                                          int32_t* hint) const {
+  if (unix_seconds < starts_.front() || unix_seconds >= window_end_) {
+    return -1;
+  }
+  // Try the interval of the previous lookup and the one after it, which
+  // covers sorted and clustered instants, before searching all of them.
+  int32_t interval = std::min<int32_t>(*hint, starts_.size() - 1);
+  if (starts_[interval] <= unix_seconds) {
+    if (unix_seconds < IntervalEnd(interval)) return interval;
+    if (unix_seconds < IntervalEnd(interval + 1)) {
+      *hint = interval + 1;
+      return interval + 1;
+    }
+  }
+  interval = static_cast<int32_t>(
+      std::upper_bound(starts_.begin(), starts_.end(), unix_seconds) -
+      starts_.begin() - 1);
+  *hint = interval;
+  return interval;
+}
+
+int32_t TimeZoneOffsetIndex::OffsetAt(int64_t unix_seconds,
+                                      int32_t* hint) const {
+  const int32_t interval = FindInterval(unix_seconds, hint);
+  if (interval < 0) {
+    return timezone_.At(absl::FromUnixSeconds(unix_seconds)).offset;
+  }
+  return offsets_[interval];
+}
+
+int32_t TimeZoneOffsetIndex::OffsetAt(int64_t unix_seconds, int32_t* hint,
+                                      int64_t* start, int64_t* end) const {
+  const int32_t interval = FindInterval(unix_seconds, hint);
+  if (interval < 0) {
+    *start = unix_seconds;
+    *end = unix_seconds + 1;
+    return timezone_.At(absl::FromUnixSeconds(unix_seconds)).offset;
+  }
+  *start = starts_[interval];
+  *end = IntervalEnd(interval);
+  return offsets_[interval];
+}
+
+bool TimeZoneOffsetIndex::HasUniqueCivilTime(int64_t unix_seconds,
+                                             int32_t* hint) const {
+  const int32_t interval = FindInterval(unix_seconds, hint);
+  if (interval < 0) {
+    const absl::TimeZone::CivilInfo info =
+        timezone_.At(absl::FromUnixSeconds(unix_seconds));
+    return timezone_.At(info.cs).kind == absl::TimeZone::TimeInfo::UNIQUE;
+  }
+  // Another instant with the same civil time would be in another interval,
+  // separated from <unix_seconds> by the change of offset between them.
+  return starts_[interval] <= unix_seconds - max_offset_change_ &&
+         unix_seconds + max_offset_change_ < IntervalEnd(interval);
+}
+
 }  // namespace bigquery_ml_utils
\ No newline at end of file
@@ -17,6 +17,10 @@
 #ifndef THIRD_PARTY_PY_BIGQUERY_ML_UTILS_SQL_UTILS_PUBLIC_TIME_ZONE_UTIL_H_
 #define THIRD_PARTY_PY_BIGQUERY_ML_UTILS_SQL_UTILS_PUBLIC_TIME_ZONE_UTIL_H_
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
@@ -35,6 +39,64 @@ namespace bigquery_ml_utils {
 absl::Status FindTimeZoneByName(absl::string_view timezone_name,
                                 absl::TimeZone* tz);
 
+// Precomputed UTC offsets of a time zone between 1900 and 2100, so that the
+// offset at an instant can be found without the binary search over all the
+// transitions of the zone that absl::TimeZone::At() does.  Lookups take a
+// <hint> with the position of the previous lookup, which makes lookups of
+// sorted or clustered instants amortized O(1).  Instants outside of the
+// window are resolved exactly with absl::TimeZone.
+//
+// An index is immutable and can be shared between threads; each thread needs
+// its own hints.
+class TimeZoneOffsetIndex {
+ public:
+  // Returns the index of <timezone>, building it on first use.  Indexes are
+  // kept for the lifetime of the process, keyed by the time zone name.
+  static std::shared_ptr<const TimeZoneOffsetIndex> ForTimeZone(
+      absl::TimeZone timezone);
+
+  explicit TimeZoneOffsetIndex(absl::TimeZone timezone);
+
+  TimeZoneOffsetIndex(const TimeZoneOffsetIndex&) = delete;
+  TimeZoneOffsetIndex& operator=(const TimeZoneOffsetIndex&) = delete;
+
+  // Returns the offset of the time zone, in seconds east of UTC, at
+  // <unix_seconds>.  <hint> must be initialized to 0 before the first lookup.
+  int32_t OffsetAt(int64_t unix_seconds, int32_t* hint) const;
+
+  // Like OffsetAt(), and also sets [<start>, <end>) to the seconds around
+  // <unix_seconds> that have the same offset.  Outside of the window, that is
+  // only <unix_seconds> itself.
+  int32_t OffsetAt(int64_t unix_seconds, int32_t* hint, int64_t* start,
+                   int64_t* end) const;
+
+  // Returns true if <unix_seconds> is known to be the only instant with its
+  // civil time in the time zone, i.e. no nearby transition repeats or skips
+  // it.  Within the window, instants close to a transition may return false
+  // even if their civil time is unique.
+  bool HasUniqueCivilTime(int64_t unix_seconds, int32_t* hint) const;
+
+ private:
+  // Returns the position in <starts_> of the interval containing
+  // <unix_seconds>, or -1 if it is outside of the window.
+  int32_t FindInterval(int64_t unix_seconds, int32_t* hint) const;
+
+  int64_t IntervalEnd(int32_t interval) const {
+    return interval + 1 < static_cast<int32_t>(starts_.size())
+               ? starts_[interval + 1]
+               : window_end_;
+  }
+
+  const absl::TimeZone timezone_;
+  // The window is split into intervals of constant offset, starting at each
+  // transition.  The first interval starts at the window start.
+  std::vector<int64_t> starts_;
+  std::vector<int32_t> offsets_;
+  int64_t window_end_;
+  // Largest change of offset at a transition within the window.
+  int64_t max_offset_change_ = 0;
+};
+
 }  // namespace bigquery_ml_utils
 
 #endif  // THIRD_PARTY_PY_BIGQUERY_ML_UTILS_SQL_UTILS_PUBLIC_TIME_ZONE_UTIL_H_
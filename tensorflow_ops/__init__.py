@@ -13,55 +13,150 @@
 # limitations under the License.
 
 from bigquery_ml_utils.tensorflow_ops.date_ops import cast_to_date_from_string
+from bigquery_ml_utils.tensorflow_ops.date_ops import cast_to_date_from_string_with_errors
+from bigquery_ml_utils.tensorflow_ops.date_ops import cast_to_string_from_date
+from bigquery_ml_utils.tensorflow_ops.date_ops import cast_to_string_from_date_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import date_add
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_add_days
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_add_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import date_diff
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_diff_days
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_diff_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import date_from_components
 from bigquery_ml_utils.tensorflow_ops.date_ops import date_from_datetime
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_from_datetime_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import date_from_timestamp
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_from_timestamp_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import date_from_unix_date
 from bigquery_ml_utils.tensorflow_ops.date_ops import date_sub
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_sub_days
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_sub_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import date_trunc
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_trunc_days
+from bigquery_ml_utils.tensorflow_ops.date_ops import date_trunc_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import extract_from_date
+from bigquery_ml_utils.tensorflow_ops.date_ops import extract_from_date_days
+from bigquery_ml_utils.tensorflow_ops.date_ops import extract_from_date_with_errors
+from bigquery_ml_utils.tensorflow_ops.date_ops import extract_parts_from_date
 from bigquery_ml_utils.tensorflow_ops.date_ops import format_date
+from bigquery_ml_utils.tensorflow_ops.date_ops import format_date_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import last_day_from_date
+from bigquery_ml_utils.tensorflow_ops.date_ops import last_day_from_date_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import parse_date
+from bigquery_ml_utils.tensorflow_ops.date_ops import parse_date_with_errors
 from bigquery_ml_utils.tensorflow_ops.date_ops import safe_parse_date
+from bigquery_ml_utils.tensorflow_ops.date_ops import safe_parse_date_with_validity
 from bigquery_ml_utils.tensorflow_ops.date_ops import unix_date
+from bigquery_ml_utils.tensorflow_ops.date_ops import unix_date_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_expr_ops import datetime_expr
 from bigquery_ml_utils.tensorflow_ops.datetime_ops import cast_to_datetime_from_string
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import cast_to_datetime_from_string_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import cast_to_string_from_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import cast_to_string_from_datetime_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_add_packed
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_add_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_diff_packed
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_diff_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_from_date_and_time_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_from_date_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_from_packed
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_from_timestamp_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_sub_packed
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_sub_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_trunc_packed
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import datetime_trunc_with_errors
 from bigquery_ml_utils.tensorflow_ops.datetime_ops import extract_date_from_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import extract_date_from_datetime_with_errors
 from bigquery_ml_utils.tensorflow_ops.datetime_ops import extract_from_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import extract_from_datetime_packed
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import extract_from_datetime_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import extract_parts_from_datetime
 from bigquery_ml_utils.tensorflow_ops.datetime_ops import extract_time_from_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import extract_time_from_datetime_with_errors
 from bigquery_ml_utils.tensorflow_ops.datetime_ops import format_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import format_datetime_with_errors
 from bigquery_ml_utils.tensorflow_ops.datetime_ops import last_day_from_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import last_day_from_datetime_with_errors
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import packed_from_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import packed_from_datetime_with_errors
 from bigquery_ml_utils.tensorflow_ops.datetime_ops import parse_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import parse_datetime_with_errors
 from bigquery_ml_utils.tensorflow_ops.datetime_ops import safe_parse_datetime
+from bigquery_ml_utils.tensorflow_ops.datetime_ops import safe_parse_datetime_with_validity
+from bigquery_ml_utils.tensorflow_ops.time_ops import cast_to_string_from_time
+from bigquery_ml_utils.tensorflow_ops.time_ops import cast_to_string_from_time_with_errors
 from bigquery_ml_utils.tensorflow_ops.time_ops import cast_to_time_from_string
+from bigquery_ml_utils.tensorflow_ops.time_ops import cast_to_time_from_string_with_errors
 from bigquery_ml_utils.tensorflow_ops.time_ops import extract_from_time
+from bigquery_ml_utils.tensorflow_ops.time_ops import extract_from_time_packed
+from bigquery_ml_utils.tensorflow_ops.time_ops import extract_from_time_with_errors
+from bigquery_ml_utils.tensorflow_ops.time_ops import extract_parts_from_time
 from bigquery_ml_utils.tensorflow_ops.time_ops import format_time
+from bigquery_ml_utils.tensorflow_ops.time_ops import format_time_with_errors
+from bigquery_ml_utils.tensorflow_ops.time_ops import packed_from_time
+from bigquery_ml_utils.tensorflow_ops.time_ops import packed_from_time_with_errors
 from bigquery_ml_utils.tensorflow_ops.time_ops import parse_time
+from bigquery_ml_utils.tensorflow_ops.time_ops import parse_time_with_errors
 from bigquery_ml_utils.tensorflow_ops.time_ops import safe_parse_time
+from bigquery_ml_utils.tensorflow_ops.time_ops import safe_parse_time_with_validity
 from bigquery_ml_utils.tensorflow_ops.time_ops import time_add
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_add_packed
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_add_with_errors
 from bigquery_ml_utils.tensorflow_ops.time_ops import time_diff
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_diff_packed
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_diff_with_errors
 from bigquery_ml_utils.tensorflow_ops.time_ops import time_from_components
 from bigquery_ml_utils.tensorflow_ops.time_ops import time_from_datetime
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_from_datetime_with_errors
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_from_packed
 from bigquery_ml_utils.tensorflow_ops.time_ops import time_from_timestamp
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_from_timestamp_with_errors
 from bigquery_ml_utils.tensorflow_ops.time_ops import time_sub
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_sub_packed
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_sub_with_errors
 from bigquery_ml_utils.tensorflow_ops.time_ops import time_trunc
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_trunc_packed
+from bigquery_ml_utils.tensorflow_ops.time_ops import time_trunc_with_errors
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import cast_to_string_from_timestamp
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import cast_to_string_from_timestamp_with_errors
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import cast_to_timestamp_from_string
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import cast_to_timestamp_from_string_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import extract_from_timestamp
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import extract_from_timestamp_micros
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import extract_from_timestamp_with_errors
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import extract_parts_from_timestamp
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import format_timestamp
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import format_timestamp_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import parse_timestamp
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import parse_timestamp_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import safe_parse_timestamp
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import safe_parse_timestamp_with_validity
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import string_from_timestamp
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import string_from_timestamp_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_add
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_add_micros
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_add_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_diff
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_diff_micros
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_diff_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_from_date
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_from_date_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_from_datetime
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_from_datetime_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_from_string
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_from_string_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_micros
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_millis
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_seconds
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_sub
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_sub_micros
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_sub_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_trunc
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_trunc_micros
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import timestamp_trunc_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import unix_micros
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import unix_micros_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import unix_millis
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import unix_millis_with_errors
 from bigquery_ml_utils.tensorflow_ops.timestamp_ops import unix_seconds
+from bigquery_ml_utils.tensorflow_ops.timestamp_ops import unix_seconds_with_errors
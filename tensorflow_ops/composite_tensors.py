@@ -0,0 +1,117 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""RaggedTensor and SparseTensor support for the elementwise op wrappers."""
+
+import functools
+
+import tensorflow as tf
+
+_COMPOSITE_TYPES = (tf.RaggedTensor, tf.SparseTensor)
+
+
+def _values(arg):
+  """Returns the values buffer of a composite tensor, or arg itself."""
+  if isinstance(arg, tf.RaggedTensor):
+    return arg.flat_values
+  if isinstance(arg, tf.SparseTensor):
+    return arg.values
+  return arg
+
+
+def _with_values(like, values):
+  """Returns values with the row partitions or indices of like."""
+  if isinstance(like, tf.RaggedTensor):
+    return like.with_flat_values(values)
+  return tf.SparseTensor(like.indices, values, like.dense_shape)
+
+
+def _partitions(arg):
+  """Returns the row splits or the indices and shape of a composite tensor."""
+  if isinstance(arg, tf.RaggedTensor):
+    return arg.nested_row_splits
+  return (arg.indices, arg.dense_shape)
+
+
+def _assert_same_partitions(name, like, composites):
+  """Returns the assertions that composites are partitioned like like."""
+  assertions = []
+  for arg in composites[1:]:
+    if isinstance(like, tf.RaggedTensor) and (
+        arg.ragged_rank != like.ragged_rank
+    ):
+      raise ValueError(
+          f"{name} requires its RaggedTensor inputs to have the same ragged"
+          " rank."
+      )
+    for expected, actual in zip(_partitions(like), _partitions(arg)):
+      assertions.append(
+          tf.debugging.assert_equal(
+              actual,
+              expected,
+              message=(
+                  f"{name} requires its composite inputs to have the same"
+                  " row partitions or indices."
+              ),
+          )
+      )
+  return assertions
+
+
+def supports_composite_tensors(op_wrapper):
+  """Lets an elementwise op wrapper take RaggedTensor and SparseTensor inputs.
+
+  The op runs on the values buffer of each tf.RaggedTensor or tf.SparseTensor
+  argument, so that no padding is ever parsed, and each output reuses the row
+  partitions or indices of the first of them. All such arguments must have the
+  same row partitions or indices, which is asserted before the op runs. Other
+  arguments, such as a scalar time zone, are passed through unchanged.
+
+  Args:
+    op_wrapper: A function whose outputs have one element per element of its
+      tensor arguments.
+
+  Returns:
+    The wrapped function.
+  """
+
+  @functools.wraps(op_wrapper)
+  def wrapper(*args, **kwargs):
+    composites = [
+        arg
+        for arg in list(args) + list(kwargs.values())
+        if isinstance(arg, _COMPOSITE_TYPES)
+    ]
+    if not composites:
+      return op_wrapper(*args, **kwargs)
+
+    like = composites[0]
+    if any(type(arg) is not type(like) for arg in composites):
+      raise ValueError(
+          f"{op_wrapper.__name__} cannot mix RaggedTensor and SparseTensor"
+          " inputs."
+      )
+    assertions = _assert_same_partitions(
+        op_wrapper.__name__, like, composites
+    )
+    with tf.control_dependencies(assertions):
+      outputs = op_wrapper(
+          *[_values(arg) for arg in args],
+          **{key: _values(arg) for key, arg in kwargs.items()},
+      )
+    return tf.nest.map_structure(
+        lambda output: _with_values(like, output), outputs
+    )
+
+  return wrapper
@@ -14,9 +14,13 @@
  * limitations under the License.
  */
 
+#include <string>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/platform/errors.h"
 
 namespace bigquery_ml_utils {
 
@@ -33,6 +37,40 @@ REGISTER_OP("ExtractFromDate")
       return absl::OkStatus();
     });
 
+// Register ExtractFromDateWithErrors op with signature.
+// Like ExtractFromDate, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("ExtractFromDateWithErrors")
+    .Input("date: string")
+    .Input("part: string")
+    .Output("part_out: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register ExtractPartsFromDate op with signature.
+// Output has the shape of the input date with an extra innermost dimension
+// for the parts.
+REGISTER_OP("ExtractPartsFromDate")
+    .Input("date: string")
+    .Attr("parts: list(string) >= 1")
+    .Output("parts_out: int64")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      std::vector<std::string> parts;
+      TF_RETURN_IF_ERROR(c->GetAttr("parts", &parts));
+      tensorflow::shape_inference::ShapeHandle output;
+      TF_RETURN_IF_ERROR(
+          c->Concatenate(c->input(0), c->Vector(parts.size()), &output));
+      c->set_output(0, output);
+      return absl::OkStatus();
+    });
+
 // Register DateFromComponents op with signature.
 // Output has the same shape of the inputs.
 REGISTER_OP("DateFromComponents")
@@ -56,6 +94,23 @@ REGISTER_OP("DateFromTimestamp")
       return absl::OkStatus();
     });
 
+// Register DateFromTimestampWithErrors op with signature.
+// Like DateFromTimestamp, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("DateFromTimestampWithErrors")
+    .Input("timestamp: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DateFromDatetime op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("DateFromDatetime")
@@ -66,6 +121,22 @@ REGISTER_OP("DateFromDatetime")
       return absl::OkStatus();
     });
 
+// Register DateFromDatetimeWithErrors op with signature.
+// Like DateFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("DateFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register CastToDateFromString op with signature.
 // Output has the same shape of the date_string.
 REGISTER_OP("CastToDateFromString")
@@ -78,6 +149,54 @@ REGISTER_OP("CastToDateFromString")
       return absl::OkStatus();
     });
 
+// Register CastToDateFromStringWithErrors op with signature.
+// Like CastToDateFromString, but rows that fail produce an empty output string
+// and their error code in error_codes instead of failing the whole batch. Both
+// have the same shape of the input date_string. error_messages has the messages
+// of the first max_error_messages failing rows.
+REGISTER_OP("CastToDateFromStringWithErrors")
+    .Input("date_string: string")
+    .Input("format_string: string")
+    .Input("with_format: bool")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register CastToStringFromDate op with signature.
+// Output has the same shape of the date.
+REGISTER_OP("CastToStringFromDate")
+    .Input("date: string")
+    .Input("format_string: string")
+    .Output("output: string")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register CastToStringFromDateWithErrors op with signature.
+// Like CastToStringFromDate, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("CastToStringFromDateWithErrors")
+    .Input("date: string")
+    .Input("format_string: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DateFromUnixDate op with signature.
 // Output has the same shape of the num_days.
 REGISTER_OP("DateFromUnixDate")
@@ -100,6 +219,24 @@ REGISTER_OP("DateAdd")
       return absl::OkStatus();
     });
 
+// Register DateAddWithErrors op with signature.
+// Like DateAdd, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("DateAddWithErrors")
+    .Input("date: string")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DateSub op with signature.
 // Output has the same shape of the input date.
 REGISTER_OP("DateSub")
@@ -112,6 +249,24 @@ REGISTER_OP("DateSub")
       return absl::OkStatus();
     });
 
+// Register DateSubWithErrors op with signature.
+// Like DateSub, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("DateSubWithErrors")
+    .Input("date: string")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DateDiff op with signature.
 // Output has the same shape of the inputs.
 REGISTER_OP("DateDiff")
@@ -124,6 +279,24 @@ REGISTER_OP("DateDiff")
       return absl::OkStatus();
     });
 
+// Register DateDiffWithErrors op with signature.
+// Like DateDiff, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("DateDiffWithErrors")
+    .Input("date_a: string")
+    .Input("date_b: string")
+    .Input("part: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DateTrunc op with signature.
 // Output has the same shape of the input date.
 REGISTER_OP("DateTrunc")
@@ -135,6 +308,23 @@ REGISTER_OP("DateTrunc")
       return absl::OkStatus();
     });
 
+// Register DateTruncWithErrors op with signature.
+// Like DateTrunc, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("DateTruncWithErrors")
+    .Input("date: string")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register FormatDate op with signature.
 // Output has the same shape of the input date.
 REGISTER_OP("FormatDate")
@@ -146,6 +336,23 @@ REGISTER_OP("FormatDate")
       return absl::OkStatus();
     });
 
+// Register FormatDateWithErrors op with signature.
+// Like FormatDate, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("FormatDateWithErrors")
+    .Input("format_string: string")
+    .Input("date: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register LastDay op with signature.
 // Output has the same shape of the input date.
 REGISTER_OP("LastDayFromDate")
@@ -157,6 +364,23 @@ REGISTER_OP("LastDayFromDate")
       return absl::OkStatus();
     });
 
+// Register LastDayFromDateWithErrors op with signature.
+// Like LastDayFromDate, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("LastDayFromDateWithErrors")
+    .Input("date: string")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register ParseDate op with signature.
 // Output has the same shape of the input date_string.
 REGISTER_OP("ParseDate")
@@ -168,6 +392,25 @@ REGISTER_OP("ParseDate")
       return absl::OkStatus();
     });
 
+// Register ParseDateWithErrors op with signature.
+// Like ParseDate, but rows that fail produce an empty output string and their
+// error code in error_codes instead of failing the whole batch. Both have the
+// same shape of the input date_string. error_messages has the messages of the
+// first max_error_messages failing rows.
+REGISTER_OP("ParseDateWithErrors")
+    .Input("format_string: string")
+    .Input("date_string: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register SafeParseDate op with signature.
 // Output has the same shape of the input date_string.
 REGISTER_OP("SafeParseDate")
@@ -179,6 +422,21 @@ REGISTER_OP("SafeParseDate")
       return absl::OkStatus();
     });
 
+// Register SafeParseDateWithValidity op with signature.
+// Like SafeParseDate, but rows that fail to parse produce an empty output
+// string and false in valid, instead of the NULL-equivalent value.  Both
+// outputs have the same shape of the input date_string.
+REGISTER_OP("SafeParseDateWithValidity")
+    .Input("format_string: string")
+    .Input("date_string: string")
+    .Output("output: string")
+    .Output("valid: bool")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      return absl::OkStatus();
+    });
+
 // Register UnixDate op with signature.
 // Output has the same shape of the input date.
 REGISTER_OP("UnixDate")
@@ -189,4 +447,78 @@ REGISTER_OP("UnixDate")
       return absl::OkStatus();
     });
 
+// Register UnixDateWithErrors op with signature.
+// Like UnixDate, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("UnixDateWithErrors")
+    .Input("date: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register ExtractFromDateDays op with signature.
+// Output has the same shape of the input date.
+REGISTER_OP("ExtractFromDateDays")
+    .Input("date: int64")
+    .Input("part: string")
+    .Output("part_out: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register DateAddDays op with signature.
+// Output has the same shape of the input date.
+REGISTER_OP("DateAddDays")
+    .Input("date: int64")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register DateSubDays op with signature.
+// Output has the same shape of the input date.
+REGISTER_OP("DateSubDays")
+    .Input("date: int64")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register DateDiffDays op with signature.
+// Output has the same shape of the input date.
+REGISTER_OP("DateDiffDays")
+    .Input("date_a: int64")
+    .Input("date_b: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register DateTruncDays op with signature.
+// Output has the same shape of the input date.
+REGISTER_OP("DateTruncDays")
+    .Input("date: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
 }  // namespace bigquery_ml_utils
@@ -14,11 +14,13 @@
 
 """Python wrapper for BigQuery date custom ops."""
 
+from bigquery_ml_utils.tensorflow_ops.composite_tensors import supports_composite_tensors
 from bigquery_ml_utils.tensorflow_ops.load_module import load_module
 
-gen_date_ops = load_module("_date_ops.so")
+gen_date_ops = load_module("_bigquery_ml_utils_ops.so")
 
 
+@supports_composite_tensors
 def extract_from_date(date, part, name=None):
   """Returns the specified part from a supplied date.
 
@@ -34,6 +36,50 @@ def extract_from_date(date, part, name=None):
   return gen_date_ops.extract_from_date(date=date, part=part, name=name)
 
 
+def extract_from_date_with_errors(date, part, max_error_messages=16, name=None):
+  """Like extract_from_date, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    part: A string represents the date part. Can be DAYOFWEEK, DAY, DAYOFYEAR,
+      WEEK, WEEK(WEEKDAY), ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. It is case
+      insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.extract_from_date_with_errors(
+      date=date,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+def extract_parts_from_date(date, parts, name=None):
+  """Returns several parts from a supplied date, parsing each date once.
+
+  Equivalent SQL: EXTRACT(part FROM date) for each part in parts.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    parts: A non-empty list of strings represents the date parts, with the
+      values accepted by extract_from_date.
+    name: An optional name for the op.
+
+  Returns:
+    A tf.Tensor of type int64 with the shape of date and an extra innermost
+    dimension, holding the value of parts[i] at index i.
+  """
+  return gen_date_ops.extract_parts_from_date(date=date, parts=parts, name=name)
+
+
+@supports_composite_tensors
 def date_from_components(year, month, day, name=None):
   """Returns a date using INT64 values representing the year, month and day.
 
@@ -50,6 +96,7 @@ def date_from_components(year, month, day, name=None):
   )
 
 
+@supports_composite_tensors
 def date_from_timestamp(timestamp, time_zone="UTC", name=None):
   """Returns a date from a timestamp.
 
@@ -65,6 +112,32 @@ def date_from_timestamp(timestamp, time_zone="UTC", name=None):
   )
 
 
+def date_from_timestamp_with_errors(
+    timestamp, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like date_from_timestamp, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    time_zone: A string represents the timezone. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.date_from_timestamp_with_errors(
+      timestamp=timestamp,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def date_from_datetime(datetime, name=None):
   """Returns a date from a datetime.
 
@@ -77,6 +150,28 @@ def date_from_datetime(datetime, name=None):
   return gen_date_ops.date_from_datetime(datetime=datetime, name=name)
 
 
+def date_from_datetime_with_errors(datetime, max_error_messages=16, name=None):
+  """Like date_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.date_from_datetime_with_errors(
+      datetime=datetime,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def date_from_unix_date(num_days, name=None):
   """Returns a date from the number of days since 1970-01-01.
 
@@ -89,6 +184,7 @@ def date_from_unix_date(num_days, name=None):
   return gen_date_ops.date_from_unix_date(num_days=num_days, name=name)
 
 
+@supports_composite_tensors
 def cast_to_date_from_string(date_string, format_string=None, name=None):
   """Returns a date by casting a string.
 
@@ -111,6 +207,82 @@ def cast_to_date_from_string(date_string, format_string=None, name=None):
   )
 
 
+def cast_to_date_from_string_with_errors(
+    date_string, format_string=None, max_error_messages=16, name=None
+):
+  """Like cast_to_date_from_string, but reports per-row errors.
+
+  Args:
+    date_string: tf.Tensor of type string. The string must conform to the
+      supported date literal format, and is independent of time zone. If the
+      string expression is invalid or represents a time that is outside of the
+      supported min/max range, then an error is produced.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.cast_to_date_from_string_with_errors(
+      date_string=date_string,
+      format_string="" if format_string is None else format_string,
+      with_format=format_string is not None,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def cast_to_string_from_date(date, format_string, name=None):
+  """Returns a string by casting a date with a format.
+
+  Equivalent SQL: CAST(date AS STRING FORMAT format_string)
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    name: An optional name for the op.
+  """
+  return gen_date_ops.cast_to_string_from_date(
+      date=date,
+      format_string=format_string,
+      name=name,
+  )
+
+
+def cast_to_string_from_date_with_errors(
+    date, format_string, max_error_messages=16, name=None
+):
+  """Like cast_to_string_from_date, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.cast_to_string_from_date_with_errors(
+      date=date,
+      format_string=format_string,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def date_add(date, interval, part, name=None):
   """Returns a date by adding interval to the date.
 
@@ -131,6 +303,35 @@ def date_add(date, interval, part, name=None):
   )
 
 
+def date_add_with_errors(
+    date, interval, part, max_error_messages=16, name=None
+):
+  """Like date_add, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the date part. Can be DAY, WEEK, MONTH, QUARTER,
+      YEAR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.date_add_with_errors(
+      date=date,
+      interval=interval,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def date_sub(date, interval, part, name=None):
   """Returns a date by subtracting interval to the timestamp.
 
@@ -151,6 +352,35 @@ def date_sub(date, interval, part, name=None):
   )
 
 
+def date_sub_with_errors(
+    date, interval, part, max_error_messages=16, name=None
+):
+  """Like date_sub, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the date part. Can be DAY, WEEK, MONTH, QUARTER,
+      YEAR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.date_sub_with_errors(
+      date=date,
+      interval=interval,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def date_diff(date_a, date_b, part, name=None):
   """Returns the whole number of specified part intervals between date_a and date_b.
 
@@ -172,6 +402,36 @@ def date_diff(date_a, date_b, part, name=None):
   )
 
 
+def date_diff_with_errors(
+    date_a, date_b, part, max_error_messages=16, name=None
+):
+  """Like date_diff, but reports per-row errors.
+
+  Args:
+    date_a: tf.Tensor of type string. Date in "%F" format.
+    date_b: tf.Tensor of type string. Date in "%F" format.
+    part: A string represents the date part. Can be DAY, WEEK,  WEEK_MONDAY,
+      WEEK_TUESDAY, WEEK_WEDNESDAY, WEEK_THURSDAY, WEEK_FRIDAY, WEEK_SATURDAY,
+      ISOWEEK, MONTH, QUARTER, YEAR,  ISOYEAR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.date_diff_with_errors(
+      date_a=date_a,
+      date_b=date_b,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def date_trunc(date, part, name=None):
   """Returns the whole number of specified part intervals between date_a and date_b.
 
@@ -191,6 +451,32 @@ def date_trunc(date, part, name=None):
   )
 
 
+def date_trunc_with_errors(date, part, max_error_messages=16, name=None):
+  """Like date_trunc, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    part: A string represents the date part. Can be DAY, WEEK,  WEEK_MONDAY,
+      WEEK_TUESDAY, WEEK_WEDNESDAY, WEEK_THURSDAY, WEEK_FRIDAY, WEEK_SATURDAY,
+      ISOWEEK, MONTH, QUARTER, YEAR,  ISOYEAR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.date_trunc_with_errors(
+      date=date,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def format_date(format_string, date, name=None):
   """Returns a date string based on format_string.
 
@@ -208,6 +494,32 @@ def format_date(format_string, date, name=None):
   )
 
 
+def format_date_with_errors(
+    format_string, date, max_error_messages=16, name=None
+):
+  """Like format_date, but reports per-row errors.
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the output string.
+    date: tf.Tensor of type string. Timestamp in "%F" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.format_date_with_errors(
+      format_string=format_string,
+      date=date,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def last_day_from_date(date, part="MONTH", name=None):
   """Returns the last day from a date.
 
@@ -222,6 +534,33 @@ def last_day_from_date(date, part="MONTH", name=None):
   return gen_date_ops.last_day_from_date(date=date, part=part, name=name)
 
 
+def last_day_from_date_with_errors(
+    date, part="MONTH", max_error_messages=16, name=None
+):
+  """Like last_day_from_date, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    part: A string represents the datetime part. Can be WEEK, WEEK(WEEKDAY),
+      ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. It is case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.last_day_from_date_with_errors(
+      date=date,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def parse_date(format_string, date_string, name=None):
   """Returns a date by parsing a string.
 
@@ -239,6 +578,32 @@ def parse_date(format_string, date_string, name=None):
   )
 
 
+def parse_date_with_errors(
+    format_string, date_string, max_error_messages=16, name=None
+):
+  """Like parse_date, but reports per-row errors.
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the string date.
+    date_string: tf.Tensor of type string. Date in any supported format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.parse_date_with_errors(
+      format_string=format_string,
+      date_string=date_string,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def safe_parse_date(format_string, date_string, name=None):
   """Returns a date by safely parsing a string.
 
@@ -257,6 +622,31 @@ def safe_parse_date(format_string, date_string, name=None):
   )
 
 
+@supports_composite_tensors
+def safe_parse_date_with_validity(format_string, date_string, name=None):
+  """Returns dates by safely parsing strings, and whether each one parsed.
+
+  Like safe_parse_date, but unsuccessful parsing produces an empty string and
+  False in the validity tensor instead of "1970-01-01", so that the date
+  1970-01-01 can be told apart from a NULL.
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the string date.
+    date_string: tf.Tensor of type string. Date in any supported format.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, valid) of a string tf.Tensor and a bool tf.Tensor, both
+    with the shape of date_string.
+  """
+  return gen_date_ops.safe_parse_date_with_validity(
+      format_string=format_string,
+      date_string=date_string,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def unix_date(date, name=None):
   """Returns the number of days since 1970-01-01 by converting a date.
 
@@ -270,3 +660,135 @@ def unix_date(date, name=None):
       date=date,
       name=name,
   )
+
+
+def unix_date_with_errors(date, max_error_messages=16, name=None):
+  """Like unix_date, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_date_ops.unix_date_with_errors(
+      date=date,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def extract_from_date_days(date, part, name=None):
+  """Returns the specified part from a date in days since 1970-01-01.
+
+  Native variant of extract_from_date which skips string parsing. Use unix_date
+  to convert a string date to days.
+
+  Equivalent SQL: EXTRACT(part FROM date)
+
+  Args:
+    date: tf.Tensor of type int64. Days since 1970-01-01.
+    part: A string represents the date part. Can be DAYOFWEEK, DAY, DAYOFYEAR,
+      WEEK, WEEK(WEEKDAY), ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. It is case
+      insensitive.
+    name: An optional name for the op.
+  """
+  return gen_date_ops.extract_from_date_days(date=date, part=part, name=name)
+
+
+@supports_composite_tensors
+def date_add_days(date, interval, part, name=None):
+  """Returns a date in days by adding interval to the date.
+
+  Native variant of date_add which skips string parsing and formatting.
+
+  Equivalent SQL: DATE_ADD(date_expression, INTERVAL int64_expression date_part)
+
+  Args:
+    date: tf.Tensor of type int64. Days since 1970-01-01.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the date part. Can be DAY, WEEK, MONTH, QUARTER,
+      YEAR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_date_ops.date_add_days(
+      date=date,
+      interval=interval,
+      part=part,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def date_sub_days(date, interval, part, name=None):
+  """Returns a date in days by subtracting interval to the date.
+
+  Native variant of date_sub which skips string parsing and formatting.
+
+  Equivalent SQL: DATE_SUB(date_expression, INTERVAL int64_expression date_part)
+
+  Args:
+    date: tf.Tensor of type int64. Days since 1970-01-01.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the date part. Can be DAY, WEEK, MONTH, QUARTER,
+      YEAR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_date_ops.date_sub_days(
+      date=date,
+      interval=interval,
+      part=part,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def date_diff_days(date_a, date_b, part, name=None):
+  """Returns the whole number of part intervals between two dates in days.
+
+  Native variant of date_diff which skips string parsing.
+
+  Equivalent SQL: DATE_DIFF(date_expression_a, date_expression_b, date_part)
+
+  Args:
+    date_a: tf.Tensor of type int64. Days since 1970-01-01.
+    date_b: tf.Tensor of type int64. Days since 1970-01-01.
+    part: A string represents the date part. Can be DAY, WEEK, WEEK_MONDAY,
+      WEEK_TUESDAY, WEEK_WEDNESDAY, WEEK_THURSDAY, WEEK_FRIDAY, WEEK_SATURDAY,
+      ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_date_ops.date_diff_days(
+      date_a=date_a,
+      date_b=date_b,
+      part=part,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def date_trunc_days(date, part, name=None):
+  """Returns a date in days truncated to the granularity of part.
+
+  Native variant of date_trunc which skips string parsing and formatting.
+
+  Equivalent SQL: DATE_TRUNC(date_expression, date_part)
+
+  Args:
+    date: tf.Tensor of type int64. Days since 1970-01-01.
+    part: A string represents the date part. Can be DAY, WEEK, WEEK_MONDAY,
+      WEEK_TUESDAY, WEEK_WEDNESDAY, WEEK_THURSDAY, WEEK_FRIDAY, WEEK_SATURDAY,
+      ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_date_ops.date_trunc_days(
+      date=date,
+      part=part,
+      name=name,
+  )
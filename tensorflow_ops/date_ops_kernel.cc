@@ -13,15 +13,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "sql_utils/public/civil_time.h"
 #include "sql_utils/public/functions/cast_date_time.h"
 #include "sql_utils/public/functions/date_time_util.h"
@@ -43,6 +48,7 @@ using ::tensorflow::OpKernel;
 using ::tensorflow::OpKernelConstruction;
 using ::tensorflow::OpKernelContext;
 using ::tensorflow::Tensor;
+using ::tensorflow::TensorShape;
 using ::tensorflow::tstring;
 using ::tensorflow::errors::InvalidArgument;
 using ::tensorflow::errors::OutOfRange;
@@ -79,24 +85,97 @@ class ExtractFromDate : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    const int N = date.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_value;
-      OP_REQUIRES_OK(context, ParseInputDate(date(i), name(), &date_value));
+      TF_RETURN_IF_ERROR(ParseInputDate(date(i), name(), &date_value));
 
       // Extract part from the date.
       int32_t out;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ExtractFromDate(
-                                             part_enum, date_value, &out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractFromDate(part_enum, date_value, &out)));
 
       // Set the output value.
       output_flat(i) = static_cast<int64_t>(out);
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, date, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
+class ExtractPartsFromDate : public OpKernel {
+ public:
+  explicit ExtractPartsFromDate(OpKernelConstruction* context)
+      : OpKernel(context) {
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::DAY, functions::DAYOFWEEK, functions::DAYOFYEAR,
+             functions::WEEK, functions::WEEK_MONDAY, functions::WEEK_TUESDAY,
+             functions::WEEK_WEDNESDAY, functions::WEEK_THURSDAY,
+             functions::WEEK_FRIDAY, functions::WEEK_SATURDAY,
+             functions::ISOWEEK, functions::MONTH, functions::QUARTER,
+             functions::YEAR, functions::ISOYEAR});
+    std::vector<std::string> parts;
+    OP_REQUIRES_OK(context, context->GetAttr("parts", &parts));
+    OP_REQUIRES_OK(context, ParseInputDateTimestampParts(
+                                parts, name(), &parts_, *supported_parts));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the date tensor
+    const Tensor& date_tensor = context->input(0);
+    auto date = date_tensor.flat<tstring>();
+
+    // Create an output tensor with the shape of the date tensor and an
+    // innermost dimension for the parts
+    TensorShape output_shape = date_tensor.shape();
+    output_shape.AddDim(parts_.size());
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape,
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = date.size();
+    const int64_t P = parts_.size();
+    // Each element is parsed once for all the parts.
+    const int64_t cost_per_unit = kParseCost + P * kComputeCost;
+    auto compute_element = [&](int64_t i,
+                               absl::Span<int32_t> out) -> ::tsl::Status {
+      // Parse the date.
+      int32_t date_value;
+      TF_RETURN_IF_ERROR(ParseInputDate(date(i), name(), &date_value));
+
+      // Extract the parts from the date.
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractPartsFromDate(parts_, date_value, out)));
+
+      // Set the output values.
+      for (int64_t j = 0; j < P; j++) {
+        output_flat(i * P + j) = static_cast<int64_t>(out[j]);
+      }
+      return ::tsl::OkStatus();
+    };
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      std::vector<int32_t> out(P);
+      for (int64_t i = start; i < limit; i++) {
+        ::tsl::Status status = compute_element(i, absl::MakeSpan(out));
+        if (!status.ok()) {
+          errors->Add(i - start, std::move(status));
+          return;
+        }
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, cost_per_unit,
+                                              compute_shard));
+  }
+
+ private:
+  std::vector<functions::DateTimestampPart> parts_;
+};
+
 class DateFromComponents : public OpKernel {
  public:
   explicit DateFromComponents(OpKernelConstruction* context)
@@ -127,21 +206,19 @@ class DateFromComponents : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = year.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Construct the date.
       int32_t date;
-      OP_REQUIRES_OK(
-          context, ToTslStatus(name(), functions::ConstructDate(
-                                           year(i), month(i), day(i), &date)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConstructDate(year(i), month(i), day(i), &date)));
 
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -164,30 +241,27 @@ class DateFromTimestamp : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(
-          context,
+      TF_RETURN_IF_ERROR(
           ParseInputTimestamp(timestamp(i), absl::UTCTimeZone(), name(), &ts));
 
       // Extract date from timestamp.
       int32_t date;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::ExtractFromTimestamp(
-                                  functions::DATE, ts, functions::kMicroseconds,
-                                  time_zone, &date)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractFromTimestamp(
+                      functions::DATE, ts, functions::kMicroseconds, time_zone,
+                      &date)));
 
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                     compute_element, output_flat));
   }
 };
 
@@ -207,26 +281,23 @@ class DateFromDatetime : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue dt;
-      OP_REQUIRES_OK(context, ParseInputDatetime(datetime(i), name(), &dt));
+      TF_RETURN_IF_ERROR(ParseInputDatetime(datetime(i), name(), &dt));
 
       // Extract date from datetime.
       int32_t date;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ExtractFromDatetime(
-                                             functions::DATE, dt, &date)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractFromDatetime(functions::DATE, dt, &date)));
 
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, datetime, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -253,30 +324,94 @@ class CastToDateFromString : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = date_string.size();
-    for (int i = 0; i < N; i++) {
-      // Convert string to date.
+    constexpr int64_t kCostPerUnit =
+        2 * kParseCost + kFormatCost + kComputeCost;
+    if (with_format) {
+      // Compile the format once, then convert the strings a shard at a time.
+      std::shared_ptr<const functions::StringToDateCaster> caster;
+      OP_REQUIRES_OK(context, ParseInputCastFormat(format, name(),
+                                                   &caster_cache_, &caster));
+      const int32_t current_date = functions::CurrentDate(absl::UTCTimeZone());
+      auto compute_shard = [&](int64_t start, int64_t limit,
+                               ShardErrors* errors) {
+        // Convert strings with format.
+        std::vector<int32_t> dates(limit - start);
+        errors->AddBatchStatus(caster->CastBatch(
+            ShardStrings(date_string, start, limit), current_date,
+            absl::MakeSpan(dates), errors));
+        // Format dates to string.
+        for (int64_t i = 0; i < limit - start; i++) {
+          errors->Add(
+              i, FormatOutputDate(dates[i], name(), &output_flat(start + i)));
+        }
+      };
+      OP_REQUIRES_OK(context, ParallelForShards(context, name(), N,
+                                                kCostPerUnit, compute_shard));
+      return;
+    }
+
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Convert string without format
       int32_t date;
-      if (with_format) {
-        // Convert string with format
-        int32_t current_date = functions::CurrentDate(absl::UTCTimeZone());
-        OP_REQUIRES_OK(context, ToTslStatus(name(), functions::CastStringToDate(
-                                                        format, date_string(i),
-                                                        current_date, &date)));
-      } else {
-        // Convert string without format
-        OP_REQUIRES_OK(context,
-                       ToTslStatus(name(), functions::ConvertStringToDate(
-                                               date_string(i), &date)));
-      }
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConvertStringToDate(date_string(i), &date)));
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date, name(), &out));
+      TF_RETURN_IF_ERROR(FormatOutputDate(date, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
 
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+ private:
+  CastFormatCache<functions::StringToDateCaster> caster_cache_;
+};
+
+class CastToStringFromDate : public OpKernel {
+ public:
+  explicit CastToStringFromDate(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the date tensor
+    const Tensor& date_tensor = context->input(0);
+    auto date = date_tensor.flat<tstring>();
+    // Grab the format tensor
+    const Tensor& format_tensor = context->input(1);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    std::shared_ptr<const functions::DateToStringCaster> caster;
+    OP_REQUIRES_OK(context, ParseInputCastFormat(format, name(),
+                                                 &caster_cache_, &caster));
+
+    // Create an output tensor with the shape of the date tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, date_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<tstring>();
+
+    const int N = date.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Parse the dates.
+      std::vector<int32_t> dates(limit - start);
+      for (int64_t i = 0; i < limit - start; i++) {
+        errors->Add(i, ParseInputDate(date(start + i), name(), &dates[i]));
+      }
+      // Convert dates to string with format.
+      absl::Span<std::string> out = ThreadLocalOutputBuffers(limit - start);
+      errors->AddBatchStatus(caster->CastBatch(dates, out, errors));
+      // Set the output values.
+      for (int64_t i = 0; i < limit - start; i++) {
+        output_flat(start + i).assign(out[i].data(), out[i].size());
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
   }
+
+ private:
+  CastFormatCache<functions::DateToStringCaster> caster_cache_;
 };
 
 ::tsl::Status DateFromIntOperator(int64_t in, int32_t* out) {
@@ -311,19 +446,18 @@ class DateFromUnixDate : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = num_days.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Convert num_days to date
       int32_t date;
-      OP_REQUIRES_OK(context, DateFromIntOperator(num_days(i), &date));
+      TF_RETURN_IF_ERROR(DateFromIntOperator(num_days(i), &date));
 
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -354,33 +488,32 @@ class DateAdd : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the date tensor
+    // Create an output tensor with the shape of the date tensor, reusing its
+    // buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(0, date_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, date_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = date.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_in;
-      OP_REQUIRES_OK(context, ParseInputDate(date(i), name(), &date_in));
+      TF_RETURN_IF_ERROR(ParseInputDate(date(i), name(), &date_in));
 
       // Add interval.
       int32_t date_out;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::AddDate(date_in, part_enum,
-                                                 interval_int(i), &date_out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::AddDate(date_in, part_enum, interval_int(i), &date_out)));
 
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date_out, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date_out, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -411,33 +544,32 @@ class DateSub : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the date tensor
+    // Create an output tensor with the shape of the date tensor, reusing its
+    // buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(0, date_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, date_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = date.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_in;
-      OP_REQUIRES_OK(context, ParseInputDate(date(i), name(), &date_in));
+      TF_RETURN_IF_ERROR(ParseInputDate(date(i), name(), &date_in));
 
       // Sub interval.
       int32_t date_out;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::AddDate(date_in, part_enum,
-                                                 -interval_int(i), &date_out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::AddDate(date_in, part_enum, -interval_int(i), &date_out)));
 
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date_out, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date_out, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -478,22 +610,26 @@ class DateDiff : public OpKernel {
     auto output_flat = output_tensor->flat<int64_t>();
 
     const int N = date_a.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = 2 * kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_a_int;
-      OP_REQUIRES_OK(context, ParseInputDate(date_a(i), name(), &date_a_int));
+      TF_RETURN_IF_ERROR(ParseInputDate(date_a(i), name(), &date_a_int));
       int32_t date_b_int;
-      OP_REQUIRES_OK(context, ParseInputDate(date_b(i), name(), &date_b_int));
+      TF_RETURN_IF_ERROR(ParseInputDate(date_b(i), name(), &date_b_int));
 
       // Compute diff.
       int32_t out;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::DiffDates(
-                                                      date_a_int, date_b_int,
-                                                      part_enum, &out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::DiffDates(date_a_int, date_b_int, part_enum, &out)));
 
       // Set the output value.
       output_flat(i) = out;
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -519,32 +655,42 @@ class DateTrunc : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the date tensor
+    // Create an output tensor with the shape of the date tensor, reusing its
+    // buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(0, date_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, date_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = date.size();
-    for (int i = 0; i < N; i++) {
-      // Parse the date.
-      int32_t date_in;
-      OP_REQUIRES_OK(context, ParseInputDate(date(i), name(), &date_in));
-
-      // Truncate date.
-      int32_t date_out;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::TruncateDate(
-                                             date_in, part_enum, &date_out)));
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Parse the dates. A date that fails to parse is truncated as 0, and its
+      // output is reset with the other failing rows.
+      std::vector<int32_t> date_in(limit - start);
+      for (int64_t i = start; i < limit; i++) {
+        ::tsl::Status status =
+            ParseInputDate(date(i), name(), &date_in[i - start]);
+        if (!status.ok()) {
+          date_in[i - start] = 0;
+          errors->Add(i - start, std::move(status));
+        }
+      }
 
-      // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date_out, name(), &out));
+      // Truncate the dates as a batch.
+      std::vector<int32_t> date_out(limit - start);
+      errors->AddBatchStatus(functions::TruncateDates(
+          date_in, part_enum, absl::MakeSpan(date_out), errors));
 
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      // Format dates to string.
+      for (int64_t i = start; i < limit; i++) {
+        errors->Add(i - start, FormatOutputDate(date_out[i - start], name(),
+                                                &output_flat(i)));
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
   }
 };
 
@@ -555,7 +701,10 @@ class FormatDate : public OpKernel {
   void Compute(OpKernelContext* context) override {
     // Grab the format string tensor
     const Tensor& format_tensor = context->input(0);
-    std::string format = format_tensor.flat<tstring>()(0);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    std::shared_ptr<const functions::DateFormatter> formatter;
+    OP_REQUIRES_OK(context, ParseInputFormat(format, name(), &format_cache_,
+                                             &formatter));
     // Grab the date tensor
     const Tensor& date_tensor = context->input(1);
     auto date = date_tensor.flat<tstring>();
@@ -566,25 +715,27 @@ class FormatDate : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = date.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_int;
-      OP_REQUIRES_OK(context, ParseInputDate(date(i), name(), &date_int));
+      TF_RETURN_IF_ERROR(ParseInputDate(date(i), name(), &date_int));
 
       // Format date based on format.
-      std::string out;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::FormatDateToString(
-                                  format, date_int,
-                                  {.expand_Q = true, .expand_J = true}, &out)));
+      std::string& out = ThreadLocalOutputBuffer();
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), formatter->Format(date_int, &out)));
 
       // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      output_flat(i).assign(out.data(), out.size());
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, date, kCostPerUnit,
+                                                compute_element, output_flat));
   }
+
+ private:
+  DateFormatterCache format_cache_;
 };
 
 class LastDayFromDate : public OpKernel {
@@ -618,31 +769,30 @@ class LastDayFromDate : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the date tensor.
+    // Create an output tensor with the shape of the date tensor, reusing its
+    // buffer when no other op needs it.
     Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(context, context->allocate_output(0, date_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, date_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = date.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_value;
-      OP_REQUIRES_OK(context, ParseInputDate(date(i), name(), &date_value));
+      TF_RETURN_IF_ERROR(ParseInputDate(date(i), name(), &date_value));
 
       // Extract LAST_DAY from the datetime value.
       int32_t date_int;
-      OP_REQUIRES_OK(
-          context, ToTslStatus(name(), functions::LastDayOfDate(
-                                           date_value, part_enum, &date_int)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::LastDayOfDate(date_value, part_enum, &date_int)));
 
       // Set the output value.
-      std::string output_str;
-      OP_REQUIRES_OK(context, FormatOutputDate(date_int, name(), &output_str));
-
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date_int, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, date, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -664,23 +814,20 @@ class ParseDate : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = date.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_in;
-      OP_REQUIRES_OK(
-          context, ToTslStatus(name(), functions::ParseStringToDate(
-                                           format, date(i),
-                                           /*parse_version2=*/true, &date_in)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ParseStringToDate(
+                      format, date(i), /*parse_version2=*/true, &date_in)));
 
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date_in, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date_in, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, date, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -702,29 +849,44 @@ class SafeParseDate : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
+    // SafeParseDateWithValidity reports failures in a second output instead
+    // of with the NULL-equivalent value.
+    bool* valid = nullptr;
+    int32_t null_date = 0;
+    if (num_outputs() > 1) {
+      Tensor* valid_tensor = nullptr;
+      OP_REQUIRES_OK(context, context->allocate_output(1, date_tensor.shape(),
+                                                       &valid_tensor));
+      valid = valid_tensor->flat<bool>().data();
+    } else {
+      OP_REQUIRES_OK(context,
+                     ToTslStatus(name(), functions::ParseStringToDate(
+                                             kDateFormatString, kNullDate,
+                                             /*parse_version2=*/true,
+                                             &null_date)));
+    }
+
     const int N = date.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_in;
-      if (!functions::ParseStringToDate(format, date(i),
-                                        /*parse_version2=*/true, &date_in)
-               .ok()) {
+      const bool parsed = functions::TryParseStringToDate(
+          format, date(i), /*parse_version2=*/true, &date_in);
+      if (valid != nullptr) {
+        valid[i] = parsed;
+        if (!parsed) return ::tsl::OkStatus();
+      } else if (!parsed) {
         // Set the NULL-equivalent output value for unsuccessful parsing
-        OP_REQUIRES_OK(
-            context,
-            ToTslStatus(name(), functions::ParseStringToDate(
-                                    kDateFormatString, kNullDate,
-                                    /*parse_version2=*/true, &date_in)));
+        date_in = null_date;
       }
 
       // Format date to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDate(date_in, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date_in, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -743,11 +905,11 @@ class UnixDate : public OpKernel {
                                 0, date_string_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    const int N = date_string.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date;
-      OP_REQUIRES_OK(context, ParseInputDate(date_string(i), name(), &date));
+      TF_RETURN_IF_ERROR(ParseInputDate(date_string(i), name(), &date));
 
       // Convert date to days.
       int64_t out;
@@ -755,33 +917,385 @@ class UnixDate : public OpKernel {
 
       // Set the output value.
       output_flat(i) = out;
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, date_string, kCostPerUnit,
+                                     compute_element, output_flat));
+  }
+};
+
+class ExtractFromDateDays : public OpKernel {
+ public:
+  explicit ExtractFromDateDays(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the date tensor.
+    const Tensor& date_tensor = context->input(0);
+    auto date = date_tensor.flat<int64_t>();
+
+    // Grab the part tensor.
+    const Tensor& part_tensor = context->input(1);
+    std::string part = absl::AsciiStrToLower(part_tensor.flat<tstring>()(0));
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::DAY, functions::DAYOFWEEK, functions::DAYOFYEAR,
+             functions::WEEK, functions::WEEK_MONDAY, functions::WEEK_TUESDAY,
+             functions::WEEK_WEDNESDAY, functions::WEEK_THURSDAY,
+             functions::WEEK_FRIDAY, functions::WEEK_SATURDAY,
+             functions::ISOWEEK, functions::MONTH, functions::QUARTER,
+             functions::YEAR, functions::ISOYEAR});
+    functions::DateTimestampPart part_enum;
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the date tensor.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, date_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = date.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Validate the dates.
+      std::vector<int32_t> date_values;
+      ::tsl::Status status;
+      const int64_t num_valid = ParseInputDateDays(
+          absl::MakeConstSpan(date.data() + start, limit - start), name(),
+          &date_values, &status);
+      errors->Add(num_valid, status);
+
+      // Extract part from the dates.
+      std::vector<int32_t> out(num_valid);
+      errors->AddBatchStatus(functions::ExtractFromDates(
+          part_enum, date_values, absl::MakeSpan(out), errors));
+
+      // Set the output values.
+      for (int64_t i = 0; i < num_valid; i++) {
+        output_flat(start + i) = static_cast<int64_t>(out[i]);
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
+  }
+};
+
+class DateAddDays : public OpKernel {
+ public:
+  explicit DateAddDays(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the date tensor
+    const Tensor& date_tensor = context->input(0);
+    auto date = date_tensor.flat<int64_t>();
+    // Grab the interval tensor
+    const Tensor& interval_tensor = context->input(1);
+    auto interval_int = interval_tensor.flat<int64_t>();
+    OP_REQUIRES(context, date.size() == interval_int.size(),
+                InvalidArgument(absl::Substitute(
+                    "Error in $0: date and interval must have the same shape, "
+                    "but are $1, $2",
+                    name(), date.size(), interval_int.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::DAY, functions::WEEK, functions::MONTH,
+             functions::QUARTER, functions::YEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the date tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, date_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = date.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Validate the dates.
+      std::vector<int32_t> date_in;
+      ::tsl::Status status;
+      const int64_t num_valid = ParseInputDateDays(
+          absl::MakeConstSpan(date.data() + start, limit - start), name(),
+          &date_in, &status);
+      errors->Add(num_valid, status);
+
+      // Add intervals.
+      std::vector<int32_t> date_out(num_valid);
+      errors->AddBatchStatus(functions::AddDates(
+          date_in, part_enum,
+          absl::MakeConstSpan(interval_int.data() + start, num_valid),
+          absl::MakeSpan(date_out), errors));
+
+      // Set the output values.
+      for (int64_t i = 0; i < num_valid; i++) {
+        output_flat(start + i) = static_cast<int64_t>(date_out[i]);
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
+  }
+};
+
+class DateSubDays : public OpKernel {
+ public:
+  explicit DateSubDays(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the date tensor
+    const Tensor& date_tensor = context->input(0);
+    auto date = date_tensor.flat<int64_t>();
+    // Grab the interval tensor
+    const Tensor& interval_tensor = context->input(1);
+    auto interval_int = interval_tensor.flat<int64_t>();
+    OP_REQUIRES(context, date.size() == interval_int.size(),
+                InvalidArgument(absl::Substitute(
+                    "Error in $0: date and interval must have the same shape, "
+                    "but are $1, $2",
+                    name(), date.size(), interval_int.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::DAY, functions::WEEK, functions::MONTH,
+             functions::QUARTER, functions::YEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the date tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, date_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = date.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Validate the dates.
+      std::vector<int32_t> date_in;
+      ::tsl::Status status;
+      const int64_t num_valid = ParseInputDateDays(
+          absl::MakeConstSpan(date.data() + start, limit - start), name(),
+          &date_in, &status);
+      errors->Add(num_valid, status);
+
+      // Sub intervals.
+      std::vector<int32_t> date_out(num_valid);
+      errors->AddBatchStatus(functions::SubDates(
+          date_in, part_enum,
+          absl::MakeConstSpan(interval_int.data() + start, num_valid),
+          absl::MakeSpan(date_out), errors));
+
+      // Set the output values.
+      for (int64_t i = 0; i < num_valid; i++) {
+        output_flat(start + i) = static_cast<int64_t>(date_out[i]);
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
+  }
+};
+
+class DateDiffDays : public OpKernel {
+ public:
+  explicit DateDiffDays(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the date_a tensor
+    const Tensor& date_a_tensor = context->input(0);
+    auto date_a = date_a_tensor.flat<int64_t>();
+    // Grab the date_b tensor
+    const Tensor& date_b_tensor = context->input(1);
+    auto date_b = date_b_tensor.flat<int64_t>();
+    OP_REQUIRES(context, date_a.size() == date_b.size(),
+                InvalidArgument(absl::Substitute(
+                    "Error in $0: date_a and date_b must have the same shape, "
+                    "but are $1, $2",
+                    name(), date_a.size(), date_b.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::DAY, functions::WEEK, functions::WEEK_MONDAY,
+             functions::WEEK_TUESDAY, functions::WEEK_WEDNESDAY,
+             functions::WEEK_THURSDAY, functions::WEEK_FRIDAY,
+             functions::WEEK_SATURDAY, functions::ISOWEEK, functions::MONTH,
+             functions::QUARTER, functions::YEAR, functions::ISOYEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the date tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, date_a_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = date_a.size();
+    constexpr int64_t kCostPerUnit = 2 * kParseCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Validate the dates.
+      std::vector<int32_t> date_a_int;
+      ::tsl::Status status_a;
+      const int64_t num_valid_a = ParseInputDateDays(
+          absl::MakeConstSpan(date_a.data() + start, limit - start), name(),
+          &date_a_int, &status_a);
+      std::vector<int32_t> date_b_int;
+      ::tsl::Status status_b;
+      const int64_t num_valid_b = ParseInputDateDays(
+          absl::MakeConstSpan(date_b.data() + start, limit - start), name(),
+          &date_b_int, &status_b);
+      errors->Add(num_valid_a, status_a);
+      errors->Add(num_valid_b, status_b);
+      const int64_t num_valid = std::min(num_valid_a, num_valid_b);
+      date_a_int.resize(num_valid);
+      date_b_int.resize(num_valid);
+
+      // Compute diffs.
+      std::vector<int32_t> out(num_valid);
+      errors->AddBatchStatus(functions::DiffDates(
+          date_a_int, date_b_int, part_enum, absl::MakeSpan(out), errors));
+
+      // Set the output values.
+      for (int64_t i = 0; i < num_valid; i++) {
+        output_flat(start + i) = out[i];
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
+  }
+};
+
+class DateTruncDays : public OpKernel {
+ public:
+  explicit DateTruncDays(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the date tensor
+    const Tensor& date_tensor = context->input(0);
+    auto date = date_tensor.flat<int64_t>();
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(1);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::DAY, functions::WEEK, functions::WEEK_MONDAY,
+             functions::WEEK_TUESDAY, functions::WEEK_WEDNESDAY,
+             functions::WEEK_THURSDAY, functions::WEEK_FRIDAY,
+             functions::WEEK_SATURDAY, functions::ISOWEEK, functions::MONTH,
+             functions::QUARTER, functions::YEAR, functions::ISOYEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the date tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, date_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = date.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Validate the dates.
+      std::vector<int32_t> date_in;
+      ::tsl::Status status;
+      const int64_t num_valid = ParseInputDateDays(
+          absl::MakeConstSpan(date.data() + start, limit - start), name(),
+          &date_in, &status);
+      errors->Add(num_valid, status);
+
+      // Truncate dates.
+      std::vector<int32_t> date_out(num_valid);
+      errors->AddBatchStatus(functions::TruncateDates(
+          date_in, part_enum, absl::MakeSpan(date_out), errors));
+
+      // Set the output values.
+      for (int64_t i = 0; i < num_valid; i++) {
+        output_flat(start + i) = static_cast<int64_t>(date_out[i]);
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
   }
 };
 
 // Register the kernels
 REGISTER_KERNEL_BUILDER(Name("ExtractFromDate").Device(DEVICE_CPU),
                         ExtractFromDate);
+REGISTER_KERNEL_BUILDER(Name("ExtractFromDateWithErrors").Device(DEVICE_CPU),
+                        ExtractFromDate);
+REGISTER_KERNEL_BUILDER(Name("ExtractPartsFromDate").Device(DEVICE_CPU),
+                        ExtractPartsFromDate);
 REGISTER_KERNEL_BUILDER(Name("DateFromComponents").Device(DEVICE_CPU),
                         DateFromComponents);
 REGISTER_KERNEL_BUILDER(Name("DateFromTimestamp").Device(DEVICE_CPU),
                         DateFromTimestamp);
+REGISTER_KERNEL_BUILDER(Name("DateFromTimestampWithErrors").Device(DEVICE_CPU),
+                        DateFromTimestamp);
 REGISTER_KERNEL_BUILDER(Name("DateFromDatetime").Device(DEVICE_CPU),
                         DateFromDatetime);
+REGISTER_KERNEL_BUILDER(Name("DateFromDatetimeWithErrors").Device(DEVICE_CPU),
+                        DateFromDatetime);
 REGISTER_KERNEL_BUILDER(Name("CastToDateFromString").Device(DEVICE_CPU),
                         CastToDateFromString);
+REGISTER_KERNEL_BUILDER(
+    Name("CastToDateFromStringWithErrors").Device(DEVICE_CPU),
+    CastToDateFromString);
+REGISTER_KERNEL_BUILDER(Name("CastToStringFromDate").Device(DEVICE_CPU),
+                        CastToStringFromDate);
+REGISTER_KERNEL_BUILDER(
+    Name("CastToStringFromDateWithErrors").Device(DEVICE_CPU),
+    CastToStringFromDate);
 REGISTER_KERNEL_BUILDER(Name("DateFromUnixDate").Device(DEVICE_CPU),
                         DateFromUnixDate);
 REGISTER_KERNEL_BUILDER(Name("DateAdd").Device(DEVICE_CPU), DateAdd);
+REGISTER_KERNEL_BUILDER(Name("DateAddWithErrors").Device(DEVICE_CPU), DateAdd);
 REGISTER_KERNEL_BUILDER(Name("DateSub").Device(DEVICE_CPU), DateSub);
+REGISTER_KERNEL_BUILDER(Name("DateSubWithErrors").Device(DEVICE_CPU), DateSub);
 REGISTER_KERNEL_BUILDER(Name("DateDiff").Device(DEVICE_CPU), DateDiff);
+REGISTER_KERNEL_BUILDER(Name("DateDiffWithErrors").Device(DEVICE_CPU),
+                        DateDiff);
 REGISTER_KERNEL_BUILDER(Name("DateTrunc").Device(DEVICE_CPU), DateTrunc);
+REGISTER_KERNEL_BUILDER(Name("DateTruncWithErrors").Device(DEVICE_CPU),
+                        DateTrunc);
 REGISTER_KERNEL_BUILDER(Name("FormatDate").Device(DEVICE_CPU), FormatDate);
+REGISTER_KERNEL_BUILDER(Name("FormatDateWithErrors").Device(DEVICE_CPU),
+                        FormatDate);
 REGISTER_KERNEL_BUILDER(Name("LastDayFromDate").Device(DEVICE_CPU),
                         LastDayFromDate);
+REGISTER_KERNEL_BUILDER(Name("LastDayFromDateWithErrors").Device(DEVICE_CPU),
+                        LastDayFromDate);
 REGISTER_KERNEL_BUILDER(Name("ParseDate").Device(DEVICE_CPU), ParseDate);
+REGISTER_KERNEL_BUILDER(Name("ParseDateWithErrors").Device(DEVICE_CPU),
+                        ParseDate);
 REGISTER_KERNEL_BUILDER(Name("SafeParseDate").Device(DEVICE_CPU),
                         SafeParseDate);
+REGISTER_KERNEL_BUILDER(
+    Name("SafeParseDateWithValidity").Device(DEVICE_CPU), SafeParseDate);
 REGISTER_KERNEL_BUILDER(Name("UnixDate").Device(DEVICE_CPU), UnixDate);
+REGISTER_KERNEL_BUILDER(Name("UnixDateWithErrors").Device(DEVICE_CPU),
+                        UnixDate);
+REGISTER_KERNEL_BUILDER(Name("ExtractFromDateDays").Device(DEVICE_CPU),
+                        ExtractFromDateDays);
+REGISTER_KERNEL_BUILDER(Name("DateAddDays").Device(DEVICE_CPU), DateAddDays);
+REGISTER_KERNEL_BUILDER(Name("DateSubDays").Device(DEVICE_CPU), DateSubDays);
+REGISTER_KERNEL_BUILDER(Name("DateDiffDays").Device(DEVICE_CPU), DateDiffDays);
+REGISTER_KERNEL_BUILDER(Name("DateTruncDays").Device(DEVICE_CPU),
+                        DateTruncDays);
 
 }  // namespace bigquery_ml_utils
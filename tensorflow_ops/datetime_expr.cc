@@ -0,0 +1,413 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tensorflow_ops/datetime_expr.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/substitute.h"
+#include "absl/time/time.h"
+#include "sql_utils/public/civil_time.h"
+#include "sql_utils/public/functions/date_time_util.h"
+#include "sql_utils/public/functions/datetime.pb.h"
+#include "sql_utils/public/functions/datetime_expr.pb.h"
+#include "sql_utils/public/functions/parse_date_time.h"
+#include "tensorflow_ops/utils.h"
+#include "tensorflow/tsl/platform/errors.h"
+#include "tensorflow/tsl/platform/status.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/tstring.h"
+
+namespace bigquery_ml_utils {
+
+using ::tensorflow::errors::InvalidArgument;
+
+namespace {
+
+using Program = functions::DateTimeExprProgram;
+using PartSet = absl::flat_hash_set<functions::DateTimestampPart>;
+
+// Microseconds kept by the "%E1S" of the canonical timestamp format.
+constexpr int64_t kCanonicalTimestampPrecision = 100000;
+
+}  // namespace
+
+const PartSet& SupportedAddParts(Program::ValueType type) {
+  static const auto* timestamp_parts =
+      new PartSet({functions::MICROSECOND, functions::MILLISECOND,
+                   functions::SECOND, functions::MINUTE, functions::HOUR,
+                   functions::DAY});
+  static const auto* date_parts =
+      new PartSet({functions::DAY, functions::WEEK, functions::MONTH,
+                   functions::QUARTER, functions::YEAR});
+  static const auto* datetime_parts = new PartSet(
+      {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+       functions::MINUTE, functions::HOUR, functions::DAY, functions::WEEK,
+       functions::MONTH, functions::QUARTER, functions::YEAR});
+  switch (type) {
+    case Program::TIMESTAMP:
+      return *timestamp_parts;
+    case Program::DATE:
+      return *date_parts;
+    default:
+      return *datetime_parts;
+  }
+}
+
+const PartSet& SupportedTruncParts(Program::ValueType type) {
+  static const auto* date_parts = new PartSet(
+      {functions::DAY, functions::WEEK, functions::WEEK_MONDAY,
+       functions::WEEK_TUESDAY, functions::WEEK_WEDNESDAY,
+       functions::WEEK_THURSDAY, functions::WEEK_FRIDAY,
+       functions::WEEK_SATURDAY, functions::ISOWEEK, functions::MONTH,
+       functions::QUARTER, functions::YEAR, functions::ISOYEAR});
+  static const auto* timestamp_parts = new PartSet(
+      {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+       functions::MINUTE, functions::HOUR, functions::DAY, functions::WEEK,
+       functions::WEEK_MONDAY, functions::WEEK_TUESDAY,
+       functions::WEEK_WEDNESDAY, functions::WEEK_THURSDAY,
+       functions::WEEK_FRIDAY, functions::WEEK_SATURDAY, functions::ISOWEEK,
+       functions::MONTH, functions::QUARTER, functions::YEAR,
+       functions::ISOYEAR});
+  return type == Program::DATE ? *date_parts : *timestamp_parts;
+}
+
+const PartSet& SupportedExtractParts(Program::ValueType type) {
+  static const auto* date_parts = new PartSet(
+      {functions::DAY, functions::DAYOFWEEK, functions::DAYOFYEAR,
+       functions::WEEK, functions::WEEK_MONDAY, functions::WEEK_TUESDAY,
+       functions::WEEK_WEDNESDAY, functions::WEEK_THURSDAY,
+       functions::WEEK_FRIDAY, functions::WEEK_SATURDAY, functions::ISOWEEK,
+       functions::MONTH, functions::QUARTER, functions::YEAR,
+       functions::ISOYEAR});
+  static const auto* timestamp_parts = new PartSet(
+      {functions::MICROSECOND,   functions::MILLISECOND,
+       functions::SECOND,        functions::MINUTE,
+       functions::HOUR,          functions::DAYOFWEEK,
+       functions::DAY,           functions::DAYOFYEAR,
+       functions::WEEK,          functions::WEEK_MONDAY,
+       functions::WEEK_TUESDAY,  functions::WEEK_WEDNESDAY,
+       functions::WEEK_THURSDAY, functions::WEEK_FRIDAY,
+       functions::WEEK_SATURDAY, functions::ISOWEEK,
+       functions::MONTH,         functions::QUARTER,
+       functions::YEAR,          functions::ISOYEAR});
+  return type == Program::DATE ? *date_parts : *timestamp_parts;
+}
+
+::tsl::Status CompiledDateTimeExpr::Compile(const Program& program,
+                                            absl::string_view function_name) {
+  function_name_ = std::string(function_name);
+  type_ = program.type();
+  if (type_ != Program::TIMESTAMP && type_ != Program::DATE &&
+      type_ != Program::DATETIME) {
+    return InvalidArgument(
+        absl::Substitute("Unsupported value type in $0: $1", function_name_,
+                         Program::ValueType_Name(type_)));
+  }
+  if (program.steps().empty() || !program.steps(0).has_parse()) {
+    return InvalidArgument(absl::Substitute(
+        "The first step of the program must be a parse in $0",
+        function_name_));
+  }
+  steps_.clear();
+  for (int s = 0; s < program.steps_size(); s++) {
+    const Program::Step& step = program.steps(s);
+    if (s > 0 && (steps_.back().kind == Program::Step::kExtract ||
+                  steps_.back().kind == Program::Step::kFormat)) {
+      return InvalidArgument(absl::Substitute(
+          "Extract and format must be the last step of the program in $0",
+          function_name_));
+    }
+    if (s > 0 && step.has_parse()) {
+      return InvalidArgument(absl::Substitute(
+          "Parse must be the first step of the program in $0",
+          function_name_));
+    }
+    Step compiled;
+    TF_RETURN_IF_ERROR(CompileStep(step, &compiled));
+    steps_.push_back(std::move(compiled));
+  }
+  output_int64_ = steps_.back().kind == Program::Step::kExtract;
+  return ::tsl::OkStatus();
+}
+
+::tsl::Status CompiledDateTimeExpr::CompileStep(const Program::Step& step,
+                                                Step* compiled) {
+  compiled->kind = step.step_case();
+  switch (step.step_case()) {
+    case Program::Step::kParse:
+      compiled->format = step.parse().format();
+      compiled->cast = step.parse().cast();
+      compiled->allow_tz_in_str = step.parse().allow_tz_in_str();
+      if (compiled->cast && type_ != Program::TIMESTAMP) {
+        return InvalidArgument(absl::Substitute(
+            "Cast parse is only supported for timestamps in $0",
+            function_name_));
+      }
+      return ParseInputTimeZone(step.parse().time_zone(), function_name_,
+                                &time_zone_cache_, &compiled->time_zone);
+    case Program::Step::kAdd:
+      compiled->part = step.add().part();
+      compiled->interval = step.add().interval();
+      return CheckPart(compiled->part, SupportedAddParts(type_));
+    case Program::Step::kTrunc:
+      compiled->part = step.trunc().part();
+      TF_RETURN_IF_ERROR(
+          CheckPart(compiled->part, SupportedTruncParts(type_)));
+      return ParseInputTimeZone(step.trunc().time_zone(), function_name_,
+                                &time_zone_cache_, &compiled->time_zone);
+    case Program::Step::kExtract:
+      compiled->part = step.extract().part();
+      TF_RETURN_IF_ERROR(
+          CheckPart(compiled->part, SupportedExtractParts(type_)));
+      return ParseInputTimeZone(step.extract().time_zone(), function_name_,
+                                &time_zone_cache_, &compiled->time_zone);
+    case Program::Step::kFormat:
+      compiled->cast = step.format().cast();
+      TF_RETURN_IF_ERROR(ParseInputTimeZone(step.format().time_zone(),
+                                            function_name_, &time_zone_cache_,
+                                            &compiled->time_zone));
+      if (compiled->cast) {
+        if (type_ != Program::TIMESTAMP) {
+          return InvalidArgument(absl::Substitute(
+              "Cast format is only supported for timestamps in $0",
+              function_name_));
+        }
+        return ::tsl::OkStatus();
+      }
+      switch (type_) {
+        case Program::TIMESTAMP:
+          return ParseInputFormat(step.format().format(), function_name_,
+                                  &timestamp_format_cache_,
+                                  &compiled->timestamp_formatter);
+        case Program::DATE:
+          return ParseInputFormat(step.format().format(), function_name_,
+                                  &date_format_cache_,
+                                  &compiled->date_formatter);
+        default:
+          return ParseInputFormat(step.format().format(), function_name_,
+                                  &datetime_format_cache_,
+                                  &compiled->datetime_formatter);
+      }
+    case Program::Step::kCanonicalize:
+      return ::tsl::OkStatus();
+    default:
+      return InvalidArgument(absl::Substitute(
+          "A step of the program is not set in $0", function_name_));
+  }
+}
+
+::tsl::Status CompiledDateTimeExpr::CheckPart(
+    functions::DateTimestampPart part, const PartSet& supported_parts) const {
+  if (!supported_parts.contains(part)) {
+    return InvalidArgument(
+        absl::Substitute("Unsupported part in $0: $1", function_name_,
+                         functions::DateTimestampPart_Name(part)));
+  }
+  return ::tsl::OkStatus();
+}
+
+::tsl::Status CompiledDateTimeExpr::Evaluate(
+    absl::string_view input, int64_t* int64_out,
+    ::tensorflow::tstring* string_out) const {
+  Value value;
+  for (const Step& step : steps_) {
+    switch (step.kind) {
+      case Program::Step::kParse:
+        TF_RETURN_IF_ERROR(Parse(step, input, &value));
+        break;
+      case Program::Step::kAdd:
+        TF_RETURN_IF_ERROR(Add(step, &value));
+        break;
+      case Program::Step::kTrunc:
+        TF_RETURN_IF_ERROR(Trunc(step, &value));
+        break;
+      case Program::Step::kCanonicalize:
+        Canonicalize(&value);
+        break;
+      case Program::Step::kExtract: {
+        int32_t out;
+        TF_RETURN_IF_ERROR(Extract(step, value, &out));
+        // Currently, BQML util inference only supports int64.
+        *int64_out = static_cast<int64_t>(out);
+        return ::tsl::OkStatus();
+      }
+      case Program::Step::kFormat: {
+        std::string& out = ThreadLocalOutputBuffer();
+        TF_RETURN_IF_ERROR(Format(step, value, &out));
+        string_out->assign(out.data(), out.size());
+        return ::tsl::OkStatus();
+      }
+      default:
+        break;
+    }
+  }
+  // Without a final extract or format step, output the canonical string.
+  switch (type_) {
+    case Program::TIMESTAMP:
+      return FormatOutputTimestamp(value.timestamp, function_name_,
+                                   string_out);
+    case Program::DATE:
+      return FormatOutputDate(value.date, function_name_, string_out);
+    default:
+      return FormatOutputDatetime(value.datetime, function_name_, string_out);
+  }
+}
+
+::tsl::Status CompiledDateTimeExpr::Parse(const Step& step,
+                                          absl::string_view input,
+                                          Value* value) const {
+  switch (type_) {
+    case Program::TIMESTAMP:
+      if (step.cast) {
+        return ToTslStatus(function_name_,
+                           functions::ConvertStringToTimestamp(
+                               input, step.time_zone, functions::kMicroseconds,
+                               step.allow_tz_in_str, &value->timestamp));
+      }
+      if (step.format.empty()) {
+        return ParseInputTimestamp(input, step.time_zone, function_name_,
+                                   &value->timestamp);
+      }
+      return ToTslStatus(
+          function_name_,
+          functions::ParseStringToTimestamp(step.format, input, step.time_zone,
+                                            /*parse_version2=*/true,
+                                            &value->timestamp));
+    case Program::DATE:
+      if (step.format.empty()) {
+        return ParseInputDate(input, function_name_, &value->date);
+      }
+      return ToTslStatus(
+          function_name_,
+          functions::ParseStringToDate(step.format, input,
+                                       /*parse_version2=*/true, &value->date));
+    default:
+      if (step.format.empty()) {
+        return ParseInputDatetime(input, function_name_, &value->datetime);
+      }
+      return ToTslStatus(
+          function_name_,
+          functions::ParseStringToDatetime(
+              step.format, input, functions::kMicroseconds,
+              /*parse_version2=*/true, &value->datetime));
+  }
+}
+
+::tsl::Status CompiledDateTimeExpr::Add(const Step& step, Value* value) const {
+  switch (type_) {
+    case Program::TIMESTAMP:
+      // Like TimestampAdd, the parts are fixed durations independent of the
+      // time zone.
+      return ToTslStatus(
+          function_name_,
+          functions::AddTimestamp(value->timestamp, functions::kMicroseconds,
+                                  absl::UTCTimeZone(), step.part,
+                                  step.interval, &value->timestamp));
+    case Program::DATE:
+      return ToTslStatus(function_name_,
+                         functions::AddDate(value->date, step.part,
+                                            step.interval, &value->date));
+    default: {
+      DatetimeValue out;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          function_name_, functions::AddDatetime(value->datetime, step.part,
+                                                 step.interval, &out)));
+      value->datetime = out;
+      return ::tsl::OkStatus();
+    }
+  }
+}
+
+::tsl::Status CompiledDateTimeExpr::Trunc(const Step& step,
+                                          Value* value) const {
+  switch (type_) {
+    case Program::TIMESTAMP:
+      return ToTslStatus(
+          function_name_,
+          functions::TruncateTimestamp(value->timestamp,
+                                       functions::kMicroseconds,
+                                       step.time_zone, step.part,
+                                       &value->timestamp));
+    case Program::DATE:
+      return ToTslStatus(
+          function_name_,
+          functions::TruncateDate(value->date, step.part, &value->date));
+    default: {
+      DatetimeValue out;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          function_name_,
+          functions::TruncateDatetime(value->datetime, step.part, &out)));
+      value->datetime = out;
+      return ::tsl::OkStatus();
+    }
+  }
+}
+
+::tsl::Status CompiledDateTimeExpr::Extract(const Step& step,
+                                            const Value& value,
+                                            int32_t* out) const {
+  switch (type_) {
+    case Program::TIMESTAMP:
+      return ToTslStatus(function_name_,
+                         functions::ExtractFromTimestamp(
+                             step.part, value.timestamp,
+                             functions::kMicroseconds, step.time_zone, out));
+    case Program::DATE:
+      return ToTslStatus(function_name_, functions::ExtractFromDate(
+                                             step.part, value.date, out));
+    default:
+      return ToTslStatus(function_name_, functions::ExtractFromDatetime(
+                                             step.part, value.datetime, out));
+  }
+}
+
+::tsl::Status CompiledDateTimeExpr::Format(const Step& step,
+                                           const Value& value,
+                                           std::string* out) const {
+  switch (type_) {
+    case Program::TIMESTAMP:
+      if (step.cast) {
+        return ToTslStatus(
+            function_name_,
+            functions::ConvertTimestampMicrosToStringWithTruncation(
+                value.timestamp, step.time_zone, out));
+      }
+      return ToTslStatus(function_name_, step.timestamp_formatter->Format(
+                                             value.timestamp, step.time_zone,
+                                             out));
+    case Program::DATE:
+      return ToTslStatus(function_name_,
+                         step.date_formatter->Format(value.date, out));
+    default:
+      return ToTslStatus(function_name_,
+                         step.datetime_formatter->Format(value.datetime, out));
+  }
+}
+
+void CompiledDateTimeExpr::Canonicalize(Value* value) const {
+  if (type_ != Program::TIMESTAMP) return;
+  // Round towards negative infinity, like FormatOutputTimestamp.
+  int64_t remainder = value->timestamp % kCanonicalTimestampPrecision;
+  if (remainder < 0) remainder += kCanonicalTimestampPrecision;
+  value->timestamp -= remainder;
+}
+
+}  // namespace bigquery_ml_utils
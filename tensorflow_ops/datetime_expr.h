@@ -0,0 +1,120 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef THIRD_PARTY_PY_BIGQUERY_ML_UTILS_TENSORFLOW_OPS_DATETIME_EXPR_H_
+#define THIRD_PARTY_PY_BIGQUERY_ML_UTILS_TENSORFLOW_OPS_DATETIME_EXPR_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "sql_utils/public/civil_time.h"
+#include "sql_utils/public/functions/date_time_util.h"
+#include "sql_utils/public/functions/datetime.pb.h"
+#include "sql_utils/public/functions/datetime_expr.pb.h"
+#include "tensorflow_ops/utils.h"
+#include "tensorflow/tsl/platform/status.h"
+#include "tensorflow/core/platform/tstring.h"
+
+namespace bigquery_ml_utils {
+
+// The parts supported by the add, trunc and extract steps of programs of
+// <type>, the same as the corresponding single function ops.
+const absl::flat_hash_set<functions::DateTimestampPart>& SupportedAddParts(
+    functions::DateTimeExprProgram::ValueType type);
+const absl::flat_hash_set<functions::DateTimestampPart>& SupportedTruncParts(
+    functions::DateTimeExprProgram::ValueType type);
+const absl::flat_hash_set<functions::DateTimestampPart>& SupportedExtractParts(
+    functions::DateTimeExprProgram::ValueType type);
+
+// A DateTimeExprProgram checked once, with its time zones resolved and its
+// formats compiled, to be evaluated on each element of the input of the
+// DateTimeExpr op. Evaluate is safe to call concurrently.
+class CompiledDateTimeExpr {
+ public:
+  // Checks that the steps of the program fit together and that their parts
+  // are supported, like the single function ops. <function_name> is reported
+  // in the errors of Compile and Evaluate.
+  ::tsl::Status Compile(const functions::DateTimeExprProgram& program,
+                        absl::string_view function_name);
+
+  // Whether the program ends with an extract step, which outputs an int64
+  // instead of a string.
+  bool output_int64() const { return output_int64_; }
+
+  int num_steps() const { return steps_.size(); }
+
+  // Runs the program on one input. Sets <int64_out> if output_int64(),
+  // <string_out> otherwise.
+  ::tsl::Status Evaluate(absl::string_view input, int64_t* int64_out,
+                         ::tensorflow::tstring* string_out) const;
+
+ private:
+  using Program = functions::DateTimeExprProgram;
+
+  // The value flowing between the steps, in the field of the program type.
+  struct Value {
+    int64_t timestamp = 0;
+    int32_t date = 0;
+    DatetimeValue datetime;
+  };
+
+  struct Step {
+    Program::Step::StepCase kind = Program::Step::STEP_NOT_SET;
+    functions::DateTimestampPart part = functions::YEAR;
+    int64_t interval = 0;
+    std::string format;
+    bool cast = false;
+    bool allow_tz_in_str = true;
+    absl::TimeZone time_zone;
+    std::shared_ptr<const functions::TimestampFormatter> timestamp_formatter;
+    std::shared_ptr<const functions::DateFormatter> date_formatter;
+    std::shared_ptr<const functions::DatetimeFormatter> datetime_formatter;
+  };
+
+  ::tsl::Status CompileStep(const Program::Step& step, Step* compiled);
+  ::tsl::Status CheckPart(
+      functions::DateTimestampPart part,
+      const absl::flat_hash_set<functions::DateTimestampPart>& supported_parts)
+      const;
+
+  ::tsl::Status Parse(const Step& step, absl::string_view input,
+                      Value* value) const;
+  ::tsl::Status Add(const Step& step, Value* value) const;
+  ::tsl::Status Trunc(const Step& step, Value* value) const;
+  ::tsl::Status Extract(const Step& step, const Value& value,
+                        int32_t* out) const;
+  ::tsl::Status Format(const Step& step, const Value& value,
+                       std::string* out) const;
+  void Canonicalize(Value* value) const;
+
+  std::string function_name_;
+  Program::ValueType type_ = Program::TIMESTAMP;
+  bool output_int64_ = false;
+  std::vector<Step> steps_;
+  TimeZoneCache time_zone_cache_;
+  TimestampFormatterCache timestamp_format_cache_;
+  DateFormatterCache date_format_cache_;
+  DatetimeFormatterCache datetime_format_cache_;
+};
+
+}  // namespace bigquery_ml_utils
+
+#endif  // THIRD_PARTY_PY_BIGQUERY_ML_UTILS_TENSORFLOW_OPS_DATETIME_EXPR_H_
@@ -0,0 +1,414 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// A graph optimization pass that rewrites chains of the single function
+// date/time ops, like TimestampTrunc -> FormatTimestamp, into one DateTimeExpr
+// op. Each op of a chain parses the canonical string output by the previous
+// one, so the fused program replaces that round trip with a canonicalize step
+// and produces the same outputs. The pass is disabled by default. Setting the
+// BIGQUERY_ML_UTILS_FUSE_DATETIME_OPS environment variable to true enables it
+// for every graph built afterwards, including the functions of existing
+// SavedModels.
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "sql_utils/public/functions/datetime.pb.h"
+#include "sql_utils/public/functions/datetime_expr.pb.h"
+#include "tensorflow_ops/datetime_expr.h"
+#include "tensorflow_ops/utils.h"
+#include "google/protobuf/text_format.h"
+#include "tensorflow/tsl/platform/errors.h"
+#include "tensorflow/tsl/platform/status.h"
+#include "tensorflow/core/common_runtime/optimization_registry.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/platform/tstring.h"
+#include "tensorflow/core/util/env_var.h"
+
+using ::tensorflow::Edge;
+using ::tensorflow::Graph;
+using ::tensorflow::Node;
+using ::tensorflow::Tensor;
+using ::tensorflow::tstring;
+
+namespace bigquery_ml_utils {
+
+namespace {
+
+using Program = functions::DateTimeExprProgram;
+
+// The environment variable that enables the pass.
+constexpr char kEnableFusionEnvVar[] = "BIGQUERY_ML_UTILS_FUSE_DATETIME_OPS";
+
+// No value type, for the inputs of the ops that parse arbitrary strings with
+// CAST and the outputs of the ops that end a program.
+constexpr Program::ValueType kNone =
+    Program::__ValueType__switch_must_have_a_default__;
+
+// How a single function op takes part in a chain.
+struct FusibleOp {
+  absl::string_view op;
+  // The type of the canonical string the op reads from the previous op of a
+  // chain, or kNone if the op can only start a chain.
+  Program::ValueType input_type;
+  // The type of the canonical string the op outputs for the next op of a
+  // chain, or kNone if the op can only end a chain.
+  Program::ValueType output_type;
+  // Index of the date/time input.
+  int value_input;
+};
+
+constexpr FusibleOp kFusibleOps[] = {
+    {"TimestampFromString", kNone, Program::TIMESTAMP, 0},
+    {"TimestampTrunc", Program::TIMESTAMP, Program::TIMESTAMP, 0},
+    {"FormatTimestamp", Program::TIMESTAMP, kNone, 1},
+    {"ExtractFromTimestamp", Program::TIMESTAMP, kNone, 1},
+    {"StringFromTimestamp", Program::TIMESTAMP, kNone, 0},
+    // Only followed by ExtractFromDate, which extracts the part of the
+    // timestamp at the time zone of DateFromTimestamp.
+    {"DateFromTimestamp", Program::TIMESTAMP, Program::DATE, 0},
+    {"DateTrunc", Program::DATE, Program::DATE, 0},
+    {"FormatDate", Program::DATE, kNone, 1},
+    {"ExtractFromDate", Program::DATE, kNone, 0},
+    {"DatetimeTrunc", Program::DATETIME, Program::DATETIME, 0},
+    {"FormatDatetime", Program::DATETIME, kNone, 1},
+    {"ExtractFromDatetime", Program::DATETIME, kNone, 0},
+};
+
+const FusibleOp* FindFusibleOp(const Node* node) {
+  for (const FusibleOp& op : kFusibleOps) {
+    if (node->type_string() == op.op) return &op;
+  }
+  return nullptr;
+}
+
+// Reads the single element of the Const input <index> of <node>. Returns false
+// if the input is not a Const with one element, such as the per-element time
+// zones or parts some kernels accept, which the programs cannot express.
+template <typename T>
+bool GetConstInput(const Node* node, int index, T* out) {
+  const Edge* edge;
+  if (!node->input_edge(index, &edge).ok() ||
+      edge->src()->type_string() != "Const") {
+    return false;
+  }
+  Tensor value;
+  if (!::tensorflow::GetNodeAttr(edge->src()->attrs(), "value", &value).ok() ||
+      value.dtype() != ::tensorflow::DataTypeToEnum<T>::value ||
+      value.NumElements() != 1) {
+    return false;
+  }
+  *out = value.flat<T>()(0);
+  return true;
+}
+
+bool GetConstPart(const Node* node, int index,
+                  functions::DateTimestampPart* part) {
+  tstring name;
+  return GetConstInput(node, index, &name) &&
+         ParseInputDateTimestampPart(name, node->name(), part).ok();
+}
+
+// Builds the program of a chain, from the op reading the input of the chain
+// to the op whose output is replaced. Returns false if the Const inputs of the
+// ops are missing.
+bool BuildProgram(const std::vector<const Node*>& chain, Program* program) {
+  // The time zone of a DateFromTimestamp, for the ExtractFromDate after it.
+  std::string date_time_zone;
+  for (size_t c = 0; c < chain.size(); c++) {
+    const Node* node = chain[c];
+    const absl::string_view op = node->type_string();
+    if (c == 0) {
+      program->set_type(FindFusibleOp(node)->input_type == kNone
+                            ? Program::TIMESTAMP
+                            : FindFusibleOp(node)->input_type);
+      Program::Parse* parse = program->add_steps()->mutable_parse();
+      if (op == "TimestampFromString") {
+        tstring time_zone;
+        bool allow_tz_in_str;
+        if (!GetConstInput(node, 1, &time_zone) ||
+            !GetConstInput(node, 2, &allow_tz_in_str)) {
+          return false;
+        }
+        parse->set_cast(true);
+        parse->set_time_zone(time_zone);
+        parse->set_allow_tz_in_str(allow_tz_in_str);
+        continue;
+      }
+      if (op == "TimestampTrunc" || op == "FormatTimestamp" ||
+          op == "ExtractFromTimestamp") {
+        tstring time_zone;
+        if (!GetConstInput(node, 2, &time_zone)) return false;
+        parse->set_time_zone(time_zone);
+      } else if (op == "StringFromTimestamp") {
+        tstring time_zone;
+        if (!GetConstInput(node, 1, &time_zone)) return false;
+        parse->set_time_zone(time_zone);
+      }
+    } else if (FindFusibleOp(chain[c - 1])->output_type == Program::TIMESTAMP) {
+      // The previous op output a canonical timestamp string.
+      program->add_steps()->mutable_canonicalize();
+    }
+
+    if (op == "TimestampTrunc") {
+      Program::Trunc* trunc = program->add_steps()->mutable_trunc();
+      functions::DateTimestampPart part;
+      tstring time_zone;
+      if (!GetConstPart(node, 1, &part) ||
+          !GetConstInput(node, 2, &time_zone)) {
+        return false;
+      }
+      trunc->set_part(part);
+      trunc->set_time_zone(time_zone);
+    } else if (op == "FormatTimestamp") {
+      Program::Format* format = program->add_steps()->mutable_format();
+      tstring format_string, time_zone;
+      if (!GetConstInput(node, 0, &format_string) ||
+          !GetConstInput(node, 2, &time_zone)) {
+        return false;
+      }
+      format->set_format(format_string);
+      format->set_time_zone(time_zone);
+    } else if (op == "ExtractFromTimestamp") {
+      Program::Extract* extract = program->add_steps()->mutable_extract();
+      functions::DateTimestampPart part;
+      tstring time_zone;
+      if (!GetConstPart(node, 0, &part) ||
+          !GetConstInput(node, 2, &time_zone)) {
+        return false;
+      }
+      extract->set_part(part);
+      extract->set_time_zone(time_zone);
+    } else if (op == "StringFromTimestamp") {
+      Program::Format* format = program->add_steps()->mutable_format();
+      tstring time_zone;
+      if (!GetConstInput(node, 1, &time_zone)) return false;
+      format->set_cast(true);
+      format->set_time_zone(time_zone);
+    } else if (op == "DateFromTimestamp") {
+      tstring time_zone;
+      if (!GetConstInput(node, 1, &time_zone)) return false;
+      date_time_zone = time_zone;
+    } else if (op == "DateTrunc" || op == "DatetimeTrunc") {
+      functions::DateTimestampPart part;
+      if (!GetConstPart(node, 1, &part)) return false;
+      program->add_steps()->mutable_trunc()->set_part(part);
+    } else if (op == "FormatDate" || op == "FormatDatetime") {
+      tstring format_string;
+      if (!GetConstInput(node, 0, &format_string)) return false;
+      program->add_steps()->mutable_format()->set_format(format_string);
+    } else if (op == "ExtractFromDate" || op == "ExtractFromDatetime") {
+      Program::Extract* extract = program->add_steps()->mutable_extract();
+      functions::DateTimestampPart part;
+      if (!GetConstPart(node, 1, &part)) return false;
+      if (program->type() == Program::TIMESTAMP) {
+        // After DateFromTimestamp, only the parts of a date are supported.
+        if (!SupportedExtractParts(Program::DATE).contains(part)) {
+          return false;
+        }
+        extract->set_time_zone(date_time_zone);
+      }
+      extract->set_part(part);
+    }
+  }
+  return true;
+}
+
+// Returns whether the only consumer of <producer> is <consumer>, so that
+// fusing <producer> into a chain with <consumer> doesn't compute it twice.
+bool OnlyConsumer(const Node* producer, const Node* consumer) {
+  for (const Edge* edge : producer->out_edges()) {
+    if (edge->dst() != consumer && !edge->dst()->IsSink()) return false;
+  }
+  return true;
+}
+
+// Returns the ops of the longest chain ending with <node>, starting with the
+// op reading the input of the chain. The chain stops before a producer with
+// other consumers, which would otherwise also run for them.
+std::vector<const Node*> FindChain(const Node* node) {
+  std::vector<const Node*> chain = {node};
+  const FusibleOp* op = FindFusibleOp(node);
+  while (op != nullptr && op->input_type != kNone) {
+    const Edge* edge;
+    if (!node->input_edge(op->value_input, &edge).ok()) break;
+    const Node* producer = edge->src();
+    const FusibleOp* producer_op = FindFusibleOp(producer);
+    if (producer_op == nullptr || producer_op->output_type != op->input_type ||
+        producer->requested_device() != node->requested_device() ||
+        !OnlyConsumer(producer, node)) {
+      break;
+    }
+    if (producer->type_string() == "DateFromTimestamp" &&
+        node->type_string() != "ExtractFromDate") {
+      break;
+    }
+    chain.push_back(producer);
+    node = producer;
+    op = producer_op;
+  }
+  std::reverse(chain.begin(), chain.end());
+  return chain;
+}
+
+// Replaces the last op of <chain> by a DateTimeExpr op running <program> on
+// the input of the chain, which lists the names of the ops of the chain in its
+// fused_ops attr for its errors. If <remove_producers>, the other ops of the
+// chain, which are left without consumers, are removed.
+::tsl::Status FuseChain(const std::vector<const Node*>& chain,
+                        const Program& program, bool output_int64,
+                        bool remove_producers, Graph* graph) {
+  Node* last = const_cast<Node*>(chain.back());
+  const Edge* input_edge;
+  TF_RETURN_IF_ERROR(chain.front()->input_edge(
+      FindFusibleOp(chain.front())->value_input, &input_edge));
+
+  std::vector<std::string> fused_ops;
+  for (const Node* node : chain) fused_ops.push_back(node->name());
+
+  std::string program_text;
+  google::protobuf::TextFormat::Printer printer;
+  printer.SetSingleLineMode(true);
+  if (!printer.PrintToString(program, &program_text)) {
+    return ::tsl::errors::Internal("Failed to print the fused program of ",
+                                   last->name());
+  }
+
+  // Keep the name of the last op, which may be fetched.
+  const std::string name = last->name();
+  const std::string requested_device = last->requested_device();
+  const std::string assigned_device = last->assigned_device_name();
+  std::vector<const Edge*> out_edges(last->out_edges().begin(),
+                                     last->out_edges().end());
+  std::vector<std::pair<Node*, int>> consumers;
+  std::vector<Node*> control_outputs;
+  for (const Edge* edge : out_edges) {
+    if (edge->IsControlEdge()) {
+      control_outputs.push_back(edge->dst());
+    } else {
+      consumers.push_back({edge->dst(), edge->dst_input()});
+    }
+  }
+  // The fused op waits for the control inputs of all the ops of the chain.
+  absl::flat_hash_set<Node*> control_inputs;
+  for (const Node* node : chain) {
+    for (const Edge* edge : node->in_edges()) {
+      if (edge->IsControlEdge() && !edge->src()->IsSource()) {
+        control_inputs.insert(edge->src());
+      }
+    }
+  }
+  Node* input = input_edge->src();
+  const int input_index = input_edge->src_output();
+  graph->RemoveNode(last);
+
+  Node* fused;
+  TF_RETURN_IF_ERROR(
+      ::tensorflow::NodeBuilder(name, "DateTimeExpr")
+          .Input(input, input_index)
+          .Attr("program", program_text)
+          .Attr("fused_ops", fused_ops)
+          .Attr("out_type", output_int64 ? ::tensorflow::DT_INT64
+                                         : ::tensorflow::DT_STRING)
+          .Device(requested_device)
+          .Finalize(graph, &fused));
+  if (!assigned_device.empty()) {
+    fused->set_assigned_device_name(assigned_device);
+  }
+  for (const auto& [consumer, index] : consumers) {
+    graph->AddEdge(fused, 0, consumer, index);
+  }
+  for (Node* node : control_outputs) graph->AddControlEdge(fused, node);
+  for (Node* node : control_inputs) graph->AddControlEdge(node, fused);
+
+  if (!remove_producers) return ::tsl::OkStatus();
+  for (size_t c = 0; c + 1 < chain.size(); c++) {
+    graph->RemoveNode(const_cast<Node*>(chain[c]));
+  }
+  return ::tsl::OkStatus();
+}
+
+class DateTimeExprFusionPass : public ::tensorflow::GraphOptimizationPass {
+ public:
+  ::tsl::Status Run(
+      const ::tensorflow::GraphOptimizationPassOptions& options) override {
+    if (options.graph == nullptr) return ::tsl::OkStatus();
+    bool enabled;
+    TF_RETURN_IF_ERROR(
+        ::tensorflow::ReadBoolFromEnvVar(kEnableFusionEnvVar,
+                                         /*default_val=*/false, &enabled));
+    if (!enabled) return ::tsl::OkStatus();
+    Graph* graph = options.graph->get();
+
+    // Visit the consumers before their producers, so that the longest chain
+    // ending with each op is fused.
+    std::vector<Node*> post_order;
+    ::tensorflow::GetPostOrder(*graph, &post_order);
+    std::vector<int> node_ids;
+    for (Node* node : post_order) {
+      if (node->IsOp() && FindFusibleOp(node) != nullptr) {
+        node_ids.push_back(node->id());
+      }
+    }
+    // A Session runs this pass on its whole graph before adding the fetch
+    // nodes, so a producer without consumers may still be fetched. Leave such
+    // producers to the pruning of the graph to the fetches, and only remove
+    // them from function bodies, whose outputs are all known. A kept producer
+    // only runs when fetched, and then the fused op computes it once more.
+    const bool remove_producers = options.is_function_graph;
+    bool changed = false;
+    for (int id : node_ids) {
+      // Skip the producers removed by the fusion of a previous chain.
+      const Node* node = graph->FindNodeId(id);
+      // DateFromTimestamp only ends a chain with ExtractFromDate.
+      if (node == nullptr || FindFusibleOp(node) == nullptr ||
+          node->type_string() == "DateFromTimestamp") {
+        continue;
+      }
+      const std::vector<const Node*> chain = FindChain(node);
+      if (chain.size() < 2) continue;
+
+      Program program;
+      if (!BuildProgram(chain, &program)) continue;
+      // Leave the chains whose ops fail on their scalar inputs, so that they
+      // report their own errors.
+      CompiledDateTimeExpr expr;
+      if (!expr.Compile(program, node->name()).ok()) continue;
+      TF_RETURN_IF_ERROR(FuseChain(chain, program, expr.output_int64(),
+                                   remove_producers, graph));
+      changed = true;
+    }
+    if (changed) ::tensorflow::FixupSourceAndSinkEdges(graph);
+    return ::tsl::OkStatus();
+  }
+};
+
+}  // namespace
+
+REGISTER_OPTIMIZATION(::tensorflow::OptimizationPassRegistry::PRE_PLACEMENT, 0,
+                      DateTimeExprFusionPass);
+
+}  // namespace bigquery_ml_utils
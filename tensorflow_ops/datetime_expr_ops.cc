@@ -0,0 +1,42 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "absl/status/status.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/shape_inference.h"
+
+namespace bigquery_ml_utils {
+
+// NOTE: changing signature will break the existing SavedModel.
+
+// Register DateTimeExpr op with signature.
+// The program attr is a DateTimeExprProgram in the protobuf text format. The
+// output is int64 for programs ending with an extract step, string otherwise.
+// Output has the same shape of the input. The fused_ops attr lists the names of
+// the ops replaced by the op, when it was fused from a chain of ops, for its
+// errors.
+REGISTER_OP("DateTimeExpr")
+    .Input("input: string")
+    .Attr("program: string")
+    .Attr("out_type: {string, int64} = DT_STRING")
+    .Attr("fused_ops: list(string) = []")
+    .Output("output: out_type")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+}  // namespace bigquery_ml_utils
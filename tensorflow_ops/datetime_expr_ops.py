@@ -0,0 +1,48 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Python wrapper for BQML fused date/time expression custom ops."""
+
+from bigquery_ml_utils.tensorflow_ops.composite_tensors import supports_composite_tensors
+from bigquery_ml_utils.tensorflow_ops.load_module import load_module
+from google.protobuf import text_format
+
+gen_datetime_expr_ops = load_module("_bigquery_ml_utils_ops.so")
+
+
+@supports_composite_tensors
+def datetime_expr(value, program, out_type="string", name=None):
+  """Evaluates a pipeline of date/time functions on each element of a tensor.
+
+  Equivalent to chaining the single function ops, e.g. TimestampTrunc,
+  TimestampAdd and FormatTimestamp, without the intermediate string tensors.
+  The values are kept at microsecond precision between the steps.
+
+  Args:
+    value: tf.Tensor of type string. Input of the parse step of the program.
+    program: A DateTimeExprProgram as defined in
+      sql_utils/public/functions/datetime_expr.proto, either a message or a
+      string in the protobuf text format.
+    out_type: "int64" for programs ending with an extract step, "string"
+      otherwise.
+    name: An optional name for the op.
+
+  Returns:
+    A tf.Tensor of type out_type with the shape of value.
+  """
+  if not isinstance(program, str):
+    program = text_format.MessageToString(program)
+  return gen_datetime_expr_ops.date_time_expr(
+      input=value, program=program, out_type=out_type, name=name
+  )
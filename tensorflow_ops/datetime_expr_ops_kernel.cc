@@ -0,0 +1,124 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_join.h"
+#include "absl/strings/substitute.h"
+#include "sql_utils/public/functions/datetime_expr.pb.h"
+#include "tensorflow_ops/datetime_expr.h"
+#include "tensorflow_ops/utils.h"
+#include "google/protobuf/text_format.h"
+#include "tensorflow/tsl/platform/errors.h"
+#include "tensorflow/tsl/platform/status.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/op_requires.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/platform/tstring.h"
+
+using ::tensorflow::DataType;
+using ::tensorflow::DEVICE_CPU;
+using ::tensorflow::OpKernel;
+using ::tensorflow::OpKernelConstruction;
+using ::tensorflow::OpKernelContext;
+using ::tensorflow::Tensor;
+using ::tensorflow::tstring;
+using ::tensorflow::errors::InvalidArgument;
+
+namespace bigquery_ml_utils {
+
+class DateTimeExpr : public OpKernel {
+ public:
+  explicit DateTimeExpr(OpKernelConstruction* context) : OpKernel(context) {
+    std::string program_text;
+    OP_REQUIRES_OK(context, context->GetAttr("program", &program_text));
+    DataType out_type;
+    OP_REQUIRES_OK(context, context->GetAttr("out_type", &out_type));
+    std::vector<std::string> fused_ops;
+    OP_REQUIRES_OK(context, context->GetAttr("fused_ops", &fused_ops));
+    if (!fused_ops.empty()) {
+      fused_ops_context_ =
+          absl::Substitute("in $0, fused from the ops $1", name(),
+                           absl::StrJoin(fused_ops, ", "));
+    }
+    functions::DateTimeExprProgram program;
+    OP_REQUIRES(context,
+                google::protobuf::TextFormat::ParseFromString(program_text,
+                                                              &program),
+                InvalidArgument(absl::Substitute(
+                    "Invalid program in $0: $1", name(), program_text)));
+    OP_REQUIRES_OK(context, expr_.Compile(program, name()));
+    const DataType expected_type = expr_.output_int64()
+                                       ? ::tensorflow::DT_INT64
+                                       : ::tensorflow::DT_STRING;
+    OP_REQUIRES(context, out_type == expected_type,
+                InvalidArgument(absl::Substitute(
+                    "The out_type of $0 must be $1 for the program", name(),
+                    ::tensorflow::DataTypeString(expected_type))));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the input tensor
+    const Tensor& input_tensor = context->input(0);
+    auto input = input_tensor.flat<tstring>();
+
+    // Create an output tensor with the shape of the input tensor, reusing its
+    // buffer when no other op needs it.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, input_tensor.shape(), &output_tensor));
+
+    // Each element is parsed once and formatted at most once for all the
+    // steps.
+    const int64_t cost_per_unit =
+        kParseCost + kFormatCost + (expr_.num_steps() - 1) * kComputeCost;
+    ::tsl::Status status;
+    if (expr_.output_int64()) {
+      auto output_flat = output_tensor->flat<int64_t>();
+      auto compute_element = [&](int64_t i) -> ::tsl::Status {
+        return expr_.Evaluate(input(i), &output_flat(i), nullptr);
+      };
+      status = ParallelForDistinct(context, input, cost_per_unit,
+                                   compute_element, output_flat);
+    } else {
+      auto output_flat = output_tensor->flat<tstring>();
+      auto compute_element = [&](int64_t i) -> ::tsl::Status {
+        return expr_.Evaluate(input(i), nullptr, &output_flat(i));
+      };
+      status = ParallelForDistinct(context, input, cost_per_unit,
+                                   compute_element, output_flat);
+    }
+    // A fused op keeps the name of the last op of its chain, so name the
+    // other ops too.
+    if (!status.ok() && !fused_ops_context_.empty()) {
+      ::tsl::errors::AppendToMessage(&status, fused_ops_context_);
+    }
+    OP_REQUIRES_OK(context, status);
+  }
+
+ private:
+  CompiledDateTimeExpr expr_;
+  // The context added to the errors of a fused op, or empty.
+  std::string fused_ops_context_;
+};
+
+// Register the kernels.
+REGISTER_KERNEL_BUILDER(Name("DateTimeExpr").Device(DEVICE_CPU), DateTimeExpr);
+
+}  // namespace bigquery_ml_utils
@@ -14,9 +14,13 @@
  * limitations under the License.
  */
 
+#include <string>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/platform/errors.h"
 
 namespace bigquery_ml_utils {
 
@@ -47,6 +51,22 @@ REGISTER_OP("DatetimeFromDate")
       return absl::OkStatus();
     });
 
+// Register DatetimeFromDateWithErrors op with signature.
+// Like DatetimeFromDate, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("DatetimeFromDateWithErrors")
+    .Input("date: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DatetimeFromDateAndTime op with signature.
 // Output has the same shape of the inputs.
 REGISTER_OP("DatetimeFromDateAndTime")
@@ -58,6 +78,23 @@ REGISTER_OP("DatetimeFromDateAndTime")
       return absl::OkStatus();
     });
 
+// Register DatetimeFromDateAndTimeWithErrors op with signature.
+// Like DatetimeFromDateAndTime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("DatetimeFromDateAndTimeWithErrors")
+    .Input("date: string")
+    .Input("time: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DatetimeFromTimestamp op with signature.
 // Output has the same shape of the inputs.
 REGISTER_OP("DatetimeFromTimestamp")
@@ -69,6 +106,23 @@ REGISTER_OP("DatetimeFromTimestamp")
       return absl::OkStatus();
     });
 
+// Register DatetimeFromTimestampWithErrors op with signature.
+// Like DatetimeFromTimestamp, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("DatetimeFromTimestampWithErrors")
+    .Input("timestamp: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register CastToDatetimeFromString op with signature.
 // Output has the same shape of the datetime_string.
 REGISTER_OP("CastToDatetimeFromString")
@@ -81,6 +135,54 @@ REGISTER_OP("CastToDatetimeFromString")
       return absl::OkStatus();
     });
 
+// Register CastToDatetimeFromStringWithErrors op with signature.
+// Like CastToDatetimeFromString, but rows that fail produce an empty output
+// string and their error code in error_codes instead of failing the whole
+// batch. Both have the same shape of the input datetime_string. error_messages
+// has the messages of the first max_error_messages failing rows.
+REGISTER_OP("CastToDatetimeFromStringWithErrors")
+    .Input("datetime_string: string")
+    .Input("format_string: string")
+    .Input("with_format: bool")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register CastToStringFromDatetime op with signature.
+// Output has the same shape of the datetime.
+REGISTER_OP("CastToStringFromDatetime")
+    .Input("datetime: string")
+    .Input("format_string: string")
+    .Output("output: string")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register CastToStringFromDatetimeWithErrors op with signature.
+// Like CastToStringFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("CastToStringFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Input("format_string: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DatetimeAdd op with signature.
 // Output has the same shape of the inputs.
 REGISTER_OP("DatetimeAdd")
@@ -93,6 +195,24 @@ REGISTER_OP("DatetimeAdd")
       return absl::OkStatus();
     });
 
+// Register DatetimeAddWithErrors op with signature.
+// Like DatetimeAdd, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("DatetimeAddWithErrors")
+    .Input("datetime: string")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DatetimeDiff op with signature.
 // Output has the same shape of the inputs.
 REGISTER_OP("DatetimeDiff")
@@ -105,6 +225,24 @@ REGISTER_OP("DatetimeDiff")
       return absl::OkStatus();
     });
 
+// Register DatetimeDiffWithErrors op with signature.
+// Like DatetimeDiff, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("DatetimeDiffWithErrors")
+    .Input("datetime_a: string")
+    .Input("datetime_b: string")
+    .Input("part: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DatetimeSub op with signature.
 // Output has the same shape of the inputs.
 REGISTER_OP("DatetimeSub")
@@ -117,6 +255,24 @@ REGISTER_OP("DatetimeSub")
       return absl::OkStatus();
     });
 
+// Register DatetimeSubWithErrors op with signature.
+// Like DatetimeSub, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("DatetimeSubWithErrors")
+    .Input("datetime: string")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register DatetimeTrunc op with signature.
 // Output has the same shape of the inputs.
 REGISTER_OP("DatetimeTrunc")
@@ -128,6 +284,23 @@ REGISTER_OP("DatetimeTrunc")
       return absl::OkStatus();
     });
 
+// Register DatetimeTruncWithErrors op with signature.
+// Like DatetimeTrunc, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("DatetimeTruncWithErrors")
+    .Input("datetime: string")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register ExtractFromDatetime op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("ExtractFromDatetime")
@@ -139,6 +312,40 @@ REGISTER_OP("ExtractFromDatetime")
       return absl::OkStatus();
     });
 
+// Register ExtractFromDatetimeWithErrors op with signature.
+// Like ExtractFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("ExtractFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Input("part: string")
+    .Output("part_out: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register ExtractPartsFromDatetime op with signature.
+// Output has the shape of the input datetime with an extra innermost dimension
+// for the parts.
+REGISTER_OP("ExtractPartsFromDatetime")
+    .Input("datetime: string")
+    .Attr("parts: list(string) >= 1")
+    .Output("parts_out: int64")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      std::vector<std::string> parts;
+      TF_RETURN_IF_ERROR(c->GetAttr("parts", &parts));
+      tensorflow::shape_inference::ShapeHandle output;
+      TF_RETURN_IF_ERROR(
+          c->Concatenate(c->input(0), c->Vector(parts.size()), &output));
+      c->set_output(0, output);
+      return absl::OkStatus();
+    });
+
 // Register ExtractDateFromDatetime op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("ExtractDateFromDatetime")
@@ -149,6 +356,22 @@ REGISTER_OP("ExtractDateFromDatetime")
       return absl::OkStatus();
     });
 
+// Register ExtractDateFromDatetimeWithErrors op with signature.
+// Like ExtractDateFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("ExtractDateFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Output("part_out: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register ExtractTimeFromDatetime op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("ExtractTimeFromDatetime")
@@ -159,6 +382,22 @@ REGISTER_OP("ExtractTimeFromDatetime")
       return absl::OkStatus();
     });
 
+// Register ExtractTimeFromDatetimeWithErrors op with signature.
+// Like ExtractTimeFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("ExtractTimeFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Output("part_out: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register LastDay op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("LastDayFromDatetime")
@@ -170,6 +409,23 @@ REGISTER_OP("LastDayFromDatetime")
       return absl::OkStatus();
     });
 
+// Register LastDayFromDatetimeWithErrors op with signature.
+// Like LastDayFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("LastDayFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register FormatDatetime op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("FormatDatetime")
@@ -181,6 +437,23 @@ REGISTER_OP("FormatDatetime")
       return absl::OkStatus();
     });
 
+// Register FormatDatetimeWithErrors op with signature.
+// Like FormatDatetime, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("FormatDatetimeWithErrors")
+    .Input("format_string: string")
+    .Input("datetime: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register ParseDatetime op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("ParseDatetime")
@@ -192,6 +465,25 @@ REGISTER_OP("ParseDatetime")
       return absl::OkStatus();
     });
 
+// Register ParseDatetimeWithErrors op with signature.
+// Like ParseDatetime, but rows that fail produce an empty output string and
+// their error code in error_codes instead of failing the whole batch. Both have
+// the same shape of the input datetime_string. error_messages has the messages
+// of the first max_error_messages failing rows.
+REGISTER_OP("ParseDatetimeWithErrors")
+    .Input("format_string: string")
+    .Input("datetime_string: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register SafeParseDatetime op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("SafeParseDatetime")
@@ -203,4 +495,113 @@ REGISTER_OP("SafeParseDatetime")
       return absl::OkStatus();
     });
 
+// Register SafeParseDatetimeWithValidity op with signature.
+// Like SafeParseDatetime, but rows that fail to parse produce an empty output
+// string and false in valid, instead of the NULL-equivalent value.  Both
+// outputs have the same shape of the input datetime_string.
+REGISTER_OP("SafeParseDatetimeWithValidity")
+    .Input("format_string: string")
+    .Input("datetime_string: string")
+    .Output("output: string")
+    .Output("valid: bool")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      return absl::OkStatus();
+    });
+
+// Register PackedFromDatetime op with signature.
+// Output has the same shape of the input datetime.
+REGISTER_OP("PackedFromDatetime")
+    .Input("datetime: string")
+    .Output("output: int64")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register PackedFromDatetimeWithErrors op with signature.
+// Like PackedFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("PackedFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register DatetimeFromPacked op with signature.
+// Output has the same shape of the input datetime.
+REGISTER_OP("DatetimeFromPacked")
+    .Input("datetime: int64")
+    .Output("output: string")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register DatetimeAddPacked op with signature.
+// Output has the same shape of the input datetime.
+REGISTER_OP("DatetimeAddPacked")
+    .Input("datetime: int64")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register DatetimeDiffPacked op with signature.
+// Output has the same shape of the input datetime.
+REGISTER_OP("DatetimeDiffPacked")
+    .Input("datetime_a: int64")
+    .Input("datetime_b: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register DatetimeSubPacked op with signature.
+// Output has the same shape of the input datetime.
+REGISTER_OP("DatetimeSubPacked")
+    .Input("datetime: int64")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register DatetimeTruncPacked op with signature.
+// Output has the same shape of the input datetime.
+REGISTER_OP("DatetimeTruncPacked")
+    .Input("datetime: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register ExtractFromDatetimePacked op with signature.
+// Output has the same shape of the input datetime.
+REGISTER_OP("ExtractFromDatetimePacked")
+    .Input("datetime: int64")
+    .Input("part: string")
+    .Output("part_out: int64")
+    .SetShapeFn([](tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
 }  // namespace bigquery_ml_utils
@@ -14,11 +14,13 @@
 
 """Python wrapper for BigQuery datetime custom ops."""
 
+from bigquery_ml_utils.tensorflow_ops.composite_tensors import supports_composite_tensors
 from bigquery_ml_utils.tensorflow_ops.load_module import load_module
 
-gen_datetime_ops = load_module("_datetime_ops.so")
+gen_datetime_ops = load_module("_bigquery_ml_utils_ops.so")
 
 
+@supports_composite_tensors
 def datetime_from_components(year, month, day, hour, minute, second, name=None):
   """Returns datetime using INT64 values representing the components of it.
 
@@ -44,6 +46,7 @@ def datetime_from_components(year, month, day, hour, minute, second, name=None):
   )
 
 
+@supports_composite_tensors
 def datetime_from_date(date, name=None):
   """Returns datetime using DATE value.
 
@@ -56,6 +59,28 @@ def datetime_from_date(date, name=None):
   return gen_datetime_ops.datetime_from_date(date=date, name=name)
 
 
+def datetime_from_date_with_errors(date, max_error_messages=16, name=None):
+  """Like datetime_from_date, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string in "%F" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.datetime_from_date_with_errors(
+      date=date,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def datetime_from_date_and_time(date, time, name=None):
   """Returns datetime using DATE value and TIME value.
 
@@ -71,6 +96,32 @@ def datetime_from_date_and_time(date, time, name=None):
   )
 
 
+def datetime_from_date_and_time_with_errors(
+    date, time, max_error_messages=16, name=None
+):
+  """Like datetime_from_date_and_time, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string in "%F" format.
+    time: tf.Tensor of type string in "%H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.datetime_from_date_and_time_with_errors(
+      date=date,
+      time=time,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def datetime_from_timestamp(timestamp, time_zone="UTC", name=None):
   """Returns datetime using TIMESTAMP value and optional time zone.
 
@@ -78,7 +129,8 @@ def datetime_from_timestamp(timestamp, time_zone="UTC", name=None):
 
   Args:
     timestamp: tf.Tensor of type string in "%F %H:%M:%E1S %z" format.
-    time_zone: Optional. A string represents the time zone.
+    time_zone: Optional. A string represents the time zone, or a tf.Tensor of
+      type string with one time zone per timestamp.
     name: An optional name for the op.
   """
   return gen_datetime_ops.datetime_from_timestamp(
@@ -86,6 +138,33 @@ def datetime_from_timestamp(timestamp, time_zone="UTC", name=None):
   )
 
 
+def datetime_from_timestamp_with_errors(
+    timestamp, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like datetime_from_timestamp, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string in "%F %H:%M:%E1S %z" format.
+    time_zone: Optional. A string represents the time zone, or a tf.Tensor of
+      type string with one time zone per timestamp.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.datetime_from_timestamp_with_errors(
+      timestamp=timestamp,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def cast_to_datetime_from_string(
     datetime_string, format_string=None, name=None
 ):
@@ -110,6 +189,82 @@ def cast_to_datetime_from_string(
   )
 
 
+def cast_to_datetime_from_string_with_errors(
+    datetime_string, format_string=None, max_error_messages=16, name=None
+):
+  """Like cast_to_datetime_from_string, but reports per-row errors.
+
+  Args:
+    datetime_string: tf.Tensor of type string. The string must conform to the
+      supported datetime literal format, and is independent of time zone. If the
+      string expression is invalid or represents a datetime that is outside of
+      the supported min/max range, then an error is produced.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.cast_to_datetime_from_string_with_errors(
+      datetime_string=datetime_string,
+      format_string="" if format_string is None else format_string,
+      with_format=format_string is not None,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def cast_to_string_from_datetime(datetime, format_string, name=None):
+  """Returns a string by casting a datetime with a format.
+
+  Equivalent SQL: CAST(datetime AS STRING FORMAT format_string)
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    name: An optional name for the op.
+  """
+  return gen_datetime_ops.cast_to_string_from_datetime(
+      datetime=datetime,
+      format_string=format_string,
+      name=name,
+  )
+
+
+def cast_to_string_from_datetime_with_errors(
+    datetime, format_string, max_error_messages=16, name=None
+):
+  """Like cast_to_string_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.cast_to_string_from_datetime_with_errors(
+      datetime=datetime,
+      format_string=format_string,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def datetime_add(datetime, interval, part, name=None):
   """Returns the added DATETIME with the interval of part.
 
@@ -129,6 +284,36 @@ def datetime_add(datetime, interval, part, name=None):
   )
 
 
+def datetime_add_with_errors(
+    datetime, interval, part, max_error_messages=16, name=None
+):
+  """Like datetime_add, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    interval: tf.Tensor of type int64. It has the same shape of datetime input.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, MONTH, QUARTER, YEAR. It is
+      case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.datetime_add_with_errors(
+      datetime=datetime,
+      interval=interval,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def datetime_diff(datetime_a, datetime_b, part, name=None):
   """Returns the number of specified part intervals between two DATETIME.
 
@@ -148,6 +333,36 @@ def datetime_diff(datetime_a, datetime_b, part, name=None):
   )
 
 
+def datetime_diff_with_errors(
+    datetime_a, datetime_b, part, max_error_messages=16, name=None
+):
+  """Like datetime_diff, but reports per-row errors.
+
+  Args:
+    datetime_a: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    datetime_b: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, WEEK(<WEEKDAY>), ISOWEEK,
+      MONTH, QUARTER, YEAR, ISOYEAR. It is case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.datetime_diff_with_errors(
+      datetime_a=datetime_a,
+      datetime_b=datetime_b,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def datetime_sub(datetime, interval, part, name=None):
   """Returns the subtracted DATETIME with the interval of part.
 
@@ -167,6 +382,36 @@ def datetime_sub(datetime, interval, part, name=None):
   )
 
 
+def datetime_sub_with_errors(
+    datetime, interval, part, max_error_messages=16, name=None
+):
+  """Like datetime_sub, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    interval: tf.Tensor of type int64. It has the same shape of datetime input.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, MONTH, QUARTER, YEAR. It is
+      case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.datetime_sub_with_errors(
+      datetime=datetime,
+      interval=interval,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def datetime_trunc(datetime, part, name=None):
   """Returns the truncated DATETIME value to the granularity of date_time_part.
 
@@ -185,6 +430,34 @@ def datetime_trunc(datetime, part, name=None):
   )
 
 
+def datetime_trunc_with_errors(
+    datetime, part, max_error_messages=16, name=None
+):
+  """Like datetime_trunc, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, MONTH, QUARTER, YEAR. It is
+      case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.datetime_trunc_with_errors(
+      datetime=datetime,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def extract_from_datetime(datetime, part, name=None):
   """Returns the specified part from a supplied datetime.
 
@@ -203,6 +476,55 @@ def extract_from_datetime(datetime, part, name=None):
   )
 
 
+def extract_from_datetime_with_errors(
+    datetime, part, max_error_messages=16, name=None
+):
+  """Like extract_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAYOFWEEK, DAY, DAYOFYEAR, WEEK,
+      WEEK(WEEKDAY), ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. It is case
+      insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.extract_from_datetime_with_errors(
+      datetime=datetime,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+def extract_parts_from_datetime(datetime, parts, name=None):
+  """Returns several parts from a supplied datetime, parsing each one once.
+
+  Equivalent SQL: EXTRACT(part FROM datetime) for each part in parts.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    parts: A non-empty list of strings represents the datetime parts, with the
+      values accepted by extract_from_datetime.
+    name: An optional name for the op.
+
+  Returns:
+    A tf.Tensor of type int64 with the shape of datetime and an extra innermost
+    dimension, holding the value of parts[i] at index i.
+  """
+  return gen_datetime_ops.extract_parts_from_datetime(
+      datetime=datetime, parts=parts, name=name
+  )
+
+
+@supports_composite_tensors
 def extract_date_from_datetime(datetime, name=None):
   """Returns the DATE part from a supplied datetime.
 
@@ -217,6 +539,30 @@ def extract_date_from_datetime(datetime, name=None):
   )
 
 
+def extract_date_from_datetime_with_errors(
+    datetime, max_error_messages=16, name=None
+):
+  """Like extract_date_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.extract_date_from_datetime_with_errors(
+      datetime=datetime,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def extract_time_from_datetime(datetime, name=None):
   """Returns the TIME part from a supplied datetime.
 
@@ -231,6 +577,30 @@ def extract_time_from_datetime(datetime, name=None):
   )
 
 
+def extract_time_from_datetime_with_errors(
+    datetime, max_error_messages=16, name=None
+):
+  """Like extract_time_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.extract_time_from_datetime_with_errors(
+      datetime=datetime,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def last_day_from_datetime(datetime, part="MONTH", name=None):
   """Returns the last day from a datetime that contains the date.
 
@@ -247,6 +617,33 @@ def last_day_from_datetime(datetime, part="MONTH", name=None):
   )
 
 
+def last_day_from_datetime_with_errors(
+    datetime, part="MONTH", max_error_messages=16, name=None
+):
+  """Like last_day_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    part: A string represents the datetime part. Can be WEEK, WEEK(WEEKDAY),
+      ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. It is case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.last_day_from_datetime_with_errors(
+      datetime=datetime,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def format_datetime(format_string, datetime, name=None):
   """Returns the datetime string based on the format_string.
 
@@ -263,6 +660,33 @@ def format_datetime(format_string, datetime, name=None):
   )
 
 
+def format_datetime_with_errors(
+    format_string, datetime, max_error_messages=16, name=None
+):
+  """Like format_datetime, but reports per-row errors.
+
+  Args:
+    format_string: tf.Tensor of type string. A string represents the format of
+      the datetime value.
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.format_datetime_with_errors(
+      format_string=format_string,
+      datetime=datetime,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def parse_datetime(format_string, datetime_string, name=None):
   """Returns the parsed DATETIME value based on the format_string.
 
@@ -279,6 +703,29 @@ def parse_datetime(format_string, datetime_string, name=None):
   )
 
 
+def parse_datetime_with_errors(
+    format_string, datetime_string, max_error_messages=16, name=None
+):
+  """Like parse_datetime, but reports per-row errors.
+
+  Args:
+    format_string: A string represents the format of the datetime value.
+    datetime_string: tf.Tensor of type string.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.parse_datetime_with_errors(
+      format_string=format_string, datetime_string=datetime_string, name=name
+  )
+
+
+@supports_composite_tensors
 def safe_parse_datetime(format_string, datetime_string, name=None):
   """Returns the safely parsed DATETIME value based on the format_string.
 
@@ -293,3 +740,173 @@ def safe_parse_datetime(format_string, datetime_string, name=None):
   return gen_datetime_ops.safe_parse_datetime(
       format_string=format_string, datetime_string=datetime_string, name=name
   )
+
+
+@supports_composite_tensors
+def safe_parse_datetime_with_validity(
+    format_string, datetime_string, name=None
+):
+  """Returns DATETIME values by safely parsing strings, and which ones parsed.
+
+  Like safe_parse_datetime, but unsuccessful parsing produces an empty string
+  and False in the validity tensor instead of "1970-01-01 00:00:00.000000".
+
+  Args:
+    format_string: A string represents the format of the datetime value.
+    datetime_string: tf.Tensor of type string.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, valid) of a string tf.Tensor and a bool tf.Tensor, both
+    with the shape of datetime_string.
+  """
+  return gen_datetime_ops.safe_parse_datetime_with_validity(
+      format_string=format_string, datetime_string=datetime_string, name=name
+  )
+
+
+@supports_composite_tensors
+def packed_from_datetime(datetime, name=None):
+  """Returns the bit-packed int64 encoding of a DATETIME.
+
+  The packed encoding is accepted by the *_packed datetime ops, which skip
+  string parsing and formatting. Use datetime_from_packed to convert back.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    name: An optional name for the op.
+  """
+  return gen_datetime_ops.packed_from_datetime(datetime=datetime, name=name)
+
+
+def packed_from_datetime_with_errors(
+    datetime, max_error_messages=16, name=None
+):
+  """Like packed_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_datetime_ops.packed_from_datetime_with_errors(
+      datetime=datetime,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def datetime_from_packed(datetime, name=None):
+  """Returns a DATETIME string from its bit-packed int64 encoding.
+
+  Args:
+    datetime: tf.Tensor of type int64. Packed datetime as returned by
+      packed_from_datetime.
+    name: An optional name for the op.
+  """
+  return gen_datetime_ops.datetime_from_packed(datetime=datetime, name=name)
+
+
+@supports_composite_tensors
+def datetime_add_packed(datetime, interval, part, name=None):
+  """Returns the added packed DATETIME with the interval of part.
+
+  Equivalent SQL:
+    DATETIME_ADD(datetime_expression, INTERVAL int64_expression part)
+
+  Args:
+    datetime: tf.Tensor of type int64. Packed datetime.
+    interval: tf.Tensor of type int64. It has the same shape of datetime input.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, MONTH, QUARTER, YEAR. It is
+      case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_datetime_ops.datetime_add_packed(
+      datetime=datetime, interval=interval, part=part, name=name
+  )
+
+
+@supports_composite_tensors
+def datetime_diff_packed(datetime_a, datetime_b, part, name=None):
+  """Returns the number of specified part intervals between two packed DATETIME.
+
+  Equivalent SQL:
+    DATETIME_DIFF(datetime_a, datetime_b, part)
+
+  Args:
+    datetime_a: tf.Tensor of type int64. Packed datetime.
+    datetime_b: tf.Tensor of type int64. Packed datetime.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, WEEK(<WEEKDAY>), ISOWEEK,
+      MONTH, QUARTER, YEAR, ISOYEAR. It is case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_datetime_ops.datetime_diff_packed(
+      datetime_a=datetime_a, datetime_b=datetime_b, part=part, name=name
+  )
+
+
+@supports_composite_tensors
+def datetime_sub_packed(datetime, interval, part, name=None):
+  """Returns the subtracted packed DATETIME with the interval of part.
+
+  Equivalent SQL:
+    DATETIME_SUB(datetime_expression, INTERVAL int64_expression part)
+
+  Args:
+    datetime: tf.Tensor of type int64. Packed datetime.
+    interval: tf.Tensor of type int64. It has the same shape of datetime input.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, MONTH, QUARTER, YEAR. It is
+      case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_datetime_ops.datetime_sub_packed(
+      datetime=datetime, interval=interval, part=part, name=name
+  )
+
+
+@supports_composite_tensors
+def datetime_trunc_packed(datetime, part, name=None):
+  """Returns the packed DATETIME truncated to the granularity of part.
+
+  Equivalent SQL:
+    DATETIME_TRUNC(datetime_expression, part)
+
+  Args:
+    datetime: tf.Tensor of type int64. Packed datetime.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, WEEK(<WEEKDAY>), ISOWEEK,
+      MONTH, QUARTER, YEAR, ISOYEAR. It is case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_datetime_ops.datetime_trunc_packed(
+      datetime=datetime, part=part, name=name
+  )
+
+
+@supports_composite_tensors
+def extract_from_datetime_packed(datetime, part, name=None):
+  """Returns the specified part from a packed datetime.
+
+  Equivalent SQL: EXTRACT(part FROM datetime)
+
+  Args:
+    datetime: tf.Tensor of type int64. Packed datetime.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAYOFWEEK, DAY, DAYOFYEAR, WEEK,
+      WEEK(WEEKDAY), ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. It is case
+      insensitive.
+    name: An optional name for the op.
+  """
+  return gen_datetime_ops.extract_from_datetime_packed(
+      datetime=datetime, part=part, name=name
+  )
@@ -15,13 +15,16 @@
  */
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "sql_utils/public/civil_time.h"
 #include "sql_utils/public/functions/cast_date_time.h"
 #include "sql_utils/public/functions/date_time_util.h"
@@ -40,6 +43,7 @@ using ::tensorflow::OpKernel;
 using ::tensorflow::OpKernelConstruction;
 using ::tensorflow::OpKernelContext;
 using ::tensorflow::Tensor;
+using ::tensorflow::TensorShape;
 using ::tensorflow::tstring;
 using ::tensorflow::errors::InvalidArgument;
 
@@ -93,24 +97,22 @@ class DatetimeFromComponents : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = years.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::ConstructDatetime(
-                                  years(i), months(i), days(i), hours(i),
-                                  minutes(i), seconds(i), &datetime_value)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConstructDatetime(
+                      years(i), months(i), days(i), hours(i), minutes(i),
+                      seconds(i), &datetime_value)));
 
       // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(context,
-                     FormatOutputDatetime(datetime_value, name(), &output_str));
-
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(datetime_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -130,27 +132,25 @@ class DatetimeFromDate : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = dates.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_int;
-      OP_REQUIRES_OK(context, ParseInputDate(dates(i), name(), &date_int));
+      TF_RETURN_IF_ERROR(ParseInputDate(dates(i), name(), &date_int));
 
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::ConstructDatetime(
-                                                      date_int, TimeValue(),
-                                                      &datetime_value)));
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), functions::ConstructDatetime(
+                                  date_int, TimeValue(), &datetime_value)));
 
       // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(context,
-                     FormatOutputDatetime(datetime_value, name(), &output_str));
-
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(datetime_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, dates, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -180,30 +180,30 @@ class DatetimeFromDateAndTime : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = dates.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit =
+        2 * kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_int;
-      OP_REQUIRES_OK(context, ParseInputDate(dates(i), name(), &date_int));
+      TF_RETURN_IF_ERROR(ParseInputDate(dates(i), name(), &date_int));
 
       // Parse the time.
       TimeValue time_value;
-      OP_REQUIRES_OK(context, ParseInputTime(times(i), name(), &time_value));
+      TF_RETURN_IF_ERROR(ParseInputTime(times(i), name(), &time_value));
 
       // Construct the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::ConstructDatetime(
-                                                      date_int, time_value,
-                                                      &datetime_value)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ConstructDatetime(date_int, time_value, &datetime_value)));
 
       // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(context,
-                     FormatOutputDatetime(datetime_value, name(), &output_str));
-
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(datetime_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -217,13 +217,17 @@ class DatetimeFromTimestamp : public OpKernel {
     const Tensor& timestamp_tensor = context->input(0);
     auto timestamps = timestamp_tensor.flat<tstring>();
 
-    // Grab the time_zone tensor.
-    const Tensor& timezone_tensor = context->input(1);
-    absl::string_view timezone_str = timezone_tensor.flat<tstring>()(0);
-    // Parse and validate the timezone.
-    absl::TimeZone timezone;
-    OP_REQUIRES_OK(context, ToTslStatus(name(), functions::MakeTimeZone(
-                                                    timezone_str, &timezone)));
+    // Grab the time_zone tensor, a scalar or one time zone per timestamp.
+    BroadcastInput<absl::TimeZone> timezone;
+    OP_REQUIRES_OK(context,
+                   timezone.Init(context->input(1), timestamp_tensor.shape(),
+                                 "time_zone", name(),
+                                 [&](absl::string_view timezone_str,
+                                     absl::TimeZone* out) {
+                                   return ParseInputTimeZone(
+                                       timezone_str, name(),
+                                       &time_zone_cache_, out);
+                                 }));
 
     // Create an output tensor with the shape of the Timestamp tensor.
     Tensor* output_tensor = nullptr;
@@ -231,30 +235,40 @@ class DatetimeFromTimestamp : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = timestamps.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      TF_RETURN_IF_ERROR(timezone.status(i));
+
       // Parse the timestamp.
       int64_t timestamp_int;
-      OP_REQUIRES_OK(context, ParseInputTimestamp(timestamps(i), timezone,
-                                                  name(), &timestamp_int));
+      TF_RETURN_IF_ERROR(ParseInputTimestamp(timestamps(i), timezone(i),
+                                             name(), &timestamp_int));
 
       // Construct the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(
-          context, ToTslStatus(name(), functions::ConvertTimestampToDatetime(
-                                           absl::FromUnixMicros(timestamp_int),
-                                           timezone, &datetime_value)));
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), functions::ConvertTimestampToDatetime(
+                                  absl::FromUnixMicros(timestamp_int),
+                                  timezone(i), &datetime_value)));
 
       // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(context,
-                     FormatOutputDatetime(datetime_value, name(), &output_str));
-
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(datetime_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    // Equal timestamps only share a result when the time zone is a scalar.
+    if (timezone.is_scalar()) {
+      OP_REQUIRES_OK(
+          context, ParallelForDistinct(context, timestamps, kCostPerUnit,
+                                       compute_element, output_flat));
+    } else {
+      OP_REQUIRES_OK(context, ParallelFor(context, timestamps.size(),
+                                          kCostPerUnit, compute_element));
     }
   }
+
+ private:
+  TimeZoneCache time_zone_cache_;
 };
 
 class CastToDatetimeFromString : public OpKernel {
@@ -281,34 +295,99 @@ class CastToDatetimeFromString : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = datetime_string.size();
-    for (int i = 0; i < N; i++) {
-      // Convert string to datetime.
+    constexpr int64_t kCostPerUnit =
+        2 * kParseCost + kFormatCost + kComputeCost;
+    if (with_format) {
+      // Compile the format once, then convert the strings a shard at a time.
+      std::shared_ptr<const functions::StringToDatetimeCaster> caster;
+      OP_REQUIRES_OK(context, ParseInputCastFormat(format, name(),
+                                                   &caster_cache_, &caster));
+      const int32_t current_date = functions::CurrentDate(absl::UTCTimeZone());
+      auto compute_shard = [&](int64_t start, int64_t limit,
+                               ShardErrors* errors) {
+        // Convert strings with format.
+        std::vector<DatetimeValue> datetimes(limit - start);
+        errors->AddBatchStatus(caster->CastBatch(
+            ShardStrings(datetime_string, start, limit),
+            functions::kMicroseconds, current_date, absl::MakeSpan(datetimes),
+            errors));
+        // Format datetimes to string.
+        for (int64_t i = 0; i < limit - start; i++) {
+          errors->Add(i, FormatOutputDatetime(datetimes[i], name(),
+                                              &output_flat(start + i)));
+        }
+      };
+      OP_REQUIRES_OK(context, ParallelForShards(context, name(), N,
+                                                kCostPerUnit, compute_shard));
+      return;
+    }
+
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Convert string without format
       DatetimeValue datetime;
-      if (with_format) {
-        // Convert string with format
-        int32_t current_date = functions::CurrentDate(absl::UTCTimeZone());
-        OP_REQUIRES_OK(context,
-                       ToTslStatus(name(), functions::CastStringToDatetime(
-                                               format, datetime_string(i),
-                                               functions::kMicroseconds,
-                                               current_date, &datetime)));
-      } else {
-        // Convert string without format
-        OP_REQUIRES_OK(
-            context,
-            ToTslStatus(name(), functions::ConvertStringToDatetime(
-                                    datetime_string(i),
-                                    functions::kMicroseconds, &datetime)));
-      }
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ConvertStringToDatetime(
+              datetime_string(i), functions::kMicroseconds, &datetime)));
       // Format datetime to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputDatetime(datetime, name(), &out));
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(datetime, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
 
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+ private:
+  CastFormatCache<functions::StringToDatetimeCaster> caster_cache_;
+};
+
+class CastToStringFromDatetime : public OpKernel {
+ public:
+  explicit CastToStringFromDatetime(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime tensor
+    const Tensor& datetime_tensor = context->input(0);
+    auto datetime = datetime_tensor.flat<tstring>();
+    // Grab the format tensor
+    const Tensor& format_tensor = context->input(1);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    std::shared_ptr<const functions::DatetimeToStringCaster> caster;
+    OP_REQUIRES_OK(context, ParseInputCastFormat(format, name(),
+                                                 &caster_cache_, &caster));
+
+    // Create an output tensor with the shape of the datetime tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, datetime_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<tstring>();
+
+    const int N = datetime.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Parse the datetimes.
+      std::vector<DatetimeValue> datetimes(limit - start);
+      for (int64_t i = 0; i < limit - start; i++) {
+        errors->Add(i, ParseInputDatetime(datetime(start + i), name(),
+                                          &datetimes[i]));
+      }
+      // Convert datetimes to string with format.
+      absl::Span<std::string> out = ThreadLocalOutputBuffers(limit - start);
+      errors->AddBatchStatus(caster->CastBatch(datetimes, out, errors));
+      // Set the output values.
+      for (int64_t i = 0; i < limit - start; i++) {
+        output_flat(start + i).assign(out[i].data(), out[i].size());
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
   }
+
+ private:
+  CastFormatCache<functions::DatetimeToStringCaster> caster_cache_;
 };
 
 class DatetimeAdd : public OpKernel {
@@ -337,10 +416,12 @@ class DatetimeAdd : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the datetime tensor.
+    // Create an output tensor with the shape of the datetime tensor, reusing
+    // its buffer when no other op needs it.
     Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context,
+                   context->forward_input_or_allocate_output(
+                       {0}, 0, datetime_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     OP_REQUIRES(
@@ -348,28 +429,27 @@ class DatetimeAdd : public OpKernel {
         absl::InvalidArgumentError("DatetimeAdd expects the same length of "
                                    "datetime and internval inputs."));
     const int N = input_datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context, ParseInputDatetime(input_datetime(i), name(),
-                                                 &datetime_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(input_datetime(i), name(), &datetime_value));
 
       // Add the part of the internal to the datetime.
       DatetimeValue output_datetime;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::AddDatetime(
-                                                      datetime_value, part_enum,
-                                                      input_interval(i),
-                                                      &output_datetime)));
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), functions::AddDatetime(datetime_value, part_enum,
+                                                     input_interval(i),
+                                                     &output_datetime)));
 
       // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(
-          context, FormatOutputDatetime(output_datetime, name(), &output_str));
-
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(output_datetime, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -413,27 +493,30 @@ class DatetimeDiff : public OpKernel {
         absl::InvalidArgumentError("DatetimeDiff expects the same length of "
                                    "datetime_a and datetime_b."));
     const int N = datetime_a.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = 2 * kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime_a.
       DatetimeValue datetime_a_value;
-      OP_REQUIRES_OK(context, ParseInputDatetime(datetime_a(i), name(),
-                                                 &datetime_a_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime_a(i), name(), &datetime_a_value));
 
       // Parse the datetime_b.
       DatetimeValue datetime_b_value;
-      OP_REQUIRES_OK(context, ParseInputDatetime(datetime_b(i), name(),
-                                                 &datetime_b_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime_b(i), name(), &datetime_b_value));
 
       // Get the diff of datetime_a and datetime_b in part.
       int64_t output;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::DiffDatetimes(
-                                             datetime_a_value, datetime_b_value,
-                                             part_enum, &output)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::DiffDatetimes(
+                      datetime_a_value, datetime_b_value, part_enum, &output)));
 
       // Set the output value.
       output_flat(i) = output;
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -463,10 +546,12 @@ class DatetimeSub : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the datetime tensor.
+    // Create an output tensor with the shape of the datetime tensor, reusing
+    // its buffer when no other op needs it.
     Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context,
+                   context->forward_input_or_allocate_output(
+                       {0}, 0, datetime_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     OP_REQUIRES(
@@ -474,28 +559,27 @@ class DatetimeSub : public OpKernel {
         absl::InvalidArgumentError("DatetimeSub expects the same length of "
                                    "datetime and internval inputs."));
     const int N = input_datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context, ParseInputDatetime(input_datetime(i), name(),
-                                                 &datetime_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(input_datetime(i), name(), &datetime_value));
 
       // Add the part of the internal to the datetime.
       DatetimeValue output_datetime;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::SubDatetime(
-                                                      datetime_value, part_enum,
-                                                      input_interval(i),
-                                                      &output_datetime)));
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), functions::SubDatetime(datetime_value, part_enum,
+                                                     input_interval(i),
+                                                     &output_datetime)));
 
       // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(
-          context, FormatOutputDatetime(output_datetime, name(), &output_str));
-
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(output_datetime, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -524,33 +608,45 @@ class DatetimeTrunc : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the datetime tensor.
+    // Create an output tensor with the shape of the datetime tensor, reusing
+    // its buffer when no other op needs it.
     Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context,
+                   context->forward_input_or_allocate_output(
+                       {0}, 0, datetime_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = input_datetime.size();
-    for (int i = 0; i < N; i++) {
-      // Parse the datetime.
-      DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context, ParseInputDatetime(input_datetime(i), name(),
-                                                 &datetime_value));
-
-      DatetimeValue output_datetime;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::TruncateDatetime(
-                                                      datetime_value, part_enum,
-                                                      &output_datetime)));
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Parse the datetimes. A datetime that fails to parse is truncated as
+      // the Unix epoch, and its output is reset with the other failing rows.
+      std::vector<DatetimeValue> datetime_in(limit - start);
+      for (int64_t i = start; i < limit; i++) {
+        ::tsl::Status status = ParseInputDatetime(input_datetime(i), name(),
+                                                  &datetime_in[i - start]);
+        if (!status.ok()) {
+          datetime_in[i - start] =
+              DatetimeValue::FromYMDHMSAndMicros(1970, 1, 1, 0, 0, 0, 0);
+          errors->Add(i - start, std::move(status));
+        }
+      }
 
-      // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(
-          context, FormatOutputDatetime(output_datetime, name(), &output_str));
+      // Truncate the datetimes as a batch, so that consecutive datetimes
+      // within the same part share the work.
+      std::vector<DatetimeValue> datetime_out(limit - start);
+      errors->AddBatchStatus(functions::TruncateDatetimes(
+          datetime_in, part_enum, absl::MakeSpan(datetime_out), errors));
 
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      // Convert the datetimes to string.
+      for (int64_t i = start; i < limit; i++) {
+        errors->Add(i - start, FormatOutputDatetime(datetime_out[i - start],
+                                                    name(), &output_flat(i)));
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
   }
 };
 
@@ -589,23 +685,103 @@ class ExtractFromDatetime : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    const int N = datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context,
-                     ParseInputDatetime(datetime(i), name(), &datetime_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime(i), name(), &datetime_value));
 
       // Extract part from the datetime.
       int32_t out;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ExtractFromDatetime(
-                                             part_enum, datetime_value, &out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ExtractFromDatetime(part_enum, datetime_value, &out)));
 
       // Set the output value.
       output_flat(i) = static_cast<int64_t>(out);
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, datetime, kCostPerUnit,
+                                                compute_element, output_flat));
+  }
+};
+
+class ExtractPartsFromDatetime : public OpKernel {
+ public:
+  explicit ExtractPartsFromDatetime(OpKernelConstruction* context)
+      : OpKernel(context) {
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND,   functions::MILLISECOND,
+             functions::SECOND,        functions::MINUTE,
+             functions::HOUR,          functions::DAYOFWEEK,
+             functions::DAY,           functions::DAYOFYEAR,
+             functions::WEEK,          functions::WEEK_MONDAY,
+             functions::WEEK_TUESDAY,  functions::WEEK_WEDNESDAY,
+             functions::WEEK_THURSDAY, functions::WEEK_FRIDAY,
+             functions::WEEK_SATURDAY, functions::ISOWEEK,
+             functions::MONTH,         functions::QUARTER,
+             functions::YEAR,          functions::ISOYEAR});
+    std::vector<std::string> parts;
+    OP_REQUIRES_OK(context, context->GetAttr("parts", &parts));
+    OP_REQUIRES_OK(context, ParseInputDateTimestampParts(
+                                parts, name(), &parts_, *supported_parts));
   }
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime tensor
+    const Tensor& datetime_tensor = context->input(0);
+    auto datetime = datetime_tensor.flat<tstring>();
+
+    // Create an output tensor with the shape of the datetime tensor and an
+    // innermost dimension for the parts
+    TensorShape output_shape = datetime_tensor.shape();
+    output_shape.AddDim(parts_.size());
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape,
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = datetime.size();
+    const int64_t P = parts_.size();
+    // Each element is parsed once for all the parts.
+    const int64_t cost_per_unit = kParseCost + P * kComputeCost;
+    auto compute_element = [&](int64_t i,
+                               absl::Span<int32_t> out) -> ::tsl::Status {
+      // Parse the datetime.
+      DatetimeValue datetime_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime(i), name(), &datetime_value));
+
+      // Extract the parts from the datetime.
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ExtractPartsFromDatetime(parts_, datetime_value, out)));
+
+      // Set the output values.
+      for (int64_t j = 0; j < P; j++) {
+        output_flat(i * P + j) = static_cast<int64_t>(out[j]);
+      }
+      return ::tsl::OkStatus();
+    };
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      std::vector<int32_t> out(P);
+      for (int64_t i = start; i < limit; i++) {
+        ::tsl::Status status = compute_element(i, absl::MakeSpan(out));
+        if (!status.ok()) {
+          errors->Add(i - start, std::move(status));
+          return;
+        }
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, cost_per_unit,
+                                              compute_shard));
+  }
+
+ private:
+  std::vector<functions::DateTimestampPart> parts_;
 };
 
 class ExtractDateFromDatetime : public OpKernel {
@@ -624,29 +800,29 @@ class ExtractDateFromDatetime : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context,
-                     ParseInputDatetime(datetime(i), name(), &datetime_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime(i), name(), &datetime_value));
 
       // Extract DATE from the datetime.
       int32_t out;
-      OP_REQUIRES_OK(
-          context,
+      TF_RETURN_IF_ERROR(
           ToTslStatus(name(), functions::ExtractFromDatetime(
                                   functions::DATE, datetime_value, &out)));
 
-      std::string output_str;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ConvertDateToString(
-                                             out, &output_str)));
+      std::string& output_str = ThreadLocalOutputBuffer();
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConvertDateToString(out, &output_str)));
 
       // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      output_flat(i).assign(output_str.data(), output_str.size());
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, datetime, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -666,29 +842,24 @@ class ExtractTimeFromDatetime : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context,
-                     ParseInputDatetime(datetime(i), name(), &datetime_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime(i), name(), &datetime_value));
 
       // Extract TIME from the datetime value.
       TimeValue time_value;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ExtractTimeFromDatetime(
-                                             datetime_value, &time_value)));
-
-      std::string output_str;
-      OP_REQUIRES_OK(
-          context, ToTslStatus(name(), functions::ConvertTimeToString(
-                                           time_value, functions::kMicroseconds,
-                                           &output_str)));
-
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(ToTslStatus(name(), functions::ExtractTimeFromDatetime(
+                                                 datetime_value, &time_value)));
+
+      // Format TIME to string, like CAST AS STRING.
+      TF_RETURN_IF_ERROR(FormatOutputTime(time_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, datetime, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -724,32 +895,33 @@ class LastDayFromDatetime : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the datetime tensor.
+    // Create an output tensor with the shape of the datetime tensor, reusing
+    // its buffer when no other op needs it.
     Tensor* output_tensor = nullptr;
-    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context,
+                   context->forward_input_or_allocate_output(
+                       {0}, 0, datetime_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context,
-                     ParseInputDatetime(datetime(i), name(), &datetime_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime(i), name(), &datetime_value));
 
       // Extract LAST_DAY from the datetime value.
       int32_t date_int;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::LastDayOfDatetime(
-                                                      datetime_value, part_enum,
-                                                      &date_int)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::LastDayOfDatetime(datetime_value, part_enum, &date_int)));
 
       // Set the output value.
-      std::string output_str;
-      OP_REQUIRES_OK(context, FormatOutputDate(date_int, name(), &output_str));
-
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputDate(date_int, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, datetime, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -760,7 +932,10 @@ class FormatDatetime : public OpKernel {
   void Compute(OpKernelContext* context) override {
     // Grab the format string tensor
     const Tensor& format_tensor = context->input(0);
-    std::string format = format_tensor.flat<tstring>()(0);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    std::shared_ptr<const functions::DatetimeFormatter> formatter;
+    OP_REQUIRES_OK(context, ParseInputFormat(format, name(), &format_cache_,
+                                             &formatter));
     // Grab the datetime tensor
     const Tensor& datetime_tensor = context->input(1);
     auto datetime = datetime_tensor.flat<tstring>();
@@ -771,30 +946,28 @@ class FormatDatetime : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(context,
-                     ParseInputDatetime(datetime(i), name(), &datetime_value));
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime(i), name(), &datetime_value));
 
       // Format the datetime string.
-      functions::FormatDateTimestampOptions format_options = {
-          .expand_Q = true,
-          .expand_J = true,
-      };
-      std::string out;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(),
-                      functions::FormatDatetimeToStringWithOptions(
-                          format, datetime_value, format_options, &out)));
+      std::string& out = ThreadLocalOutputBuffer();
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), formatter->Format(datetime_value, &out)));
 
       // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      output_flat(i).assign(out.data(), out.size());
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, datetime, kCostPerUnit,
+                                                compute_element, output_flat));
   }
+
+ private:
+  DatetimeFormatterCache format_cache_;
 };
 
 class ParseDatetime : public OpKernel {
@@ -817,26 +990,24 @@ class ParseDatetime : public OpKernel {
                                             &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = datetime_strings.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::ParseStringToDatetime(
-                                  format_string, datetime_strings(i),
-                                  functions::kMicroseconds,
-                                  /*parse_version2=*/true, &datetime_value)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ParseStringToDatetime(
+              format_string, datetime_strings(i), functions::kMicroseconds,
+              /*parse_version2=*/true, &datetime_value)));
 
       // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(context,
-                     FormatOutputDatetime(datetime_value, name(), &output_str));
-
-      // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(datetime_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, datetime_strings, kCostPerUnit,
+                                     compute_element, output_flat));
   }
 };
 
@@ -861,32 +1032,422 @@ class SafeParseDatetime : public OpKernel {
                                             &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
+    // SafeParseDatetimeWithValidity reports failures in a second output
+    // instead of with the NULL-equivalent value.
+    bool* valid = nullptr;
+    DatetimeValue null_datetime;
+    if (num_outputs() > 1) {
+      Tensor* valid_tensor = nullptr;
+      OP_REQUIRES_OK(context,
+                     context->allocate_output(1, datetime_string_tensor.shape(),
+                                              &valid_tensor));
+      valid = valid_tensor->flat<bool>().data();
+    } else {
+      OP_REQUIRES_OK(
+          context,
+          ToTslStatus(name(), functions::ParseStringToDatetime(
+                                  kDatetimeFormatString, kNullDatetime,
+                                  functions::kMicroseconds,
+                                  /*parse_version2=*/true, &null_datetime)));
+    }
+
     const int N = datetime_strings.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue datetime_value;
-      if (!functions::ParseStringToDatetime(
-               format_string, datetime_strings(i), functions::kMicroseconds,
-               /*parse_version2=*/true, &datetime_value)
-               .ok()) {
+      const bool parsed = functions::TryParseStringToDatetime(
+          format_string, datetime_strings(i), functions::kMicroseconds,
+          /*parse_version2=*/true, &datetime_value);
+      if (valid != nullptr) {
+        valid[i] = parsed;
+        if (!parsed) return ::tsl::OkStatus();
+      } else if (!parsed) {
         // Set the NULL-equivalent output value for unsuccessful parsing.
-        OP_REQUIRES_OK(
-            context,
-            ToTslStatus(name(), functions::ParseStringToDatetime(
-                                    kDatetimeFormatString, kNullDatetime,
-                                    functions::kMicroseconds,
-                                    /*parse_version2=*/true, &datetime_value)));
+        datetime_value = null_datetime;
       }
 
       // Convert output_datetime to string.
-      std::string output_str;
-      OP_REQUIRES_OK(context,
-                     FormatOutputDatetime(datetime_value, name(), &output_str));
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(datetime_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class PackedFromDatetime : public OpKernel {
+ public:
+  explicit PackedFromDatetime(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime tensor.
+    const Tensor& datetime_tensor = context->input(0);
+    auto datetime = datetime_tensor.flat<tstring>();
+
+    // Create an output tensor with the shape of the datetime tensor.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = datetime.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Parse the datetime.
+      DatetimeValue datetime_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputDatetime(datetime(i), name(), &datetime_value));
 
       // Set the output value.
-      output_flat(i).reserve(output_str.size());
-      output_flat(i) = std::move(output_str);
-    }
+      output_flat(i) = datetime_value.Packed64DatetimeMicros();
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class DatetimeFromPacked : public OpKernel {
+ public:
+  explicit DatetimeFromPacked(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime tensor.
+    const Tensor& datetime_tensor = context->input(0);
+    auto datetime = datetime_tensor.flat<int64_t>();
+
+    // Create an output tensor with the shape of the datetime tensor.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<tstring>();
+
+    const int N = datetime.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the datetime.
+      DatetimeValue datetime_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputPackedDatetime(datetime(i), name(), &datetime_value));
+
+      // Convert datetime_value to string.
+      TF_RETURN_IF_ERROR(
+          FormatOutputDatetime(datetime_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class DatetimeAddPacked : public OpKernel {
+ public:
+  explicit DatetimeAddPacked(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime tensor.
+    const Tensor& datetime_tensor = context->input(0);
+    auto input_datetime = datetime_tensor.flat<int64_t>();
+
+    // Grab the interval tensor.
+    const Tensor& interval_tensor = context->input(1);
+    auto input_interval = interval_tensor.flat<int64_t>();
+
+    // Grab the part tensor.
+    const Tensor& part_tensor = context->input(2);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR, functions::DAY,
+             functions::WEEK, functions::MONTH, functions::QUARTER,
+             functions::YEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the datetime tensor.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    OP_REQUIRES(
+        context, input_datetime.size() == input_interval.size(),
+        absl::InvalidArgumentError("DatetimeAddPacked expects the same length "
+                                   "of datetime and interval inputs."));
+    const int N = input_datetime.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the datetime.
+      DatetimeValue datetime_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputPackedDatetime(input_datetime(i), name(), &datetime_value));
+
+      // Add the part of the internal to the datetime.
+      DatetimeValue output_datetime;
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), functions::AddDatetime(datetime_value, part_enum,
+                                                     input_interval(i),
+                                                     &output_datetime)));
+
+      // Set the output value.
+      output_flat(i) = output_datetime.Packed64DatetimeMicros();
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class DatetimeDiffPacked : public OpKernel {
+ public:
+  explicit DatetimeDiffPacked(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime_a tensor.
+    const Tensor& datetime_a_tensor = context->input(0);
+    auto datetime_a = datetime_a_tensor.flat<int64_t>();
+
+    // Grab the datetime_b tensor.
+    const Tensor& datetime_b_tensor = context->input(1);
+    auto datetime_b = datetime_b_tensor.flat<int64_t>();
+
+    // Grab the part tensor.
+    const Tensor& part_tensor = context->input(2);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR, functions::DAY,
+             functions::WEEK, functions::WEEK_MONDAY, functions::WEEK_TUESDAY,
+             functions::WEEK_WEDNESDAY, functions::WEEK_THURSDAY,
+             functions::WEEK_FRIDAY, functions::WEEK_SATURDAY,
+             functions::ISOWEEK, functions::MONTH, functions::QUARTER,
+             functions::YEAR, functions::ISOYEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the datetime tensor.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, datetime_a_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    OP_REQUIRES(
+        context, datetime_a.size() == datetime_b.size(),
+        absl::InvalidArgumentError("DatetimeDiffPacked expects the same length "
+                                   "of datetime_a and datetime_b."));
+    const int N = datetime_a.size();
+    constexpr int64_t kCostPerUnit = 2 * kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the datetime_a.
+      DatetimeValue datetime_a_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputPackedDatetime(datetime_a(i), name(), &datetime_a_value));
+
+      // Unpack the datetime_b.
+      DatetimeValue datetime_b_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputPackedDatetime(datetime_b(i), name(), &datetime_b_value));
+
+      // Get the diff of datetime_a and datetime_b in part.
+      int64_t output;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::DiffDatetimes(
+                      datetime_a_value, datetime_b_value, part_enum, &output)));
+
+      // Set the output value.
+      output_flat(i) = output;
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class DatetimeSubPacked : public OpKernel {
+ public:
+  explicit DatetimeSubPacked(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime tensor.
+    const Tensor& datetime_tensor = context->input(0);
+    auto input_datetime = datetime_tensor.flat<int64_t>();
+
+    // Grab the interval tensor.
+    const Tensor& interval_tensor = context->input(1);
+    auto input_interval = interval_tensor.flat<int64_t>();
+
+    // Grab the part tensor.
+    const Tensor& part_tensor = context->input(2);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR, functions::DAY,
+             functions::WEEK, functions::MONTH, functions::QUARTER,
+             functions::YEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the datetime tensor.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    OP_REQUIRES(
+        context, input_datetime.size() == input_interval.size(),
+        absl::InvalidArgumentError("DatetimeSubPacked expects the same length "
+                                   "of datetime and interval inputs."));
+    const int N = input_datetime.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the datetime.
+      DatetimeValue datetime_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputPackedDatetime(input_datetime(i), name(), &datetime_value));
+
+      // Subtract the part of the internal from the datetime.
+      DatetimeValue output_datetime;
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), functions::SubDatetime(datetime_value, part_enum,
+                                                     input_interval(i),
+                                                     &output_datetime)));
+
+      // Set the output value.
+      output_flat(i) = output_datetime.Packed64DatetimeMicros();
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class DatetimeTruncPacked : public OpKernel {
+ public:
+  explicit DatetimeTruncPacked(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime tensor.
+    const Tensor& datetime_tensor = context->input(0);
+    auto input_datetime = datetime_tensor.flat<int64_t>();
+
+    // Grab the part tensor.
+    const Tensor& part_tensor = context->input(1);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR, functions::DAY,
+             functions::WEEK, functions::WEEK_MONDAY, functions::WEEK_TUESDAY,
+             functions::WEEK_WEDNESDAY, functions::WEEK_THURSDAY,
+             functions::WEEK_FRIDAY, functions::WEEK_SATURDAY,
+             functions::ISOWEEK, functions::MONTH, functions::QUARTER,
+             functions::YEAR, functions::ISOYEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the datetime tensor.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = input_datetime.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Unpack the datetimes.
+      std::vector<DatetimeValue> datetime_in;
+      ::tsl::Status status;
+      const int64_t num_valid = ParseInputPackedDatetime(
+          absl::MakeConstSpan(input_datetime.data() + start, limit - start),
+          name(), &datetime_in, &status);
+      errors->Add(num_valid, status);
+
+      // Truncate datetimes.
+      std::vector<DatetimeValue> datetime_out(num_valid);
+      errors->AddBatchStatus(functions::TruncateDatetimes(
+          datetime_in, part_enum, absl::MakeSpan(datetime_out), errors));
+
+      // Set the output values.
+      for (int64_t i = 0; i < num_valid; i++) {
+        output_flat(start + i) = datetime_out[i].Packed64DatetimeMicros();
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
+  }
+};
+
+class ExtractFromDatetimePacked : public OpKernel {
+ public:
+  explicit ExtractFromDatetimePacked(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the datetime tensor.
+    const Tensor& datetime_tensor = context->input(0);
+    auto datetime = datetime_tensor.flat<int64_t>();
+
+    // Grab the part tensor.
+    const Tensor& part_tensor = context->input(1);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND,   functions::MILLISECOND,
+             functions::SECOND,        functions::MINUTE,
+             functions::HOUR,          functions::DAY,
+             functions::DAYOFWEEK,     functions::DAYOFYEAR,
+             functions::WEEK,          functions::WEEK_MONDAY,
+             functions::WEEK_TUESDAY,  functions::WEEK_WEDNESDAY,
+             functions::WEEK_THURSDAY, functions::WEEK_FRIDAY,
+             functions::WEEK_SATURDAY, functions::ISOWEEK,
+             functions::MONTH,         functions::QUARTER,
+             functions::YEAR,          functions::ISOYEAR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the datetime tensor.
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, datetime_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = datetime.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the datetime.
+      DatetimeValue datetime_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputPackedDatetime(datetime(i), name(), &datetime_value));
+
+      // Extract part from the datetime.
+      int32_t out;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ExtractFromDatetime(part_enum, datetime_value, &out)));
+
+      // Set the output value.
+      output_flat(i) = static_cast<int64_t>(out);
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -895,30 +1456,91 @@ REGISTER_KERNEL_BUILDER(Name("DatetimeFromComponents").Device(DEVICE_CPU),
                         DatetimeFromComponents);
 REGISTER_KERNEL_BUILDER(Name("DatetimeFromDate").Device(DEVICE_CPU),
                         DatetimeFromDate);
+REGISTER_KERNEL_BUILDER(Name("DatetimeFromDateWithErrors").Device(DEVICE_CPU),
+                        DatetimeFromDate);
 REGISTER_KERNEL_BUILDER(Name("DatetimeFromDateAndTime").Device(DEVICE_CPU),
                         DatetimeFromDateAndTime);
+REGISTER_KERNEL_BUILDER(
+    Name("DatetimeFromDateAndTimeWithErrors").Device(DEVICE_CPU),
+    DatetimeFromDateAndTime);
 REGISTER_KERNEL_BUILDER(Name("DatetimeFromTimestamp").Device(DEVICE_CPU),
                         DatetimeFromTimestamp);
+REGISTER_KERNEL_BUILDER(
+    Name("DatetimeFromTimestampWithErrors").Device(DEVICE_CPU),
+    DatetimeFromTimestamp);
 REGISTER_KERNEL_BUILDER(Name("CastToDatetimeFromString").Device(DEVICE_CPU),
                         CastToDatetimeFromString);
+REGISTER_KERNEL_BUILDER(
+    Name("CastToDatetimeFromStringWithErrors").Device(DEVICE_CPU),
+    CastToDatetimeFromString);
+REGISTER_KERNEL_BUILDER(Name("CastToStringFromDatetime").Device(DEVICE_CPU),
+                        CastToStringFromDatetime);
+REGISTER_KERNEL_BUILDER(
+    Name("CastToStringFromDatetimeWithErrors").Device(DEVICE_CPU),
+    CastToStringFromDatetime);
 REGISTER_KERNEL_BUILDER(Name("DatetimeAdd").Device(DEVICE_CPU), DatetimeAdd);
+REGISTER_KERNEL_BUILDER(Name("DatetimeAddWithErrors").Device(DEVICE_CPU),
+                        DatetimeAdd);
 REGISTER_KERNEL_BUILDER(Name("DatetimeDiff").Device(DEVICE_CPU), DatetimeDiff);
+REGISTER_KERNEL_BUILDER(Name("DatetimeDiffWithErrors").Device(DEVICE_CPU),
+                        DatetimeDiff);
 REGISTER_KERNEL_BUILDER(Name("DatetimeSub").Device(DEVICE_CPU), DatetimeSub);
+REGISTER_KERNEL_BUILDER(Name("DatetimeSubWithErrors").Device(DEVICE_CPU),
+                        DatetimeSub);
 REGISTER_KERNEL_BUILDER(Name("DatetimeTrunc").Device(DEVICE_CPU),
                         DatetimeTrunc);
+REGISTER_KERNEL_BUILDER(Name("DatetimeTruncWithErrors").Device(DEVICE_CPU),
+                        DatetimeTrunc);
 REGISTER_KERNEL_BUILDER(Name("ExtractFromDatetime").Device(DEVICE_CPU),
                         ExtractFromDatetime);
+REGISTER_KERNEL_BUILDER(
+    Name("ExtractFromDatetimeWithErrors").Device(DEVICE_CPU),
+    ExtractFromDatetime);
+REGISTER_KERNEL_BUILDER(Name("ExtractPartsFromDatetime").Device(DEVICE_CPU),
+                        ExtractPartsFromDatetime);
 REGISTER_KERNEL_BUILDER(Name("ExtractDateFromDatetime").Device(DEVICE_CPU),
                         ExtractDateFromDatetime);
+REGISTER_KERNEL_BUILDER(
+    Name("ExtractDateFromDatetimeWithErrors").Device(DEVICE_CPU),
+    ExtractDateFromDatetime);
 REGISTER_KERNEL_BUILDER(Name("ExtractTimeFromDatetime").Device(DEVICE_CPU),
                         ExtractTimeFromDatetime);
+REGISTER_KERNEL_BUILDER(
+    Name("ExtractTimeFromDatetimeWithErrors").Device(DEVICE_CPU),
+    ExtractTimeFromDatetime);
 REGISTER_KERNEL_BUILDER(Name("LastDayFromDatetime").Device(DEVICE_CPU),
                         LastDayFromDatetime);
+REGISTER_KERNEL_BUILDER(
+    Name("LastDayFromDatetimeWithErrors").Device(DEVICE_CPU),
+    LastDayFromDatetime);
 REGISTER_KERNEL_BUILDER(Name("FormatDatetime").Device(DEVICE_CPU),
                         FormatDatetime);
+REGISTER_KERNEL_BUILDER(Name("FormatDatetimeWithErrors").Device(DEVICE_CPU),
+                        FormatDatetime);
 REGISTER_KERNEL_BUILDER(Name("ParseDatetime").Device(DEVICE_CPU),
                         ParseDatetime);
+REGISTER_KERNEL_BUILDER(Name("ParseDatetimeWithErrors").Device(DEVICE_CPU),
+                        ParseDatetime);
 REGISTER_KERNEL_BUILDER(Name("SafeParseDatetime").Device(DEVICE_CPU),
                         SafeParseDatetime);
+REGISTER_KERNEL_BUILDER(
+    Name("SafeParseDatetimeWithValidity").Device(DEVICE_CPU),
+    SafeParseDatetime);
+REGISTER_KERNEL_BUILDER(Name("PackedFromDatetime").Device(DEVICE_CPU),
+                        PackedFromDatetime);
+REGISTER_KERNEL_BUILDER(Name("PackedFromDatetimeWithErrors").Device(DEVICE_CPU),
+                        PackedFromDatetime);
+REGISTER_KERNEL_BUILDER(Name("DatetimeFromPacked").Device(DEVICE_CPU),
+                        DatetimeFromPacked);
+REGISTER_KERNEL_BUILDER(Name("DatetimeAddPacked").Device(DEVICE_CPU),
+                        DatetimeAddPacked);
+REGISTER_KERNEL_BUILDER(Name("DatetimeDiffPacked").Device(DEVICE_CPU),
+                        DatetimeDiffPacked);
+REGISTER_KERNEL_BUILDER(Name("DatetimeSubPacked").Device(DEVICE_CPU),
+                        DatetimeSubPacked);
+REGISTER_KERNEL_BUILDER(Name("DatetimeTruncPacked").Device(DEVICE_CPU),
+                        DatetimeTruncPacked);
+REGISTER_KERNEL_BUILDER(Name("ExtractFromDatetimePacked").Device(DEVICE_CPU),
+                        ExtractFromDatetimePacked);
 
 }  // namespace bigquery_ml_utils
@@ -21,6 +21,32 @@ from tensorflow.python.framework import load_library
 from tensorflow.python.platform import resource_loader
 
 
+# The library with all the ops.
+_OPS_LIBRARY = "_bigquery_ml_utils_ops.so"
+
+# The libraries the ops used to be split into, now all part of _OPS_LIBRARY.
+_MERGED_LIBRARIES = frozenset([
+    "_date_ops.so",
+    "_datetime_expr_ops.so",
+    "_datetime_ops.so",
+    "_time_ops.so",
+    "_timestamp_ops.so",
+])
+
+_loaded_modules = {}
+
+
+def _load_library(name):
+  try:
+    path = resource_loader.get_path_to_datafile(name)
+    return load_library.load_op_library(path)
+  except:
+    path = os.path.join(
+        get_python_lib(), "bigquery_ml_utils/tensorflow_ops", name
+    )
+    return load_library.load_op_library(path)
+
+
 def load_module(name):
   """Loads the module with the given name.
 
@@ -28,8 +54,12 @@ def load_module(name):
   using Bazel. If that fails, then it attempts to load the module as though
   it was installed in site-packages via PIP.
 
+  Each module is only loaded once per process. The names of the libraries the
+  ops used to be split into, such as "_date_ops.so", load the library with all
+  the ops instead.
+
   Args:
-      name: The name of the module, e.g. "_timestamp_ops.so"
+      name: The name of the module, e.g. "_bigquery_ml_utils_ops.so"
 
   Returns:
       A python module containing the Python wrappers for the Ops.
@@ -37,11 +67,8 @@ def load_module(name):
   Raises:
       RuntimeError: If the library cannot be found.
   """
-  try:
-    path = resource_loader.get_path_to_datafile(name)
-    return load_library.load_op_library(path)
-  except:
-    path = os.path.join(
-        get_python_lib(), "bigquery_ml_utils/tensorflow_ops", name
-    )
-    return load_library.load_op_library(path)
+  if name in _MERGED_LIBRARIES:
+    name = _OPS_LIBRARY
+  if name not in _loaded_modules:
+    _loaded_modules[name] = _load_library(name)
+  return _loaded_modules[name]
@@ -14,9 +14,13 @@
  * limitations under the License.
  */
 
+#include <string>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/platform/errors.h"
 
 namespace bigquery_ml_utils {
 
@@ -45,6 +49,23 @@ REGISTER_OP("TimeFromTimestamp")
       return absl::OkStatus();
     });
 
+// Register TimeFromTimestampWithErrors op with signature.
+// Like TimeFromTimestamp, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("TimeFromTimestampWithErrors")
+    .Input("timestamp: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimeFromDatetime op with signature.
 // Output has the same shape of the datetime.
 REGISTER_OP("TimeFromDatetime")
@@ -55,6 +76,22 @@ REGISTER_OP("TimeFromDatetime")
       return absl::OkStatus();
     });
 
+// Register TimeFromDatetimeWithErrors op with signature.
+// Like TimeFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("TimeFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register CastToTimeFromString op with signature.
 // Output has the same shape of the time_string.
 REGISTER_OP("CastToTimeFromString")
@@ -67,6 +104,54 @@ REGISTER_OP("CastToTimeFromString")
       return absl::OkStatus();
     });
 
+// Register CastToTimeFromStringWithErrors op with signature.
+// Like CastToTimeFromString, but rows that fail produce an empty output string
+// and their error code in error_codes instead of failing the whole batch. Both
+// have the same shape of the input time_string. error_messages has the messages
+// of the first max_error_messages failing rows.
+REGISTER_OP("CastToTimeFromStringWithErrors")
+    .Input("time_string: string")
+    .Input("format_string: string")
+    .Input("with_format: bool")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register CastToStringFromTime op with signature.
+// Output has the same shape of the time.
+REGISTER_OP("CastToStringFromTime")
+    .Input("time: string")
+    .Input("format_string: string")
+    .Output("output: string")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register CastToStringFromTimeWithErrors op with signature.
+// Like CastToStringFromTime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("CastToStringFromTimeWithErrors")
+    .Input("time: string")
+    .Input("format_string: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimeAdd op with signature.
 // Output has the same shape of the time.
 REGISTER_OP("TimeAdd")
@@ -79,6 +164,24 @@ REGISTER_OP("TimeAdd")
       return absl::OkStatus();
     });
 
+// Register TimeAddWithErrors op with signature.
+// Like TimeAdd, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("TimeAddWithErrors")
+    .Input("time: string")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimeSub op with signature.
 // Output has the same shape of the time.
 REGISTER_OP("TimeSub")
@@ -91,6 +194,24 @@ REGISTER_OP("TimeSub")
       return absl::OkStatus();
     });
 
+// Register TimeSubWithErrors op with signature.
+// Like TimeSub, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("TimeSubWithErrors")
+    .Input("time: string")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimeDiff op with signature.
 // Output has the same shape of the times.
 REGISTER_OP("TimeDiff")
@@ -103,6 +224,24 @@ REGISTER_OP("TimeDiff")
       return absl::OkStatus();
     });
 
+// Register TimeDiffWithErrors op with signature.
+// Like TimeDiff, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("TimeDiffWithErrors")
+    .Input("time_a: string")
+    .Input("time_b: string")
+    .Input("part: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimeTrunc op with signature.
 // Output has the same shape of the time.
 REGISTER_OP("TimeTrunc")
@@ -114,6 +253,23 @@ REGISTER_OP("TimeTrunc")
       return absl::OkStatus();
     });
 
+// Register TimeTruncWithErrors op with signature.
+// Like TimeTrunc, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("TimeTruncWithErrors")
+    .Input("time: string")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register ExtractFromTime op with signature.
 // Output has the same shape of the time.
 REGISTER_OP("ExtractFromTime")
@@ -125,6 +281,40 @@ REGISTER_OP("ExtractFromTime")
       return absl::OkStatus();
     });
 
+// Register ExtractFromTimeWithErrors op with signature.
+// Like ExtractFromTime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("ExtractFromTimeWithErrors")
+    .Input("time: string")
+    .Input("part: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register ExtractPartsFromTime op with signature.
+// Output has the shape of the input time with an extra innermost dimension
+// for the parts.
+REGISTER_OP("ExtractPartsFromTime")
+    .Input("time: string")
+    .Attr("parts: list(string) >= 1")
+    .Output("parts_out: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      std::vector<std::string> parts;
+      TF_RETURN_IF_ERROR(c->GetAttr("parts", &parts));
+      ::tensorflow::shape_inference::ShapeHandle output;
+      TF_RETURN_IF_ERROR(
+          c->Concatenate(c->input(0), c->Vector(parts.size()), &output));
+      c->set_output(0, output);
+      return absl::OkStatus();
+    });
+
 // Register ParseTime op with signature.
 // Output has the same shape of the time_string.
 REGISTER_OP("ParseTime")
@@ -136,6 +326,25 @@ REGISTER_OP("ParseTime")
       return absl::OkStatus();
     });
 
+// Register ParseTimeWithErrors op with signature.
+// Like ParseTime, but rows that fail produce an empty output string and their
+// error code in error_codes instead of failing the whole batch. Both have the
+// same shape of the input time_string. error_messages has the messages of the
+// first max_error_messages failing rows.
+REGISTER_OP("ParseTimeWithErrors")
+    .Input("format_string: string")
+    .Input("time_string: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register SafeParseTime op with signature.
 // Output has the same shape of the time_string.
 REGISTER_OP("SafeParseTime")
@@ -147,6 +356,21 @@ REGISTER_OP("SafeParseTime")
       return absl::OkStatus();
     });
 
+// Register SafeParseTimeWithValidity op with signature.
+// Like SafeParseTime, but rows that fail to parse produce an empty output
+// string and false in valid, instead of the NULL-equivalent value.  Both
+// outputs have the same shape of the input time_string.
+REGISTER_OP("SafeParseTimeWithValidity")
+    .Input("format_string: string")
+    .Input("time_string: string")
+    .Output("output: string")
+    .Output("valid: bool")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      return absl::OkStatus();
+    });
+
 // Register FormatTime op with signature.
 // Output has the same shape of the time.
 REGISTER_OP("FormatTime")
@@ -158,4 +382,115 @@ REGISTER_OP("FormatTime")
       return absl::OkStatus();
     });
 
+// Register FormatTimeWithErrors op with signature.
+// Like FormatTime, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("FormatTimeWithErrors")
+    .Input("format_string: string")
+    .Input("time: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register PackedFromTime op with signature.
+// Output has the same shape of the input time.
+REGISTER_OP("PackedFromTime")
+    .Input("time: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register PackedFromTimeWithErrors op with signature.
+// Like PackedFromTime, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("PackedFromTimeWithErrors")
+    .Input("time: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register TimeFromPacked op with signature.
+// Output has the same shape of the input time.
+REGISTER_OP("TimeFromPacked")
+    .Input("time: int64")
+    .Output("output: string")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register TimeAddPacked op with signature.
+// Output has the same shape of the input time.
+REGISTER_OP("TimeAddPacked")
+    .Input("time: int64")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register TimeSubPacked op with signature.
+// Output has the same shape of the input time.
+REGISTER_OP("TimeSubPacked")
+    .Input("time: int64")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register TimeDiffPacked op with signature.
+// Output has the same shape of the input time.
+REGISTER_OP("TimeDiffPacked")
+    .Input("time_a: int64")
+    .Input("time_b: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register TimeTruncPacked op with signature.
+// Output has the same shape of the input time.
+REGISTER_OP("TimeTruncPacked")
+    .Input("time: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register ExtractFromTimePacked op with signature.
+// Output has the same shape of the input time.
+REGISTER_OP("ExtractFromTimePacked")
+    .Input("time: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
 }  // namespace bigquery_ml_utils
@@ -14,11 +14,13 @@
 
 """Python wrapper for BQML time custom ops."""
 
+from bigquery_ml_utils.tensorflow_ops.composite_tensors import supports_composite_tensors
 from bigquery_ml_utils.tensorflow_ops.load_module import load_module
 
-gen_time_ops = load_module("_time_ops.so")
+gen_time_ops = load_module("_bigquery_ml_utils_ops.so")
 
 
+@supports_composite_tensors
 def time_from_components(hour, minute, second, name=None):
   """Returns a time using INT64 values representing the hour, minute, and second.
 
@@ -35,6 +37,7 @@ def time_from_components(hour, minute, second, name=None):
   )
 
 
+@supports_composite_tensors
 def time_from_timestamp(timestamp, time_zone="UTC", name=None):
   """Returns a time from a timestamp.
 
@@ -50,6 +53,32 @@ def time_from_timestamp(timestamp, time_zone="UTC", name=None):
   )
 
 
+def time_from_timestamp_with_errors(
+    timestamp, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like time_from_timestamp, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    time_zone: A string represents the timezone. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.time_from_timestamp_with_errors(
+      timestamp=timestamp,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def time_from_datetime(datetime, name=None):
   """Returns a time from a datetime.
 
@@ -62,6 +91,28 @@ def time_from_datetime(datetime, name=None):
   return gen_time_ops.time_from_datetime(datetime=datetime, name=name)
 
 
+def time_from_datetime_with_errors(datetime, max_error_messages=16, name=None):
+  """Like time_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.time_from_datetime_with_errors(
+      datetime=datetime,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def cast_to_time_from_string(time_string, format_string=None, name=None):
   """Returns a time by casting a string.
 
@@ -84,6 +135,82 @@ def cast_to_time_from_string(time_string, format_string=None, name=None):
   )
 
 
+def cast_to_time_from_string_with_errors(
+    time_string, format_string=None, max_error_messages=16, name=None
+):
+  """Like cast_to_time_from_string, but reports per-row errors.
+
+  Args:
+    time_string: tf.Tensor of type string. The string must conform to the
+      supported time literal format, and is independent of time zone. If the
+      string expression is invalid or represents a time that is outside of the
+      supported min/max range, then an error is produced.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.cast_to_time_from_string_with_errors(
+      time_string=time_string,
+      format_string="" if format_string is None else format_string,
+      with_format=format_string is not None,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def cast_to_string_from_time(time, format_string, name=None):
+  """Returns a string by casting a time with a format.
+
+  Equivalent SQL: CAST(time AS STRING FORMAT format_string)
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    name: An optional name for the op.
+  """
+  return gen_time_ops.cast_to_string_from_time(
+      time=time,
+      format_string=format_string,
+      name=name,
+  )
+
+
+def cast_to_string_from_time_with_errors(
+    time, format_string, max_error_messages=16, name=None
+):
+  """Like cast_to_string_from_time, but reports per-row errors.
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.cast_to_string_from_time_with_errors(
+      time=time,
+      format_string=format_string,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def time_add(time, interval, part, name=None):
   """Returns a time by adding interval to the time..
 
@@ -101,6 +228,35 @@ def time_add(time, interval, part, name=None):
   )
 
 
+def time_add_with_errors(
+    time, interval, part, max_error_messages=16, name=None
+):
+  """Like time_add, but reports per-row errors.
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.time_add_with_errors(
+      time=time,
+      interval=interval,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def time_sub(time, interval, part, name=None):
   """Returns a time by subtracting interval to the time.
 
@@ -118,6 +274,35 @@ def time_sub(time, interval, part, name=None):
   )
 
 
+def time_sub_with_errors(
+    time, interval, part, max_error_messages=16, name=None
+):
+  """Like time_sub, but reports per-row errors.
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.time_sub_with_errors(
+      time=time,
+      interval=interval,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def time_diff(time_a, time_b, part, name=None):
   """Returns the whole number of specified part intervals between two times.
 
@@ -135,6 +320,35 @@ def time_diff(time_a, time_b, part, name=None):
   )
 
 
+def time_diff_with_errors(
+    time_a, time_b, part, max_error_messages=16, name=None
+):
+  """Like time_diff, but reports per-row errors.
+
+  Args:
+    time_a: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    time_b: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.time_diff_with_errors(
+      time_a=time_a,
+      time_b=time_b,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def time_trunc(time, part, name=None):
   """Returns a time by truncating a time to the granularity of part.
 
@@ -149,6 +363,31 @@ def time_trunc(time, part, name=None):
   return gen_time_ops.time_trunc(time=time, part=part, name=name)
 
 
+def time_trunc_with_errors(time, part, max_error_messages=16, name=None):
+  """Like time_trunc, but reports per-row errors.
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.time_trunc_with_errors(
+      time=time,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def extract_from_time(time, part, name=None):
   """Returns a value that corresponds to the specified part from a supplied time.
 
@@ -163,6 +402,49 @@ def extract_from_time(time, part, name=None):
   return gen_time_ops.extract_from_time(time=time, part=part, name=name)
 
 
+def extract_from_time_with_errors(time, part, max_error_messages=16, name=None):
+  """Like extract_from_time, but reports per-row errors.
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.extract_from_time_with_errors(
+      time=time,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+def extract_parts_from_time(time, parts, name=None):
+  """Returns several parts from a supplied time, parsing each time once.
+
+  Equivalent SQL: EXTRACT(part FROM time_expression) for each part in parts.
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    parts: A non-empty list of strings represents the time parts, with the
+      values accepted by extract_from_time.
+    name: An optional name for the op.
+
+  Returns:
+    A tf.Tensor of type int64 with the shape of time and an extra innermost
+    dimension, holding the value of parts[i] at index i.
+  """
+  return gen_time_ops.extract_parts_from_time(time=time, parts=parts, name=name)
+
+
+@supports_composite_tensors
 def parse_time(format_string, time_string, name=None):
   """Returns a time by parsing a string representation of time.
 
@@ -178,6 +460,29 @@ def parse_time(format_string, time_string, name=None):
   )
 
 
+def parse_time_with_errors(
+    format_string, time_string, max_error_messages=16, name=None
+):
+  """Like parse_time, but reports per-row errors.
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the string time.
+    time_string: tf.Tensor of type string. Time in any supported format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.parse_time_with_errors(
+      format_string=format_string, time_string=time_string, name=name
+  )
+
+
+@supports_composite_tensors
 def safe_parse_time(format_string, time_string, name=None):
   """Returns a time by safely parsing a string representation of time.
 
@@ -194,6 +499,28 @@ def safe_parse_time(format_string, time_string, name=None):
   )
 
 
+@supports_composite_tensors
+def safe_parse_time_with_validity(format_string, time_string, name=None):
+  """Returns times by safely parsing strings, and whether each one parsed.
+
+  Like safe_parse_time, but unsuccessful parsing produces an empty string and
+  False in the validity tensor instead of "12:34:56.123456".
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the string time.
+    time_string: tf.Tensor of type string. Time in any supported format.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, valid) of a string tf.Tensor and a bool tf.Tensor, both
+    with the shape of time_string.
+  """
+  return gen_time_ops.safe_parse_time_with_validity(
+      format_string=format_string, time_string=time_string, name=name
+  )
+
+
+@supports_composite_tensors
 def format_time(format_string, time, name=None):
   """Returns a time by parsing a string representation of time.
 
@@ -207,3 +534,158 @@ def format_time(format_string, time, name=None):
   return gen_time_ops.format_time(
       format_string=format_string, time=time, name=name
   )
+
+
+def format_time_with_errors(
+    format_string, time, max_error_messages=16, name=None
+):
+  """Like format_time, but reports per-row errors.
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the string time.
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.format_time_with_errors(
+      format_string=format_string,
+      time=time,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def packed_from_time(time, name=None):
+  """Returns the bit-packed int64 encoding of a TIME.
+
+  The packed encoding is accepted by the *_packed time ops, which skip string
+  parsing and formatting. Use time_from_packed to convert back.
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    name: An optional name for the op.
+  """
+  return gen_time_ops.packed_from_time(time=time, name=name)
+
+
+def packed_from_time_with_errors(time, max_error_messages=16, name=None):
+  """Like packed_from_time, but reports per-row errors.
+
+  Args:
+    time: tf.Tensor of type string. Time in "%H:%M:%E6S" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_time_ops.packed_from_time_with_errors(
+      time=time,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def time_from_packed(time, name=None):
+  """Returns a TIME string from its bit-packed int64 encoding.
+
+  Args:
+    time: tf.Tensor of type int64. Packed time as returned by packed_from_time.
+    name: An optional name for the op.
+  """
+  return gen_time_ops.time_from_packed(time=time, name=name)
+
+
+@supports_composite_tensors
+def time_add_packed(time, interval, part, name=None):
+  """Returns a packed time by adding interval to the time.
+
+  Equivalent SQL: TIME_ADD(time_expression, INTERVAL int64_expression part)
+
+  Args:
+    time: tf.Tensor of type int64. Packed time.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_time_ops.time_add_packed(
+      time=time, interval=interval, part=part, name=name
+  )
+
+
+@supports_composite_tensors
+def time_sub_packed(time, interval, part, name=None):
+  """Returns a packed time by subtracting interval to the time.
+
+  Equivalent SQL: TIME_SUB(time_expression, INTERVAL int64_expression part)
+
+  Args:
+    time: tf.Tensor of type int64. Packed time.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_time_ops.time_sub_packed(
+      time=time, interval=interval, part=part, name=name
+  )
+
+
+@supports_composite_tensors
+def time_diff_packed(time_a, time_b, part, name=None):
+  """Returns the whole number of specified part intervals between two times.
+
+  Equivalent SQL: TIME_DIFF(time_expression_a, time_expression_b, part)
+
+  Args:
+    time_a: tf.Tensor of type int64. Packed time.
+    time_b: tf.Tensor of type int64. Packed time.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_time_ops.time_diff_packed(
+      time_a=time_a, time_b=time_b, part=part, name=name
+  )
+
+
+@supports_composite_tensors
+def time_trunc_packed(time, part, name=None):
+  """Returns a packed time by truncating a time to the granularity of part.
+
+  Equivalent SQL: TIME_TRUNC(time_expression, time_part)
+
+  Args:
+    time: tf.Tensor of type int64. Packed time.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_time_ops.time_trunc_packed(time=time, part=part, name=name)
+
+
+@supports_composite_tensors
+def extract_from_time_packed(time, part, name=None):
+  """Returns a value that corresponds to the specified part from a packed time.
+
+  Equivalent SQL: EXTRACT(part FROM time_expression)
+
+  Args:
+    time: tf.Tensor of type int64. Packed time.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_time_ops.extract_from_time_packed(time=time, part=part, name=name)
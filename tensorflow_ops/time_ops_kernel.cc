@@ -16,13 +16,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "sql_utils/public/civil_time.h"
 #include "sql_utils/public/functions/cast_date_time.h"
 #include "sql_utils/public/functions/date_time_util.h"
@@ -42,6 +45,7 @@ using ::tensorflow::OpKernel;
 using ::tensorflow::OpKernelConstruction;
 using ::tensorflow::OpKernelContext;
 using ::tensorflow::Tensor;
+using ::tensorflow::TensorShape;
 using ::tensorflow::tstring;
 using ::tensorflow::errors::InvalidArgument;
 
@@ -77,21 +81,20 @@ class TimeFromComponents : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = hour.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the time.
       TimeValue time;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::ConstructTime(
-                                                      hour(i), minute(i),
-                                                      second(i), &time)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ConstructTime(hour(i), minute(i), second(i), &time)));
 
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(time, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTime(time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -114,29 +117,26 @@ class TimeFromTimestamp : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(
-          context,
+      TF_RETURN_IF_ERROR(
           ParseInputTimestamp(timestamp(i), absl::UTCTimeZone(), name(), &ts));
 
       // Extract time from timestamp.
       TimeValue time;
-      OP_REQUIRES_OK(
-          context,
+      TF_RETURN_IF_ERROR(
           ToTslStatus(name(), functions::ConvertTimestampToTime(
                                   absl::FromUnixMicros(ts), time_zone, &time)));
 
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(time, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTime(time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                     compute_element, output_flat));
   }
 };
 
@@ -156,26 +156,23 @@ class TimeFromDatetime : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue dt;
-      OP_REQUIRES_OK(context, ParseInputDatetime(datetime(i), name(), &dt));
+      TF_RETURN_IF_ERROR(ParseInputDatetime(datetime(i), name(), &dt));
 
       // Extract time from datetime.
       TimeValue time;
-      OP_REQUIRES_OK(
-          context,
+      TF_RETURN_IF_ERROR(
           ToTslStatus(name(), functions::ExtractTimeFromDatetime(dt, &time)));
 
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(time, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTime(time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, datetime, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -202,31 +199,94 @@ class CastToTimeFromString : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = time_string.size();
-    for (int i = 0; i < N; i++) {
-      // Convert string to time.
+    constexpr int64_t kCostPerUnit =
+        2 * kParseCost + kFormatCost + kComputeCost;
+    if (with_format) {
+      // Compile the format once, then convert the strings a shard at a time.
+      std::shared_ptr<const functions::StringToTimeCaster> caster;
+      OP_REQUIRES_OK(context, ParseInputCastFormat(format, name(),
+                                                   &caster_cache_, &caster));
+      auto compute_shard = [&](int64_t start, int64_t limit,
+                               ShardErrors* errors) {
+        // Convert strings with format.
+        std::vector<TimeValue> times(limit - start);
+        errors->AddBatchStatus(caster->CastBatch(
+            ShardStrings(time_string, start, limit), functions::kMicroseconds,
+            absl::MakeSpan(times), errors));
+        // Format times to string.
+        for (int64_t i = 0; i < limit - start; i++) {
+          errors->Add(
+              i, FormatOutputTime(times[i], name(), &output_flat(start + i)));
+        }
+      };
+      OP_REQUIRES_OK(context, ParallelForShards(context, name(), N,
+                                                kCostPerUnit, compute_shard));
+      return;
+    }
+
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Convert string without format
       TimeValue time;
-      if (with_format) {
-        // Convert string with format
-        OP_REQUIRES_OK(
-            context, ToTslStatus(name(), functions::CastStringToTime(
-                                             format, time_string(i),
-                                             functions::kMicroseconds, &time)));
-      } else {
-        // Convert string without format
-        OP_REQUIRES_OK(
-            context, ToTslStatus(name(), functions::ConvertStringToTime(
-                                             time_string(i),
-                                             functions::kMicroseconds, &time)));
-      }
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConvertStringToTime(
+                      time_string(i), functions::kMicroseconds, &time)));
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(time, name(), &out));
+      TF_RETURN_IF_ERROR(FormatOutputTime(time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
 
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+ private:
+  CastFormatCache<functions::StringToTimeCaster> caster_cache_;
+};
+
+class CastToStringFromTime : public OpKernel {
+ public:
+  explicit CastToStringFromTime(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time tensor
+    const Tensor& time_tensor = context->input(0);
+    auto time = time_tensor.flat<tstring>();
+    // Grab the format tensor
+    const Tensor& format_tensor = context->input(1);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    std::shared_ptr<const functions::TimeToStringCaster> caster;
+    OP_REQUIRES_OK(context, ParseInputCastFormat(format, name(),
+                                                 &caster_cache_, &caster));
+
+    // Create an output tensor with the shape of the time tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, time_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<tstring>();
+
+    const int N = time.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Parse the times.
+      std::vector<TimeValue> times(limit - start);
+      for (int64_t i = 0; i < limit - start; i++) {
+        errors->Add(i, ParseInputTime(time(start + i), name(), &times[i]));
+      }
+      // Convert times to string with format.
+      absl::Span<std::string> out = ThreadLocalOutputBuffers(limit - start);
+      errors->AddBatchStatus(caster->CastBatch(times, out, errors));
+      // Set the output values.
+      for (int64_t i = 0; i < limit - start; i++) {
+        output_flat(start + i).assign(out[i].data(), out[i].size());
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
   }
+
+ private:
+  CastFormatCache<functions::TimeToStringCaster> caster_cache_;
 };
 
 ::tsl::Status TimeAddOperator(TimeValue& time, int64_t interval,
@@ -263,31 +323,31 @@ class TimeAdd : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the time tensor
+    // Create an output tensor with the shape of the time tensor, reusing its
+    // buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, time_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = time.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the time.
       TimeValue time_value;
-      OP_REQUIRES_OK(context, ParseInputTime(time(i), name(), &time_value));
+      TF_RETURN_IF_ERROR(ParseInputTime(time(i), name(), &time_value));
 
       // Extract time from datetime.
       TimeValue out_time;
-      OP_REQUIRES_OK(context, TimeAddOperator(time_value, interval_int(i),
-                                              part_enum, name(), &out_time));
+      TF_RETURN_IF_ERROR(TimeAddOperator(
+          time_value, interval_int(i), part_enum, name(), &out_time));
 
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(out_time, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTime(out_time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -318,31 +378,31 @@ class TimeSub : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the time tensor
+    // Create an output tensor with the shape of the time tensor, reusing its
+    // buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, time_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = time.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the time.
       TimeValue time_value;
-      OP_REQUIRES_OK(context, ParseInputTime(time(i), name(), &time_value));
+      TF_RETURN_IF_ERROR(ParseInputTime(time(i), name(), &time_value));
 
       // Extract time from datetime.
       TimeValue out_time;
-      OP_REQUIRES_OK(context, TimeAddOperator(time_value, -interval_int(i),
-                                              part_enum, name(), &out_time));
+      TF_RETURN_IF_ERROR(TimeAddOperator(
+          time_value, -interval_int(i), part_enum, name(), &out_time));
 
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(out_time, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTime(out_time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -380,23 +440,26 @@ class TimeDiff : public OpKernel {
     auto output_flat = output_tensor->flat<int64_t>();
 
     const int N = time_a.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = 2 * kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the time.
       TimeValue time_a_value;
-      OP_REQUIRES_OK(context, ParseInputTime(time_a(i), name(), &time_a_value));
+      TF_RETURN_IF_ERROR(ParseInputTime(time_a(i), name(), &time_a_value));
       TimeValue time_b_value;
-      OP_REQUIRES_OK(context, ParseInputTime(time_b(i), name(), &time_b_value));
+      TF_RETURN_IF_ERROR(ParseInputTime(time_b(i), name(), &time_b_value));
 
       // Compute diff.
       int64_t out;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::DiffTimes(time_a_value, time_b_value,
-                                                   part_enum, &out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::DiffTimes(time_a_value, time_b_value, part_enum, &out)));
 
       // Set the output value.
       output_flat(i) = out;
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -419,32 +482,30 @@ class TimeTrunc : public OpKernel {
     OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
                                 part, name(), &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the time tensor
+    // Create an output tensor with the shape of the time tensor, reusing its
+    // buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
-                                                     &output_tensor));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, time_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = time.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the time.
       TimeValue time_value;
-      OP_REQUIRES_OK(context, ParseInputTime(time(i), name(), &time_value));
+      TF_RETURN_IF_ERROR(ParseInputTime(time(i), name(), &time_value));
 
       // Extract time from datetime.
       TimeValue out_time;
-      OP_REQUIRES_OK(
-          context, ToTslStatus(name(), functions::TruncateTime(
-                                           time_value, part_enum, &out_time)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::TruncateTime(time_value, part_enum, &out_time)));
 
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(out_time, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTime(out_time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, time, kCostPerUnit,
+                                                compute_element, output_flat));
   }
 };
 
@@ -473,23 +534,92 @@ class ExtractFromTime : public OpKernel {
                                                      &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    const int N = time.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the time.
       TimeValue time_value;
-      OP_REQUIRES_OK(context, ParseInputTime(time(i), name(), &time_value));
+      TF_RETURN_IF_ERROR(ParseInputTime(time(i), name(), &time_value));
 
       // Extract time from datetime.
       int32_t out;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ExtractFromTime(
-                                             part_enum, time_value, &out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractFromTime(part_enum, time_value, &out)));
 
       // Set the output value.
       // Currently, BQML util inference only supports int64.
       output_flat(i) = static_cast<int64_t>(out);
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, time, kCostPerUnit,
+                                                compute_element, output_flat));
+  }
+};
+
+class ExtractPartsFromTime : public OpKernel {
+ public:
+  explicit ExtractPartsFromTime(OpKernelConstruction* context)
+      : OpKernel(context) {
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR});
+    std::vector<std::string> parts;
+    OP_REQUIRES_OK(context, context->GetAttr("parts", &parts));
+    OP_REQUIRES_OK(context, ParseInputDateTimestampParts(
+                                parts, name(), &parts_, *supported_parts));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time tensor
+    const Tensor& time_tensor = context->input(0);
+    auto time = time_tensor.flat<tstring>();
+
+    // Create an output tensor with the shape of the time tensor and an
+    // innermost dimension for the parts
+    TensorShape output_shape = time_tensor.shape();
+    output_shape.AddDim(parts_.size());
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape,
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = time.size();
+    const int64_t P = parts_.size();
+    // Each element is parsed once for all the parts.
+    const int64_t cost_per_unit = kParseCost + P * kComputeCost;
+    auto compute_element = [&](int64_t i,
+                               absl::Span<int32_t> out) -> ::tsl::Status {
+      // Parse the time.
+      TimeValue time_value;
+      TF_RETURN_IF_ERROR(ParseInputTime(time(i), name(), &time_value));
+
+      // Extract the parts from the time.
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractPartsFromTime(parts_, time_value, out)));
+
+      // Set the output values.
+      for (int64_t j = 0; j < P; j++) {
+        output_flat(i * P + j) = static_cast<int64_t>(out[j]);
+      }
+      return ::tsl::OkStatus();
+    };
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      std::vector<int32_t> out(P);
+      for (int64_t i = start; i < limit; i++) {
+        ::tsl::Status status = compute_element(i, absl::MakeSpan(out));
+        if (!status.ok()) {
+          errors->Add(i - start, std::move(status));
+          return;
+        }
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, cost_per_unit,
+                                              compute_shard));
   }
+
+ private:
+  std::vector<functions::DateTimestampPart> parts_;
 };
 
 class ParseTime : public OpKernel {
@@ -510,23 +640,22 @@ class ParseTime : public OpKernel {
                                 0, time_string_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = time_string.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse time.
       TimeValue out_time;
-      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::ParseStringToTime(
-                                                      format, time_string(i),
-                                                      functions::kMicroseconds,
-                                                      &out_time)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ParseStringToTime(
+              format, time_string(i), functions::kMicroseconds, &out_time)));
 
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(out_time, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTime(out_time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, time_string, kCostPerUnit,
+                                     compute_element, output_flat));
   }
 };
 
@@ -548,29 +677,45 @@ class SafeParseTime : public OpKernel {
                                 0, time_string_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
+    // SafeParseTimeWithValidity reports failures in a second output instead
+    // of with the NULL-equivalent value.
+    bool* valid = nullptr;
+    TimeValue null_time;
+    if (num_outputs() > 1) {
+      Tensor* valid_tensor = nullptr;
+      OP_REQUIRES_OK(context,
+                     context->allocate_output(1, time_string_tensor.shape(),
+                                              &valid_tensor));
+      valid = valid_tensor->flat<bool>().data();
+    } else {
+      OP_REQUIRES_OK(context, ToTslStatus(name(), functions::ParseStringToTime(
+                                                      kTimeFormatString,
+                                                      kNullTime,
+                                                      functions::kMicroseconds,
+                                                      &null_time)));
+    }
+
     const int N = time_string.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse time.
       TimeValue out_time;
-      if (!functions::ParseStringToTime(format, time_string(i),
-                                        functions::kMicroseconds, &out_time)
-               .ok()) {
+      const bool parsed = functions::TryParseStringToTime(
+          format, time_string(i), functions::kMicroseconds, &out_time);
+      if (valid != nullptr) {
+        valid[i] = parsed;
+        if (!parsed) return ::tsl::OkStatus();
+      } else if (!parsed) {
         // Set the NULL-equivalent output value for unsuccessful parsing.
-        OP_REQUIRES_OK(
-            context,
-            ToTslStatus(name(), functions::ParseStringToTime(
-                                    kTimeFormatString, kNullTime,
-                                    functions::kMicroseconds, &out_time)));
+        out_time = null_time;
       }
 
       // Format time to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTime(out_time, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTime(out_time, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -581,7 +726,10 @@ class FormatTime : public OpKernel {
   void Compute(OpKernelContext* context) override {
     // Grab the format tensor
     const Tensor& format_tensor = context->input(0);
-    std::string format = format_tensor.flat<tstring>()(0);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    std::shared_ptr<const functions::TimeFormatter> formatter;
+    OP_REQUIRES_OK(context, ParseInputFormat(format, name(), &format_cache_,
+                                             &formatter));
     // Grab the time tensor
     const Tensor& time_string_tensor = context->input(1);
     auto time = time_string_tensor.flat<tstring>();
@@ -592,22 +740,350 @@ class FormatTime : public OpKernel {
                                 0, time_string_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = time.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the time.
       TimeValue time_value;
-      OP_REQUIRES_OK(context, ParseInputTime(time(i), name(), &time_value));
+      TF_RETURN_IF_ERROR(ParseInputTime(time(i), name(), &time_value));
 
       // Format time.
-      std::string out;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::FormatTimeToString(
-                                             format, time_value, &out)));
+      std::string& out = ThreadLocalOutputBuffer();
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), formatter->Format(time_value, &out)));
 
       // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      output_flat(i).assign(out.data(), out.size());
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, time, kCostPerUnit,
+                                                compute_element, output_flat));
+  }
+
+ private:
+  TimeFormatterCache format_cache_;
+};
+
+class PackedFromTime : public OpKernel {
+ public:
+  explicit PackedFromTime(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time tensor
+    const Tensor& time_tensor = context->input(0);
+    auto time = time_tensor.flat<tstring>();
+
+    // Create an output tensor with the shape of the time tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = time.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Parse the time.
+      TimeValue time_value;
+      TF_RETURN_IF_ERROR(ParseInputTime(time(i), name(), &time_value));
+
+      // Set the output value.
+      output_flat(i) = time_value.Packed64TimeMicros();
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class TimeFromPacked : public OpKernel {
+ public:
+  explicit TimeFromPacked(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time tensor
+    const Tensor& time_tensor = context->input(0);
+    auto time = time_tensor.flat<int64_t>();
+
+    // Create an output tensor with the shape of the time tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<tstring>();
+
+    const int N = time.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the time.
+      TimeValue time_value;
+      TF_RETURN_IF_ERROR(ParseInputPackedTime(time(i), name(), &time_value));
+
+      // Format time to string.
+      TF_RETURN_IF_ERROR(FormatOutputTime(time_value, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class TimeAddPacked : public OpKernel {
+ public:
+  explicit TimeAddPacked(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time tensor
+    const Tensor& time_tensor = context->input(0);
+    auto time = time_tensor.flat<int64_t>();
+    // Grab the interval tensor
+    const Tensor& diff_tensor = context->input(1);
+    auto interval_int = diff_tensor.flat<int64_t>();
+    OP_REQUIRES(context, time.size() == interval_int.size(),
+                InvalidArgument(absl::Substitute(
+                    "Error in $0: time and interval must have the same shape, "
+                    "but are $1, $2",
+                    name(), time.size(), interval_int.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the time tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = time.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the time.
+      TimeValue time_value;
+      TF_RETURN_IF_ERROR(ParseInputPackedTime(time(i), name(), &time_value));
+
+      // Add interval to the time.
+      TimeValue out_time;
+      TF_RETURN_IF_ERROR(TimeAddOperator(
+          time_value, interval_int(i), part_enum, name(), &out_time));
+
+      // Set the output value.
+      output_flat(i) = out_time.Packed64TimeMicros();
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class TimeSubPacked : public OpKernel {
+ public:
+  explicit TimeSubPacked(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time tensor
+    const Tensor& time_tensor = context->input(0);
+    auto time = time_tensor.flat<int64_t>();
+    // Grab the interval tensor
+    const Tensor& diff_tensor = context->input(1);
+    auto interval_int = diff_tensor.flat<int64_t>();
+    OP_REQUIRES(context, interval_int.size() == time.size(),
+                InvalidArgument(absl::Substitute(
+                    "Error in $0: time and interval must have the same shape, "
+                    "but are $1, $2",
+                    name(), time.size(), interval_int.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the time tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = time.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the time.
+      TimeValue time_value;
+      TF_RETURN_IF_ERROR(ParseInputPackedTime(time(i), name(), &time_value));
+
+      // Subtract interval from the time.
+      TimeValue out_time;
+      TF_RETURN_IF_ERROR(TimeAddOperator(
+          time_value, -interval_int(i), part_enum, name(), &out_time));
+
+      // Set the output value.
+      output_flat(i) = out_time.Packed64TimeMicros();
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class TimeDiffPacked : public OpKernel {
+ public:
+  explicit TimeDiffPacked(OpKernelConstruction* context) : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time_a tensor
+    const Tensor& time_a_tensor = context->input(0);
+    auto time_a = time_a_tensor.flat<int64_t>();
+    // Grab the time_b tensor
+    const Tensor& time_b_tensor = context->input(1);
+    auto time_b = time_b_tensor.flat<int64_t>();
+    OP_REQUIRES(context, time_a.size() == time_b.size(),
+                InvalidArgument(absl::Substitute(
+                    "Error in $0: time_a and time_b must have the same shape, "
+                    "but are $1, $2",
+                    name(), time_a.size(), time_b.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the time tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, time_a_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = time_a.size();
+    constexpr int64_t kCostPerUnit = 2 * kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the times.
+      TimeValue time_a_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputPackedTime(time_a(i), name(), &time_a_value));
+      TimeValue time_b_value;
+      TF_RETURN_IF_ERROR(
+          ParseInputPackedTime(time_b(i), name(), &time_b_value));
+
+      // Compute diff.
+      int64_t out;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::DiffTimes(time_a_value, time_b_value, part_enum, &out)));
+
+      // Set the output value.
+      output_flat(i) = out;
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class TimeTruncPacked : public OpKernel {
+ public:
+  explicit TimeTruncPacked(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time tensor
+    const Tensor& time_tensor = context->input(0);
+    auto time = time_tensor.flat<int64_t>();
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(1);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the time tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = time.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the time.
+      TimeValue time_value;
+      TF_RETURN_IF_ERROR(ParseInputPackedTime(time(i), name(), &time_value));
+
+      // Truncate the time.
+      TimeValue out_time;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::TruncateTime(time_value, part_enum, &out_time)));
+
+      // Set the output value.
+      output_flat(i) = out_time.Packed64TimeMicros();
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+};
+
+class ExtractFromTimePacked : public OpKernel {
+ public:
+  explicit ExtractFromTimePacked(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the time tensor
+    const Tensor& time_tensor = context->input(0);
+    auto time = time_tensor.flat<int64_t>();
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(1);
+    std::string part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR});
+    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
+                                part, name(), &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the time tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(0, time_tensor.shape(),
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = time.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Unpack the time.
+      TimeValue time_value;
+      TF_RETURN_IF_ERROR(ParseInputPackedTime(time(i), name(), &time_value));
+
+      // Extract part from the time.
+      int32_t out;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractFromTime(part_enum, time_value, &out)));
+
+      // Set the output value.
+      // Currently, BQML util inference only supports int64.
+      output_flat(i) = static_cast<int64_t>(out);
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -616,19 +1092,63 @@ REGISTER_KERNEL_BUILDER(Name("TimeFromComponents").Device(DEVICE_CPU),
                         TimeFromComponents);
 REGISTER_KERNEL_BUILDER(Name("TimeFromTimestamp").Device(DEVICE_CPU),
                         TimeFromTimestamp);
+REGISTER_KERNEL_BUILDER(Name("TimeFromTimestampWithErrors").Device(DEVICE_CPU),
+                        TimeFromTimestamp);
 REGISTER_KERNEL_BUILDER(Name("TimeFromDatetime").Device(DEVICE_CPU),
                         TimeFromDatetime);
+REGISTER_KERNEL_BUILDER(Name("TimeFromDatetimeWithErrors").Device(DEVICE_CPU),
+                        TimeFromDatetime);
 REGISTER_KERNEL_BUILDER(Name("CastToTimeFromString").Device(DEVICE_CPU),
                         CastToTimeFromString);
+REGISTER_KERNEL_BUILDER(
+    Name("CastToTimeFromStringWithErrors").Device(DEVICE_CPU),
+    CastToTimeFromString);
+REGISTER_KERNEL_BUILDER(Name("CastToStringFromTime").Device(DEVICE_CPU),
+                        CastToStringFromTime);
+REGISTER_KERNEL_BUILDER(
+    Name("CastToStringFromTimeWithErrors").Device(DEVICE_CPU),
+    CastToStringFromTime);
 REGISTER_KERNEL_BUILDER(Name("TimeAdd").Device(DEVICE_CPU), TimeAdd);
+REGISTER_KERNEL_BUILDER(Name("TimeAddWithErrors").Device(DEVICE_CPU), TimeAdd);
 REGISTER_KERNEL_BUILDER(Name("TimeSub").Device(DEVICE_CPU), TimeSub);
+REGISTER_KERNEL_BUILDER(Name("TimeSubWithErrors").Device(DEVICE_CPU), TimeSub);
 REGISTER_KERNEL_BUILDER(Name("TimeDiff").Device(DEVICE_CPU), TimeDiff);
+REGISTER_KERNEL_BUILDER(Name("TimeDiffWithErrors").Device(DEVICE_CPU),
+                        TimeDiff);
 REGISTER_KERNEL_BUILDER(Name("TimeTrunc").Device(DEVICE_CPU), TimeTrunc);
+REGISTER_KERNEL_BUILDER(Name("TimeTruncWithErrors").Device(DEVICE_CPU),
+                        TimeTrunc);
 REGISTER_KERNEL_BUILDER(Name("ExtractFromTime").Device(DEVICE_CPU),
                         ExtractFromTime);
+REGISTER_KERNEL_BUILDER(Name("ExtractFromTimeWithErrors").Device(DEVICE_CPU),
+                        ExtractFromTime);
+REGISTER_KERNEL_BUILDER(Name("ExtractPartsFromTime").Device(DEVICE_CPU),
+                        ExtractPartsFromTime);
 REGISTER_KERNEL_BUILDER(Name("ParseTime").Device(DEVICE_CPU), ParseTime);
+REGISTER_KERNEL_BUILDER(Name("ParseTimeWithErrors").Device(DEVICE_CPU),
+                        ParseTime);
 REGISTER_KERNEL_BUILDER(Name("SafeParseTime").Device(DEVICE_CPU),
                         SafeParseTime);
+REGISTER_KERNEL_BUILDER(
+    Name("SafeParseTimeWithValidity").Device(DEVICE_CPU), SafeParseTime);
 REGISTER_KERNEL_BUILDER(Name("FormatTime").Device(DEVICE_CPU), FormatTime);
+REGISTER_KERNEL_BUILDER(Name("FormatTimeWithErrors").Device(DEVICE_CPU),
+                        FormatTime);
+REGISTER_KERNEL_BUILDER(Name("PackedFromTime").Device(DEVICE_CPU),
+                        PackedFromTime);
+REGISTER_KERNEL_BUILDER(Name("PackedFromTimeWithErrors").Device(DEVICE_CPU),
+                        PackedFromTime);
+REGISTER_KERNEL_BUILDER(Name("TimeFromPacked").Device(DEVICE_CPU),
+                        TimeFromPacked);
+REGISTER_KERNEL_BUILDER(Name("TimeAddPacked").Device(DEVICE_CPU),
+                        TimeAddPacked);
+REGISTER_KERNEL_BUILDER(Name("TimeSubPacked").Device(DEVICE_CPU),
+                        TimeSubPacked);
+REGISTER_KERNEL_BUILDER(Name("TimeDiffPacked").Device(DEVICE_CPU),
+                        TimeDiffPacked);
+REGISTER_KERNEL_BUILDER(Name("TimeTruncPacked").Device(DEVICE_CPU),
+                        TimeTruncPacked);
+REGISTER_KERNEL_BUILDER(Name("ExtractFromTimePacked").Device(DEVICE_CPU),
+                        ExtractFromTimePacked);
 
 }  // namespace bigquery_ml_utils
@@ -14,9 +14,13 @@
  * limitations under the License.
  */
 
+#include <string>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/platform/errors.h"
 
 namespace bigquery_ml_utils {
 
@@ -34,6 +38,42 @@ REGISTER_OP("ExtractFromTimestamp")
       return absl::OkStatus();
     });
 
+// Register ExtractFromTimestampWithErrors op with signature.
+// Like ExtractFromTimestamp, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("ExtractFromTimestampWithErrors")
+    .Input("part: string")
+    .Input("timestamp: string")
+    .Input("time_zone: string")
+    .Output("part_out: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register ExtractPartsFromTimestamp op with signature.
+// Output has the shape of the input timestamp with an extra innermost dimension
+// for the parts.
+REGISTER_OP("ExtractPartsFromTimestamp")
+    .Input("timestamp: string")
+    .Input("time_zone: string")
+    .Attr("parts: list(string) >= 1")
+    .Output("parts_out: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      std::vector<std::string> parts;
+      TF_RETURN_IF_ERROR(c->GetAttr("parts", &parts));
+      ::tensorflow::shape_inference::ShapeHandle output;
+      TF_RETURN_IF_ERROR(
+          c->Concatenate(c->input(0), c->Vector(parts.size()), &output));
+      c->set_output(0, output);
+      return absl::OkStatus();
+    });
+
 // Register StringFromTimestamp op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("StringFromTimestamp")
@@ -45,6 +85,23 @@ REGISTER_OP("StringFromTimestamp")
       return absl::OkStatus();
     });
 
+// Register StringFromTimestampWithErrors op with signature.
+// Like StringFromTimestamp, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("StringFromTimestampWithErrors")
+    .Input("timestamp: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimestampFromString op with signature.
 // Output has the same shape of the input string.
 REGISTER_OP("TimestampFromString")
@@ -57,6 +114,88 @@ REGISTER_OP("TimestampFromString")
       return absl::OkStatus();
     });
 
+// Register TimestampFromStringWithErrors op with signature.
+// Like TimestampFromString, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("TimestampFromStringWithErrors")
+    .Input("timestamp_string: string")
+    .Input("time_zone: string")
+    .Input("allow_tz_in_str: bool")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register CastToTimestampFromString op with signature.
+// Output has the same shape of the timestamp_string.
+REGISTER_OP("CastToTimestampFromString")
+    .Input("timestamp_string: string")
+    .Input("format_string: string")
+    .Input("time_zone: string")
+    .Input("with_format: bool")
+    .Output("output: string")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register CastToTimestampFromStringWithErrors op with signature.
+// Like CastToTimestampFromString, but rows that fail produce an empty output
+// string and their error code in error_codes instead of failing the whole
+// batch. Both have the same shape of the input timestamp_string. error_messages
+// has the messages of the first max_error_messages failing rows.
+REGISTER_OP("CastToTimestampFromStringWithErrors")
+    .Input("timestamp_string: string")
+    .Input("format_string: string")
+    .Input("time_zone: string")
+    .Input("with_format: bool")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register CastToStringFromTimestamp op with signature.
+// Output has the same shape of the timestamp.
+REGISTER_OP("CastToStringFromTimestamp")
+    .Input("timestamp: string")
+    .Input("format_string: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register CastToStringFromTimestampWithErrors op with signature.
+// Like CastToStringFromTimestamp, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("CastToStringFromTimestampWithErrors")
+    .Input("timestamp: string")
+    .Input("format_string: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimestampFromDate op with signature.
 // Output has the same shape of the input date.
 REGISTER_OP("TimestampFromDate")
@@ -68,6 +207,23 @@ REGISTER_OP("TimestampFromDate")
       return absl::OkStatus();
     });
 
+// Register TimestampFromDateWithErrors op with signature.
+// Like TimestampFromDate, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("TimestampFromDateWithErrors")
+    .Input("date: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimestampFromDatetime op with signature.
 // Output has the same shape of the input datetime.
 REGISTER_OP("TimestampFromDatetime")
@@ -79,6 +235,23 @@ REGISTER_OP("TimestampFromDatetime")
       return absl::OkStatus();
     });
 
+// Register TimestampFromDatetimeWithErrors op with signature.
+// Like TimestampFromDatetime, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("TimestampFromDatetimeWithErrors")
+    .Input("datetime: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimestampAdd op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("TimestampAdd")
@@ -91,6 +264,24 @@ REGISTER_OP("TimestampAdd")
       return absl::OkStatus();
     });
 
+// Register TimestampAddWithErrors op with signature.
+// Like TimestampAdd, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("TimestampAddWithErrors")
+    .Input("timestamp: string")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimestampSub op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("TimestampSub")
@@ -103,6 +294,24 @@ REGISTER_OP("TimestampSub")
       return absl::OkStatus();
     });
 
+// Register TimestampSubWithErrors op with signature.
+// Like TimestampSub, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("TimestampSubWithErrors")
+    .Input("timestamp: string")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimestampDiff op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("TimestampDiff")
@@ -115,6 +324,24 @@ REGISTER_OP("TimestampDiff")
       return absl::OkStatus();
     });
 
+// Register TimestampDiffWithErrors op with signature.
+// Like TimestampDiff, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("TimestampDiffWithErrors")
+    .Input("timestamp_a: string")
+    .Input("timestamp_b: string")
+    .Input("part: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register TimestampTrunc op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("TimestampTrunc")
@@ -127,6 +354,24 @@ REGISTER_OP("TimestampTrunc")
       return absl::OkStatus();
     });
 
+// Register TimestampTruncWithErrors op with signature.
+// Like TimestampTrunc, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("TimestampTruncWithErrors")
+    .Input("timestamp: string")
+    .Input("part: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register FormatTimestamp op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("FormatTimestamp")
@@ -139,6 +384,24 @@ REGISTER_OP("FormatTimestamp")
       return absl::OkStatus();
     });
 
+// Register FormatTimestampWithErrors op with signature.
+// Like FormatTimestamp, but reports the errors of failing rows in
+// error_codes and error_messages instead of failing the whole batch.
+REGISTER_OP("FormatTimestampWithErrors")
+    .Input("format_string: string")
+    .Input("timestamp: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register ParseTimestamp op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("ParseTimestamp")
@@ -151,6 +414,26 @@ REGISTER_OP("ParseTimestamp")
       return absl::OkStatus();
     });
 
+// Register ParseTimestampWithErrors op with signature.
+// Like ParseTimestamp, but rows that fail produce an empty output string and
+// their error code in error_codes instead of failing the whole batch. Both have
+// the same shape of the input timestamp_string. error_messages has the messages
+// of the first max_error_messages failing rows.
+REGISTER_OP("ParseTimestampWithErrors")
+    .Input("format_string: string")
+    .Input("timestamp_string: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register SafeParseTimestamp op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("SafeParseTimestamp")
@@ -163,6 +446,22 @@ REGISTER_OP("SafeParseTimestamp")
       return absl::OkStatus();
     });
 
+// Register SafeParseTimestampWithValidity op with signature.
+// Like SafeParseTimestamp, but rows that fail to parse produce an empty output
+// string and false in valid, instead of the NULL-equivalent value.  Both
+// outputs have the same shape of the input timestamp_string.
+REGISTER_OP("SafeParseTimestampWithValidity")
+    .Input("format_string: string")
+    .Input("timestamp_string: string")
+    .Input("time_zone: string")
+    .Output("output: string")
+    .Output("valid: bool")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      c->set_output(1, c->input(1));
+      return absl::OkStatus();
+    });
+
 // Register TimestampMicros op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("TimestampMicros")
@@ -203,6 +502,22 @@ REGISTER_OP("UnixMicros")
       return absl::OkStatus();
     });
 
+// Register UnixMicrosWithErrors op with signature.
+// Like UnixMicros, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("UnixMicrosWithErrors")
+    .Input("timestamp: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register UnixMillis op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("UnixMillis")
@@ -213,6 +528,22 @@ REGISTER_OP("UnixMillis")
       return absl::OkStatus();
     });
 
+// Register UnixMillisWithErrors op with signature.
+// Like UnixMillis, but reports the errors of failing rows in error_codes and
+// error_messages instead of failing the whole batch.
+REGISTER_OP("UnixMillisWithErrors")
+    .Input("timestamp: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
 // Register UnixSeconds op with signature.
 // Output has the same shape of the input timestamp.
 REGISTER_OP("UnixSeconds")
@@ -223,4 +554,80 @@ REGISTER_OP("UnixSeconds")
       return absl::OkStatus();
     });
 
+// Register UnixSecondsWithErrors op with signature.
+// Like UnixSeconds, but reports the errors of failing rows in error_codes
+// and error_messages instead of failing the whole batch.
+REGISTER_OP("UnixSecondsWithErrors")
+    .Input("timestamp: string")
+    .Output("output: int64")
+    .Output("error_codes: int32")
+    .Output("error_messages: string")
+    .Attr("max_error_messages: int >= 0 = 16")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      c->set_output(1, c->input(0));
+      c->set_output(2, c->Vector(c->UnknownDim()));
+      return absl::OkStatus();
+    });
+
+// Register ExtractFromTimestampMicros op with signature.
+// Output has the same shape of the input timestamp.
+REGISTER_OP("ExtractFromTimestampMicros")
+    .Input("part: string")
+    .Input("timestamp: int64")
+    .Input("time_zone: string")
+    .Output("part_out: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(1));
+      return absl::OkStatus();
+    });
+
+// Register TimestampAddMicros op with signature.
+// Output has the same shape of the input timestamp.
+REGISTER_OP("TimestampAddMicros")
+    .Input("timestamp: int64")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register TimestampSubMicros op with signature.
+// Output has the same shape of the input timestamp.
+REGISTER_OP("TimestampSubMicros")
+    .Input("timestamp: int64")
+    .Input("interval: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register TimestampDiffMicros op with signature.
+// Output has the same shape of the input timestamp.
+REGISTER_OP("TimestampDiffMicros")
+    .Input("timestamp_a: int64")
+    .Input("timestamp_b: int64")
+    .Input("part: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
+// Register TimestampTruncMicros op with signature.
+// Output has the same shape of the input timestamp.
+REGISTER_OP("TimestampTruncMicros")
+    .Input("timestamp: int64")
+    .Input("part: string")
+    .Input("time_zone: string")
+    .Output("output: int64")
+    .SetShapeFn([](::tensorflow::shape_inference::InferenceContext* c) {
+      c->set_output(0, c->input(0));
+      return absl::OkStatus();
+    });
+
 }  // namespace bigquery_ml_utils
@@ -14,11 +14,13 @@
 
 """Python wrapper for BQML timestamp custom ops."""
 
+from bigquery_ml_utils.tensorflow_ops.composite_tensors import supports_composite_tensors
 from bigquery_ml_utils.tensorflow_ops.load_module import load_module
 
-gen_timestamp_ops = load_module("_timestamp_ops.so")
+gen_timestamp_ops = load_module("_bigquery_ml_utils_ops.so")
 
 
+@supports_composite_tensors
 def extract_from_timestamp(part, timestamp, time_zone="UTC", name=None):
   """Returns the specified part from a supplied timestamp at a given timezone.
 
@@ -28,8 +30,10 @@ def extract_from_timestamp(part, timestamp, time_zone="UTC", name=None):
     part: A string represents the datetime part. Can be MICROSECOND,
       MILLISECOND, SECOND, MINUTE, HOUR, DAYOFWEEK, DAY, DAYOFYEAR, WEEK,
       WEEK(<WEEKDAY>), ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. Case insensitive.
+      Can also be a tf.Tensor of type string with one part per timestamp.
     timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
-    time_zone: A string represents the timezone. Case sensitive.
+    time_zone: A string represents the timezone, or a tf.Tensor of type string
+      with one timezone per timestamp. Case sensitive.
     name: An optional name for the op.
   """
   return gen_timestamp_ops.extract_from_timestamp(
@@ -37,6 +41,60 @@ def extract_from_timestamp(part, timestamp, time_zone="UTC", name=None):
   )
 
 
+def extract_from_timestamp_with_errors(
+    part, timestamp, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like extract_from_timestamp, but reports per-row errors.
+
+  Args:
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAYOFWEEK, DAY, DAYOFYEAR, WEEK,
+      WEEK(<WEEKDAY>), ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. Case insensitive.
+      Can also be a tf.Tensor of type string with one part per timestamp.
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    time_zone: A string represents the timezone, or a tf.Tensor of type string
+      with one timezone per timestamp. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.extract_from_timestamp_with_errors(
+      part=part,
+      timestamp=timestamp,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+def extract_parts_from_timestamp(parts, timestamp, time_zone="UTC", name=None):
+  """Returns several parts from a supplied timestamp at a given timezone.
+
+  Equivalent SQL: EXTRACT(part FROM timestamp AT TIME ZONE time_zone) for each
+  part in parts. Each timestamp is parsed and converted to the time zone once.
+
+  Args:
+    parts: A non-empty list of strings represents the datetime parts, with the
+      values accepted by extract_from_timestamp.
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    time_zone: A string represents the timezone. Case sensitive.
+    name: An optional name for the op.
+
+  Returns:
+    A tf.Tensor of type int64 with the shape of timestamp and an extra
+    innermost dimension, holding the value of parts[i] at index i.
+  """
+  return gen_timestamp_ops.extract_parts_from_timestamp(
+      timestamp=timestamp, time_zone=time_zone, parts=parts, name=name
+  )
+
+
+@supports_composite_tensors
 def string_from_timestamp(timestamp, time_zone="UTC", name=None):
   """Returns a string from a timestamp at a given timezone.
 
@@ -44,7 +102,8 @@ def string_from_timestamp(timestamp, time_zone="UTC", name=None):
 
   Args:
     timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
-    time_zone: A string represents the timezone. Case sensitive.
+    time_zone: A string represents the timezone, or a tf.Tensor of type string
+      with one timezone per timestamp. Case sensitive.
     name: An optional name for the op.
   """
   return gen_timestamp_ops.string_from_timestamp(
@@ -52,6 +111,33 @@ def string_from_timestamp(timestamp, time_zone="UTC", name=None):
   )
 
 
+def string_from_timestamp_with_errors(
+    timestamp, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like string_from_timestamp, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    time_zone: A string represents the timezone, or a tf.Tensor of type string
+      with one timezone per timestamp. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.string_from_timestamp_with_errors(
+      timestamp=timestamp,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def timestamp_from_string(timestamp_string, time_zone=None, name=None):
   """Returns a timestamp from a string at a given timezone.
 
@@ -72,6 +158,155 @@ def timestamp_from_string(timestamp_string, time_zone=None, name=None):
   )
 
 
+def timestamp_from_string_with_errors(
+    timestamp_string, time_zone=None, max_error_messages=16, name=None
+):
+  """Like timestamp_from_string, but reports per-row errors.
+
+  Args:
+    timestamp_string: tf.Tensor of type string. Must include a timestamp
+      literal. If timestamp includes a time_zone in the string, do not include
+      an explicit time_zone argument.
+    time_zone: A string represents the timezone. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.timestamp_from_string_with_errors(
+      timestamp_string=timestamp_string,
+      time_zone="UTC" if time_zone is None else time_zone,
+      allow_tz_in_str=time_zone is None,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def cast_to_timestamp_from_string(
+    timestamp_string, format_string=None, time_zone="UTC", name=None
+):
+  """Returns a timestamp by casting a string.
+
+  Equivalent SQL: CAST(string AS TIMESTAMP [FORMAT format_string [AT TIME ZONE
+  time_zone]])
+
+  Args:
+    timestamp_string: tf.Tensor of type string. Without format_string, the
+      string must conform to the supported timestamp literal format. If the
+      string expression is invalid or represents a time that is outside of the
+      supported min/max range, then an error is produced.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    time_zone: A string represents the default timezone, used when the string
+      does not include one. Case sensitive.
+    name: An optional name for the op.
+  """
+  return gen_timestamp_ops.cast_to_timestamp_from_string(
+      timestamp_string=timestamp_string,
+      format_string="" if format_string is None else format_string,
+      time_zone=time_zone,
+      with_format=format_string is not None,
+      name=name,
+  )
+
+
+def cast_to_timestamp_from_string_with_errors(
+    timestamp_string,
+    format_string=None,
+    time_zone="UTC",
+    max_error_messages=16,
+    name=None,
+):
+  """Like cast_to_timestamp_from_string, but reports per-row errors.
+
+  Args:
+    timestamp_string: tf.Tensor of type string. Without format_string, the
+      string must conform to the supported timestamp literal format. If the
+      string expression is invalid or represents a time that is outside of the
+      supported min/max range, then an error is produced.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    time_zone: A string represents the default timezone, used when the string
+      does not include one. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.cast_to_timestamp_from_string_with_errors(
+      timestamp_string=timestamp_string,
+      format_string="" if format_string is None else format_string,
+      time_zone=time_zone,
+      with_format=format_string is not None,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def cast_to_string_from_timestamp(
+    timestamp, format_string, time_zone="UTC", name=None
+):
+  """Returns a string by casting a timestamp with a format.
+
+  Equivalent SQL: CAST(timestamp AS STRING FORMAT format_string [AT TIME ZONE
+  time_zone])
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z"
+      format.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    time_zone: A string represents the timezone. Case sensitive.
+    name: An optional name for the op.
+  """
+  return gen_timestamp_ops.cast_to_string_from_timestamp(
+      timestamp=timestamp,
+      format_string=format_string,
+      time_zone=time_zone,
+      name=name,
+  )
+
+
+def cast_to_string_from_timestamp_with_errors(
+    timestamp, format_string, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like cast_to_string_from_timestamp, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z"
+      format.
+    format_string: tf.Tensor of type string. A string which contains format
+      elements.
+    time_zone: A string represents the timezone. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.cast_to_string_from_timestamp_with_errors(
+      timestamp=timestamp,
+      format_string=format_string,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def timestamp_from_date(date, time_zone="UTC", name=None):
   """Returns a timestamp from a date at a given timezone.
 
@@ -90,6 +325,33 @@ def timestamp_from_date(date, time_zone="UTC", name=None):
   )
 
 
+def timestamp_from_date_with_errors(
+    date, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like timestamp_from_date, but reports per-row errors.
+
+  Args:
+    date: tf.Tensor of type string. Date in "%F" format. Returned is the
+      earliest timestamp that falls within the given date.
+    time_zone: A string represents the timezone. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.timestamp_from_date_with_errors(
+      date=date,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def timestamp_from_datetime(datetime, time_zone="UTC", name=None):
   """Returns a timestamp from a datetime at a given timezone.
 
@@ -107,6 +369,32 @@ def timestamp_from_datetime(datetime, time_zone="UTC", name=None):
   )
 
 
+def timestamp_from_datetime_with_errors(
+    datetime, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like timestamp_from_datetime, but reports per-row errors.
+
+  Args:
+    datetime: tf.Tensor of type string. Datetime in "%F %H:%M:%E6S" format.
+    time_zone: A string represents the timezone. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.timestamp_from_datetime_with_errors(
+      datetime=datetime,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def timestamp_add(timestamp, interval, part, name=None):
   """Returns a timestamp by adding interval to the timestamp.
 
@@ -128,6 +416,35 @@ def timestamp_add(timestamp, interval, part, name=None):
   )
 
 
+def timestamp_add_with_errors(
+    timestamp, interval, part, max_error_messages=16, name=None
+):
+  """Like timestamp_add, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.timestamp_add_with_errors(
+      timestamp=timestamp,
+      interval=interval,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def timestamp_sub(timestamp, interval, part, name=None):
   """Returns a timestamp by subtracting interval to the timestamp.
 
@@ -149,6 +466,35 @@ def timestamp_sub(timestamp, interval, part, name=None):
   )
 
 
+def timestamp_sub_with_errors(
+    timestamp, interval, part, max_error_messages=16, name=None
+):
+  """Like timestamp_sub, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.timestamp_sub_with_errors(
+      timestamp=timestamp,
+      interval=interval,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def timestamp_diff(timestamp_a, timestamp_b, part, name=None):
   """Returns the whole number of specified date_part intervals between timestamp_a and timestamp_b.
 
@@ -172,6 +518,37 @@ def timestamp_diff(timestamp_a, timestamp_b, part, name=None):
   )
 
 
+def timestamp_diff_with_errors(
+    timestamp_a, timestamp_b, part, max_error_messages=16, name=None
+):
+  """Like timestamp_diff, but reports per-row errors.
+
+  Args:
+    timestamp_a: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z"
+      format.
+    timestamp_b: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z"
+      format.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY. Case insensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.timestamp_diff_with_errors(
+      timestamp_a=timestamp_a,
+      timestamp_b=timestamp_b,
+      part=part,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def timestamp_trunc(timestamp, part, time_zone="UTC", name=None):
   """Returns a timestamp which by truncating the original timestamp to the granularity of part.
 
@@ -183,8 +560,10 @@ def timestamp_trunc(timestamp, part, time_zone="UTC", name=None):
     part: A string represents the datetime part. Can be MICROSECOND,
       MILLISECOND, SECOND,MINUTE, HOUR,  DAY, WEEK,  WEEK_MONDAY, WEEK_TUESDAY,
       WEEK_WEDNESDAY, WEEK_THURSDAY, WEEK_FRIDAY, WEEK_SATURDAY, ISOWEEK, MONTH,
-      QUARTER, YEAR,  ISOYEAR. Case insensitive.
-    time_zone: A string represents the timezone. Case sensitive.
+      QUARTER, YEAR,  ISOYEAR. Case insensitive. Can also be a tf.Tensor of
+      type string with one part per timestamp.
+    time_zone: A string represents the timezone, or a tf.Tensor of type string
+      with one timezone per timestamp. Case sensitive.
     name: An optional name for the op.
   """
   return gen_timestamp_ops.timestamp_trunc(
@@ -195,6 +574,39 @@ def timestamp_trunc(timestamp, part, time_zone="UTC", name=None):
   )
 
 
+def timestamp_trunc_with_errors(
+    timestamp, part, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like timestamp_trunc, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND,MINUTE, HOUR,  DAY, WEEK,  WEEK_MONDAY, WEEK_TUESDAY,
+      WEEK_WEDNESDAY, WEEK_THURSDAY, WEEK_FRIDAY, WEEK_SATURDAY, ISOWEEK, MONTH,
+      QUARTER, YEAR,  ISOYEAR. Case insensitive. Can also be a tf.Tensor of
+      type string with one part per timestamp.
+    time_zone: A string represents the timezone, or a tf.Tensor of type string
+      with one timezone per timestamp. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.timestamp_trunc_with_errors(
+      timestamp=timestamp,
+      part=part,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def format_timestamp(format_string, timestamp, time_zone="UTC", name=None):
   """Returns a timestamp string based on format_string.
 
@@ -214,6 +626,34 @@ def format_timestamp(format_string, timestamp, time_zone="UTC", name=None):
   )
 
 
+def format_timestamp_with_errors(
+    format_string, timestamp, time_zone="UTC", max_error_messages=16, name=None
+):
+  """Like format_timestamp, but reports per-row errors.
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the output string.
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    time_zone: A string represents the timezone. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.format_timestamp_with_errors(
+      format_string=format_string,
+      timestamp=timestamp,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def parse_timestamp(
     format_string, timestamp_string, time_zone="UTC", name=None
 ):
@@ -236,6 +676,39 @@ def parse_timestamp(
   )
 
 
+def parse_timestamp_with_errors(
+    format_string,
+    timestamp_string,
+    time_zone="UTC",
+    max_error_messages=16,
+    name=None,
+):
+  """Like parse_timestamp, but reports per-row errors.
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the string timestamp.
+    timestamp_string: tf.Tensor of type string. Timestamp in any supported
+      format.
+    time_zone: A string represents the timezone. Case sensitive.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with an empty output string and the nonzero
+    tf.errors code of each failing row. error_messages is a string vector with
+    the messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.parse_timestamp_with_errors(
+      format_string=format_string,
+      timestamp_string=timestamp_string,
+      time_zone=time_zone,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def safe_parse_timestamp(
     format_string, timestamp_string, time_zone="UTC", name=None
 ):
@@ -260,6 +733,35 @@ def safe_parse_timestamp(
   )
 
 
+@supports_composite_tensors
+def safe_parse_timestamp_with_validity(
+    format_string, timestamp_string, time_zone="UTC", name=None
+):
+  """Returns timestamps by safely parsing strings, and which ones parsed.
+
+  Like safe_parse_timestamp, but unsuccessful parsing produces an empty string
+  and False in the validity tensor instead of '1970-01-01 00:00:00.0 +0000'.
+
+  Args:
+    format_string: tf.Tensor of type string. Format of the string timestamp.
+    timestamp_string: tf.Tensor of type string. Timestamp in any supported
+      format.
+    time_zone: A string represents the timezone. Case sensitive.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, valid) of a string tf.Tensor and a bool tf.Tensor, both
+    with the shape of timestamp_string.
+  """
+  return gen_timestamp_ops.safe_parse_timestamp_with_validity(
+      format_string=format_string,
+      timestamp_string=timestamp_string,
+      time_zone=time_zone,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def timestamp_micros(timestamp_micro, name=None):
   """Returns a timestamp by interpreting timestamp_micro as the number of microseconds since 1970-01-01 00:00:00 UTC.
 
@@ -275,6 +777,7 @@ def timestamp_micros(timestamp_micro, name=None):
   )
 
 
+@supports_composite_tensors
 def timestamp_millis(timestamp_milli, name=None):
   """Returns a timestamp by interpreting timestamp_milli as the number of milliseconds since 1970-01-01 00:00:00 UTC.
 
@@ -290,6 +793,7 @@ def timestamp_millis(timestamp_milli, name=None):
   )
 
 
+@supports_composite_tensors
 def timestamp_seconds(timestamp_sec, name=None):
   """Returns a timestamp by interpreting timestamp_sec as the number of seconds since 1970-01-01 00:00:00 UTC.
 
@@ -305,6 +809,7 @@ def timestamp_seconds(timestamp_sec, name=None):
   )
 
 
+@supports_composite_tensors
 def unix_micros(timestamp, name=None):
   """Returns the number of microseconds since 1970-01-01 00:00:00 UTC.
 
@@ -320,6 +825,28 @@ def unix_micros(timestamp, name=None):
   )
 
 
+def unix_micros_with_errors(timestamp, max_error_messages=16, name=None):
+  """Like unix_micros, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.unix_micros_with_errors(
+      timestamp=timestamp,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def unix_millis(timestamp, name=None):
   """Returns number of milliseconds since 1970-01-01 00:00:00 UTC.
 
@@ -335,6 +862,28 @@ def unix_millis(timestamp, name=None):
   )
 
 
+def unix_millis_with_errors(timestamp, max_error_messages=16, name=None):
+  """Like unix_millis, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.unix_millis_with_errors(
+      timestamp=timestamp,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
 def unix_seconds(timestamp, name=None):
   """Returns number of seconds since 1970-01-01 00:00:00 UTC.
 
@@ -348,3 +897,150 @@ def unix_seconds(timestamp, name=None):
       timestamp=timestamp,
       name=name,
   )
+
+
+def unix_seconds_with_errors(timestamp, max_error_messages=16, name=None):
+  """Like unix_seconds, but reports per-row errors.
+
+  Args:
+    timestamp: tf.Tensor of type string. Timestamp in "%F %H:%M:%E1S %z" format.
+    max_error_messages: The maximum number of error messages to return.
+    name: An optional name for the op.
+
+  Returns:
+    A tuple (output, error_codes, error_messages). output and error_codes have
+    the shape of the input, with a zero output and the nonzero tf.errors
+    code of each failing row. error_messages is a string vector with the
+    messages of the first max_error_messages failing rows, in row order.
+  """
+  return gen_timestamp_ops.unix_seconds_with_errors(
+      timestamp=timestamp,
+      max_error_messages=max_error_messages,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def extract_from_timestamp_micros(part, timestamp, time_zone="UTC", name=None):
+  """Returns the specified part from a timestamp in micros at a given timezone.
+
+  Native variant of extract_from_timestamp which skips string parsing. Use
+  unix_micros to convert a string timestamp to micros.
+
+  Equivalent SQL: EXTRACT(part FROM timestamp AT TIME ZONE time_zone)
+
+  Args:
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAYOFWEEK, DAY, DAYOFYEAR, WEEK,
+      WEEK(<WEEKDAY>), ISOWEEK, MONTH, QUARTER, YEAR, ISOYEAR. Case insensitive.
+    timestamp: tf.Tensor of type int64. Microseconds since 1970-01-01 00:00:00
+      UTC.
+    time_zone: A string represents the timezone. Case sensitive.
+    name: An optional name for the op.
+  """
+  return gen_timestamp_ops.extract_from_timestamp_micros(
+      part=part, timestamp=timestamp, time_zone=time_zone, name=name
+  )
+
+
+@supports_composite_tensors
+def timestamp_add_micros(timestamp, interval, part, name=None):
+  """Returns a timestamp in micros by adding interval to the timestamp.
+
+  Native variant of timestamp_add which skips string parsing and formatting.
+
+  Equivalent SQL: TIMESTAMP_ADD(timestamp_expression, INTERVAL int64_expression
+  date_part)
+
+  Args:
+    timestamp: tf.Tensor of type int64. Microseconds since 1970-01-01 00:00:00
+      UTC.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_timestamp_ops.timestamp_add_micros(
+      timestamp=timestamp,
+      interval=interval,
+      part=part,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def timestamp_sub_micros(timestamp, interval, part, name=None):
+  """Returns a timestamp in micros by subtracting interval to the timestamp.
+
+  Native variant of timestamp_sub which skips string parsing and formatting.
+
+  Equivalent SQL: TIMESTAMP_SUB(timestamp_expression, INTERVAL int64_expression
+  date_part)
+
+  Args:
+    timestamp: tf.Tensor of type int64. Microseconds since 1970-01-01 00:00:00
+      UTC.
+    interval: tf.Tensor of type int64. Integer represents the unit of part.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_timestamp_ops.timestamp_sub_micros(
+      timestamp=timestamp,
+      interval=interval,
+      part=part,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def timestamp_diff_micros(timestamp_a, timestamp_b, part, name=None):
+  """Returns the whole number of part intervals between two timestamps in micros.
+
+  Native variant of timestamp_diff which skips string parsing.
+
+  Equivalent SQL: TIMESTAMP_DIFF(timestamp_expression_a, timestamp_expression_b,
+  date_part)
+
+  Args:
+    timestamp_a: tf.Tensor of type int64. Microseconds since 1970-01-01
+      00:00:00 UTC.
+    timestamp_b: tf.Tensor of type int64. Microseconds since 1970-01-01
+      00:00:00 UTC.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY. Case insensitive.
+    name: An optional name for the op.
+  """
+  return gen_timestamp_ops.timestamp_diff_micros(
+      timestamp_a=timestamp_a,
+      timestamp_b=timestamp_b,
+      part=part,
+      name=name,
+  )
+
+
+@supports_composite_tensors
+def timestamp_trunc_micros(timestamp, part, time_zone="UTC", name=None):
+  """Returns a timestamp in micros truncated to the granularity of part.
+
+  Native variant of timestamp_trunc which skips string parsing and formatting.
+
+  Equivalent SQL: TIMESTAMP_TRUNC(timestamp_expression, date_time_part[,
+  time_zone])
+
+  Args:
+    timestamp: tf.Tensor of type int64. Microseconds since 1970-01-01 00:00:00
+      UTC.
+    part: A string represents the datetime part. Can be MICROSECOND,
+      MILLISECOND, SECOND, MINUTE, HOUR, DAY, WEEK, WEEK_MONDAY, WEEK_TUESDAY,
+      WEEK_WEDNESDAY, WEEK_THURSDAY, WEEK_FRIDAY, WEEK_SATURDAY, ISOWEEK, MONTH,
+      QUARTER, YEAR, ISOYEAR. Case insensitive.
+    time_zone: A string represents the timezone. Case sensitive.
+    name: An optional name for the op.
+  """
+  return gen_timestamp_ops.timestamp_trunc_micros(
+      timestamp=timestamp,
+      part=part,
+      time_zone=time_zone,
+      name=name,
+  )
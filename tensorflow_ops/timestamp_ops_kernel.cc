@@ -16,8 +16,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
@@ -26,8 +28,10 @@
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "sql_utils/public/civil_time.h"
 #include "sql_utils/public/functions/arithmetics.h"
+#include "sql_utils/public/functions/cast_date_time.h"
 #include "sql_utils/public/functions/date_time_util.h"
 #include "sql_utils/public/functions/datetime.pb.h"
 #include "sql_utils/public/functions/parse_date_time.h"
@@ -35,6 +39,7 @@
 #include "sql_utils/public/types/timestamp_util.h"
 #include "tensorflow_ops/constants.h"
 #include "tensorflow_ops/utils.h"
+#include "tensorflow/tsl/platform/errors.h"
 #include "tensorflow/tsl/platform/status.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/op_requires.h"
@@ -47,6 +52,7 @@ using ::tensorflow::OpKernel;
 using ::tensorflow::OpKernelConstruction;
 using ::tensorflow::OpKernelContext;
 using ::tensorflow::Tensor;
+using ::tensorflow::TensorShape;
 using ::tensorflow::tstring;
 using ::tensorflow::errors::Internal;
 using ::tensorflow::errors::InvalidArgument;
@@ -59,9 +65,10 @@ class ExtractFromTimestamp : public OpKernel {
       : OpKernel(context) {}
 
   void Compute(OpKernelContext* context) override {
-    // Grab the part tensor
-    const Tensor& part_tensor = context->input(0);
-    std::string part = absl::AsciiStrToLower(part_tensor.flat<tstring>()(0));
+    // Grab the timestamp tensor
+    const Tensor& timestamp_tensor = context->input(1);
+    auto timestamp = timestamp_tensor.flat<tstring>();
+    // Grab the part tensor, a scalar or one part per timestamp
     static auto* supported_parts =
         new absl::flat_hash_set<functions::DateTimestampPart>(
             {functions::MICROSECOND,   functions::MILLISECOND,
@@ -74,18 +81,30 @@ class ExtractFromTimestamp : public OpKernel {
              functions::WEEK_SATURDAY, functions::ISOWEEK,
              functions::MONTH,         functions::QUARTER,
              functions::YEAR,          functions::ISOYEAR});
-    functions::DateTimestampPart part_enum;
-    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
-                                part, name(), &part_enum, *supported_parts));
-    // Grab the timestamp tensor
-    const Tensor& timestamp_tensor = context->input(1);
-    auto timestamp = timestamp_tensor.flat<tstring>();
-    // Grab the time_zone tensor
-    const Tensor& time_zone_tensor = context->input(2);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
-    absl::TimeZone tz;
+    BroadcastInput<functions::DateTimestampPart> part_enum;
+    OP_REQUIRES_OK(
+        context,
+        part_enum.Init(
+            context->input(0), timestamp_tensor.shape(), "part", name(),
+            [&](absl::string_view part, functions::DateTimestampPart* out) {
+              return part_cache_.Lookup(
+                  part,
+                  [&](functions::DateTimestampPart* part_out) {
+                    return ParseInputDateTimestampPart(
+                        absl::AsciiStrToLower(part), name(), part_out,
+                        *supported_parts);
+                  },
+                  out);
+            }));
+    // Grab the time_zone tensor, a scalar or one time zone per timestamp
+    BroadcastInput<absl::TimeZone> tz;
     OP_REQUIRES_OK(
-        context, ToTslStatus(name(), functions::MakeTimeZone(time_zone, &tz)));
+        context,
+        tz.Init(context->input(2), timestamp_tensor.shape(), "time_zone",
+                name(), [&](absl::string_view time_zone, absl::TimeZone* out) {
+                  return ParseInputTimeZone(time_zone, name(),
+                                            &time_zone_cache_, out);
+                }));
 
     // Create an output tensor with the shape of the timestamp tensor
     Tensor* output_tensor = NULL;
@@ -93,26 +112,125 @@ class ExtractFromTimestamp : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      TF_RETURN_IF_ERROR(part_enum.status(i));
+      TF_RETURN_IF_ERROR(tz.status(i));
+
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(context,
-                     ParseInputTimestamp(timestamp(i), tz, name(), &ts));
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestamp(timestamp(i), tz(i), name(), &ts));
 
       // Extract part from the timestamp.
       int32_t out;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(),
-                      functions::ExtractFromTimestamp(
-                          part_enum, ts, functions::kMicroseconds, tz, &out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractFromTimestamp(
+                      part_enum(i), ts, functions::kMicroseconds, tz(i),
+                      &out)));
 
       // Set the output value.
       // Currently, BQML util inference only supports int64.
       output_flat(i) = static_cast<int64_t>(out);
+      return ::tsl::OkStatus();
+    };
+    // Equal timestamps only share a result when the other inputs are scalars.
+    if (part_enum.is_scalar() && tz.is_scalar()) {
+      OP_REQUIRES_OK(
+          context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                       compute_element, output_flat));
+    } else {
+      OP_REQUIRES_OK(context, ParallelFor(context, timestamp.size(),
+                                          kCostPerUnit, compute_element));
     }
   }
+
+ private:
+  DateTimestampPartCache part_cache_;
+  TimeZoneCache time_zone_cache_;
+};
+
+class ExtractPartsFromTimestamp : public OpKernel {
+ public:
+  explicit ExtractPartsFromTimestamp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND,   functions::MILLISECOND,
+             functions::SECOND,        functions::MINUTE,
+             functions::HOUR,          functions::DAYOFWEEK,
+             functions::DAY,           functions::DAYOFYEAR,
+             functions::WEEK,          functions::WEEK_MONDAY,
+             functions::WEEK_TUESDAY,  functions::WEEK_WEDNESDAY,
+             functions::WEEK_THURSDAY, functions::WEEK_FRIDAY,
+             functions::WEEK_SATURDAY, functions::ISOWEEK,
+             functions::MONTH,         functions::QUARTER,
+             functions::YEAR,          functions::ISOYEAR});
+    std::vector<std::string> parts;
+    OP_REQUIRES_OK(context, context->GetAttr("parts", &parts));
+    OP_REQUIRES_OK(context, ParseInputDateTimestampParts(
+                                parts, name(), &parts_, *supported_parts));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the timestamp tensor
+    const Tensor& timestamp_tensor = context->input(0);
+    auto timestamp = timestamp_tensor.flat<tstring>();
+    // Grab the time_zone tensor
+    const Tensor& time_zone_tensor = context->input(1);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::TimeZone tz;
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
+
+    // Create an output tensor with the shape of the timestamp tensor and an
+    // innermost dimension for the parts
+    TensorShape output_shape = timestamp_tensor.shape();
+    output_shape.AddDim(parts_.size());
+    Tensor* output_tensor = nullptr;
+    OP_REQUIRES_OK(context, context->allocate_output(0, output_shape,
+                                                     &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = timestamp.size();
+    const int64_t P = parts_.size();
+    // Each element is parsed once for all the parts.
+    const int64_t cost_per_unit = kParseCost + P * kComputeCost;
+    auto compute_element = [&](int64_t i,
+                               absl::Span<int32_t> out) -> ::tsl::Status {
+      // Parse the timestamp.
+      int64_t ts;
+      TF_RETURN_IF_ERROR(ParseInputTimestamp(timestamp(i), tz, name(), &ts));
+
+      // Extract the parts from the timestamp.
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ExtractPartsFromTimestamp(
+                      parts_, ts, functions::kMicroseconds, tz, out)));
+
+      // Set the output values.
+      for (int64_t j = 0; j < P; j++) {
+        output_flat(i * P + j) = static_cast<int64_t>(out[j]);
+      }
+      return ::tsl::OkStatus();
+    };
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      std::vector<int32_t> out(P);
+      for (int64_t i = start; i < limit; i++) {
+        ::tsl::Status status = compute_element(i, absl::MakeSpan(out));
+        if (!status.ok()) {
+          errors->Add(i - start, std::move(status));
+          return;
+        }
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, cost_per_unit,
+                                              compute_shard));
+  }
+
+ private:
+  std::vector<functions::DateTimestampPart> parts_;
+  TimeZoneCache time_zone_cache_;
 };
 
 class StringFromTimestamp : public OpKernel {
@@ -124,9 +242,15 @@ class StringFromTimestamp : public OpKernel {
     // Grab the timestamp tensor
     const Tensor& timestamp_tensor = context->input(0);
     auto timestamp = timestamp_tensor.flat<tstring>();
-    // Grab the time_zone tensor
-    const Tensor& time_zone_tensor = context->input(1);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
+    // Grab the time_zone tensor, a scalar or one time zone per timestamp
+    BroadcastInput<absl::TimeZone> tz;
+    OP_REQUIRES_OK(
+        context,
+        tz.Init(context->input(1), timestamp_tensor.shape(), "time_zone",
+                name(), [&](absl::string_view time_zone, absl::TimeZone* out) {
+                  return ParseInputTimeZone(time_zone, name(),
+                                            &time_zone_cache_, out);
+                }));
 
     // Create an output tensor with the shape of the timestamp tensor
     Tensor* output_tensor = NULL;
@@ -134,31 +258,38 @@ class StringFromTimestamp : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    // Parse and validate the timezone.
-    absl::TimeZone tz;
-    OP_REQUIRES_OK(
-        context, ToTslStatus(name(), functions::MakeTimeZone(time_zone, &tz)));
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      TF_RETURN_IF_ERROR(tz.status(i));
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(context,
-                     ParseInputTimestamp(timestamp(i), tz, name(), &ts));
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestamp(timestamp(i), tz(i), name(), &ts));
 
       // Convert timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(),
-                      functions::ConvertTimestampMicrosToStringWithTruncation(
-                          ts, tz, &out)));
+      std::string& out = ThreadLocalOutputBuffer();
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConvertTimestampMicrosToStringWithTruncation(
+                      ts, tz(i), &out)));
 
       // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
+      output_flat(i).assign(out.data(), out.size());
+      return ::tsl::OkStatus();
+    };
+    // Equal timestamps only share a result when the time zone is a scalar.
+    if (tz.is_scalar()) {
+      OP_REQUIRES_OK(
+          context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                       compute_element, output_flat));
+    } else {
+      OP_REQUIRES_OK(context, ParallelFor(context, timestamp.size(),
+                                          kCostPerUnit, compute_element));
     }
   }
+
+ private:
+  TimeZoneCache time_zone_cache_;
 };
 
 class TimestampFromString : public OpKernel {
@@ -172,7 +303,7 @@ class TimestampFromString : public OpKernel {
     auto timestamp = timestamp_tensor.flat<tstring>();
     // Grab the time_zone tensor
     const Tensor& time_zone_tensor = context->input(1);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
     // Grab the allow_tz_in_str tensor
     const Tensor& allow_tz_in_str_tensor = context->input(2);
     bool allow_tz_in_str = allow_tz_in_str_tensor.flat<bool>()(0);
@@ -185,28 +316,163 @@ class TimestampFromString : public OpKernel {
 
     // Parse and validate the timezone.
     absl::TimeZone tz;
-    OP_REQUIRES_OK(
-        context, ToTslStatus(name(), functions::MakeTimeZone(time_zone, &tz)));
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::ConvertStringToTimestamp(
-                                  timestamp(i), tz, functions::kMicroseconds,
-                                  allow_tz_in_str, &ts)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConvertStringToTimestamp(
+                      timestamp(i), tz, functions::kMicroseconds,
+                      allow_tz_in_str, &ts)));
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                     compute_element, output_flat));
+  }
 
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
+ private:
+  TimeZoneCache time_zone_cache_;
+};
+
+class CastToTimestampFromString : public OpKernel {
+ public:
+  explicit CastToTimestampFromString(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the timestamp_string tensor
+    const Tensor& timestamp_string_tensor = context->input(0);
+    auto timestamp_string = timestamp_string_tensor.flat<tstring>();
+    // Grab the format tensor
+    const Tensor& format_tensor = context->input(1);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    // Grab the time_zone tensor
+    const Tensor& time_zone_tensor = context->input(2);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
+    // Grab the with_format tensor
+    const Tensor& with_format_tensor = context->input(3);
+    bool with_format = with_format_tensor.flat<bool>()(0);
+
+    // Create an output tensor with the shape of the timestamp_string tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(0, timestamp_string_tensor.shape(),
+                                            &output_tensor));
+    auto output_flat = output_tensor->flat<tstring>();
+
+    // Parse and validate the timezone.
+    absl::TimeZone tz;
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
+
+    const int N = timestamp_string.size();
+    constexpr int64_t kCostPerUnit =
+        2 * kParseCost + kFormatCost + kComputeCost;
+    if (with_format) {
+      // Compile the format once, then convert the strings a shard at a time.
+      std::shared_ptr<const functions::StringToTimestampCaster> caster;
+      OP_REQUIRES_OK(context, ParseInputCastFormat(format, name(),
+                                                   &caster_cache_, &caster));
+      const absl::Time now =
+          absl::FromUnixMicros(functions::CurrentTimestamp());
+      auto compute_shard = [&](int64_t start, int64_t limit,
+                               ShardErrors* errors) {
+        // Convert strings with format.
+        std::vector<int64_t> timestamps(limit - start);
+        errors->AddBatchStatus(caster->CastBatch(
+            ShardStrings(timestamp_string, start, limit), tz, now,
+            absl::MakeSpan(timestamps), errors));
+        // Format timestamps to string.
+        for (int64_t i = 0; i < limit - start; i++) {
+          errors->Add(i, FormatOutputTimestamp(timestamps[i], name(),
+                                               &output_flat(start + i)));
+        }
+      };
+      OP_REQUIRES_OK(context, ParallelForShards(context, name(), N,
+                                                kCostPerUnit, compute_shard));
+      return;
     }
+
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Convert string without format
+      int64_t ts;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConvertStringToTimestamp(
+                      timestamp_string(i), tz, functions::kMicroseconds,
+                      /*allow_tz_in_str=*/true, &ts)));
+      // Format timestamp to string.
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+
+ private:
+  TimeZoneCache time_zone_cache_;
+  CastFormatCache<functions::StringToTimestampCaster> caster_cache_;
+};
+
+class CastToStringFromTimestamp : public OpKernel {
+ public:
+  explicit CastToStringFromTimestamp(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the timestamp tensor
+    const Tensor& timestamp_tensor = context->input(0);
+    auto timestamp = timestamp_tensor.flat<tstring>();
+    // Grab the format tensor
+    const Tensor& format_tensor = context->input(1);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    std::shared_ptr<const functions::TimestampToStringCaster> caster;
+    OP_REQUIRES_OK(context, ParseInputCastFormat(format, name(),
+                                                 &caster_cache_, &caster));
+    // Grab the time_zone tensor
+    const Tensor& time_zone_tensor = context->input(2);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::TimeZone tz;
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
+
+    // Create an output tensor with the shape of the timestamp tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, timestamp_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<tstring>();
+
+    const int N = timestamp.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Parse the timestamps.
+      std::vector<int64_t> timestamps(limit - start);
+      for (int64_t i = 0; i < limit - start; i++) {
+        errors->Add(i, ParseInputTimestamp(timestamp(start + i), tz, name(),
+                                           &timestamps[i]));
+      }
+      // Convert timestamps to string with format.
+      absl::Span<std::string> out = ThreadLocalOutputBuffers(limit - start);
+      errors->AddBatchStatus(caster->CastBatch(timestamps, tz, out, errors));
+      // Set the output values.
+      for (int64_t i = 0; i < limit - start; i++) {
+        output_flat(start + i).assign(out[i].data(), out[i].size());
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
   }
+
+ private:
+  CastFormatCache<functions::TimestampToStringCaster> caster_cache_;
+  TimeZoneCache time_zone_cache_;
 };
 
 class TimestampFromDate : public OpKernel {
@@ -220,7 +486,7 @@ class TimestampFromDate : public OpKernel {
     auto date = date_tensor.flat<tstring>();
     // Grab the time_zone tensor
     const Tensor& time_zone_tensor = context->input(1);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
 
     // Create an output tensor with the shape of the date tensor
     Tensor* output_tensor = NULL;
@@ -230,30 +496,30 @@ class TimestampFromDate : public OpKernel {
 
     // Parse and validate the timezone.
     absl::TimeZone tz;
-    OP_REQUIRES_OK(
-        context, ToTslStatus(name(), functions::MakeTimeZone(time_zone, &tz)));
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
 
-    const int N = date.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the date.
       int32_t date_int;
-      OP_REQUIRES_OK(context, ParseInputDate(date(i), name(), &date_int));
+      TF_RETURN_IF_ERROR(ParseInputDate(date(i), name(), &date_int));
 
       int64_t ts;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ConvertDateToTimestamp(
-                                             date_int, functions::kMicroseconds,
-                                             tz, &ts)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::ConvertDateToTimestamp(
+                      date_int, functions::kMicroseconds, tz, &ts)));
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, date, kCostPerUnit,
+                                                compute_element, output_flat));
   }
+
+ private:
+  TimeZoneCache time_zone_cache_;
 };
 
 class TimestampFromDatetime : public OpKernel {
@@ -267,7 +533,7 @@ class TimestampFromDatetime : public OpKernel {
     auto datetime = date_tensor.flat<tstring>();
     // Grab the time_zone tensor
     const Tensor& time_zone_tensor = context->input(1);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
 
     // Create an output tensor with the shape of the datetime tensor
     Tensor* output_tensor = NULL;
@@ -277,32 +543,33 @@ class TimestampFromDatetime : public OpKernel {
 
     // Parse and validate the timezone.
     absl::TimeZone tz;
-    OP_REQUIRES_OK(
-        context, ToTslStatus(name(), functions::MakeTimeZone(time_zone, &tz)));
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
 
-    const int N = datetime.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the datetime.
       DatetimeValue dt;
-      OP_REQUIRES_OK(context, ParseInputDatetime(datetime(i), name(), &dt));
+      TF_RETURN_IF_ERROR(ParseInputDatetime(datetime(i), name(), &dt));
 
       absl::Time base_time;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ConvertDatetimeToTimestamp(
-                                             DatetimeValue::FromPacked64Micros(
-                                                 dt.Packed64DatetimeMicros()),
-                                             tz, &base_time)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ConvertDatetimeToTimestamp(
+              DatetimeValue::FromPacked64Micros(dt.Packed64DatetimeMicros()),
+              tz, &base_time)));
       int64_t ts = absl::ToUnixMicros(base_time);
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context, ParallelForDistinct(context, datetime, kCostPerUnit,
+                                                compute_element, output_flat));
   }
+
+ private:
+  TimeZoneCache time_zone_cache_;
 };
 
 class TimestampAdd : public OpKernel {
@@ -324,52 +591,58 @@ class TimestampAdd : public OpKernel {
             name(), timestamp.size(), interval_int.size())));
     // Grab the part tensor
     const Tensor& part_tensor = context->input(2);
-    std::string part = part_tensor.flat<tstring>()(0);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
     functions::DateTimestampPart part_enum;
     static auto* supported_parts =
         new absl::flat_hash_set<functions::DateTimestampPart>(
             {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
              functions::MINUTE, functions::HOUR, functions::DAY});
-    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
-                                part, name(), &part_enum, *supported_parts));
+    OP_REQUIRES_OK(context,
+                   ParseInputDateTimestampPart(part, name(), &part_cache_,
+                                               &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the timestamp tensor
+    // Create an output tensor with the shape of the timestamp tensor, reusing
+    // its buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(
-                                0, timestamp_tensor.shape(), &output_tensor));
+    OP_REQUIRES_OK(context,
+                   context->forward_input_or_allocate_output(
+                       {0}, 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Default time zone.
       absl::TimeZone tz = absl::UTCTimeZone();
 
       // Parse the timestamp.
       int64_t input_ts;
-      OP_REQUIRES_OK(context,
-                     ParseInputTimestamp(timestamp(i), tz, name(), &input_ts));
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestamp(timestamp(i), tz, name(), &input_ts));
 
       absl::StatusOr<IntervalValue> interval =
           GetIntervalValue(interval_int(i), part_enum);
-      OP_REQUIRES(
-          context, interval.ok(),
-          Internal("Error in getting interval of TimestampAdd with status: ",
-                   interval.status()));
+      if (!interval.ok()) {
+        return Internal(
+            "Error in getting interval of TimestampAdd with status: ",
+            interval.status());
+      }
       absl::Time base_time;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::AddTimestamp(
-                                             absl::FromUnixMicros(input_ts), tz,
-                                             *interval, &base_time)));
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), functions::AddTimestamp(
+                                  absl::FromUnixMicros(input_ts), tz, *interval,
+                                  &base_time)));
       int64_t ts = absl::ToUnixMicros(base_time);
 
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
+
+ private:
+  DateTimestampPartCache part_cache_;
 };
 
 class TimestampSub : public OpKernel {
@@ -391,53 +664,59 @@ class TimestampSub : public OpKernel {
             name(), timestamp.size(), interval_int.size())));
     // Grab the part tensor
     const Tensor& part_tensor = context->input(2);
-    std::string part = part_tensor.flat<tstring>()(0);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
     functions::DateTimestampPart part_enum;
     static auto* supported_parts =
         new absl::flat_hash_set<functions::DateTimestampPart>(
             {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
              functions::MINUTE, functions::HOUR, functions::DAY});
-    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
-                                part, name(), &part_enum, *supported_parts));
+    OP_REQUIRES_OK(context,
+                   ParseInputDateTimestampPart(part, name(), &part_cache_,
+                                               &part_enum, *supported_parts));
 
-    // Create an output tensor with the shape of the timestamp tensor
+    // Create an output tensor with the shape of the timestamp tensor, reusing
+    // its buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(
-                                0, timestamp_tensor.shape(), &output_tensor));
+    OP_REQUIRES_OK(context,
+                   context->forward_input_or_allocate_output(
+                       {0}, 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Default time zone.
       absl::TimeZone tz = absl::UTCTimeZone();
 
       // Parse the timestamp.
       int64_t input_ts;
-      OP_REQUIRES_OK(context,
-                     ParseInputTimestamp(timestamp(i), tz, name(), &input_ts));
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestamp(timestamp(i), tz, name(), &input_ts));
 
       absl::StatusOr<IntervalValue> interval =
           GetIntervalValue(-interval_int(i), part_enum);
-      OP_REQUIRES(
-          context, interval.ok(),
-          Internal("Error in getting interval of TimestampSub with status: ",
-                   interval.status()));
+      if (!interval.ok()) {
+        return Internal(
+            "Error in getting interval of TimestampSub with status: ",
+            interval.status());
+      }
       absl::Time base_time;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::AddTimestamp(
-                                             absl::FromUnixMicros(input_ts), tz,
-                                             *interval, &base_time)));
+      TF_RETURN_IF_ERROR(
+          ToTslStatus(name(), functions::AddTimestamp(
+                                  absl::FromUnixMicros(input_ts), tz, *interval,
+                                  &base_time)));
       int64_t ts = absl::ToUnixMicros(base_time);
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
+
+ private:
+  DateTimestampPartCache part_cache_;
 };
 
 class TimestampDiff : public OpKernel {
@@ -456,14 +735,15 @@ class TimestampDiff : public OpKernel {
                     "Timestamps in TimestampDiff must have the same length."));
     // Grab the part tensor
     const Tensor& part_tensor = context->input(2);
-    std::string part = part_tensor.flat<tstring>()(0);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
     functions::DateTimestampPart part_enum;
     static auto* supported_parts =
         new absl::flat_hash_set<functions::DateTimestampPart>(
             {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
              functions::MINUTE, functions::HOUR, functions::DAY});
-    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
-                                part, name(), &part_enum, *supported_parts));
+    OP_REQUIRES_OK(context,
+                   ParseInputDateTimestampPart(part, name(), &part_cache_,
+                                               &part_enum, *supported_parts));
 
     // Create an output tensor with the shape of the timestamp tensor
     Tensor* output_tensor = NULL;
@@ -472,28 +752,34 @@ class TimestampDiff : public OpKernel {
     auto output_flat = output_tensor->flat<int64_t>();
 
     const int N = timestamp_a.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = 2 * kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Default time zone.
       absl::TimeZone tz = absl::UTCTimeZone();
 
       // Parse the timestamp.
       int64_t ts_a;
       int64_t ts_b;
-      OP_REQUIRES_OK(context,
-                     ParseInputTimestamp(timestamp_a(i), tz, name(), &ts_a));
-      OP_REQUIRES_OK(context,
-                     ParseInputTimestamp(timestamp_b(i), tz, name(), &ts_b));
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestamp(timestamp_a(i), tz, name(), &ts_a));
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestamp(timestamp_b(i), tz, name(), &ts_b));
 
       int64_t out;
-      OP_REQUIRES_OK(
-          context, ToTslStatus(name(), functions::TimestampDiff(
-                                           ts_a, ts_b, functions::kMicroseconds,
-                                           part_enum, &out)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::TimestampDiff(
+                      ts_a, ts_b, functions::kMicroseconds, part_enum, &out)));
 
       // Set the output value.
       output_flat(i) = out;
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
+
+ private:
+  DateTimestampPartCache part_cache_;
 };
 
 class TimestampTrunc : public OpKernel {
@@ -504,10 +790,7 @@ class TimestampTrunc : public OpKernel {
     // Grab the timestamp tensor
     const Tensor& timestamp_tensor = context->input(0);
     auto timestamp = timestamp_tensor.flat<tstring>();
-    // Grab the part tensor
-    const Tensor& part_tensor = context->input(1);
-    std::string part = part_tensor.flat<tstring>()(0);
-    functions::DateTimestampPart part_enum;
+    // Grab the part tensor, a scalar or one part per timestamp
     static auto* supported_parts =
         new absl::flat_hash_set<functions::DateTimestampPart>(
             {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
@@ -517,43 +800,95 @@ class TimestampTrunc : public OpKernel {
              functions::WEEK_FRIDAY, functions::WEEK_SATURDAY,
              functions::ISOWEEK, functions::MONTH, functions::QUARTER,
              functions::YEAR, functions::ISOYEAR});
-    OP_REQUIRES_OK(context, ParseInputDateTimestampPart(
-                                part, name(), &part_enum, *supported_parts));
-    // Grab the time_zone tensor
-    const Tensor& time_zone_tensor = context->input(2);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
-    absl::TimeZone tz;
+    BroadcastInput<functions::DateTimestampPart> part_enum;
     OP_REQUIRES_OK(
-        context, ToTslStatus(name(), functions::MakeTimeZone(time_zone, &tz)));
-
-    // Create an output tensor with the shape of the timestamp tensor
+        context,
+        part_enum.Init(
+            context->input(1), timestamp_tensor.shape(), "part", name(),
+            [&](absl::string_view part, functions::DateTimestampPart* out) {
+              return ParseInputDateTimestampPart(part, name(), &part_cache_,
+                                                 out, *supported_parts);
+            }));
+    // Grab the time_zone tensor, a scalar or one time zone per timestamp
+    BroadcastInput<absl::TimeZone> tz;
+    OP_REQUIRES_OK(
+        context,
+        tz.Init(context->input(2), timestamp_tensor.shape(), "time_zone",
+                name(), [&](absl::string_view time_zone, absl::TimeZone* out) {
+                  return ParseInputTimeZone(time_zone, name(),
+                                            &time_zone_cache_, out);
+                }));
+
+    // Create an output tensor with the shape of the timestamp tensor, reusing
+    // its buffer when no other op needs it.
     Tensor* output_tensor = NULL;
-    OP_REQUIRES_OK(context, context->allocate_output(
-                                0, timestamp_tensor.shape(), &output_tensor));
+    OP_REQUIRES_OK(context,
+                   context->forward_input_or_allocate_output(
+                       {0}, 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      TF_RETURN_IF_ERROR(part_enum.status(i));
+      TF_RETURN_IF_ERROR(tz.status(i));
+
       // Parse the timestamp.
       int64_t input_ts;
-      OP_REQUIRES_OK(context,
-                     ParseInputTimestamp(timestamp(i), tz, name(), &input_ts));
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestamp(timestamp(i), tz(i), name(), &input_ts));
 
       int64_t out_ts;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::TruncateTimestamp(
-                                             input_ts, functions::kMicroseconds,
-                                             tz, part_enum, &out_ts)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::TruncateTimestamp(input_ts, functions::kMicroseconds,
+                                       tz(i), part_enum(i), &out_ts)));
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(out_ts, name(), &out));
+      TF_RETURN_IF_ERROR(
+          FormatOutputTimestamp(out_ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Parse the timestamps. A timestamp that fails to parse is truncated as
+      // 0, and its output is reset with the other failing rows.
+      std::vector<int64_t> timestamp_in(limit - start);
+      for (int64_t i = start; i < limit; i++) {
+        ::tsl::Status status = ParseInputTimestamp(timestamp(i), tz(i), name(),
+                                                   &timestamp_in[i - start]);
+        if (!status.ok()) {
+          timestamp_in[i - start] = 0;
+          errors->Add(i - start, std::move(status));
+        }
+      }
 
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
+      // Truncate the timestamps as a batch, so that consecutive timestamps
+      // within the same part share the work.
+      std::vector<int64_t> timestamp_out(limit - start);
+      errors->AddBatchStatus(functions::TruncateTimestamps(
+          timestamp_in, tz(start), part_enum(start),
+          absl::MakeSpan(timestamp_out), errors));
+
+      // Format timestamps to string.
+      for (int64_t i = start; i < limit; i++) {
+        errors->Add(i - start, FormatOutputTimestamp(timestamp_out[i - start],
+                                                     name(), &output_flat(i)));
+      }
+    };
+    // The batch truncation needs a single part and time zone.
+    if (part_enum.is_scalar() && tz.is_scalar()) {
+      OP_REQUIRES_OK(context,
+                     ParallelForShards(context, name(), timestamp.size(),
+                                       kCostPerUnit, compute_shard));
+    } else {
+      OP_REQUIRES_OK(context, ParallelFor(context, timestamp.size(),
+                                          kCostPerUnit, compute_element));
     }
   }
+
+ private:
+  DateTimestampPartCache part_cache_;
+  TimeZoneCache time_zone_cache_;
 };
 
 class FormatTimestamp : public OpKernel {
@@ -563,16 +898,19 @@ class FormatTimestamp : public OpKernel {
   void Compute(OpKernelContext* context) override {
     // Grab the format string tensor
     const Tensor& format_tensor = context->input(0);
-    std::string format = format_tensor.flat<tstring>()(0);
+    absl::string_view format = format_tensor.flat<tstring>()(0);
+    std::shared_ptr<const functions::TimestampFormatter> formatter;
+    OP_REQUIRES_OK(context, ParseInputFormat(format, name(), &format_cache_,
+                                             &formatter));
     // Grab the timestamp tensor
     const Tensor& timestamp_tensor = context->input(1);
     auto timestamp = timestamp_tensor.flat<tstring>();
     // Grab the time_zone tensor
     const Tensor& time_zone_tensor = context->input(2);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
     absl::TimeZone tz;
-    OP_REQUIRES_OK(
-        context, ToTslStatus(name(), functions::MakeTimeZone(time_zone, &tz)));
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
 
     // Create an output tensor with the shape of the timestamp tensor
     Tensor* output_tensor = NULL;
@@ -580,29 +918,28 @@ class FormatTimestamp : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(context,
-                     ParseInputTimestamp(timestamp(i), tz, name(), &ts));
+      TF_RETURN_IF_ERROR(ParseInputTimestamp(timestamp(i), tz, name(), &ts));
 
       // Format the timestamp string.
-      functions::FormatDateTimestampOptions format_options = {
-          .expand_Q = true,
-          .expand_J = true,
-      };
-      std::string out;
-      OP_REQUIRES_OK(
-          context,
-          ToTslStatus(name(), functions::FormatTimestampToString(
-                                  format, ts, tz, format_options, &out)));
+      std::string& out = ThreadLocalOutputBuffer();
+      TF_RETURN_IF_ERROR(ToTslStatus(name(), formatter->Format(ts, tz, &out)));
 
       // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      output_flat(i).assign(out.data(), out.size());
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                     compute_element, output_flat));
   }
+
+ private:
+  TimestampFormatterCache format_cache_;
+  TimeZoneCache time_zone_cache_;
 };
 
 class ParseTimestamp : public OpKernel {
@@ -618,10 +955,10 @@ class ParseTimestamp : public OpKernel {
     auto timestamp = timestamp_tensor.flat<tstring>();
     // Grab the time_zone tensor
     const Tensor& time_zone_tensor = context->input(2);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
     absl::TimeZone tz;
-    OP_REQUIRES_OK(
-        context, ToTslStatus(name(), functions::MakeTimeZone(time_zone, &tz)));
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
 
     // Create an output tensor with the shape of the timestamp tensor
     Tensor* output_tensor = NULL;
@@ -629,24 +966,26 @@ class ParseTimestamp : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(context,
-                     ToTslStatus(name(), functions::ParseStringToTimestamp(
-                                             format, timestamp(i), time_zone,
-                                             /*parse_version2=*/true, &ts)));
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(),
+          functions::ParseStringToTimestamp(
+              format, timestamp(i), time_zone, /*parse_version2=*/true, &ts)));
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                     compute_element, output_flat));
   }
+
+ private:
+  TimeZoneCache time_zone_cache_;
 };
 
 class SafeParseTimestamp : public OpKernel {
@@ -663,8 +1002,11 @@ class SafeParseTimestamp : public OpKernel {
     auto timestamp = timestamp_tensor.flat<tstring>();
     // Grab the time_zone tensor
     const Tensor& time_zone_tensor = context->input(2);
-    std::string time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
+    // An invalid time zone makes every element NULL.
     absl::TimeZone tz;
+    const bool valid_time_zone =
+        ParseInputTimeZone(time_zone, name(), &time_zone_cache_, &tz).ok();
 
     // Create an output tensor with the shape of the timestamp tensor
     Tensor* output_tensor = NULL;
@@ -672,32 +1014,51 @@ class SafeParseTimestamp : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<tstring>();
 
+    // SafeParseTimestampWithValidity reports failures in a second output
+    // instead of with the NULL-equivalent value.
+    bool* valid = nullptr;
+    int64_t null_timestamp = 0;
+    if (num_outputs() > 1) {
+      Tensor* valid_tensor = nullptr;
+      OP_REQUIRES_OK(context, context->allocate_output(
+                                  1, timestamp_tensor.shape(), &valid_tensor));
+      valid = valid_tensor->flat<bool>().data();
+    } else {
+      OP_REQUIRES_OK(
+          context, ToTslStatus(name(), functions::ParseStringToTimestamp(
+                                           kTimestampFormatString,
+                                           kNullTimestamp, absl::UTCTimeZone(),
+                                           /*parse_version2=*/true,
+                                           &null_timestamp)));
+    }
+
     const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Safe parse the timestamp.
       int64_t ts;
-      if (!functions::MakeTimeZone(time_zone, &tz).ok() ||
-          !functions::ParseStringToTimestamp(format, timestamp(i), time_zone,
-                                             /*parse_version2=*/true, &ts)
-               .ok()) {
+      const bool parsed =
+          valid_time_zone &&
+          functions::TryParseStringToTimestamp(format, timestamp(i), tz,
+                                               /*parse_version2=*/true, &ts);
+      if (valid != nullptr) {
+        valid[i] = parsed;
+        if (!parsed) return ::tsl::OkStatus();
+      } else if (!parsed) {
         // Set the NULL-equivalent output value for unsuccessful parsing.
-        OP_REQUIRES_OK(
-            context,
-            ToTslStatus(name(), functions::ParseStringToTimestamp(
-                                    kTimestampFormatString, kNullTimestamp,
-                                    absl::UTCTimeZone(),
-                                    /*parse_version2=*/true, &ts)));
+        ts = null_timestamp;
       }
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
+
+ private:
+  TimeZoneCache time_zone_cache_;
 };
 
 ::tsl::Status TimestampFromIntOperator(int64_t in, int64_t scale,
@@ -753,21 +1114,19 @@ class TimestampMicros : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = timestamp_int.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(context,
-                     TimestampFromIntOperator(timestamp_int(i),
-                                              /* scale= */ 1, name(), &ts));
+      TF_RETURN_IF_ERROR(TimestampFromIntOperator(
+          timestamp_int(i), /* scale= */ 1, name(), &ts));
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -788,21 +1147,19 @@ class TimestampMillis : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = timestamp_int.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(context,
-                     TimestampFromIntOperator(timestamp_int(i),
-                                              /* scale= */ 1000, name(), &ts));
+      TF_RETURN_IF_ERROR(TimestampFromIntOperator(
+          timestamp_int(i), /* scale= */ 1000, name(), &ts));
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -824,21 +1181,19 @@ class TimestampSeconds : public OpKernel {
     auto output_flat = output_tensor->flat<tstring>();
 
     const int N = timestamp_int.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kFormatCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(
-          context, TimestampFromIntOperator(timestamp_int(i),
-                                            /* scale= */ 1000000, name(), &ts));
+      TF_RETURN_IF_ERROR(TimestampFromIntOperator(
+          timestamp_int(i), /* scale= */ 1000000, name(), &ts));
 
       // Format timestamp to string.
-      std::string out;
-      OP_REQUIRES_OK(context, FormatOutputTimestamp(ts, name(), &out));
-
-      // Set the output value.
-      output_flat(i).reserve(out.size());
-      output_flat(i) = std::move(out);
-    }
+      TF_RETURN_IF_ERROR(FormatOutputTimestamp(ts, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
 };
 
@@ -874,23 +1229,25 @@ class UnixMicros : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(
-          context,
+      TF_RETURN_IF_ERROR(
           ParseInputTimestamp(timestamp(i), absl::UTCTimeZone(), name(), &ts));
 
       // Convert timestamp to micros.
       int64_t out;
-      OP_REQUIRES_OK(context,
-                     IntFromTimestampOperator(ts,
-                                              /* scale= */ 1, name(), &out));
+      TF_RETURN_IF_ERROR(
+          IntFromTimestampOperator(ts, /* scale= */ 1, name(), &out));
 
       // Set the output value.
       output_flat(i) = out;
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                     compute_element, output_flat));
   }
 };
 
@@ -909,23 +1266,25 @@ class UnixMillis : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(
-          context,
+      TF_RETURN_IF_ERROR(
           ParseInputTimestamp(timestamp(i), absl::UTCTimeZone(), name(), &ts));
 
       // Convert timestamp to millis.
       int64_t out;
-      OP_REQUIRES_OK(context,
-                     IntFromTimestampOperator(ts,
-                                              /* scale= */ 1000, name(), &out));
+      TF_RETURN_IF_ERROR(
+          IntFromTimestampOperator(ts, /* scale= */ 1000, name(), &out));
 
       // Set the output value.
       output_flat(i) = out;
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                     compute_element, output_flat));
   }
 };
 
@@ -944,49 +1303,422 @@ class UnixSeconds : public OpKernel {
                                 0, timestamp_tensor.shape(), &output_tensor));
     auto output_flat = output_tensor->flat<int64_t>();
 
-    const int N = timestamp.size();
-    for (int i = 0; i < N; i++) {
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
       // Parse the timestamp.
       int64_t ts;
-      OP_REQUIRES_OK(
-          context,
+      TF_RETURN_IF_ERROR(
           ParseInputTimestamp(timestamp(i), absl::UTCTimeZone(), name(), &ts));
 
       // Convert timestamp to seconds.
       int64_t out;
-      OP_REQUIRES_OK(context, IntFromTimestampOperator(ts,
-                                                       /* scale= */ 1000000,
-                                                       name(), &out));
+      TF_RETURN_IF_ERROR(
+          IntFromTimestampOperator(ts, /* scale= */ 1000000, name(), &out));
 
       // Set the output value.
       output_flat(i) = out;
-    }
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(
+        context, ParallelForDistinct(context, timestamp, kCostPerUnit,
+                                     compute_element, output_flat));
+  }
+};
+
+class ExtractFromTimestampMicros : public OpKernel {
+ public:
+  explicit ExtractFromTimestampMicros(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(0);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND,   functions::MILLISECOND,
+             functions::SECOND,        functions::MINUTE,
+             functions::HOUR,          functions::DAYOFWEEK,
+             functions::DAY,           functions::DAYOFYEAR,
+             functions::WEEK,          functions::WEEK_MONDAY,
+             functions::WEEK_TUESDAY,  functions::WEEK_WEDNESDAY,
+             functions::WEEK_THURSDAY, functions::WEEK_FRIDAY,
+             functions::WEEK_SATURDAY, functions::ISOWEEK,
+             functions::MONTH,         functions::QUARTER,
+             functions::YEAR,          functions::ISOYEAR});
+    functions::DateTimestampPart part_enum;
+    OP_REQUIRES_OK(context,
+                   part_cache_.Lookup(
+                       part,
+                       [&](functions::DateTimestampPart* out) {
+                         return ParseInputDateTimestampPart(
+                             absl::AsciiStrToLower(part), name(), out,
+                             *supported_parts);
+                       },
+                       &part_enum));
+    // Grab the timestamp tensor
+    const Tensor& timestamp_tensor = context->input(1);
+    auto timestamp = timestamp_tensor.flat<int64_t>();
+    // Grab the time_zone tensor
+    const Tensor& time_zone_tensor = context->input(2);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::TimeZone tz;
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
+
+    // Create an output tensor with the shape of the timestamp tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, timestamp_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = timestamp.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Validate the timestamps.
+      ::tsl::Status status;
+      const auto timestamp_in =
+          absl::MakeConstSpan(timestamp.data() + start, limit - start);
+      const int64_t num_valid =
+          ParseInputTimestampMicros(timestamp_in, name(), &status);
+      errors->Add(num_valid, status);
+
+      // Extract part from the timestamps.
+      std::vector<int32_t> out(num_valid);
+      errors->AddBatchStatus(functions::ExtractFromTimestamps(
+          part_enum, timestamp_in.first(num_valid), functions::kMicroseconds,
+          tz, absl::MakeSpan(out), errors));
+
+      // Set the output values.
+      for (int64_t i = 0; i < num_valid; i++) {
+        output_flat(start + i) = static_cast<int64_t>(out[i]);
+      }
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
+  }
+
+ private:
+  DateTimestampPartCache part_cache_;
+  TimeZoneCache time_zone_cache_;
+};
+
+::tsl::Status TimestampAddMicrosOperator(int64_t in, int64_t interval_int,
+                                         functions::DateTimestampPart part_enum,
+                                         absl::string_view function_name,
+                                         int64_t* out) {
+  int64_t input_ts;
+  TF_RETURN_IF_ERROR(ParseInputTimestampMicros(in, function_name, &input_ts));
+
+  absl::StatusOr<IntervalValue> interval =
+      GetIntervalValue(interval_int, part_enum);
+  if (!interval.ok()) {
+    return Internal("Error in getting interval of ", function_name,
+                    " with status: ", interval.status());
+  }
+  absl::Time base_time;
+  TF_RETURN_IF_ERROR(ToTslStatus(
+      function_name,
+      functions::AddTimestamp(absl::FromUnixMicros(input_ts),
+                              absl::UTCTimeZone(), *interval, &base_time)));
+  *out = absl::ToUnixMicros(base_time);
+  return ::tsl::OkStatus();
+}
+
+class TimestampAddMicros : public OpKernel {
+ public:
+  explicit TimestampAddMicros(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the timestamp tensor
+    const Tensor& timestamp_tensor = context->input(0);
+    auto timestamp = timestamp_tensor.flat<int64_t>();
+    // Grab the interval tensor
+    const Tensor& diff_tensor = context->input(1);
+    auto interval_int = diff_tensor.flat<int64_t>();
+    OP_REQUIRES(
+        context, interval_int.size() == timestamp.size(),
+        InvalidArgument(absl::Substitute(
+            "Error in $0: timestamp and interval must have the same shape, "
+            "but are $1, $2",
+            name(), timestamp.size(), interval_int.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR, functions::DAY});
+    OP_REQUIRES_OK(context,
+                   ParseInputDateTimestampPart(part, name(), &part_cache_,
+                                               &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the timestamp tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, timestamp_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = timestamp.size();
+    constexpr int64_t kCostPerUnit = kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      TF_RETURN_IF_ERROR(TimestampAddMicrosOperator(
+          timestamp(i), interval_int(i), part_enum, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+
+ private:
+  DateTimestampPartCache part_cache_;
+};
+
+class TimestampSubMicros : public OpKernel {
+ public:
+  explicit TimestampSubMicros(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the timestamp tensor
+    const Tensor& timestamp_tensor = context->input(0);
+    auto timestamp = timestamp_tensor.flat<int64_t>();
+    // Grab the interval tensor
+    const Tensor& diff_tensor = context->input(1);
+    auto interval_int = diff_tensor.flat<int64_t>();
+    OP_REQUIRES(
+        context, interval_int.size() == timestamp.size(),
+        InvalidArgument(absl::Substitute(
+            "Error in $0: timestamp and interval must have the same shape, "
+            "but are $1, $2",
+            name(), timestamp.size(), interval_int.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR, functions::DAY});
+    OP_REQUIRES_OK(context,
+                   ParseInputDateTimestampPart(part, name(), &part_cache_,
+                                               &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the timestamp tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, timestamp_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = timestamp.size();
+    constexpr int64_t kCostPerUnit = kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      TF_RETURN_IF_ERROR(TimestampAddMicrosOperator(
+          timestamp(i), -interval_int(i), part_enum, name(), &output_flat(i)));
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
   }
+
+ private:
+  DateTimestampPartCache part_cache_;
+};
+
+class TimestampDiffMicros : public OpKernel {
+ public:
+  explicit TimestampDiffMicros(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the timestamp_a tensor
+    const Tensor& timestamp_a_tensor = context->input(0);
+    auto timestamp_a = timestamp_a_tensor.flat<int64_t>();
+    // Grab the timestamp_b tensor
+    const Tensor& timestamp_b_tensor = context->input(1);
+    auto timestamp_b = timestamp_b_tensor.flat<int64_t>();
+    OP_REQUIRES(context, timestamp_a.size() == timestamp_b.size(),
+                InvalidArgument(absl::Substitute(
+                    "Error in $0: timestamp_a and timestamp_b must have the "
+                    "same shape, but are $1, $2",
+                    name(), timestamp_a.size(), timestamp_b.size())));
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(2);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR, functions::DAY});
+    OP_REQUIRES_OK(context,
+                   ParseInputDateTimestampPart(part, name(), &part_cache_,
+                                               &part_enum, *supported_parts));
+
+    // Create an output tensor with the shape of the timestamp tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, timestamp_a_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = timestamp_a.size();
+    constexpr int64_t kCostPerUnit = 2 * kParseCost + kComputeCost;
+    auto compute_element = [&](int64_t i) -> ::tsl::Status {
+      // Validate the timestamps.
+      int64_t ts_a;
+      int64_t ts_b;
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestampMicros(timestamp_a(i), name(), &ts_a));
+      TF_RETURN_IF_ERROR(
+          ParseInputTimestampMicros(timestamp_b(i), name(), &ts_b));
+
+      int64_t out;
+      TF_RETURN_IF_ERROR(ToTslStatus(
+          name(), functions::TimestampDiff(
+                      ts_a, ts_b, functions::kMicroseconds, part_enum, &out)));
+
+      // Set the output value.
+      output_flat(i) = out;
+      return ::tsl::OkStatus();
+    };
+    OP_REQUIRES_OK(context,
+                   ParallelFor(context, N, kCostPerUnit, compute_element));
+  }
+
+ private:
+  DateTimestampPartCache part_cache_;
+};
+
+class TimestampTruncMicros : public OpKernel {
+ public:
+  explicit TimestampTruncMicros(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* context) override {
+    // Grab the timestamp tensor
+    const Tensor& timestamp_tensor = context->input(0);
+    auto timestamp = timestamp_tensor.flat<int64_t>();
+    // Grab the part tensor
+    const Tensor& part_tensor = context->input(1);
+    absl::string_view part = part_tensor.flat<tstring>()(0);
+    functions::DateTimestampPart part_enum;
+    static auto* supported_parts =
+        new absl::flat_hash_set<functions::DateTimestampPart>(
+            {functions::MICROSECOND, functions::MILLISECOND, functions::SECOND,
+             functions::MINUTE, functions::HOUR, functions::DAY,
+             functions::WEEK, functions::WEEK_MONDAY, functions::WEEK_TUESDAY,
+             functions::WEEK_WEDNESDAY, functions::WEEK_THURSDAY,
+             functions::WEEK_FRIDAY, functions::WEEK_SATURDAY,
+             functions::ISOWEEK, functions::MONTH, functions::QUARTER,
+             functions::YEAR, functions::ISOYEAR});
+    OP_REQUIRES_OK(context,
+                   ParseInputDateTimestampPart(part, name(), &part_cache_,
+                                               &part_enum, *supported_parts));
+    // Grab the time_zone tensor
+    const Tensor& time_zone_tensor = context->input(2);
+    absl::string_view time_zone = time_zone_tensor.flat<tstring>()(0);
+    absl::TimeZone tz;
+    OP_REQUIRES_OK(context, ParseInputTimeZone(time_zone, name(),
+                                               &time_zone_cache_, &tz));
+
+    // Create an output tensor with the shape of the timestamp tensor
+    Tensor* output_tensor = NULL;
+    OP_REQUIRES_OK(context, context->allocate_output(
+                                0, timestamp_tensor.shape(), &output_tensor));
+    auto output_flat = output_tensor->flat<int64_t>();
+
+    const int N = timestamp.size();
+    constexpr int64_t kCostPerUnit = kParseCost + kComputeCost;
+    auto compute_shard = [&](int64_t start, int64_t limit,
+                             ShardErrors* errors) {
+      // Validate the timestamps.
+      ::tsl::Status status;
+      const auto timestamp_in =
+          absl::MakeConstSpan(timestamp.data() + start, limit - start);
+      const int64_t num_valid =
+          ParseInputTimestampMicros(timestamp_in, name(), &status);
+      errors->Add(num_valid, status);
+
+      // Truncate the timestamps directly into the output tensor.
+      errors->AddBatchStatus(functions::TruncateTimestamps(
+          timestamp_in.first(num_valid), tz, part_enum,
+          absl::MakeSpan(output_flat.data() + start, num_valid), errors));
+    };
+    OP_REQUIRES_OK(context, ParallelForShards(context, name(), N, kCostPerUnit,
+                                              compute_shard));
+  }
+
+ private:
+  DateTimestampPartCache part_cache_;
+  TimeZoneCache time_zone_cache_;
 };
 
 // Register the kernels.
 REGISTER_KERNEL_BUILDER(Name("ExtractFromTimestamp").Device(DEVICE_CPU),
                         ExtractFromTimestamp);
+REGISTER_KERNEL_BUILDER(
+    Name("ExtractFromTimestampWithErrors").Device(DEVICE_CPU),
+    ExtractFromTimestamp);
+REGISTER_KERNEL_BUILDER(Name("ExtractPartsFromTimestamp").Device(DEVICE_CPU),
+                        ExtractPartsFromTimestamp);
 REGISTER_KERNEL_BUILDER(Name("StringFromTimestamp").Device(DEVICE_CPU),
                         StringFromTimestamp);
+REGISTER_KERNEL_BUILDER(
+    Name("StringFromTimestampWithErrors").Device(DEVICE_CPU),
+    StringFromTimestamp);
 REGISTER_KERNEL_BUILDER(Name("TimestampFromString").Device(DEVICE_CPU),
                         TimestampFromString);
+REGISTER_KERNEL_BUILDER(
+    Name("TimestampFromStringWithErrors").Device(DEVICE_CPU),
+    TimestampFromString);
+REGISTER_KERNEL_BUILDER(Name("CastToTimestampFromString").Device(DEVICE_CPU),
+                        CastToTimestampFromString);
+REGISTER_KERNEL_BUILDER(
+    Name("CastToTimestampFromStringWithErrors").Device(DEVICE_CPU),
+    CastToTimestampFromString);
+REGISTER_KERNEL_BUILDER(Name("CastToStringFromTimestamp").Device(DEVICE_CPU),
+                        CastToStringFromTimestamp);
+REGISTER_KERNEL_BUILDER(
+    Name("CastToStringFromTimestampWithErrors").Device(DEVICE_CPU),
+    CastToStringFromTimestamp);
 REGISTER_KERNEL_BUILDER(Name("TimestampFromDate").Device(DEVICE_CPU),
                         TimestampFromDate);
+REGISTER_KERNEL_BUILDER(Name("TimestampFromDateWithErrors").Device(DEVICE_CPU),
+                        TimestampFromDate);
 REGISTER_KERNEL_BUILDER(Name("TimestampFromDatetime").Device(DEVICE_CPU),
                         TimestampFromDatetime);
+REGISTER_KERNEL_BUILDER(
+    Name("TimestampFromDatetimeWithErrors").Device(DEVICE_CPU),
+    TimestampFromDatetime);
 REGISTER_KERNEL_BUILDER(Name("TimestampAdd").Device(DEVICE_CPU), TimestampAdd);
+REGISTER_KERNEL_BUILDER(Name("TimestampAddWithErrors").Device(DEVICE_CPU),
+                        TimestampAdd);
 REGISTER_KERNEL_BUILDER(Name("TimestampSub").Device(DEVICE_CPU), TimestampSub);
+REGISTER_KERNEL_BUILDER(Name("TimestampSubWithErrors").Device(DEVICE_CPU),
+                        TimestampSub);
 REGISTER_KERNEL_BUILDER(Name("TimestampDiff").Device(DEVICE_CPU),
                         TimestampDiff);
+REGISTER_KERNEL_BUILDER(Name("TimestampDiffWithErrors").Device(DEVICE_CPU),
+                        TimestampDiff);
 REGISTER_KERNEL_BUILDER(Name("TimestampTrunc").Device(DEVICE_CPU),
                         TimestampTrunc);
+REGISTER_KERNEL_BUILDER(Name("TimestampTruncWithErrors").Device(DEVICE_CPU),
+                        TimestampTrunc);
 REGISTER_KERNEL_BUILDER(Name("FormatTimestamp").Device(DEVICE_CPU),
                         FormatTimestamp);
+REGISTER_KERNEL_BUILDER(Name("FormatTimestampWithErrors").Device(DEVICE_CPU),
+                        FormatTimestamp);
 REGISTER_KERNEL_BUILDER(Name("ParseTimestamp").Device(DEVICE_CPU),
                         ParseTimestamp);
+REGISTER_KERNEL_BUILDER(Name("ParseTimestampWithErrors").Device(DEVICE_CPU),
+                        ParseTimestamp);
 REGISTER_KERNEL_BUILDER(Name("SafeParseTimestamp").Device(DEVICE_CPU),
                         SafeParseTimestamp);
+REGISTER_KERNEL_BUILDER(
+    Name("SafeParseTimestampWithValidity").Device(DEVICE_CPU),
+    SafeParseTimestamp);
 REGISTER_KERNEL_BUILDER(Name("TimestampMicros").Device(DEVICE_CPU),
                         TimestampMicros);
 REGISTER_KERNEL_BUILDER(Name("TimestampMillis").Device(DEVICE_CPU),
@@ -994,7 +1726,23 @@ REGISTER_KERNEL_BUILDER(Name("TimestampMillis").Device(DEVICE_CPU),
 REGISTER_KERNEL_BUILDER(Name("TimestampSeconds").Device(DEVICE_CPU),
                         TimestampSeconds);
 REGISTER_KERNEL_BUILDER(Name("UnixMicros").Device(DEVICE_CPU), UnixMicros);
+REGISTER_KERNEL_BUILDER(Name("UnixMicrosWithErrors").Device(DEVICE_CPU),
+                        UnixMicros);
 REGISTER_KERNEL_BUILDER(Name("UnixMillis").Device(DEVICE_CPU), UnixMillis);
+REGISTER_KERNEL_BUILDER(Name("UnixMillisWithErrors").Device(DEVICE_CPU),
+                        UnixMillis);
 REGISTER_KERNEL_BUILDER(Name("UnixSeconds").Device(DEVICE_CPU), UnixSeconds);
+REGISTER_KERNEL_BUILDER(Name("UnixSecondsWithErrors").Device(DEVICE_CPU),
+                        UnixSeconds);
+REGISTER_KERNEL_BUILDER(Name("ExtractFromTimestampMicros").Device(DEVICE_CPU),
+                        ExtractFromTimestampMicros);
+REGISTER_KERNEL_BUILDER(Name("TimestampAddMicros").Device(DEVICE_CPU),
+                        TimestampAddMicros);
+REGISTER_KERNEL_BUILDER(Name("TimestampSubMicros").Device(DEVICE_CPU),
+                        TimestampSubMicros);
+REGISTER_KERNEL_BUILDER(Name("TimestampDiffMicros").Device(DEVICE_CPU),
+                        TimestampDiffMicros);
+REGISTER_KERNEL_BUILDER(Name("TimestampTruncMicros").Device(DEVICE_CPU),
+                        TimestampTruncMicros);
 
 }  // namespace bigquery_ml_utils
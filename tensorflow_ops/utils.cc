@@ -16,28 +16,374 @@
 
 #include "tensorflow_ops/utils.h"
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
+#include "absl/time/civil_time.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "sql_utils/public/civil_time.h"
 #include "sql_utils/public/functions/date_time_util.h"
 #include "sql_utils/public/functions/parse_date_time.h"
 #include "sql_utils/public/interval_value.h"
+#include "sql_utils/public/types/timestamp_util.h"
 #include "tensorflow_ops/constants.h"
 #include "tensorflow/tsl/platform/errors.h"
 #include "tensorflow/tsl/platform/status.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/tstring.h"
+#include "tensorflow/core/util/work_sharder.h"
 
+using ::tsl::errors::Internal;
 using ::tsl::errors::InvalidArgument;
 
 namespace bigquery_ml_utils {
 
+namespace {
+
+// Fast paths for the fixed layouts of the input format strings in constants.h.
+// They only accept the canonical spelling of a valid value, e.g.
+// "2023-01-10 12:34:56.7 +1234" for kTimestampFormatString. Anything else,
+// such as extra whitespace, missing leading zeros, leap seconds or
+// out-of-range values, returns false and is left to the generic parser, so
+// results and error messages are unchanged.
+
+// Parse exactly n decimal digits starting at p.
+bool ParseFixedDigits(const char* p, int n, int* out) {
+  int value = 0;
+  for (int i = 0; i < n; i++) {
+    const unsigned digit = static_cast<unsigned char>(p[i]) - '0';
+    if (digit > 9) return false;
+    value = value * 10 + static_cast<int>(digit);
+  }
+  *out = value;
+  return true;
+}
+
+// "YYYY-MM-DD", the layout of kDateFormatString.
+constexpr int kCanonicalDateLength = 10;
+
+bool ParseCanonicalDate(absl::string_view str, absl::CivilDay* out) {
+  if (str.size() < kCanonicalDateLength || str[4] != '-' || str[7] != '-') {
+    return false;
+  }
+  int year, month, day;
+  if (!ParseFixedDigits(str.data(), 4, &year) ||
+      !ParseFixedDigits(str.data() + 5, 2, &month) ||
+      !ParseFixedDigits(str.data() + 8, 2, &day)) {
+    return false;
+  }
+  if (year < 1 || month < 1 || month > 12 || day < 1) return false;
+  // CivilDay normalizes out-of-range days, e.g. Feb 30 to Mar 2.
+  const absl::CivilDay civil_day(year, month, day);
+  if (civil_day.month() != month || civil_day.day() != day) return false;
+  *out = civil_day;
+  return true;
+}
+
+// "HH:MM:SS" followed by an optional '.' and 1 to max_fraction_digits digits,
+// the layout of "%H:%M:%E<max_fraction_digits>S". Consumes the time from the
+// front of str.
+bool ParseCanonicalTime(absl::string_view* str, int max_fraction_digits,
+                        int* hour, int* minute, int* second, int* micros) {
+  const absl::string_view s = *str;
+  if (s.size() < 8 || s[2] != ':' || s[5] != ':') return false;
+  if (!ParseFixedDigits(s.data(), 2, hour) ||
+      !ParseFixedDigits(s.data() + 3, 2, minute) ||
+      !ParseFixedDigits(s.data() + 6, 2, second)) {
+    return false;
+  }
+  if (*hour > 23 || *minute > 59 || *second > 59) return false;
+
+  size_t pos = 8;
+  *micros = 0;
+  if (pos < s.size() && s[pos] == '.') {
+    pos++;
+    int num_digits = 0;
+    while (pos < s.size() && num_digits < max_fraction_digits &&
+           absl::ascii_isdigit(s[pos])) {
+      *micros = *micros * 10 + (s[pos] - '0');
+      pos++;
+      num_digits++;
+    }
+    if (num_digits == 0) return false;
+    for (; num_digits < 6; num_digits++) *micros *= 10;
+  }
+  str->remove_prefix(pos);
+  return true;
+}
+
+bool ParseCanonicalDatetime(absl::string_view str, DatetimeValue* out) {
+  absl::CivilDay civil_day;
+  if (!ParseCanonicalDate(str, &civil_day) ||
+      str.size() <= kCanonicalDateLength || str[kCanonicalDateLength] != ' ') {
+    return false;
+  }
+  str.remove_prefix(kCanonicalDateLength + 1);
+  int hour, minute, second, micros;
+  if (!ParseCanonicalTime(&str, /*max_fraction_digits=*/6, &hour, &minute,
+                          &second, &micros) ||
+      !str.empty()) {
+    return false;
+  }
+  *out = DatetimeValue::FromYMDHMSAndMicros(
+      static_cast<int32_t>(civil_day.year()), civil_day.month(),
+      civil_day.day(), hour, minute, second, micros);
+  return true;
+}
+
+bool ParseCanonicalTimestamp(absl::string_view str, int64_t* out) {
+  absl::CivilDay civil_day;
+  if (!ParseCanonicalDate(str, &civil_day) ||
+      str.size() <= kCanonicalDateLength || str[kCanonicalDateLength] != ' ') {
+    return false;
+  }
+  str.remove_prefix(kCanonicalDateLength + 1);
+  int hour, minute, second, micros;
+  if (!ParseCanonicalTime(&str, /*max_fraction_digits=*/1, &hour, &minute,
+                          &second, &micros)) {
+    return false;
+  }
+
+  // " +HHMM"
+  int offset_hour, offset_minute;
+  if (str.size() != 6 || str[0] != ' ' || (str[1] != '+' && str[1] != '-') ||
+      !ParseFixedDigits(str.data() + 2, 2, &offset_hour) ||
+      !ParseFixedDigits(str.data() + 4, 2, &offset_minute) ||
+      offset_hour > 23 || offset_minute > 59) {
+    return false;
+  }
+  int offset_minutes = offset_hour * 60 + offset_minute;
+  if (str[1] == '-') offset_minutes = -offset_minutes;
+  if (!functions::IsValidTimeZone(offset_minutes)) return false;
+
+  const int64_t seconds = (civil_day - absl::CivilDay(1970)) * 86400 +
+                          hour * 3600 + minute * 60 + second -
+                          offset_minutes * 60;
+  const int64_t timestamp = seconds * 1000000 + micros;
+  if (!functions::IsValidTimestamp(timestamp, functions::kMicroseconds)) {
+    return false;
+  }
+  *out = timestamp;
+  return true;
+}
+
+// Writers for the output layouts of the FormatOutput* functions. They handle
+// every valid value, sizing the output once and writing the fields straight
+// into it. Invalid values are left to the generic formatters, which produce
+// the errors.
+
+// "00" through "99", for emitting two-digit fields.
+constexpr std::array<char, 200> MakeTwoDigitTable() {
+  std::array<char, 200> table = {};
+  for (int i = 0; i < 100; i++) {
+    table[2 * i] = static_cast<char>('0' + i / 10);
+    table[2 * i + 1] = static_cast<char>('0' + i % 10);
+  }
+  return table;
+}
+
+constexpr std::array<char, 200> kTwoDigits = MakeTwoDigitTable();
+
+char* WriteTwoDigits(int value, char* p) {
+  std::memcpy(p, &kTwoDigits[2 * value], 2);
+  return p + 2;
+}
+
+// Number of digits of a year in [1, 9999] when printed without padding, as
+// "%Y" does.
+int YearWidth(int64_t year) {
+  return year >= 1000 ? 4 : year >= 100 ? 3 : year >= 10 ? 2 : 1;
+}
+
+char* WriteYear(int64_t year, int width, char* p) {
+  for (int i = width - 1; i >= 0; i--) {
+    p[i] = static_cast<char>('0' + year % 10);
+    year /= 10;
+  }
+  return p + width;
+}
+
+// "Y-MM-DD", with the year taking year_width digits.
+char* WriteDate(const absl::CivilDay& day, int year_width, char* p) {
+  p = WriteYear(day.year(), year_width, p);
+  *p++ = '-';
+  p = WriteTwoDigits(day.month(), p);
+  *p++ = '-';
+  return WriteTwoDigits(day.day(), p);
+}
+
+// "HH:MM:SS"
+char* WriteTime(int hour, int minute, int second, char* p) {
+  p = WriteTwoDigits(hour, p);
+  *p++ = ':';
+  p = WriteTwoDigits(minute, p);
+  *p++ = ':';
+  return WriteTwoDigits(second, p);
+}
+
+// Length of the fraction of a DATETIME or TIME cast to string, which drops a
+// zero fraction and otherwise uses 3 or 6 digits, whichever is exact.
+int FractionWidth(int micros) {
+  return micros == 0 ? 0 : micros % 1000 == 0 ? 4 : 7;
+}
+
+char* WriteFraction(int micros, int width, char* p) {
+  if (width == 0) return p;
+  *p++ = '.';
+  if (width == 4) {
+    const int millis = micros / 1000;
+    *p++ = static_cast<char>('0' + millis / 100);
+    return WriteTwoDigits(millis % 100, p);
+  }
+  p = WriteTwoDigits(micros / 10000, p);
+  p = WriteTwoDigits(micros / 100 % 100, p);
+  return WriteTwoDigits(micros % 100, p);
+}
+
+char* ResizeOutput(std::string* out, size_t size) {
+  out->resize(size);
+  return &(*out)[0];
+}
+
+char* ResizeOutput(::tensorflow::tstring* out, size_t size) {
+  out->resize_uninitialized(size);
+  return out->mdata();
+}
+
+template <typename String>
+::tsl::Status FormatOutputDatetimeImpl(const DatetimeValue& dt,
+                                       absl::string_view function_name,
+                                       String* out) {
+  if (!dt.IsValid()) {
+    // Output 3 formats dynamically to align with CAST AS STRING in BQML.
+    std::string generic;
+    TF_RETURN_IF_ERROR(ToTslStatus(
+        function_name, functions::ConvertDatetimeToString(
+                           dt, functions::kMicroseconds, &generic)));
+    *out = std::move(generic);
+    return ::tsl::OkStatus();
+  }
+  const int fraction_width = FractionWidth(dt.Microseconds());
+  // "YYYY-MM-DD HH:MM:SS[.fff[fff]]"
+  char* p = ResizeOutput(out, 19 + fraction_width);
+  p = WriteDate(absl::CivilDay(dt.Year(), dt.Month(), dt.Day()), 4, p);
+  *p++ = ' ';
+  p = WriteTime(dt.Hour(), dt.Minute(), dt.Second(), p);
+  WriteFraction(dt.Microseconds(), fraction_width, p);
+  return ::tsl::OkStatus();
+}
+
+template <typename String>
+::tsl::Status FormatOutputDateImpl(int32_t d, absl::string_view function_name,
+                                   String* out) {
+  if (d < types::kDateMin || d > types::kDateMax) {
+    std::string generic;
+    TF_RETURN_IF_ERROR(ToTslStatus(
+        function_name,
+        functions::FormatDateToString(kDateFormatString, d, &generic)));
+    *out = std::move(generic);
+    return ::tsl::OkStatus();
+  }
+  const absl::CivilDay day = absl::CivilDay(1970) + d;
+  const int year_width = YearWidth(day.year());
+  // "Y-MM-DD"
+  WriteDate(day, year_width, ResizeOutput(out, year_width + 6));
+  return ::tsl::OkStatus();
+}
+
+template <typename String>
+::tsl::Status FormatOutputTimeImpl(const TimeValue& time,
+                                   absl::string_view function_name,
+                                   String* out) {
+  if (!time.IsValid()) {
+    // Output 3 formats dynamically to align with CAST AS STRING in BQML.
+    std::string generic;
+    TF_RETURN_IF_ERROR(ToTslStatus(
+        function_name, functions::ConvertTimeToString(
+                           time, functions::kMicroseconds, &generic)));
+    *out = std::move(generic);
+    return ::tsl::OkStatus();
+  }
+  const int fraction_width = FractionWidth(time.Microseconds());
+  // "HH:MM:SS[.fff[fff]]"
+  char* p = ResizeOutput(out, 8 + fraction_width);
+  p = WriteTime(time.Hour(), time.Minute(), time.Second(), p);
+  WriteFraction(time.Microseconds(), fraction_width, p);
+  return ::tsl::OkStatus();
+}
+
+template <typename String>
+::tsl::Status FormatOutputTimestampImpl(int64_t ts,
+                                        absl::string_view function_name,
+                                        String* out) {
+  if (!functions::IsValidTimestamp(ts, functions::kMicroseconds)) {
+    functions::FormatDateTimestampOptions format_options = {
+        .expand_Q = true,
+        .expand_J = true,
+    };
+    // Output at the UTC time zone.
+    std::string generic;
+    TF_RETURN_IF_ERROR(ToTslStatus(
+        function_name, functions::FormatTimestampToString(
+                           kTimestampFormatString, ts, absl::UTCTimeZone(),
+                           format_options, &generic)));
+    *out = std::move(generic);
+    return ::tsl::OkStatus();
+  }
+  // Split into UTC civil fields, rounding towards negative infinity.
+  int64_t seconds = ts / 1000000;
+  int64_t micros = ts % 1000000;
+  if (micros < 0) {
+    seconds--;
+    micros += 1000000;
+  }
+  int64_t days = seconds / 86400;
+  int64_t second_of_day = seconds % 86400;
+  if (second_of_day < 0) {
+    days--;
+    second_of_day += 86400;
+  }
+  const absl::CivilDay day = absl::CivilDay(1970) + days;
+  const int year_width = YearWidth(day.year());
+  // "Y-MM-DD HH:MM:SS.f +0000", "%E1S" truncating to tenths of a second.
+  char* p = ResizeOutput(out, year_width + 23);
+  p = WriteDate(day, year_width, p);
+  *p++ = ' ';
+  p = WriteTime(static_cast<int>(second_of_day / 3600),
+                static_cast<int>(second_of_day / 60 % 60),
+                static_cast<int>(second_of_day % 60), p);
+  *p++ = '.';
+  *p++ = static_cast<char>('0' + micros / 100000);
+  std::memcpy(p, " +0000", 6);
+  return ::tsl::OkStatus();
+}
+
+}  // namespace
+
 ::tsl::Status ParseInputDateTimestampPart(
     absl::string_view part, absl::string_view function_name,
     functions::DateTimestampPart* out,
@@ -56,16 +402,246 @@ namespace bigquery_ml_utils {
   return ::tsl::OkStatus();
 }
 
+::tsl::Status ParseInputDateTimestampParts(
+    absl::Span<const std::string> parts, absl::string_view function_name,
+    std::vector<functions::DateTimestampPart>* out,
+    const absl::flat_hash_set<functions::DateTimestampPart>& supported_parts) {
+  out->resize(parts.size());
+  for (size_t i = 0; i < parts.size(); ++i) {
+    TF_RETURN_IF_ERROR(ParseInputDateTimestampPart(
+        absl::AsciiStrToLower(parts[i]), function_name, &(*out)[i],
+        supported_parts));
+  }
+  return ::tsl::OkStatus();
+}
+
+::tsl::Status ParseInputDateTimestampPart(
+    absl::string_view part, absl::string_view function_name,
+    DateTimestampPartCache* cache, functions::DateTimestampPart* out,
+    const absl::flat_hash_set<functions::DateTimestampPart>& supported_parts) {
+  return cache->Lookup(
+      part,
+      [&](functions::DateTimestampPart* part_enum) {
+        return ParseInputDateTimestampPart(part, function_name, part_enum,
+                                           supported_parts);
+      },
+      out);
+}
+
+::tsl::Status ParseInputTimeZone(absl::string_view time_zone,
+                                 absl::string_view function_name,
+                                 TimeZoneCache* cache, absl::TimeZone* out) {
+  return cache->Lookup(
+      time_zone,
+      [&](absl::TimeZone* tz) {
+        return ToTslStatus(function_name,
+                           functions::MakeTimeZone(time_zone, tz));
+      },
+      out);
+}
+
+::tsl::Status InternBroadcastInput(const ::tensorflow::Tensor& tensor,
+                                   const ::tensorflow::TensorShape& shape,
+                                   absl::string_view input_name,
+                                   absl::string_view function_name,
+                                   std::vector<absl::string_view>* keys,
+                                   std::vector<int32_t>* index) {
+  auto strings = tensor.flat<::tensorflow::tstring>();
+  keys->clear();
+  index->clear();
+  if (strings.size() == 1) {
+    keys->push_back(strings(0));
+    return ::tsl::OkStatus();
+  }
+  if (tensor.shape() != shape) {
+    return InvalidArgument(absl::Substitute("Invalid $0 shape in $1: $2",
+                                            input_name, function_name,
+                                            tensor.shape().DebugString()));
+  }
+
+  absl::flat_hash_map<absl::string_view, int32_t> positions;
+  index->resize(strings.size());
+  for (int64_t i = 0; i < strings.size(); ++i) {
+    auto [it, inserted] = positions.try_emplace(
+        absl::string_view(strings(i)), static_cast<int32_t>(keys->size()));
+    if (inserted) keys->push_back(it->first);
+    (*index)[i] = it->second;
+  }
+  if (keys->size() == 1) index->clear();
+  return ::tsl::OkStatus();
+}
+
+namespace {
+
+// The kernels expand %J so that it is reported as unsupported.
+constexpr functions::FormatDateTimestampOptions kFormatOptions = {
+    .expand_Q = true,
+    .expand_J = true,
+};
+
+template <typename Formatter, typename CreateFn>
+::tsl::Status ParseInputFormatImpl(
+    absl::string_view format, absl::string_view function_name,
+    ScalarInputCache<std::shared_ptr<const Formatter>>* cache,
+    CreateFn create, std::shared_ptr<const Formatter>* out) {
+  return cache->Lookup(
+      format,
+      [&](std::shared_ptr<const Formatter>* formatter) {
+        absl::StatusOr<Formatter> compiled = create(format);
+        if (!compiled.ok()) {
+          return ToTslStatus(function_name, compiled.status());
+        }
+        *formatter = std::make_shared<const Formatter>(*std::move(compiled));
+        return ::tsl::OkStatus();
+      },
+      out);
+}
+
+}  // namespace
+
+::tsl::Status ParseInputFormat(
+    absl::string_view format, absl::string_view function_name,
+    DateFormatterCache* cache,
+    std::shared_ptr<const functions::DateFormatter>* out) {
+  return ParseInputFormatImpl(
+      format, function_name, cache,
+      [](absl::string_view format) {
+        return functions::DateFormatter::Create(format, kFormatOptions);
+      },
+      out);
+}
+
+::tsl::Status ParseInputFormat(
+    absl::string_view format, absl::string_view function_name,
+    DatetimeFormatterCache* cache,
+    std::shared_ptr<const functions::DatetimeFormatter>* out) {
+  return ParseInputFormatImpl(
+      format, function_name, cache,
+      [](absl::string_view format) {
+        return functions::DatetimeFormatter::Create(format, kFormatOptions);
+      },
+      out);
+}
+
+::tsl::Status ParseInputFormat(
+    absl::string_view format, absl::string_view function_name,
+    TimeFormatterCache* cache,
+    std::shared_ptr<const functions::TimeFormatter>* out) {
+  return ParseInputFormatImpl(format, function_name, cache,
+                              &functions::TimeFormatter::Create, out);
+}
+
+::tsl::Status ParseInputFormat(
+    absl::string_view format, absl::string_view function_name,
+    TimestampFormatterCache* cache,
+    std::shared_ptr<const functions::TimestampFormatter>* out) {
+  return ParseInputFormatImpl(
+      format, function_name, cache,
+      [](absl::string_view format) {
+        return functions::TimestampFormatter::Create(format, kFormatOptions);
+      },
+      out);
+}
+
 ::tsl::Status ParseInputDate(absl::string_view date,
                              absl::string_view function_name, int32_t* out) {
+  absl::CivilDay civil_day;
+  if (date.size() == kCanonicalDateLength &&
+      ParseCanonicalDate(date, &civil_day)) {
+    *out = static_cast<int32_t>(civil_day - absl::CivilDay(1970));
+    return ::tsl::OkStatus();
+  }
   return ToTslStatus(function_name, functions::ParseStringToDate(
                                         kDateFormatString, date,
                                         /*parse_version2=*/true, out));
 }
 
+::tsl::Status ParseInputTimestampMicros(int64_t timestamp,
+                                        absl::string_view function_name,
+                                        int64_t* out) {
+  if (!functions::IsValidTimestamp(timestamp, functions::kMicroseconds)) {
+    return InvalidArgument(absl::Substitute(
+        "Invalid timestamp micros in $0: $1", function_name, timestamp));
+  }
+  *out = timestamp;
+  return ::tsl::OkStatus();
+}
+
+int64_t ParseInputTimestampMicros(absl::Span<const int64_t> timestamps,
+                                  absl::string_view function_name,
+                                  ::tsl::Status* status) {
+  for (int64_t i = 0; i < static_cast<int64_t>(timestamps.size()); i++) {
+    int64_t timestamp;
+    *status =
+        ParseInputTimestampMicros(timestamps[i], function_name, &timestamp);
+    if (!status->ok()) return i;
+  }
+  return timestamps.size();
+}
+
+::tsl::Status ParseInputDateDays(int64_t date, absl::string_view function_name,
+                                 int32_t* out) {
+  if (date > types::kDateMax || date < types::kDateMin) {
+    return InvalidArgument(
+        absl::Substitute("Invalid date days in $0: $1", function_name, date));
+  }
+  *out = static_cast<int32_t>(date);
+  return ::tsl::OkStatus();
+}
+
+int64_t ParseInputDateDays(absl::Span<const int64_t> dates,
+                           absl::string_view function_name,
+                           std::vector<int32_t>* out, ::tsl::Status* status) {
+  out->reserve(out->size() + dates.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(dates.size()); i++) {
+    int32_t date;
+    *status = ParseInputDateDays(dates[i], function_name, &date);
+    if (!status->ok()) return i;
+    out->push_back(date);
+  }
+  return dates.size();
+}
+
+::tsl::Status ParseInputPackedDatetime(int64_t datetime,
+                                       absl::string_view function_name,
+                                       DatetimeValue* out) {
+  *out = DatetimeValue::FromPacked64Micros(datetime);
+  if (!out->IsValid()) {
+    return InvalidArgument(absl::Substitute(
+        "Invalid packed datetime in $0: $1", function_name, datetime));
+  }
+  return ::tsl::OkStatus();
+}
+
+int64_t ParseInputPackedDatetime(absl::Span<const int64_t> datetimes,
+                                 absl::string_view function_name,
+                                 std::vector<DatetimeValue>* out,
+                                 ::tsl::Status* status) {
+  out->reserve(out->size() + datetimes.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(datetimes.size()); i++) {
+    DatetimeValue datetime;
+    *status = ParseInputPackedDatetime(datetimes[i], function_name, &datetime);
+    if (!status->ok()) return i;
+    out->push_back(datetime);
+  }
+  return datetimes.size();
+}
+
+::tsl::Status ParseInputPackedTime(int64_t time,
+                                   absl::string_view function_name,
+                                   TimeValue* out) {
+  *out = TimeValue::FromPacked64Micros(time);
+  if (!out->IsValid()) {
+    return InvalidArgument(absl::Substitute("Invalid packed time in $0: $1",
+                                            function_name, time));
+  }
+  return ::tsl::OkStatus();
+}
+
 ::tsl::Status ParseInputDatetime(absl::string_view datetime,
                                  absl::string_view function_name,
                                  DatetimeValue* out) {
+  if (ParseCanonicalDatetime(datetime, out)) return ::tsl::OkStatus();
   return ToTslStatus(function_name, functions::ParseStringToDatetime(
                                         kDatetimeFormatString, datetime,
                                         functions::kMicroseconds,
@@ -74,6 +650,14 @@ namespace bigquery_ml_utils {
 
 ::tsl::Status ParseInputTime(absl::string_view time,
                              absl::string_view function_name, TimeValue* out) {
+  absl::string_view rest = time;
+  int hour, minute, second, micros;
+  if (ParseCanonicalTime(&rest, /*max_fraction_digits=*/6, &hour, &minute,
+                         &second, &micros) &&
+      rest.empty()) {
+    *out = TimeValue::FromHMSAndMicros(hour, minute, second, micros);
+    return ::tsl::OkStatus();
+  }
   return ToTslStatus(function_name, functions::ParseStringToTime(
                                         kTimeFormatString, time,
                                         functions::kMicroseconds, out));
@@ -83,6 +667,7 @@ namespace bigquery_ml_utils {
                                   const absl::TimeZone& time_zone,
                                   absl::string_view function_name,
                                   int64_t* out) {
+  if (ParseCanonicalTimestamp(timestamp, out)) return ::tsl::OkStatus();
   return ToTslStatus(function_name,
                      functions::ParseStringToTimestamp(
                          kTimestampFormatString, timestamp, time_zone,
@@ -92,36 +677,56 @@ namespace bigquery_ml_utils {
 ::tsl::Status FormatOutputDatetime(const DatetimeValue& dt,
                                    absl::string_view function_name,
                                    std::string* out) {
-  // Output 3 formats dynamically to align with CAST AS STRING in BQML.
-  return ToTslStatus(function_name, functions::ConvertDatetimeToString(
-                                        dt, functions::kMicroseconds, out));
+  return FormatOutputDatetimeImpl(dt, function_name, out);
+}
+
+::tsl::Status FormatOutputDatetime(const DatetimeValue& dt,
+                                   absl::string_view function_name,
+                                   ::tensorflow::tstring* out) {
+  return FormatOutputDatetimeImpl(dt, function_name, out);
 }
 
 ::tsl::Status FormatOutputDate(int32_t d, absl::string_view function_name,
                                std::string* out) {
-  return ToTslStatus(function_name,
-                     functions::FormatDateToString(kDateFormatString, d, out));
+  return FormatOutputDateImpl(d, function_name, out);
+}
+
+::tsl::Status FormatOutputDate(int32_t d, absl::string_view function_name,
+                               ::tensorflow::tstring* out) {
+  return FormatOutputDateImpl(d, function_name, out);
 }
 
 ::tsl::Status FormatOutputTime(const TimeValue& time,
                                absl::string_view function_name,
                                std::string* out) {
-  // Output 3 formats dynamically to align with CAST AS STRING in BQML.
-  return ToTslStatus(function_name, functions::ConvertTimeToString(
-                                        time, functions::kMicroseconds, out));
+  return FormatOutputTimeImpl(time, function_name, out);
+}
+
+::tsl::Status FormatOutputTime(const TimeValue& time,
+                               absl::string_view function_name,
+                               ::tensorflow::tstring* out) {
+  return FormatOutputTimeImpl(time, function_name, out);
 }
 
 ::tsl::Status FormatOutputTimestamp(int64_t ts, absl::string_view function_name,
                                     std::string* out) {
-  functions::FormatDateTimestampOptions format_options = {
-      .expand_Q = true,
-      .expand_J = true,
-  };
-  // Output at the UTC time zone.
-  return ToTslStatus(function_name,
-                     functions::FormatTimestampToString(kTimestampFormatString,
-                                                        ts, absl::UTCTimeZone(),
-                                                        format_options, out));
+  return FormatOutputTimestampImpl(ts, function_name, out);
+}
+
+::tsl::Status FormatOutputTimestamp(int64_t ts, absl::string_view function_name,
+                                    ::tensorflow::tstring* out) {
+  return FormatOutputTimestampImpl(ts, function_name, out);
+}
+
+std::string& ThreadLocalOutputBuffer() {
+  thread_local std::string buffer;
+  return buffer;
+}
+
+absl::Span<std::string> ThreadLocalOutputBuffers(int64_t size) {
+  thread_local std::vector<std::string> buffers;
+  if (static_cast<int64_t>(buffers.size()) < size) buffers.resize(size);
+  return absl::MakeSpan(buffers.data(), size);
 }
 
 ::tsl::Status ToTslStatus(absl::string_view function_name,
@@ -135,6 +740,304 @@ namespace bigquery_ml_utils {
                                         function_name, status.ToString()));
 }
 
+::tsl::Status RowErrors::Create(::tensorflow::OpKernelContext* context,
+                                int64_t total,
+                                std::unique_ptr<RowErrors>* out) {
+  out->reset();
+  int codes_index, codes_stop;
+  if (!context->op_kernel()
+           .OutputRange("error_codes", &codes_index, &codes_stop)
+           .ok()) {
+    return ::tsl::OkStatus();
+  }
+  const ::tensorflow::Tensor* output = context->mutable_output(0);
+  if (output == nullptr || output->NumElements() != total) {
+    return Internal(absl::Substitute(
+        "The regular outputs of $0 must be allocated before its rows are "
+        "computed",
+        context->op_kernel().name()));
+  }
+  int64_t max_messages;
+  TF_RETURN_IF_ERROR(::tensorflow::GetNodeAttr(
+      context->op_kernel().def(), "max_error_messages", &max_messages));
+
+  ::tensorflow::Tensor* codes_tensor = nullptr;
+  TF_RETURN_IF_ERROR(
+      context->allocate_output(codes_index, output->shape(), &codes_tensor));
+  int32_t* codes = codes_tensor->flat<int32_t>().data();
+  std::fill(codes, codes + total, 0);
+  out->reset(new RowErrors(codes, total, max_messages));
+  return ::tsl::OkStatus();
+}
+
+void RowErrors::Record(int64_t row, const ::tsl::Status& error) {
+  codes_[row] = static_cast<int32_t>(error.code());
+  ::tensorflow::mutex_lock lock(mu_);
+  AddMessage(row, std::string(error.message()));
+}
+
+void RowErrors::RecordCopy(int64_t row, int64_t from) {
+  codes_[row] = codes_[from];
+  ::tensorflow::mutex_lock lock(mu_);
+  auto it = messages_.find(from);
+  if (it != messages_.end()) AddMessage(row, it->second);
+}
+
+void RowErrors::AddMessage(int64_t row, std::string message) {
+  if (static_cast<int64_t>(messages_.size()) >= max_messages_) {
+    if (max_messages_ == 0 || row > messages_.rbegin()->first) return;
+    messages_.erase(std::prev(messages_.end()));
+  }
+  messages_.emplace(row, std::move(message));
+}
+
+::tsl::Status RowErrors::Finish(::tensorflow::OpKernelContext* context) {
+  int codes_index, codes_stop, messages_index, messages_stop;
+  TF_RETURN_IF_ERROR(context->op_kernel().OutputRange(
+      "error_codes", &codes_index, &codes_stop));
+  TF_RETURN_IF_ERROR(context->op_kernel().OutputRange(
+      "error_messages", &messages_index, &messages_stop));
+
+  // Reset the regular outputs of the failing rows, whose values may be
+  // partially written.
+  for (int i = 0; i < context->num_outputs(); i++) {
+    if (i == codes_index || i == messages_index) continue;
+    ::tensorflow::Tensor* output = context->mutable_output(i);
+    if (output == nullptr || output->NumElements() != total_) continue;
+    for (int64_t row = 0; row < total_; row++) {
+      if (!Failed(row)) continue;
+      switch (output->dtype()) {
+        case ::tensorflow::DT_STRING:
+          output->flat<::tensorflow::tstring>()(row).clear();
+          break;
+        case ::tensorflow::DT_INT64:
+          output->flat<int64_t>()(row) = 0;
+          break;
+        case ::tensorflow::DT_INT32:
+          output->flat<int32_t>()(row) = 0;
+          break;
+        case ::tensorflow::DT_BOOL:
+          output->flat<bool>()(row) = false;
+          break;
+        default:
+          return Internal(absl::Substitute(
+              "Unsupported output type in $0: $1", context->op_kernel().name(),
+              ::tensorflow::DataTypeString(output->dtype())));
+      }
+    }
+  }
+
+  ::tensorflow::mutex_lock lock(mu_);
+  ::tensorflow::Tensor* messages_tensor = nullptr;
+  TF_RETURN_IF_ERROR(context->allocate_output(
+      messages_index,
+      ::tensorflow::TensorShape({static_cast<int64_t>(messages_.size())}),
+      &messages_tensor));
+  auto messages = messages_tensor->flat<::tensorflow::tstring>();
+  int64_t i = 0;
+  for (const auto& [row, message] : messages_) messages(i++) = message;
+  return ::tsl::OkStatus();
+}
+
+namespace {
+
+::tsl::Status ParallelForFirstError(
+    ::tensorflow::OpKernelContext* context, int64_t total,
+    int64_t cost_per_unit, const std::function<::tsl::Status(int64_t)>& fn) {
+  // Index of the first failing element seen so far. Shards skip elements past
+  // it since their errors could never be the one reported.
+  std::atomic<int64_t> first_error_index(std::numeric_limits<int64_t>::max());
+  ::tensorflow::mutex mu;
+  ::tsl::Status first_error;
+
+  auto work = [&](int64_t start, int64_t limit) {
+    for (int64_t i = start; i < limit; i++) {
+      if (i > first_error_index.load(std::memory_order_relaxed)) return;
+      ::tsl::Status status = fn(i);
+      if (!status.ok()) {
+        ::tensorflow::mutex_lock lock(mu);
+        if (i < first_error_index.load(std::memory_order_relaxed)) {
+          first_error_index.store(i, std::memory_order_relaxed);
+          first_error = std::move(status);
+        }
+        return;
+      }
+    }
+  };
+
+  auto worker_threads = *context->device()->tensorflow_cpu_worker_threads();
+  ::tensorflow::Shard(worker_threads.num_threads, worker_threads.workers,
+                      total, cost_per_unit, work);
+  return first_error;
+}
+
+}  // namespace
+
+::tsl::Status ParallelFor(::tensorflow::OpKernelContext* context,
+                          int64_t total, int64_t cost_per_unit,
+                          const std::function<::tsl::Status(int64_t)>& fn) {
+  std::unique_ptr<RowErrors> row_errors;
+  TF_RETURN_IF_ERROR(RowErrors::Create(context, total, &row_errors));
+  if (row_errors == nullptr) {
+    return ParallelForFirstError(context, total, cost_per_unit, fn);
+  }
+  TF_RETURN_IF_ERROR(ParallelForFirstError(
+      context, total, cost_per_unit, [&](int64_t i) -> ::tsl::Status {
+        ::tsl::Status status = fn(i);
+        if (!status.ok()) row_errors->Record(i, status);
+        return ::tsl::OkStatus();
+      }));
+  return row_errors->Finish(context);
+}
+
+namespace {
+
+// Batches smaller than this are computed element by element, as the
+// deduplication would not pay for itself.
+constexpr int64_t kMinDistinctBatchSize = 256;
+// Number of elements, evenly spaced in the batch, sampled to estimate its
+// ratio of distinct values.
+constexpr int64_t kDistinctSampleSize = 64;
+// Deduplicate the batch when at most this many of the sampled elements are
+// distinct.
+constexpr int64_t kMaxDistinctSampled = kDistinctSampleSize / 4;
+// Rough cost, in CPU cycles, of hashing an element or copying a result.
+constexpr int64_t kCopyCost = 100;
+
+absl::string_view ToStringView(const ::tensorflow::tstring& value) {
+  return absl::string_view(value.data(), value.size());
+}
+
+// Whether a sample of <input> has few enough distinct values to deduplicate.
+bool HasFewDistinctValues(
+    ::tensorflow::TTypes<::tensorflow::tstring>::ConstFlat input) {
+  const int64_t total = input.size();
+  if (total < kMinDistinctBatchSize) return false;
+  absl::flat_hash_set<absl::string_view> sampled;
+  for (int64_t s = 0; s < kDistinctSampleSize; s++) {
+    sampled.insert(ToStringView(input(s * total / kDistinctSampleSize)));
+    if (sampled.size() > kMaxDistinctSampled) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+::tsl::Status ParallelForDistinct(
+    ::tensorflow::OpKernelContext* context,
+    ::tensorflow::TTypes<::tensorflow::tstring>::ConstFlat input,
+    int64_t cost_per_unit, const std::function<::tsl::Status(int64_t)>& fn,
+    const std::function<void(int64_t, int64_t)>& copy) {
+  const int64_t total = input.size();
+  if (!HasFewDistinctValues(input)) {
+    return ParallelFor(context, total, cost_per_unit, fn);
+  }
+
+  // Index of the first occurrence of the value of each element, and the
+  // first occurrences in increasing order.
+  std::vector<int64_t> first_index(total);
+  std::vector<int64_t> distinct;
+  absl::flat_hash_map<absl::string_view, int64_t> first_index_of_value;
+  for (int64_t i = 0; i < total; i++) {
+    auto [it, inserted] =
+        first_index_of_value.try_emplace(ToStringView(input(i)), i);
+    if (inserted) distinct.push_back(i);
+    first_index[i] = it->second;
+  }
+
+  std::unique_ptr<RowErrors> row_errors;
+  TF_RETURN_IF_ERROR(RowErrors::Create(context, total, &row_errors));
+  if (row_errors == nullptr) {
+    // The lowest failing first occurrence is also the lowest failing element.
+    TF_RETURN_IF_ERROR(ParallelForFirstError(
+        context, distinct.size(), cost_per_unit,
+        [&](int64_t d) -> ::tsl::Status { return fn(distinct[d]); }));
+    return ParallelForFirstError(context, total, kCopyCost,
+                                 [&](int64_t i) -> ::tsl::Status {
+                                   if (first_index[i] != i) {
+                                     copy(first_index[i], i);
+                                   }
+                                   return ::tsl::OkStatus();
+                                 });
+  }
+
+  // Repeated values fail like their first occurrence.
+  TF_RETURN_IF_ERROR(ParallelForFirstError(
+      context, distinct.size(), cost_per_unit,
+      [&](int64_t d) -> ::tsl::Status {
+        ::tsl::Status status = fn(distinct[d]);
+        if (!status.ok()) row_errors->Record(distinct[d], status);
+        return ::tsl::OkStatus();
+      }));
+  TF_RETURN_IF_ERROR(ParallelForFirstError(
+      context, total, kCopyCost, [&](int64_t i) -> ::tsl::Status {
+        if (first_index[i] == i) return ::tsl::OkStatus();
+        if (row_errors->Failed(first_index[i])) {
+          row_errors->RecordCopy(i, first_index[i]);
+        } else {
+          copy(first_index[i], i);
+        }
+        return ::tsl::OkStatus();
+      }));
+  return row_errors->Finish(context);
+}
+
+::tsl::Status ParallelForShards(
+    ::tensorflow::OpKernelContext* context, absl::string_view function_name,
+    int64_t total, int64_t cost_per_unit,
+    const std::function<void(int64_t, int64_t, ShardErrors*)>& fn) {
+  std::unique_ptr<RowErrors> row_errors;
+  TF_RETURN_IF_ERROR(RowErrors::Create(context, total, &row_errors));
+  if (row_errors != nullptr) {
+    auto work = [&](int64_t start, int64_t limit) {
+      ShardErrors errors(function_name, /*keep_all=*/true);
+      fn(start, limit, &errors);
+      for (const auto& [row, error] : errors.all_errors()) {
+        row_errors->Record(start + row, error);
+      }
+    };
+    auto worker_threads = *context->device()->tensorflow_cpu_worker_threads();
+    ::tensorflow::Shard(worker_threads.num_threads, worker_threads.workers,
+                        total, cost_per_unit, work);
+    return row_errors->Finish(context);
+  }
+
+  // Index of the first failing element seen so far, as in ParallelFor. Shards
+  // starting past it are skipped.
+  std::atomic<int64_t> first_error_index(std::numeric_limits<int64_t>::max());
+  ::tensorflow::mutex mu;
+  ::tsl::Status first_error;
+
+  auto work = [&](int64_t start, int64_t limit) {
+    if (start > first_error_index.load(std::memory_order_relaxed)) return;
+    ShardErrors errors(function_name);
+    fn(start, limit, &errors);
+    if (errors.first_error().ok()) return;
+    const int64_t i = start + errors.first_error_row();
+    ::tensorflow::mutex_lock lock(mu);
+    if (i < first_error_index.load(std::memory_order_relaxed)) {
+      first_error_index.store(i, std::memory_order_relaxed);
+      first_error = std::move(errors.first_error());
+    }
+  };
+
+  auto worker_threads = *context->device()->tensorflow_cpu_worker_threads();
+  ::tensorflow::Shard(worker_threads.num_threads, worker_threads.workers,
+                      total, cost_per_unit, work);
+  return first_error;
+}
+
+std::vector<absl::string_view> ShardStrings(
+    ::tensorflow::TTypes<::tensorflow::tstring>::ConstFlat input,
+    int64_t start, int64_t limit) {
+  std::vector<absl::string_view> strings;
+  strings.reserve(limit - start);
+  for (int64_t i = start; i < limit; ++i) {
+    strings.emplace_back(input(i).data(), input(i).size());
+  }
+  return strings;
+}
+
 absl::StatusOr<IntervalValue> GetIntervalValue(
     int64_t diff, functions::DateTimestampPart part_enum) {
   switch (part_enum) {
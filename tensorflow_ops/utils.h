@@ -18,17 +18,31 @@
 #define THIRD_PARTY_PY_BIGQUERY_ML_UTILS_TENSORFLOW_OPS_UTILS_H_
 
 #include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "sql_utils/public/civil_time.h"
+#include "sql_utils/public/functions/date_time_util.h"
 #include "sql_utils/public/functions/datetime.pb.h"
 #include "sql_utils/public/interval_value.h"
 #include "tensorflow/tsl/platform/status.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/tstring.h"
 
 namespace bigquery_ml_utils {
 
@@ -38,6 +52,14 @@ namespace bigquery_ml_utils {
     const absl::flat_hash_set<functions::DateTimestampPart>& supported_parts =
         {});
 
+// Same as ParseInputDateTimestampPart for each of the case insensitive parts,
+// like the list attr of the ExtractPartsFrom* ops.
+::tsl::Status ParseInputDateTimestampParts(
+    absl::Span<const std::string> parts, absl::string_view function_name,
+    std::vector<functions::DateTimestampPart>* out,
+    const absl::flat_hash_set<functions::DateTimestampPart>& supported_parts =
+        {});
+
 ::tsl::Status ParseInputDate(absl::string_view date,
                              absl::string_view function_name, int32_t* out);
 
@@ -53,23 +75,410 @@ namespace bigquery_ml_utils {
                                   absl::string_view function_name,
                                   int64_t* out);
 
+// Validate native (non-string) representations of the date/time types:
+// TIMESTAMP as int64 micros since the Unix epoch, DATE as days since the Unix
+// epoch, and DATETIME/TIME as the bit-packed Packed64DatetimeMicros and
+// Packed64TimeMicros encodings from civil_time.h.
+::tsl::Status ParseInputTimestampMicros(int64_t timestamp,
+                                        absl::string_view function_name,
+                                        int64_t* out);
+
+// Validates a run of timestamp micros like the scalar overload, stopping at the
+// first invalid one. Returns the number of leading timestamps that were valid,
+// and sets <status> to the error of the first invalid timestamp.
+int64_t ParseInputTimestampMicros(absl::Span<const int64_t> timestamps,
+                                  absl::string_view function_name,
+                                  ::tsl::Status* status);
+
+::tsl::Status ParseInputDateDays(int64_t date, absl::string_view function_name,
+                                 int32_t* out);
+
+// Validates a run of date days like the scalar overload, stopping at the first
+// invalid one. Returns the number of leading dates that were valid, which are
+// appended to <out>, and sets <status> to the error of the first invalid date.
+int64_t ParseInputDateDays(absl::Span<const int64_t> dates,
+                           absl::string_view function_name,
+                           std::vector<int32_t>* out, ::tsl::Status* status);
+
+::tsl::Status ParseInputPackedDatetime(int64_t datetime,
+                                       absl::string_view function_name,
+                                       DatetimeValue* out);
+
+// Validates a run of packed datetimes like the scalar overload, stopping at
+// the first invalid one. Returns the number of leading datetimes that were
+// valid, which are appended to <out>, and sets <status> to the error of the
+// first invalid datetime.
+int64_t ParseInputPackedDatetime(absl::Span<const int64_t> datetimes,
+                                 absl::string_view function_name,
+                                 std::vector<DatetimeValue>* out,
+                                 ::tsl::Status* status);
+
+::tsl::Status ParseInputPackedTime(int64_t time,
+                                   absl::string_view function_name,
+                                   TimeValue* out);
+
+// Format the date/time types as the string layouts of the op outputs. The
+// tstring overloads write directly into an output tensor element.
 ::tsl::Status FormatOutputDatetime(const DatetimeValue& dt,
                                    absl::string_view function_name,
                                    std::string* out);
+::tsl::Status FormatOutputDatetime(const DatetimeValue& dt,
+                                   absl::string_view function_name,
+                                   ::tensorflow::tstring* out);
 
 ::tsl::Status FormatOutputDate(int32_t d, absl::string_view function_name,
                                std::string* out);
+::tsl::Status FormatOutputDate(int32_t d, absl::string_view function_name,
+                               ::tensorflow::tstring* out);
 
 ::tsl::Status FormatOutputTime(const TimeValue& time,
                                absl::string_view function_name,
                                std::string* out);
+::tsl::Status FormatOutputTime(const TimeValue& time,
+                               absl::string_view function_name,
+                               ::tensorflow::tstring* out);
 
 ::tsl::Status FormatOutputTimestamp(int64_t ts, absl::string_view function_name,
                                     std::string* out);
+::tsl::Status FormatOutputTimestamp(int64_t ts, absl::string_view function_name,
+                                    ::tensorflow::tstring* out);
+
+// A string owned by the calling thread, for the kernels to format an element
+// with the functions:: formatters before copying it to its output tstring. It
+// keeps its buffer across elements, so formatting a batch does not allocate a
+// std::string per element. Every call on a thread returns the same string.
+std::string& ThreadLocalOutputBuffer();
+
+// <size> strings owned by the calling thread, for the kernels to format a shard
+// with the functions:: batch casters before copying it to the output tstrings.
+// The strings keep their buffers across shards, and hold unspecified values
+// until overwritten. Every call on a thread returns a prefix of the same
+// strings.
+absl::Span<std::string> ThreadLocalOutputBuffers(int64_t size);
 
 ::tsl::Status ToTslStatus(absl::string_view function_name,
                           const absl::Status& status);
 
+// Memoizes the value resolved from a scalar string input of a kernel, such as
+// a time zone name or a date part, for the few most recently used inputs. This
+// lets repeated Compute calls with the same input skip the lookup. Failed
+// resolutions are not cached so their errors are reported on every call. Safe
+// to use from concurrent Compute calls.
+template <typename T>
+class ScalarInputCache {
+ public:
+  static constexpr int kCapacity = 8;
+
+  ::tsl::Status Lookup(absl::string_view key,
+                       const std::function<::tsl::Status(T*)>& resolve,
+                       T* out) {
+    {
+      ::tensorflow::mutex_lock lock(mu_);
+      for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->first == key) {
+          // Move the entry to the front so it is evicted last.
+          std::rotate(entries_.begin(), it, it + 1);
+          *out = entries_.front().second;
+          return ::tsl::OkStatus();
+        }
+      }
+    }
+
+    T value;
+    ::tsl::Status status = resolve(&value);
+    if (!status.ok()) return status;
+
+    ::tensorflow::mutex_lock lock(mu_);
+    if (entries_.size() >= kCapacity) entries_.pop_back();
+    entries_.emplace(entries_.begin(), std::string(key), value);
+    *out = value;
+    return ::tsl::OkStatus();
+  }
+
+ private:
+  ::tensorflow::mutex mu_;
+  // Most recently used first.
+  std::vector<std::pair<std::string, T>> entries_;
+};
+
+using DateTimestampPartCache = ScalarInputCache<functions::DateTimestampPart>;
+using TimeZoneCache = ScalarInputCache<absl::TimeZone>;
+
+// Same as ParseInputDateTimestampPart, memoizing the result in cache.
+::tsl::Status ParseInputDateTimestampPart(
+    absl::string_view part, absl::string_view function_name,
+    DateTimestampPartCache* cache, functions::DateTimestampPart* out,
+    const absl::flat_hash_set<functions::DateTimestampPart>& supported_parts =
+        {});
+
+// Resolve a time zone name with functions::MakeTimeZone, memoizing the result
+// in cache.
+::tsl::Status ParseInputTimeZone(absl::string_view time_zone,
+                                 absl::string_view function_name,
+                                 TimeZoneCache* cache, absl::TimeZone* out);
+
+// Interns the strings of a BroadcastInput tensor into keys. Leaves index empty
+// if all the rows share one string, and otherwise sets index[row] to the
+// position in keys of the string of each row.
+::tsl::Status InternBroadcastInput(const ::tensorflow::Tensor& tensor,
+                                   const ::tensorflow::TensorShape& shape,
+                                   absl::string_view input_name,
+                                   absl::string_view function_name,
+                                   std::vector<absl::string_view>* keys,
+                                   std::vector<int32_t>* index);
+
+// A string input of a kernel, such as a time zone or a date part, that is
+// either a scalar or has one string per element of the kernel's main input.
+// Each distinct string is resolved once per batch, so that the rows only pay
+// for an index lookup. The strings must outlive the BroadcastInput.
+template <typename T>
+class BroadcastInput {
+ public:
+  // Resolves each distinct string of tensor, which must have a single element
+  // or the given shape, with resolve. A string that fails to resolve only
+  // fails Init when all the rows share it; otherwise the failure is kept for
+  // its rows, see status().
+  ::tsl::Status Init(
+      const ::tensorflow::Tensor& tensor,
+      const ::tensorflow::TensorShape& shape, absl::string_view input_name,
+      absl::string_view function_name,
+      const std::function<::tsl::Status(absl::string_view, T*)>& resolve) {
+    std::vector<absl::string_view> keys;
+    TF_RETURN_IF_ERROR(InternBroadcastInput(tensor, shape, input_name,
+                                            function_name, &keys, &index_));
+    values_.resize(keys.size());
+    statuses_.assign(index_.empty() ? 0 : keys.size(), ::tsl::OkStatus());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      ::tsl::Status status = resolve(keys[i], &values_[i]);
+      if (index_.empty()) {
+        TF_RETURN_IF_ERROR(status);
+      } else {
+        statuses_[i] = std::move(status);
+      }
+    }
+    return ::tsl::OkStatus();
+  }
+
+  // Whether all the rows share one value.
+  bool is_scalar() const { return index_.empty(); }
+
+  // The failure to resolve the string of row, to be checked before reading
+  // its value, so that the *WithErrors ops only fail the rows with a bad
+  // string.
+  ::tsl::Status status(int64_t row) const {
+    return index_.empty() ? ::tsl::OkStatus() : statuses_[index_[row]];
+  }
+
+  const T& operator()(int64_t row) const {
+    return index_.empty() ? values_[0] : values_[index_[row]];
+  }
+
+ private:
+  std::vector<T> values_;
+  std::vector<::tsl::Status> statuses_;
+  std::vector<int32_t> index_;
+};
+
+using DateFormatterCache =
+    ScalarInputCache<std::shared_ptr<const functions::DateFormatter>>;
+using DatetimeFormatterCache =
+    ScalarInputCache<std::shared_ptr<const functions::DatetimeFormatter>>;
+using TimeFormatterCache =
+    ScalarInputCache<std::shared_ptr<const functions::TimeFormatter>>;
+using TimestampFormatterCache =
+    ScalarInputCache<std::shared_ptr<const functions::TimestampFormatter>>;
+
+// Compile a format string once for all the elements of a batch, memoizing the
+// compiled formatter in cache.
+::tsl::Status ParseInputFormat(
+    absl::string_view format, absl::string_view function_name,
+    DateFormatterCache* cache,
+    std::shared_ptr<const functions::DateFormatter>* out);
+::tsl::Status ParseInputFormat(
+    absl::string_view format, absl::string_view function_name,
+    DatetimeFormatterCache* cache,
+    std::shared_ptr<const functions::DatetimeFormatter>* out);
+::tsl::Status ParseInputFormat(
+    absl::string_view format, absl::string_view function_name,
+    TimeFormatterCache* cache,
+    std::shared_ptr<const functions::TimeFormatter>* out);
+::tsl::Status ParseInputFormat(
+    absl::string_view format, absl::string_view function_name,
+    TimestampFormatterCache* cache,
+    std::shared_ptr<const functions::TimestampFormatter>* out);
+
+// Memoizes the casters of the CAST ... FORMAT ops, such as
+// functions::StringToDateCaster, compiled from their format string inputs.
+template <typename Caster>
+using CastFormatCache = ScalarInputCache<std::shared_ptr<const Caster>>;
+
+// Compile a CAST ... FORMAT format string with Caster::Create once for all the
+// elements of a batch, memoizing the caster in cache.
+template <typename Caster>
+::tsl::Status ParseInputCastFormat(absl::string_view format,
+                                   absl::string_view function_name,
+                                   CastFormatCache<Caster>* cache,
+                                   std::shared_ptr<const Caster>* out) {
+  return cache->Lookup(
+      format,
+      [&](std::shared_ptr<const Caster>* caster) {
+        absl::StatusOr<Caster> compiled = Caster::Create(format);
+        if (!compiled.ok()) {
+          return ToTslStatus(function_name, compiled.status());
+        }
+        *caster = std::make_shared<const Caster>(*std::move(compiled));
+        return ::tsl::OkStatus();
+      },
+      out);
+}
+
+// Rough per-element cost, in CPU cycles, of the work done by the kernels. Used
+// by ParallelFor to decide how finely to shard a batch across the intra-op
+// thread pool.
+inline constexpr int64_t kParseCost = 2000;
+inline constexpr int64_t kFormatCost = 2000;
+inline constexpr int64_t kComputeCost = 500;
+
+// Records the failing rows of a batch for the *WithErrors variants of the
+// ops. Those have two outputs after the regular ones: error_codes, the error
+// code of each row (0 for rows that succeeded), and error_messages, the
+// messages of the first max_error_messages failing rows in row order. Instead
+// of failing the whole batch, failing rows get a zero or empty value in the
+// regular outputs. ParallelFor, ParallelForDistinct and ParallelForShards
+// switch to recording errors on their own for ops with these outputs, so a
+// kernel serves both variants as long as it allocates its regular outputs
+// before its single call to one of them.
+class RowErrors {
+ public:
+  // Allocates error_codes with the shape of the first output, which must have
+  // <total> elements. Sets <out> to null for ops without the error outputs.
+  static ::tsl::Status Create(::tensorflow::OpKernelContext* context,
+                              int64_t total, std::unique_ptr<RowErrors>* out);
+
+  // Records the failure of <row>. Rows can be recorded concurrently.
+  void Record(int64_t row, const ::tsl::Status& error);
+
+  // Records for <row> the failure already recorded for <from>.
+  void RecordCopy(int64_t row, int64_t from);
+
+  bool Failed(int64_t row) const { return codes_[row] != 0; }
+
+  // Resets the regular outputs of the failing rows and allocates
+  // error_messages.
+  ::tsl::Status Finish(::tensorflow::OpKernelContext* context);
+
+ private:
+  RowErrors(int32_t* codes, int64_t total, int64_t max_messages)
+      : codes_(codes), total_(total), max_messages_(max_messages) {}
+
+  // Keeps <message> for <row> if it is among the first max_messages_ rows.
+  void AddMessage(int64_t row, std::string message)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  int32_t* const codes_;
+  const int64_t total_;
+  const int64_t max_messages_;
+  ::tensorflow::mutex mu_;
+  std::map<int64_t, std::string> messages_ TF_GUARDED_BY(mu_);
+};
+
+// Run fn(i) for every i in [0, total) on the intra-op thread pool of the
+// context's device, sharded according to cost_per_unit. If fn fails for any
+// element, returns the error of the lowest failing index so that the reported
+// error does not depend on how the work was scheduled. For the *WithErrors
+// ops, records the failures of every element instead (see RowErrors).
+::tsl::Status ParallelFor(::tensorflow::OpKernelContext* context,
+                          int64_t total, int64_t cost_per_unit,
+                          const std::function<::tsl::Status(int64_t)>& fn);
+
+// Like ParallelFor over the elements of <input>, but when a sample of the batch
+// shows few distinct values, only calls fn(i) for the first occurrence of each
+// value and then copy(from, to) from that occurrence to the repeated ones. fn
+// must only depend on input(i) and write its result to index i. It may
+// overwrite input(i), as the kernels that forward their input buffer to their
+// output do, since the values are all compared before the first call. Since
+// the first occurrence of a failing value fails first, the reported error is
+// the same as with ParallelFor.
+::tsl::Status ParallelForDistinct(
+    ::tensorflow::OpKernelContext* context,
+    ::tensorflow::TTypes<::tensorflow::tstring>::ConstFlat input,
+    int64_t cost_per_unit, const std::function<::tsl::Status(int64_t)>& fn,
+    const std::function<void(int64_t, int64_t)>& copy);
+
+// Same as above, for kernels writing the result of fn(i) to output(i).
+template <typename OutputFlat>
+::tsl::Status ParallelForDistinct(
+    ::tensorflow::OpKernelContext* context,
+    ::tensorflow::TTypes<::tensorflow::tstring>::ConstFlat input,
+    int64_t cost_per_unit, const std::function<::tsl::Status(int64_t)>& fn,
+    OutputFlat& output) {
+  return ParallelForDistinct(
+      context, input, cost_per_unit, fn,
+      [&output](int64_t from, int64_t to) { output(to) = output(from); });
+}
+
+// Collects the errors of one shard of a ParallelForShards call, keeping the
+// one with the lowest row, counted from the start of the shard, or all of
+// them if <keep_all>. It is also the ErrorSink to pass to the functions::
+// batch API for the shard's rows.
+class ShardErrors : public functions::ErrorSink {
+ public:
+  explicit ShardErrors(absl::string_view function_name, bool keep_all = false)
+      : function_name_(function_name), keep_all_(keep_all) {}
+
+  void OnError(int64_t row, absl::Status error) override {
+    Add(row, ToTslStatus(function_name_, error));
+  }
+
+  // Records <error> for <row> unless an earlier row already failed.
+  void Add(int64_t row, ::tsl::Status error) {
+    if (error.ok()) return;
+    if (keep_all_) all_errors_.emplace_back(row, error);
+    if (row < first_error_row_) {
+      first_error_row_ = row;
+      first_error_ = std::move(error);
+    }
+  }
+
+  // Records the status returned by a batch function itself, which only fails
+  // if the whole shard could not be processed.
+  void AddBatchStatus(const absl::Status& status) {
+    if (!status.ok()) Add(0, ToTslStatus(function_name_, status));
+  }
+
+  int64_t first_error_row() const { return first_error_row_; }
+  ::tsl::Status& first_error() { return first_error_; }
+
+  // All the errors, if <keep_all>.
+  const std::vector<std::pair<int64_t, ::tsl::Status>>& all_errors() const {
+    return all_errors_;
+  }
+
+ private:
+  const absl::string_view function_name_;
+  const bool keep_all_;
+  int64_t first_error_row_ = std::numeric_limits<int64_t>::max();
+  ::tsl::Status first_error_;
+  std::vector<std::pair<int64_t, ::tsl::Status>> all_errors_;
+};
+
+// Like ParallelFor, but calls fn(start, limit, errors) once per shard
+// [start, limit) so that the shard can be processed as a batch. fn reports
+// failing rows of the shard to <errors>, and the error of the lowest failing
+// index overall is returned. fn may stop at the first failing row of its
+// shard, except in the kernels of the *WithErrors ops, where it must process
+// every row and report each failing one.
+::tsl::Status ParallelForShards(
+    ::tensorflow::OpKernelContext* context, absl::string_view function_name,
+    int64_t total, int64_t cost_per_unit,
+    const std::function<void(int64_t, int64_t, ShardErrors*)>& fn);
+
+// The elements [start, limit) of <input>, for passing a shard of a string
+// tensor to the functions:: batch APIs.
+std::vector<absl::string_view> ShardStrings(
+    ::tensorflow::TTypes<::tensorflow::tstring>::ConstFlat input,
+    int64_t start, int64_t limit);
+
 // Create an IntervalValue based on number of DateTimestampPart.
 absl::StatusOr<IntervalValue> GetIntervalValue(
     int64_t diff, functions::DateTimestampPart part_enum);
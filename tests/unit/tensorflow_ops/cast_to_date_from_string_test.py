@@ -53,6 +53,20 @@ class CastToDateFromStringTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.cast_to_date_from_string(date_string, 'abc'))
 
+  def test_cast_to_date_from_string_with_errors(self):
+    date_string = tf.constant(['2018-12-03', '2018-12-03a', '2018-12-03'])
+    output, error_codes, error_messages = (
+        date_ops.cast_to_date_from_string_with_errors(date_string)
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2018-12-03', '', '2018-12-03'])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True, False])
+    self.assertLen(error_messages, 1)
+    self.assertRegex(
+        error_messages[0].numpy().decode(), "Invalid date: '2018-12-03a'"
+    )
+
 
 if __name__ == '__main__':
   tf.test.main()
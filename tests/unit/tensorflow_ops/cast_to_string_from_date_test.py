@@ -0,0 +1,77 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Tests for BigQuery CastToStringFromDate custom op."""
+
+
+from bigquery_ml_utils.tensorflow_ops import date_ops
+import tensorflow as tf
+
+
+class CastToStringFromDateTest(tf.test.TestCase):
+
+  def test_cast_to_string_from_date(self):
+    date = tf.constant(['2018-12-03', '2020-01-11'])
+    self.assertAllEqual(
+        date_ops.cast_to_string_from_date(date, 'DAY, Month DD, YYYY'),
+        tf.constant(
+            ['MONDAY, December 03, 2018', 'SATURDAY, January 11, 2020']
+        ),
+    )
+
+  def test_cast_to_string_from_date_repeated_formats(self):
+    date = tf.constant([['2018-12-03'], ['2020-01-11']])
+    expected = {
+        'YYYY/MM/DD': [['2018/12/03'], ['2020/01/11']],
+        'MON-DD-YY': [['DEC-03-18'], ['JAN-11-20']],
+    }
+    # Cast each format twice so the second call reuses the compiled format.
+    for _ in range(2):
+      for format_string, output in expected.items():
+        self.assertAllEqual(
+            date_ops.cast_to_string_from_date(date, format_string),
+            tf.constant(output),
+        )
+
+  def test_cast_to_string_from_date_invalid_date(self):
+    date = tf.constant(['2018-12-03', '2020-13-11'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        "Invalid date: '2020-13-11'",
+    ):
+      self.evaluate(date_ops.cast_to_string_from_date(date, 'YYYY'))
+
+  def test_cast_to_string_from_date_unsupported_format(self):
+    date = tf.constant(['2018-12-03'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        "DATE does not support 'HH24'",
+    ):
+      self.evaluate(
+          date_ops.cast_to_string_from_date(date, 'YYYY-MM-DD HH24')
+      )
+
+  def test_cast_to_string_from_date_with_errors(self):
+    date = tf.constant(['invalid_date', '2018-12-03', '2020-13-11'])
+    output, error_codes, error_messages = (
+        date_ops.cast_to_string_from_date_with_errors(date, 'YYYY/MM/DD')
+    )
+    self.assertAllEqual(output, tf.constant(['', '2018/12/03', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [True, False, True])
+    self.assertLen(error_messages, 2)
+
+
+if __name__ == '__main__':
+  tf.test.main()
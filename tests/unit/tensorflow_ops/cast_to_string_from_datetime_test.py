@@ -0,0 +1,56 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Tests for BigQuery CastToStringFromDatetime custom op."""
+
+
+from bigquery_ml_utils.tensorflow_ops import datetime_ops
+import tensorflow as tf
+
+
+class CastToStringFromDatetimeTest(tf.test.TestCase):
+
+  def test_cast_to_string_from_datetime(self):
+    datetime = tf.constant(['2018-12-03 14:05:06.789123'])
+    self.assertAllEqual(
+        datetime_ops.cast_to_string_from_datetime(
+            datetime, 'MON DD, YYYY HH12:MI:SS.FF3 A.M.'
+        ),
+        tf.constant(['DEC 03, 2018 02:05:06.789 P.M.']),
+    )
+
+  def test_cast_to_string_from_datetime_invalid_format(self):
+    datetime = tf.constant(['2018-12-03 14:05:06.789123'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Cannot find matched format element at 0',
+    ):
+      self.evaluate(datetime_ops.cast_to_string_from_datetime(datetime, 'abc'))
+
+  def test_cast_to_string_from_datetime_with_errors(self):
+    datetime = tf.constant(['2018-12-03 14:05:06.789123', 'invalid_datetime'])
+    output, error_codes, _ = (
+        datetime_ops.cast_to_string_from_datetime_with_errors(
+            datetime, 'MON DD, YYYY HH12:MI:SS.FF3 A.M.'
+        )
+    )
+    self.assertAllEqual(
+        output, tf.constant(['DEC 03, 2018 02:05:06.789 P.M.', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+
+if __name__ == '__main__':
+  tf.test.main()
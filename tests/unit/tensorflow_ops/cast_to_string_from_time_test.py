@@ -0,0 +1,50 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Tests for BigQuery CastToStringFromTime custom op."""
+
+
+from bigquery_ml_utils.tensorflow_ops import time_ops
+import tensorflow as tf
+
+
+class CastToStringFromTimeTest(tf.test.TestCase):
+
+  def test_cast_to_string_from_time(self):
+    time = tf.constant(['14:05:06.789123'])
+    self.assertAllEqual(
+        time_ops.cast_to_string_from_time(time, 'HH24:MI:SS.FF6 "sharp"'),
+        tf.constant(['14:05:06.789123 sharp']),
+    )
+
+  def test_cast_to_string_from_time_invalid_time(self):
+    time = tf.constant(['14:05:06', '25:00:00'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        "Invalid time: '25:00:00'",
+    ):
+      self.evaluate(time_ops.cast_to_string_from_time(time, 'HH24'))
+
+  def test_cast_to_string_from_time_with_errors(self):
+    time = tf.constant(['14:05:06.789123', 'invalid_time'])
+    output, error_codes, _ = time_ops.cast_to_string_from_time_with_errors(
+        time, 'HH24:MI:SS.FF6 "sharp"'
+    )
+    self.assertAllEqual(output, tf.constant(['14:05:06.789123 sharp', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -0,0 +1,61 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Tests for BigQuery CastToStringFromTimestamp custom op."""
+
+
+from bigquery_ml_utils.tensorflow_ops import timestamp_ops
+import tensorflow as tf
+
+
+class CastToStringFromTimestampTest(tf.test.TestCase):
+
+  def test_cast_to_string_from_timestamp(self):
+    timestamp = tf.constant(['2008-12-25 15:30:00+00'])
+    format_string = 'YYYY-MM-DD HH24:MI:SS TZH:TZM'
+    self.assertAllEqual(
+        timestamp_ops.cast_to_string_from_timestamp(timestamp, format_string),
+        tf.constant(['2008-12-25 15:30:00 +00:00']),
+    )
+    self.assertAllEqual(
+        timestamp_ops.cast_to_string_from_timestamp(
+            timestamp, format_string, 'America/Los_Angeles'
+        ),
+        tf.constant(['2008-12-25 07:30:00 -08:00']),
+    )
+
+  def test_cast_to_string_from_timestamp_invalid_format(self):
+    timestamp = tf.constant(['2008-12-25 15:30:00+00'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Cannot find matched format element at 0',
+    ):
+      self.evaluate(
+          timestamp_ops.cast_to_string_from_timestamp(timestamp, 'abc')
+      )
+
+  def test_cast_to_string_from_timestamp_with_errors(self):
+    timestamp = tf.constant(['2008-12-25 15:30:00+00', 'invalid_timestamp'])
+    output, error_codes, _ = (
+        timestamp_ops.cast_to_string_from_timestamp_with_errors(
+            timestamp, 'YYYY-MM-DD HH24:MI:SS TZH:TZM'
+        )
+    )
+    self.assertAllEqual(output, tf.constant(['2008-12-25 15:30:00 +00:00', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+
+if __name__ == '__main__':
+  tf.test.main()
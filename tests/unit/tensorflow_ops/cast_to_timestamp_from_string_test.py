@@ -0,0 +1,82 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Tests for BigQuery CastToTimestampFromString custom op."""
+
+
+from bigquery_ml_utils.tensorflow_ops import timestamp_ops
+import tensorflow as tf
+
+
+class CastToTimestampFromStringTest(tf.test.TestCase):
+
+  def test_cast_to_timestamp_from_string_without_format(self):
+    timestamp_string = tf.constant(
+        ['2008-12-25 15:30:00+00', '2023-11-11 14:30:00']
+    )
+    self.assertAllEqual(
+        timestamp_ops.cast_to_timestamp_from_string(timestamp_string),
+        tf.constant(
+            ['2008-12-25 15:30:00.0 +0000', '2023-11-11 14:30:00.0 +0000']
+        ),
+    )
+
+  def test_cast_to_timestamp_from_string_with_format(self):
+    timestamp_string = tf.constant(['12/25/2008 15:30', '11/11/2023 14:30'])
+    self.assertAllEqual(
+        timestamp_ops.cast_to_timestamp_from_string(
+            timestamp_string, 'MM/DD/YYYY HH24:MI', 'America/Los_Angeles'
+        ),
+        tf.constant(
+            ['2008-12-25 23:30:00.0 +0000', '2023-11-11 22:30:00.0 +0000']
+        ),
+    )
+
+  def test_cast_to_timestamp_from_string_with_time_zone_in_format(self):
+    timestamp_string = tf.constant(['12/25/2008 15:30 +02'])
+    self.assertAllEqual(
+        timestamp_ops.cast_to_timestamp_from_string(
+            timestamp_string, 'MM/DD/YYYY HH24:MI TZH', 'America/Los_Angeles'
+        ),
+        tf.constant(['2008-12-25 13:30:00.0 +0000']),
+    )
+
+  def test_cast_to_timestamp_from_string_invalid_string(self):
+    timestamp_string = tf.constant(['12/25/2008 15:30', '12/25/2008 15:3x'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        "Illegal non-space trailing data 'x' in timestamp string",
+    ):
+      self.evaluate(
+          timestamp_ops.cast_to_timestamp_from_string(
+              timestamp_string, 'MM/DD/YYYY HH24:MI'
+          )
+      )
+
+  def test_cast_to_timestamp_from_string_with_errors(self):
+    timestamp_string = tf.constant(['12/25/2008 15:30', '13/25/2008 15:30'])
+    output, error_codes, _ = (
+        timestamp_ops.cast_to_timestamp_from_string_with_errors(
+            timestamp_string, 'MM/DD/YYYY HH24:MI'
+        )
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2008-12-25 15:30:00.0 +0000', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -0,0 +1,119 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for RaggedTensor and SparseTensor inputs of the custom ops."""
+
+from bigquery_ml_utils.tensorflow_ops import date_ops
+from bigquery_ml_utils.tensorflow_ops import timestamp_ops
+import tensorflow as tf
+
+
+class CompositeTensorsTest(tf.test.TestCase):
+
+  def test_ragged_input(self):
+    timestamp = tf.ragged.constant([
+        ['Thu Dec 25 15:30:00 2008'],
+        [],
+        ['Sat Nov 11 14:30:00 2023', 'Thu Dec 25 15:30:00 2008'],
+    ])
+    result = timestamp_ops.parse_timestamp(
+        '%c', timestamp, 'America/Los_Angeles'
+    )
+    self.assertIsInstance(result, tf.RaggedTensor)
+    self.assertAllEqual(
+        result,
+        tf.ragged.constant([
+            ['2008-12-25 23:30:00.0 +0000'],
+            [],
+            ['2023-11-11 22:30:00.0 +0000', '2008-12-25 23:30:00.0 +0000'],
+        ]),
+    )
+    self.assertIs(result.row_splits, timestamp.row_splits)
+
+  def test_ragged_inputs(self):
+    date_a = tf.ragged.constant([['2023-02-02'], ['2008-12-25', '2023-02-02']])
+    date_b = tf.ragged.constant([['2008-12-25'], ['2023-02-02', '2023-02-02']])
+    self.assertAllEqual(
+        date_ops.date_diff(date_a, date_b, 'DAY'),
+        tf.ragged.constant([[5152], [-5152, 0]], dtype=tf.int64),
+    )
+
+  def test_ragged_input_multiple_outputs(self):
+    date = tf.ragged.constant([['Thursday Jan  1 1970'], ['invalid_date']])
+    output, valid = date_ops.safe_parse_date_with_validity('%A %b %e %Y', date)
+    self.assertAllEqual(output, tf.ragged.constant([['1970-01-01'], ['']]))
+    self.assertAllEqual(valid, tf.ragged.constant([[True], [False]]))
+
+  def test_sparse_input(self):
+    date = tf.SparseTensor(
+        indices=[[0, 1], [2, 0]],
+        values=['2008-12-25', '2023-11-11'],
+        dense_shape=[3, 2],
+    )
+    result = date_ops.extract_from_date(date, 'YEAR')
+    self.assertIsInstance(result, tf.SparseTensor)
+    self.assertAllEqual(result.indices, date.indices)
+    self.assertAllEqual(result.values, tf.constant([2008, 2023]))
+    self.assertAllEqual(result.dense_shape, date.dense_shape)
+
+  def test_ragged_input_in_function(self):
+    timestamp = tf.ragged.constant(
+        [['2023-01-10 12:34:56.7 +1234'], ['2023-03-14 23:45:12.3 +1234']]
+    )
+    self.assertAllEqual(
+        tf.function(timestamp_ops.string_from_timestamp)(timestamp),
+        tf.ragged.constant(
+            [['2023-01-10 00:00:56.700+00'], ['2023-03-14 11:11:12.300+00']]
+        ),
+    )
+
+  def test_mixed_ragged_and_sparse_inputs(self):
+    date_a = tf.ragged.constant([['2023-02-02']])
+    date_b = tf.SparseTensor(
+        indices=[[0, 0]], values=['2008-12-25'], dense_shape=[1, 1]
+    )
+    with self.assertRaisesRegex(
+        ValueError, 'cannot mix RaggedTensor and SparseTensor'
+    ):
+      date_ops.date_diff(date_a, date_b, 'DAY')
+
+  def test_ragged_inputs_with_different_row_splits(self):
+    date_a = tf.ragged.constant([['2023-02-02'], ['2008-12-25', '2023-02-02']])
+    date_b = tf.ragged.constant([['2008-12-25', '2023-02-02'], ['2023-02-02']])
+    with self.assertRaisesRegex(
+        (ValueError, tf.errors.InvalidArgumentError),
+        'same row partitions or indices',
+    ):
+      self.evaluate(date_ops.date_diff(date_a, date_b, 'DAY'))
+
+  def test_sparse_inputs_with_different_indices(self):
+    date_a = tf.SparseTensor(
+        indices=[[0, 1], [2, 0]],
+        values=['2008-12-25', '2023-11-11'],
+        dense_shape=[3, 2],
+    )
+    date_b = tf.SparseTensor(
+        indices=[[0, 0], [2, 0]],
+        values=['2008-12-25', '2023-11-11'],
+        dense_shape=[3, 2],
+    )
+    with self.assertRaisesRegex(
+        (ValueError, tf.errors.InvalidArgumentError),
+        'same row partitions or indices',
+    ):
+      self.evaluate(date_ops.date_diff(date_a, date_b, 'DAY'))
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -62,6 +62,15 @@ class DateAddTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.date_add(date, interval, 'SECOND'))
 
+  def test_date_add_with_errors(self):
+    date = tf.constant(['2008-12-25', 'invalid_date', '9999-12-31'])
+    interval = tf.constant([2, 2, 2], dtype=tf.int64)
+    output, error_codes, _ = date_ops.date_add_with_errors(
+        date, interval, 'DAY'
+    )
+    self.assertAllEqual(output, tf.constant(['2008-12-27', '', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -0,0 +1,118 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BigQuery DATE custom ops on int64 days since the epoch."""
+
+from bigquery_ml_utils.tensorflow_ops import date_ops
+import tensorflow as tf
+
+
+class DateDaysOpsTest(tf.test.TestCase):
+
+  def setUp(self):
+    super().setUp()
+    # 2008-12-25 and 2023-11-11.
+    self.date = tf.constant([14238, 19672], dtype=tf.int64)
+
+  def test_extract_from_date_days(self):
+    self.assertAllEqual(
+        date_ops.extract_from_date_days(self.date, 'MONTH'),
+        tf.constant([12, 11], dtype=tf.int64),
+    )
+    self.assertAllEqual(
+        date_ops.extract_from_date_days(self.date, 'DAYOFWEEK'),
+        tf.constant([5, 7], dtype=tf.int64),
+    )
+
+  def test_date_add_sub_days(self):
+    interval = tf.constant([1, 1], dtype=tf.int64)
+    added = date_ops.date_add_days(self.date, interval, 'MONTH')
+    self.assertAllEqual(added, tf.constant([14269, 19702], dtype=tf.int64))
+    self.assertAllEqual(
+        date_ops.date_sub_days(added, interval, 'MONTH'), self.date
+    )
+
+  def test_date_diff_days(self):
+    self.assertAllEqual(
+        date_ops.date_diff_days(
+            self.date, tf.constant([14214, 19662], dtype=tf.int64), 'DAY'
+        ),
+        tf.constant([24, 10], dtype=tf.int64),
+    )
+
+  def test_date_trunc_days(self):
+    self.assertAllEqual(
+        date_ops.date_trunc_days(self.date, 'MONTH'),
+        tf.constant([14214, 19662], dtype=tf.int64),
+    )
+
+  def test_matches_string_ops(self):
+    date = tf.constant(['2008-12-25', '2023-11-11'])
+    self.assertAllEqual(
+        date_ops.date_from_unix_date(
+            date_ops.date_trunc_days(date_ops.unix_date(date), 'ISOWEEK')
+        ),
+        date_ops.date_trunc(date, 'ISOWEEK'),
+    )
+
+  def test_date_days_batch_matches_string_ops(self):
+    days = tf.range(-1000, 1000, dtype=tf.int64) * 37
+    date = date_ops.date_from_unix_date(days)
+    for part in ['YEAR', 'QUARTER', 'DAYOFWEEK', 'DAYOFYEAR', 'ISOWEEK']:
+      self.assertAllEqual(
+          date_ops.extract_from_date_days(days, part),
+          date_ops.extract_from_date(date, part),
+      )
+    for part in ['WEEK', 'WEEK_FRIDAY', 'QUARTER', 'YEAR']:
+      self.assertAllEqual(
+          date_ops.date_from_unix_date(date_ops.date_trunc_days(days, part)),
+          date_ops.date_trunc(date, part),
+      )
+
+  def test_extract_from_date_days_calendar_edges(self):
+    # 0001-01-01, 2000-02-29, 1900-03-01 and 9999-12-31.
+    date = tf.constant([-719162, 11016, -25508, 2932896], dtype=tf.int64)
+    expected = {
+        'YEAR': [1, 2000, 1900, 9999],
+        'MONTH': [1, 2, 3, 12],
+        'DAY': [1, 29, 1, 31],
+        'DAYOFYEAR': [1, 60, 60, 365],
+        'DAYOFWEEK': [2, 3, 5, 6],
+    }
+    for part, values in expected.items():
+      self.assertAllEqual(
+          date_ops.extract_from_date_days(date, part),
+          tf.constant(values, dtype=tf.int64),
+      )
+
+  def test_date_add_days_reports_first_error(self):
+    date = tf.constant([0, 2932896, 2932897], dtype=tf.int64)
+    interval = tf.constant([1, 1, 1], dtype=tf.int64)
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Adding 1 DAY to date 9999-12-31 causes overflow',
+    ):
+      self.evaluate(date_ops.date_add_days(date, interval, 'DAY'))
+
+  def test_date_days_out_of_range(self):
+    date = tf.constant([2932897], dtype=tf.int64)
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Invalid date days in DateTruncDays: 2932897',
+    ):
+      self.evaluate(date_ops.date_trunc_days(date, 'MONTH'))
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -74,6 +74,16 @@ class DateDiffTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.date_diff(date_a, date_b, 'SECOND'))
 
+  def test_date_diff_with_errors(self):
+    date_a = tf.constant(['2023-02-02', '2008-12-25', 'invalid_date'])
+    date_b = tf.constant(['2008-12-25', 'invalid_date', '2023-02-02'])
+    output, error_codes, error_messages = date_ops.date_diff_with_errors(
+        date_a, date_b, 'DAY'
+    )
+    self.assertAllEqual(output, tf.constant([5152, 0, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True, True])
+    self.assertLen(error_messages, 2)
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -39,6 +39,12 @@ class DateFromDatetimeTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.date_from_datetime(datetime))
 
+  def test_date_from_datetime_with_errors(self):
+    datetime = tf.constant(['2023-02-02 02:02:01.152903', 'invalid_datetime'])
+    output, error_codes, _ = date_ops.date_from_datetime_with_errors(datetime)
+    self.assertAllEqual(output, tf.constant(['2023-02-02', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -53,6 +53,14 @@ class DateFromTimestampTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.date_from_timestamp(timestamp, 'UtC'))
 
+  def test_date_from_timestamp_with_errors(self):
+    timestamp = tf.constant(['2008-12-25 06:30:00+00', 'invalid_timestamp'])
+    output, error_codes, _ = date_ops.date_from_timestamp_with_errors(
+        timestamp, 'America/Los_Angeles'
+    )
+    self.assertAllEqual(output, tf.constant(['2008-12-24', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
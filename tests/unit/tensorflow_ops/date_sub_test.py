@@ -62,6 +62,15 @@ class DateSubTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.date_sub(date, interval, 'SECOND'))
 
+  def test_date_sub_with_errors(self):
+    date = tf.constant(['2008-12-25', 'invalid_date'])
+    interval = tf.constant([2, 2], dtype=tf.int64)
+    output, error_codes, _ = date_ops.date_sub_with_errors(
+        date, interval, 'DAY'
+    )
+    self.assertAllEqual(output, tf.constant(['2008-12-23', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -55,6 +55,22 @@ class DateTruncTest(tf.test.TestCase):
         tf.constant(['2007-12-31', '2023-01-02']),
     )
 
+  def test_date_trunc_repeated_dates(self):
+    # Large enough for the kernel to split the dates into several batches.
+    date = tf.constant(['2008-12-25', '2023-02-02', '2023-02-05'] * 200)
+    self.assertAllEqual(
+        date_ops.date_trunc(date, 'WEEK'),
+        tf.constant(['2008-12-21', '2023-01-29', '2023-02-05'] * 200),
+    )
+
+  def test_date_trunc_repeated_invalid_date(self):
+    date = tf.constant(['2008-12-25', '2023-02-02'] * 200 + ['2008-12-25 a'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Failed to parse input string "2008-12-25 a"',
+    ):
+      self.evaluate(date_ops.date_trunc(date, 'DAY'))
+
   def test_date_trunc_invalid_date(self):
     date = tf.constant(['2008-12-25 a', '2023-02-02'])
     with self.assertRaisesRegex(
@@ -71,6 +87,45 @@ class DateTruncTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.date_trunc(date, 'SECOND'))
 
+  def test_date_trunc_intermediate_input(self):
+    date = tf.constant(['2023-01-31', '2008-12-25'])
+    interval = tf.constant([1, 1], dtype=tf.int64)
+
+    @tf.function
+    def add_and_trunc(date):
+      # The first result may be truncated in place, the second one may not.
+      truncated = date_ops.date_trunc(
+          date_ops.date_add(date, interval, 'DAY'), 'MONTH'
+      )
+      added = date_ops.date_add(date, interval, 'DAY')
+      return truncated, added, date_ops.date_trunc(added, 'MONTH')
+
+    truncated, added, truncated_again = add_and_trunc(date)
+    self.assertAllEqual(truncated, tf.constant(['2023-02-01', '2008-12-01']))
+    self.assertAllEqual(added, tf.constant(['2023-02-01', '2008-12-26']))
+    self.assertAllEqual(truncated_again, truncated)
+
+  def test_date_trunc_with_errors(self):
+    date = tf.constant(['2008-12-25', 'invalid_date'])
+    output, error_codes, _ = date_ops.date_trunc_with_errors(date, 'MONTH')
+    self.assertAllEqual(output, tf.constant(['2008-12-01', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+  def test_date_trunc_with_errors_sorted_dates(self):
+    date = tf.constant(
+        ['2023-01-30', '2023-01-31', 'invalid_date', '2023-02-01', '2023-02-02']
+    )
+    output, error_codes, _ = date_ops.date_trunc_with_errors(date, 'MONTH')
+    self.assertAllEqual(
+        output,
+        tf.constant(
+            ['2023-01-01', '2023-01-01', '', '2023-02-01', '2023-02-01']
+        ),
+    )
+    self.assertAllEqual(
+        tf.not_equal(error_codes, 0), [False, False, True, False, False]
+    )
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -118,6 +118,15 @@ class DatetimeAddTest(tf.test.TestCase):
           )
       )
 
+  def test_datetime_add_with_errors(self):
+    datetime = tf.constant(['2023-01-10 12:34:56.7', 'invalid_datetime'])
+    interval = tf.constant([10, 20], dtype=tf.int64)
+    output, error_codes, _ = datetime_ops.datetime_add_with_errors(
+        datetime, interval, 'MILLISECOND'
+    )
+    self.assertAllEqual(output, tf.constant(['2023-01-10 12:34:56.710', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -142,6 +142,15 @@ class DatetimeDiffTest(tf.test.TestCase):
     ):
       self.evaluate(datetime_ops.datetime_diff(datetime, datetime, 'DATE'))
 
+  def test_datetime_diff_with_errors(self):
+    datetime_a = tf.constant(['2022-01-09 12:34:00', 'invalid_datetime'])
+    datetime_b = tf.constant(['2023-01-10 12:34:56.7', '2022-03-04 23:45:00'])
+    output, error_codes, _ = datetime_ops.datetime_diff_with_errors(
+        datetime_a, datetime_b, 'MILLISECOND'
+    )
+    self.assertAllEqual(output, tf.constant([-31622456700, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -0,0 +1,295 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BigQuery DateTimeExpr custom op."""
+
+import os
+from unittest import mock
+
+from bigquery_ml_utils.tensorflow_ops import date_ops
+from bigquery_ml_utils.tensorflow_ops import datetime_expr_ops
+from bigquery_ml_utils.tensorflow_ops import timestamp_ops
+import tensorflow as tf
+
+
+_ENABLE_FUSION_ENV_VAR = 'BIGQUERY_ML_UTILS_FUSE_DATETIME_OPS'
+
+
+class DateTimeExprTest(tf.test.TestCase):
+
+  def setUp(self):
+    super().setUp()
+    # The fusion pass only runs when enabled.
+    patcher = mock.patch.dict(os.environ, {_ENABLE_FUSION_ENV_VAR: 'true'})
+    patcher.start()
+    self.addCleanup(patcher.stop)
+
+  def _run_session(self, fetches, feed_dict):
+    """Runs fetches in a new session, returns their values and the op types."""
+    run_metadata = tf.compat.v1.RunMetadata()
+    with tf.compat.v1.Session() as sess:
+      values = sess.run(
+          fetches,
+          feed_dict=feed_dict,
+          options=tf.compat.v1.RunOptions(output_partition_graphs=True),
+          run_metadata=run_metadata,
+      )
+    op_types = [
+        node.op
+        for graph in run_metadata.partition_graphs
+        for node in graph.node
+    ]
+    return values, op_types
+
+  def test_datetime_expr_timestamp_matches_chained_ops(self):
+    timestamp = tf.constant([
+        '2023-01-10 12:34:56.7 +1234',
+        '2023-03-12 02:30:00 -0700',
+        '2008-12-25 15:30:00 +0000',
+    ])
+    program = """
+        type: TIMESTAMP
+        steps { parse { time_zone: "America/Los_Angeles" } }
+        steps { trunc { part: DAY time_zone: "America/Los_Angeles" } }
+        steps { add { part: HOUR interval: 8 } }
+        steps { format { format: "%F %H:%M" time_zone: "Asia/Tokyo" } }
+    """
+    truncated = timestamp_ops.timestamp_trunc(
+        timestamp, 'DAY', 'America/Los_Angeles'
+    )
+    added = timestamp_ops.timestamp_add(
+        truncated, tf.constant([8, 8, 8], dtype=tf.int64), 'HOUR'
+    )
+    self.assertAllEqual(
+        datetime_expr_ops.datetime_expr(timestamp, program),
+        timestamp_ops.format_timestamp('%F %H:%M', added, 'Asia/Tokyo'),
+    )
+
+  def test_datetime_expr_date_extract(self):
+    date = tf.constant(
+        [['2023/01/31', '2008/12/25'], ['2000/02/29', '1970/01/01']]
+    )
+    program = """
+        type: DATE
+        steps { parse { format: "%Y/%m/%d" } }
+        steps { add { part: MONTH interval: 1 } }
+        steps { extract { part: DAY } }
+    """
+    self.assertAllEqual(
+        datetime_expr_ops.datetime_expr(date, program, out_type='int64'),
+        tf.constant([[28, 25], [29, 1]], dtype=tf.int64),
+    )
+
+  def test_datetime_expr_date_canonical_output(self):
+    date = tf.constant(['2023-11-11', '2008-12-25'])
+    program = """
+        type: DATE
+        steps { parse {} }
+        steps { trunc { part: ISOWEEK } }
+    """
+    self.assertAllEqual(
+        datetime_expr_ops.datetime_expr(date, program),
+        date_ops.date_trunc(date, 'ISOWEEK'),
+    )
+
+  def test_datetime_expr_datetime(self):
+    datetime = tf.constant(['2023-11-11 14:30:15.123456'])
+    program = """
+        type: DATETIME
+        steps { parse {} }
+        steps { add { part: MICROSECOND interval: 1 } }
+    """
+    self.assertAllEqual(
+        datetime_expr_ops.datetime_expr(datetime, program),
+        tf.constant(['2023-11-11 14:30:15.123457']),
+    )
+
+  def test_datetime_expr_invalid_input(self):
+    timestamp = tf.constant(['2023-01-10 12:34:56.7 +1234', 'abc'])
+    program = """
+        type: TIMESTAMP
+        steps { parse {} }
+        steps { extract { part: HOUR } }
+    """
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Failed to parse input string "abc"',
+    ):
+      self.evaluate(
+          datetime_expr_ops.datetime_expr(timestamp, program, out_type='int64')
+      )
+
+  def test_datetime_expr_unsupported_part(self):
+    date = tf.constant(['2023-11-11'])
+    program = """
+        type: DATE
+        steps { parse {} }
+        steps { add { part: HOUR interval: 1 } }
+    """
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Unsupported part in DateTimeExpr: HOUR',
+    ):
+      self.evaluate(datetime_expr_ops.datetime_expr(date, program))
+
+  def test_datetime_expr_wrong_out_type(self):
+    date = tf.constant(['2023-11-11'])
+    program = """
+        type: DATE
+        steps { parse {} }
+        steps { extract { part: YEAR } }
+    """
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'The out_type of DateTimeExpr must be int64',
+    ):
+      self.evaluate(datetime_expr_ops.datetime_expr(date, program))
+
+  def test_fused_timestamp_chain_matches_eager(self):
+    timestamp = tf.constant([
+        '2023-01-10 12:34:56.123456',
+        '2023-03-12 02:30:00 -0700',
+        '1969-12-31 23:59:59.987654 +0000',
+    ])
+
+    def chain(timestamp):
+      parsed = timestamp_ops.timestamp_from_string(timestamp)
+      truncated = timestamp_ops.timestamp_trunc(
+          parsed, 'HOUR', 'America/Los_Angeles'
+      )
+      return (
+          timestamp_ops.string_from_timestamp(parsed, 'Asia/Tokyo'),
+          timestamp_ops.format_timestamp('%F %H:%M', truncated, 'Asia/Tokyo'),
+          timestamp_ops.extract_from_timestamp('DAY', truncated),
+      )
+
+    for fused, eager in zip(tf.function(chain)(timestamp), chain(timestamp)):
+      self.assertAllEqual(fused, eager)
+
+  def test_fused_date_chain_matches_eager(self):
+    timestamp = tf.constant(
+        ['2023-01-01 03:00:00 +0000', '2008-12-25 15:30:00.5 +0000']
+    )
+    date = tf.constant(['2023-11-11', '2008-12-25'])
+
+    def chain(timestamp, date):
+      return (
+          date_ops.extract_from_date(
+              date_ops.date_from_timestamp(timestamp, 'America/Los_Angeles'),
+              'DAY',
+          ),
+          date_ops.format_date('%A %F', date_ops.date_trunc(date, 'ISOWEEK')),
+      )
+
+    fused_outputs = tf.function(chain)(timestamp, date)
+    for fused, eager in zip(fused_outputs, chain(timestamp, date)):
+      self.assertAllEqual(fused, eager)
+
+  def test_fused_chain_in_session_fetches_intermediate_op(self):
+    with tf.Graph().as_default():
+      timestamp = tf.compat.v1.placeholder(tf.string)
+      truncated = timestamp_ops.timestamp_trunc(
+          timestamp, 'HOUR', 'America/Los_Angeles'
+      )
+      formatted = timestamp_ops.format_timestamp(
+          '%F %H:%M', truncated, 'Asia/Tokyo'
+      )
+      feed_dict = {
+          timestamp: [
+              '2023-01-10 12:34:56.123456 +0000',
+              '2023-03-12 02:30:00 -0700',
+          ]
+      }
+      (truncated_value, formatted_value), op_types = self._run_session(
+          [truncated, formatted], feed_dict
+      )
+      formatted_only_value, formatted_only_op_types = self._run_session(
+          formatted, feed_dict
+      )
+
+    self.assertAllEqual(
+        truncated_value,
+        [b'2023-01-10 12:00:00.0 +0000', b'2023-03-12 09:00:00.0 +0000'],
+    )
+    self.assertAllEqual(
+        formatted_value, [b'2023-01-10 21:00', b'2023-03-12 18:00']
+    )
+    self.assertAllEqual(formatted_only_value, formatted_value)
+    # The producer kept for the fetch of the intermediate op only runs when
+    # fetched, and then the fused op truncates the timestamps once more.
+    self.assertIn('TimestampTrunc', op_types)
+    self.assertIn('DateTimeExpr', op_types)
+    self.assertNotIn('TimestampTrunc', formatted_only_op_types)
+    self.assertIn('DateTimeExpr', formatted_only_op_types)
+
+  def test_fusion_skips_producer_with_other_consumers(self):
+    with tf.Graph().as_default():
+      timestamp = tf.compat.v1.placeholder(tf.string)
+      truncated = timestamp_ops.timestamp_trunc(timestamp, 'HOUR')
+      formatted = timestamp_ops.format_timestamp(
+          '%F %H:%M', truncated, 'Asia/Tokyo'
+      )
+      day = timestamp_ops.extract_from_timestamp('DAY', truncated)
+      (formatted_value, day_value), op_types = self._run_session(
+          [formatted, day], {timestamp: ['2023-01-10 20:34:56 +0000']}
+      )
+
+    self.assertAllEqual(formatted_value, [b'2023-01-11 05:00'])
+    self.assertAllEqual(day_value, [10])
+    # Fusing TimestampTrunc into both chains would truncate the timestamps
+    # twice.
+    self.assertEqual(op_types.count('TimestampTrunc'), 1)
+    self.assertNotIn('DateTimeExpr', op_types)
+
+  def test_fusion_is_disabled_by_default(self):
+    del os.environ[_ENABLE_FUSION_ENV_VAR]
+    with tf.Graph().as_default():
+      timestamp = tf.compat.v1.placeholder(tf.string)
+      formatted = timestamp_ops.format_timestamp(
+          '%F %H:%M',
+          timestamp_ops.timestamp_trunc(timestamp, 'HOUR'),
+          'Asia/Tokyo',
+      )
+      value, op_types = self._run_session(
+          formatted, {timestamp: ['2023-01-10 12:34:56.123456 +0000']}
+      )
+
+    self.assertAllEqual(value, [b'2023-01-10 21:00'])
+    self.assertNotIn('DateTimeExpr', op_types)
+    self.assertIn('TimestampTrunc', op_types)
+
+  def test_fused_chain_errors_name_fused_ops(self):
+    with tf.Graph().as_default():
+      timestamp = tf.compat.v1.placeholder(tf.string)
+      formatted = timestamp_ops.format_timestamp(
+          '%F %H:%M',
+          timestamp_ops.timestamp_trunc(timestamp, 'HOUR'),
+          'Asia/Tokyo',
+      )
+      value, op_types = self._run_session(
+          formatted, {timestamp: ['2023-01-10 12:34:56.123456 +0000']}
+      )
+      self.assertAllEqual(value, [b'2023-01-10 21:00'])
+      self.assertIn('DateTimeExpr', op_types)
+      self.assertNotIn('TimestampTrunc', op_types)
+
+      with self.assertRaisesRegex(
+          tf.errors.OpError,
+          'fused from the ops TimestampTrunc, FormatTimestamp',
+      ):
+        self._run_session(formatted, {timestamp: ['invalid']})
+
+
+if __name__ == '__main__':
+  tf.test.main()
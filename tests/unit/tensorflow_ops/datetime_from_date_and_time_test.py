@@ -53,6 +53,16 @@ class DatetimeFromDateAndTimeTest(tf.test.TestCase):
           )
       )
 
+  def test_datetime_from_date_and_time_with_errors(self):
+    output, error_codes, _ = (
+        datetime_ops.datetime_from_date_and_time_with_errors(
+            tf.constant(['2012-01-01', '2023-04-14']),
+            tf.constant(['01:00:00', 'invalid_time']),
+        )
+    )
+    self.assertAllEqual(output, tf.constant(['2012-01-01 01:00:00', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
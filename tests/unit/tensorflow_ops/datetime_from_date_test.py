@@ -40,6 +40,13 @@ class DatetimeFromDateTest(tf.test.TestCase):
           )
       )
 
+  def test_datetime_from_date_with_errors(self):
+    output, error_codes, _ = datetime_ops.datetime_from_date_with_errors(
+        tf.constant(['2012-01-01', 'invalid_date'])
+    )
+    self.assertAllEqual(output, tf.constant(['2012-01-01 00:00:00', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -52,6 +52,24 @@ class DatetimeFromTimestampTest(tf.test.TestCase):
           )
       )
 
+  def test_datetime_from_timestamp_per_element_time_zone(self):
+    self.assertAllEqual(
+        datetime_ops.datetime_from_timestamp(
+            tf.constant(
+                ['2023-01-10 12:34:56.7 +1234', '2023-03-14 23:45:12.3 +1234']
+            ),
+            tf.constant(['UTC', 'America/Los_Angeles']),
+        ),
+        tf.constant(['2023-01-10 00:00:56.700', '2023-03-14 04:11:12.300']),
+    )
+
+  def test_datetime_from_timestamp_with_errors(self):
+    output, error_codes, _ = datetime_ops.datetime_from_timestamp_with_errors(
+        tf.constant(['2023-01-10 12:34:56.7 +1234', 'invalid_timestamp'])
+    )
+    self.assertAllEqual(output, tf.constant(['2023-01-10 00:00:56.700', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -0,0 +1,101 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BigQuery DATETIME custom ops on packed int64 datetimes."""
+
+from bigquery_ml_utils.tensorflow_ops import datetime_ops
+import tensorflow as tf
+
+
+class DatetimePackedOpsTest(tf.test.TestCase):
+
+  def setUp(self):
+    super().setUp()
+    self.datetime = tf.constant(
+        ['2023-01-10 12:34:56.7', '2023-03-14 23:45:12.3']
+    )
+
+  def test_packed_from_datetime(self):
+    self.assertAllEqual(
+        datetime_ops.packed_from_datetime(
+            tf.constant(['2008-12-25 15:30:00'])
+        ),
+        tf.constant([141356717278494720], dtype=tf.int64),
+    )
+    self.assertAllEqual(
+        datetime_ops.datetime_from_packed(
+            datetime_ops.packed_from_datetime(self.datetime)
+        ),
+        tf.constant(['2023-01-10 12:34:56.700', '2023-03-14 23:45:12.300']),
+    )
+
+  def test_datetime_add_sub_packed(self):
+    packed = datetime_ops.packed_from_datetime(self.datetime)
+    interval = tf.constant([10, 20], dtype=tf.int64)
+    added = datetime_ops.datetime_add_packed(packed, interval, 'MINUTE')
+    self.assertAllEqual(
+        datetime_ops.datetime_from_packed(added),
+        datetime_ops.datetime_add(self.datetime, interval, 'MINUTE'),
+    )
+    self.assertAllEqual(
+        datetime_ops.datetime_sub_packed(added, interval, 'MINUTE'), packed
+    )
+
+  def test_datetime_diff_packed(self):
+    packed = datetime_ops.packed_from_datetime(self.datetime)
+    other = datetime_ops.packed_from_datetime(
+        tf.constant(['2023-01-01 00:00:00', '2023-03-01 00:00:00'])
+    )
+    self.assertAllEqual(
+        datetime_ops.datetime_diff_packed(packed, other, 'DAY'),
+        tf.constant([9, 13], dtype=tf.int64),
+    )
+
+  def test_datetime_trunc_packed(self):
+    packed = datetime_ops.packed_from_datetime(self.datetime)
+    self.assertAllEqual(
+        datetime_ops.datetime_from_packed(
+            datetime_ops.datetime_trunc_packed(packed, 'HOUR')
+        ),
+        tf.constant(['2023-01-10 12:00:00', '2023-03-14 23:00:00']),
+    )
+
+  def test_extract_from_datetime_packed(self):
+    packed = datetime_ops.packed_from_datetime(self.datetime)
+    self.assertAllEqual(
+        datetime_ops.extract_from_datetime_packed(packed, 'MILLISECOND'),
+        tf.constant([700, 300], dtype=tf.int64),
+    )
+
+  def test_invalid_packed_datetime(self):
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Invalid packed datetime in DatetimeFromPacked: -1',
+    ):
+      self.evaluate(
+          datetime_ops.datetime_from_packed(tf.constant([-1], dtype=tf.int64))
+      )
+
+  def test_packed_from_datetime_with_errors(self):
+    output, error_codes, _ = datetime_ops.packed_from_datetime_with_errors(
+        tf.constant(['2008-12-25 15:30:00', 'invalid_datetime'])
+    )
+    self.assertAllEqual(
+        output, tf.constant([141356717278494720, 0], dtype=tf.int64)
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -140,6 +140,37 @@ class DatetimeTruncTest(tf.test.TestCase):
     ):
       self.evaluate(datetime_ops.datetime_trunc(datetime, 'DATE'))
 
+  def test_datetime_trunc_with_errors(self):
+    datetime = tf.constant(['2023-01-10 12:34:56.7', 'invalid_datetime'])
+    output, error_codes, _ = datetime_ops.datetime_trunc_with_errors(
+        datetime, 'MILLISECOND'
+    )
+    self.assertAllEqual(output, tf.constant(['2023-01-10 12:34:56.700', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+  def test_datetime_trunc_with_errors_sorted_datetimes(self):
+    datetime = tf.constant([
+        '2023-01-10 12:59:59.9',
+        '2023-01-10 13:00:00',
+        'invalid_datetime',
+        '2023-01-10 13:30:00',
+    ])
+    output, error_codes, _ = datetime_ops.datetime_trunc_with_errors(
+        datetime, 'HOUR'
+    )
+    self.assertAllEqual(
+        output,
+        tf.constant([
+            '2023-01-10 12:00:00',
+            '2023-01-10 13:00:00',
+            '',
+            '2023-01-10 13:00:00',
+        ]),
+    )
+    self.assertAllEqual(
+        tf.not_equal(error_codes, 0), [False, False, True, False]
+    )
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -74,6 +74,14 @@ class ExtractFromDateTest(tf.test.TestCase):
         tf.constant([2023, 2023]),
     )
 
+  def test_extract_from_date_non_canonical_date(self):
+    date = tf.constant(['2023-1-10', ' 2023-03-14 '])
+
+    self.assertAllEqual(
+        date_ops.extract_from_date(date, 'DAY'),
+        tf.constant([10, 14]),
+    )
+
   def test_extract_from_date_invalid_date(self):
     with self.assertRaisesRegex(
         (tf.errors.OutOfRangeError, ValueError),
@@ -95,6 +103,25 @@ class ExtractFromDateTest(tf.test.TestCase):
           )
       )
 
+  def test_extract_from_date_large_batch(self):
+    date = tf.constant(['2023-01-10', '2023-03-14'] * 50000)
+
+    self.assertAllEqual(
+        date_ops.extract_from_date(date, 'DAY'),
+        tf.constant([10, 14] * 50000),
+    )
+
+  def test_extract_from_date_large_batch_reports_first_error(self):
+    date = ['2023-01-10'] * 100000
+    date[70000] = '2023-02-30'
+    date[30000] = '2023-01-32'
+
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Failed to parse input string "2023-01-32"',
+    ):
+      self.evaluate(date_ops.extract_from_date(tf.constant(date), 'DAY'))
+
   def test_extract_from_date_invalid_part(self):
     with self.assertRaisesRegex(
         (tf.errors.InvalidArgumentError, ValueError),
@@ -116,6 +143,15 @@ class ExtractFromDateTest(tf.test.TestCase):
           )
       )
 
+  def test_extract_from_date_with_errors(self):
+    date = tf.constant(['2023-01-10', 'invalid_date'])
+    output, error_codes, error_messages = (
+        date_ops.extract_from_date_with_errors(date, 'DAY')
+    )
+    self.assertAllEqual(output, tf.constant([10, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+    self.assertLen(error_messages, 1)
+
 
 if __name__ == '__main__':
   tf.test.main()
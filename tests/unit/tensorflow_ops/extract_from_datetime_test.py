@@ -124,6 +124,14 @@ class ExtractFromDatetimeTest(tf.test.TestCase):
     ):
       self.evaluate(datetime_ops.extract_from_datetime(datetime, 'DATE'))
 
+  def test_extract_from_datetime_with_errors(self):
+    datetime = tf.constant(['2023-01-10 12:34:56.7', 'invalid_datetime'])
+    output, error_codes, _ = datetime_ops.extract_from_datetime_with_errors(
+        datetime, 'MILLISECOND'
+    )
+    self.assertAllEqual(output, tf.constant([700, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -59,6 +59,14 @@ class ExtractFromTimeTest(tf.test.TestCase):
     ):
       self.evaluate(time_ops.extract_from_time(time, 'DAY'))
 
+  def test_extract_from_time_with_errors(self):
+    time = tf.constant(['07:31:15.123456', 'invalid_time'])
+    output, error_codes, _ = time_ops.extract_from_time_with_errors(
+        time, 'SECOND'
+    )
+    self.assertAllEqual(output, tf.constant([15, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -91,6 +91,33 @@ class ExtractFromTimestampTest(tf.test.TestCase):
     result = timestamp_ops.extract_from_timestamp('ISOYEAR', timestamp, 'UTC')
     self.assertAllEqual(result, expect)
 
+  def test_extract_from_timestamp_non_canonical_timestamp(self):
+    timestamp = tf.constant(
+        ['2023-01-10 1:2:3 +12', '2023-01-10 23:59:60 +0000']
+    )
+
+    expect = tf.constant([13, 0])
+    result = timestamp_ops.extract_from_timestamp('HOUR', timestamp, 'UTC')
+    self.assertAllEqual(result, expect)
+
+    expect = tf.constant([9, 11])
+    result = timestamp_ops.extract_from_timestamp('DAY', timestamp, 'UTC')
+    self.assertAllEqual(result, expect)
+
+  def test_extract_from_timestamp_repeated_time_zones(self):
+    timestamp = tf.constant(
+        ['2023-01-10 12:00:00 +0000', '2023-03-14 00:00:00']
+    )
+
+    # Cycle through more time zones than each kernel memoizes, twice, so that
+    # both cached and evicted entries are exercised.
+    for _ in range(2):
+      for offset in range(10):
+        result = timestamp_ops.extract_from_timestamp(
+            'HOUR', timestamp, '+%02d:00' % offset
+        )
+        self.assertAllEqual(result, tf.constant([12 + offset, 0]))
+
   def test_extract_from_timestamp_invalid_timezone(self):
     timestamp = tf.constant(
         ['2023-01-10 12:34:56.7 +1234', '2023-03-14 23:45:12.3 +1234']
@@ -119,13 +146,68 @@ class ExtractFromTimestampTest(tf.test.TestCase):
     timestamp = tf.constant(
         ['2023-01-10 12:34:56.7 +1234', '2023-03-14 23:45:12.3 +1234']
     )
-    with self.assertRaisesRegex(
-        (tf.errors.InvalidArgumentError, ValueError),
-        'Invalid part in ExtractFromTimestamp: micro',
-    ):
-      self.evaluate(
-          timestamp_ops.extract_from_timestamp('MICRO', timestamp, 'UTC')
-      )
+    # Failed lookups are not memoized, so the error is raised on every call.
+    for _ in range(2):
+      with self.assertRaisesRegex(
+          (tf.errors.InvalidArgumentError, ValueError),
+          'Invalid part in ExtractFromTimestamp: micro',
+      ):
+        self.evaluate(
+            timestamp_ops.extract_from_timestamp('MICRO', timestamp, 'UTC')
+        )
+
+  def test_extract_from_timestamp_per_element_inputs(self):
+    timestamp = tf.constant(
+        ['2023-01-10 12:34:56.7 +1234', '2023-03-14 23:45:12.3 +1234']
+    )
+    self.assertAllEqual(
+        timestamp_ops.extract_from_timestamp(
+            'HOUR', timestamp, tf.constant(['UTC', 'America/Los_Angeles'])
+        ),
+        tf.constant([0, 4]),
+    )
+    self.assertAllEqual(
+        timestamp_ops.extract_from_timestamp(
+            tf.constant(['DAY', 'minute']), timestamp, 'UTC'
+        ),
+        tf.constant([10, 11]),
+    )
+
+  def test_extract_from_timestamp_with_errors(self):
+    timestamp = tf.constant(
+        ['2023-01-10 12:34:56.7 +1234', 'invalid_timestamp']
+    )
+    output, error_codes, _ = timestamp_ops.extract_from_timestamp_with_errors(
+        'MILLISECOND', timestamp, 'UTC'
+    )
+    self.assertAllEqual(output, tf.constant([700, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+  def test_extract_from_timestamp_with_errors_per_row_time_zones(self):
+    timestamp = tf.constant(
+        ['2023-01-10 12:34:56.7 +0000', 'invalid_timestamp']
+    )
+    output, error_codes, _ = timestamp_ops.extract_from_timestamp_with_errors(
+        'HOUR', timestamp, tf.constant(['Asia/Tokyo', 'UTC'])
+    )
+    self.assertAllEqual(output, tf.constant([21, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+  def test_extract_from_timestamp_with_errors_invalid_time_zone_row(self):
+    timestamp = tf.constant(
+        ['2023-01-10 12:34:56.7 +0000', '2023-01-10 12:34:56.7 +0000']
+    )
+    output, error_codes, error_messages = (
+        timestamp_ops.extract_from_timestamp_with_errors(
+            'HOUR', timestamp, tf.constant(['Asia/Tokyo', 'UtC'])
+        )
+    )
+    self.assertAllEqual(output, tf.constant([21, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+    self.assertLen(error_messages, 1)
+    self.assertRegex(
+        error_messages[0].numpy().decode(), 'Invalid time zone: UtC'
+    )
 
 
 if __name__ == '__main__':
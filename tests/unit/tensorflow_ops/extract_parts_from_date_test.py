@@ -0,0 +1,44 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BigQuery ExtractPartsFromDate custom op."""
+
+from bigquery_ml_utils.tensorflow_ops import date_ops
+import tensorflow as tf
+
+
+class ExtractPartsFromDateTest(tf.test.TestCase):
+
+  def test_extract_parts_from_date(self):
+    date = tf.constant(['2008-12-25', '2023-11-11', '2021-01-01'])
+    parts = ['YEAR', 'QUARTER', 'MONTH', 'DAY', 'DAYOFWEEK', 'DAYOFYEAR']
+    parts += ['WEEK', 'WEEK_MONDAY', 'ISOWEEK', 'ISOYEAR']
+    result = date_ops.extract_parts_from_date(date, parts)
+    self.assertAllEqual(tf.shape(result), [3, len(parts)])
+    for i, part in enumerate(parts):
+      self.assertAllEqual(
+          result[:, i], date_ops.extract_from_date(date, part)
+      )
+
+  def test_extract_parts_from_date_invalid_part(self):
+    date = tf.constant(['2008-12-25'])
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Unsupported part in ExtractPartsFromDate: hour',
+    ):
+      self.evaluate(date_ops.extract_parts_from_date(date, ['YEAR', 'HOUR']))
+
+
+if __name__ == '__main__':
+  tf.test.main()
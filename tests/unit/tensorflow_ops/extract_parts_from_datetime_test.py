@@ -0,0 +1,46 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BigQuery ExtractPartsFromDatetime custom op."""
+
+from bigquery_ml_utils.tensorflow_ops import datetime_ops
+import tensorflow as tf
+
+
+class ExtractPartsFromDatetimeTest(tf.test.TestCase):
+
+  def test_extract_parts_from_datetime(self):
+    datetime = tf.constant(
+        ['2008-12-25 15:30:00.123456', '2023-11-11 01:02:03']
+    )
+    self.assertAllEqual(
+        datetime_ops.extract_parts_from_datetime(
+            datetime, ['YEAR', 'DAYOFWEEK', 'HOUR', 'MILLISECOND']
+        ),
+        tf.constant([[2008, 5, 15, 123], [2023, 7, 1, 0]], dtype=tf.int64),
+    )
+
+  def test_extract_parts_from_datetime_invalid_datetime(self):
+    datetime = tf.constant(['2008-12-25 15:30:00', '2023-01-10'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Failed to parse input string "2023-01-10"',
+    ):
+      self.evaluate(
+          datetime_ops.extract_parts_from_datetime(datetime, ['YEAR'])
+      )
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -0,0 +1,44 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BigQuery ExtractPartsFromTime custom op."""
+
+from bigquery_ml_utils.tensorflow_ops import time_ops
+import tensorflow as tf
+
+
+class ExtractPartsFromTimeTest(tf.test.TestCase):
+
+  def test_extract_parts_from_time(self):
+    time = tf.constant(['07:31:15.123456', '06:22:23'])
+    self.assertAllEqual(
+        time_ops.extract_parts_from_time(
+            time, ['HOUR', 'MINUTE', 'SECOND', 'MICROSECOND', 'HOUR']
+        ),
+        tf.constant(
+            [[7, 31, 15, 123456, 7], [6, 22, 23, 0, 6]], dtype=tf.int64
+        ),
+    )
+
+  def test_extract_parts_from_time_invalid_part(self):
+    time = tf.constant(['07:30:00.000000'])
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Unsupported part in ExtractPartsFromTime: day',
+    ):
+      self.evaluate(time_ops.extract_parts_from_time(time, ['DAY']))
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -0,0 +1,82 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BigQuery ExtractPartsFromTimestamp custom op."""
+
+from bigquery_ml_utils.tensorflow_ops import timestamp_ops
+import tensorflow as tf
+
+
+class ExtractPartsFromTimestampTest(tf.test.TestCase):
+
+  def test_extract_parts_from_timestamp(self):
+    timestamp = tf.constant(
+        ['2023-01-10 12:34:56.7 +1234', '2023-03-14 23:45:12.3 +1234']
+    )
+    self.assertAllEqual(
+        timestamp_ops.extract_parts_from_timestamp(
+            ['YEAR', 'MONTH', 'DAYOFWEEK', 'HOUR', 'ISOWEEK'], timestamp, 'UTC'
+        ),
+        tf.constant(
+            [[2023, 1, 3, 0, 2], [2023, 3, 3, 11, 11]], dtype=tf.int64
+        ),
+    )
+
+  def test_extract_parts_from_timestamp_matches_extract_from_timestamp(self):
+    timestamp = tf.constant([
+        ['2023-01-10 12:34:56.7 +1234', '2023-03-12 02:30:00 -0700'],
+        ['2008-12-25 15:30:00 +0000', '2023-11-05 01:30:00 -0800'],
+    ])
+    parts = ['HOUR', 'DAY', 'WEEK_TUESDAY', 'isoyear', 'MICROSECOND']
+    result = timestamp_ops.extract_parts_from_timestamp(
+        parts, timestamp, 'America/Los_Angeles'
+    )
+    self.assertAllEqual(tf.shape(result), [2, 2, len(parts)])
+    for i, part in enumerate(parts):
+      self.assertAllEqual(
+          result[:, :, i],
+          timestamp_ops.extract_from_timestamp(
+              part, timestamp, 'America/Los_Angeles'
+          ),
+      )
+
+  def test_extract_parts_from_timestamp_invalid_timestamp(self):
+    timestamp = tf.constant(
+        ['2023-01-10 12:34:56.7 +1234', '2023-03-14 23:45:12.3']
+    )
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Failed to parse input string "2023-03-14 23:45:12.3"',
+    ):
+      self.evaluate(
+          timestamp_ops.extract_parts_from_timestamp(
+              ['YEAR', 'HOUR'], timestamp, 'UTC'
+          )
+      )
+
+  def test_extract_parts_from_timestamp_invalid_part(self):
+    timestamp = tf.constant(['2023-01-10 12:34:56.7 +1234'])
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Unsupported part in ExtractPartsFromTimestamp: date',
+    ):
+      self.evaluate(
+          timestamp_ops.extract_parts_from_timestamp(
+              ['YEAR', 'DATE'], timestamp, 'UTC'
+          )
+      )
+
+
+if __name__ == '__main__':
+  tf.test.main()
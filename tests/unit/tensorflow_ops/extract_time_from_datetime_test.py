@@ -40,6 +40,15 @@ class ExtractTimeFromDatetimeTest(tf.test.TestCase):
           )
       )
 
+  def test_extract_time_from_datetime_with_errors(self):
+    output, error_codes, _ = (
+        datetime_ops.extract_time_from_datetime_with_errors(
+            tf.constant(['2023-01-10 12:34:56.7', 'invalid_datetime'])
+        )
+    )
+    self.assertAllEqual(output, tf.constant(['12:34:56.700', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -42,6 +42,26 @@ class FormatDateTest(tf.test.TestCase):
         tf.constant(['abc', 'abc']),
     )
 
+  def test_format_date_time_elements(self):
+    date = tf.constant(['2008-12-25'])
+    self.assertAllEqual(
+        date_ops.format_date('%F %H:%M %Q', date),
+        tf.constant(['2008-12-25 %H:%M 4']),
+    )
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Format element %J not supported yet',
+    ):
+      self.evaluate(date_ops.format_date('%J', date))
+
+  def test_format_date_with_errors(self):
+    date = tf.constant(['2008-12-25', 'invalid_date'])
+    output, error_codes, _ = date_ops.format_date_with_errors(
+        '%A %b %e %Y', date
+    )
+    self.assertAllEqual(output, tf.constant(['Thursday Dec 25 2008', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
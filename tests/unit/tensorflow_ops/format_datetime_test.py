@@ -45,6 +45,14 @@ class FormatDatetimeTest(tf.test.TestCase):
     ):
       self.evaluate(datetime_ops.format_datetime('%c', datetime))
 
+  def test_format_datetime_with_errors(self):
+    datetime = tf.constant(['2008-12-25 15:30:00', 'invalid_datetime'])
+    output, error_codes, _ = datetime_ops.format_datetime_with_errors(
+        '%b-%d-%Y', datetime
+    )
+    self.assertAllEqual(output, tf.constant(['Dec-25-2008', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -42,6 +42,12 @@ class FormatTimeTest(tf.test.TestCase):
         tf.constant(['abc', 'abc']),
     )
 
+  def test_format_time_with_errors(self):
+    time = tf.constant(['07:31:15.000000', 'invalid_time'])
+    output, error_codes, _ = time_ops.format_time_with_errors('%R', time)
+    self.assertAllEqual(output, tf.constant(['07:31', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
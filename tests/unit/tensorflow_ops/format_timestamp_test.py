@@ -33,6 +33,38 @@ class FormatTimestampTest(tf.test.TestCase):
         tf.constant(['Dec-25-2008', 'Nov-11-2023']),
     )
 
+  def test_format_timestamp_repeated_formats(self):
+    timestamp = tf.constant(
+        ['2008-12-25 15:30:00.123456+00', '2023-11-11 14:30:00+00']
+    )
+    expected = {
+        '%Y-%m-%d %H:%M:%E3S %Ez': [
+            '2008-12-25 07:30:00.123 -08:00',
+            '2023-11-11 06:30:00.000 -08:00',
+        ],
+        '%F %T %Z': ['2008-12-25 07:30:00 UTC-8', '2023-11-11 06:30:00 UTC-8'],
+        '%j %Q %e %%H': ['360 4 25 %H', '315 4 11 %H'],
+    }
+    # Format each string twice so the second call reuses the compiled format.
+    for _ in range(2):
+      for format_string, output in expected.items():
+        self.assertAllEqual(
+            timestamp_ops.format_timestamp(
+                format_string, timestamp, 'America/Los_Angeles'
+            ),
+            tf.constant(output),
+        )
+
+  def test_format_timestamp_repeated_timestamps(self):
+    # Large enough and repetitive enough for the kernel to deduplicate.
+    timestamp = tf.constant(
+        ['2008-12-25 15:30:00+00', '2023-11-11 14:30:00+00'] * 300
+    )
+    self.assertAllEqual(
+        timestamp_ops.format_timestamp('%b-%d-%Y %H', timestamp),
+        tf.constant(['Dec-25-2008 15', 'Nov-11-2023 14'] * 300),
+    )
+
   def test_format_timestamp_invalid_timestamp(self):
     timestamp = tf.constant(
         ['2008-12-25 15:30:00 abc', '2023-11-11 14:30:00+00']
@@ -64,6 +96,14 @@ class FormatTimestampTest(tf.test.TestCase):
         tf.constant(['abc', 'abc']),
     )
 
+  def test_format_timestamp_with_errors(self):
+    timestamp = tf.constant(['2008-12-25 15:30:00+00', 'invalid_timestamp'])
+    output, error_codes, _ = timestamp_ops.format_timestamp_with_errors(
+        '%b-%d-%Y', timestamp
+    )
+    self.assertAllEqual(output, tf.constant(['Dec-25-2008', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -109,6 +109,14 @@ class LastDayFromDateTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.last_day_from_date(date, 'DATE'))
 
+  def test_last_day_from_date_with_errors(self):
+    date = tf.constant(['2023-01-10', 'invalid_date'])
+    output, error_codes, _ = date_ops.last_day_from_date_with_errors(
+        date, 'MONTH'
+    )
+    self.assertAllEqual(output, tf.constant(['2023-01-31', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -84,6 +84,14 @@ class LastDayFromDatetimeTest(tf.test.TestCase):
     ):
       self.evaluate(datetime_ops.last_day_from_datetime(datetime, 'DATE'))
 
+  def test_last_day_from_datetime_with_errors(self):
+    datetime = tf.constant(['2023-01-10 12:34:56.7', 'invalid_datetime'])
+    output, error_codes, _ = datetime_ops.last_day_from_datetime_with_errors(
+        datetime, 'WEEK'
+    )
+    self.assertAllEqual(output, tf.constant(['2023-01-14', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
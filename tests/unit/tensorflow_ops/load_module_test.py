@@ -0,0 +1,39 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for loading the custom op library."""
+
+from bigquery_ml_utils.tensorflow_ops import date_ops
+from bigquery_ml_utils.tensorflow_ops import timestamp_ops
+from bigquery_ml_utils.tensorflow_ops.load_module import load_module
+import tensorflow as tf
+
+
+class LoadModuleTest(tf.test.TestCase):
+
+  def test_load_module_once(self):
+    self.assertIs(
+        load_module('_bigquery_ml_utils_ops.so'),
+        load_module('_bigquery_ml_utils_ops.so'),
+    )
+    self.assertIs(date_ops.gen_date_ops, timestamp_ops.gen_timestamp_ops)
+
+  def test_load_module_merged_library(self):
+    module = load_module('_date_ops.so')
+    self.assertIs(module, load_module('_bigquery_ml_utils_ops.so'))
+    self.assertTrue(hasattr(module, 'timestamp_trunc'))
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -43,6 +43,28 @@ class ParseDateTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.parse_date('abc', date))
 
+  def test_parse_date_with_errors(self):
+    date = tf.constant(['Thursday Dec 25 2008', 'Thursday aaa 25 2008'])
+    output, error_codes, error_messages = date_ops.parse_date_with_errors(
+        '%A %b %e %Y', date
+    )
+    self.assertAllEqual(output, tf.constant(['2008-12-25', '']))
+    self.assertEqual(error_codes[0], 0)
+    self.assertNotEqual(error_codes[1], 0)
+    self.assertLen(error_messages, 1)
+    self.assertRegex(
+        error_messages[0].numpy().decode(),
+        'Failed to parse input string "Thursday aaa 25 2008"',
+    )
+
+  def test_parse_date_with_errors_no_messages(self):
+    date = tf.constant(['Thursday aaa 25 2008', 'Thursday bbb 25 2008'])
+    _, error_codes, error_messages = date_ops.parse_date_with_errors(
+        '%A %b %e %Y', date, max_error_messages=0
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [True, True])
+    self.assertLen(error_messages, 0)
+
 
 if __name__ == '__main__':
   tf.test.main()
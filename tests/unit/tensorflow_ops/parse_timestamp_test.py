@@ -71,6 +71,42 @@ class ParseTimestampTest(tf.test.TestCase):
     ):
       self.evaluate(timestamp_ops.parse_timestamp('abc', timestamp))
 
+  def test_parse_timestamp_with_errors(self):
+    timestamp = tf.constant([
+        ['Thu Dec 25 15:30:00 2008', 'Thu Dec 25 15:30:00 abc'],
+        ['Sat Nov 11 14:30:00 abc', 'Sat Nov 11 14:30:00 2023'],
+    ])
+    output, error_codes, error_messages = (
+        timestamp_ops.parse_timestamp_with_errors(
+            '%c', timestamp, 'America/Los_Angeles', max_error_messages=1
+        )
+    )
+    self.assertAllEqual(
+        output,
+        tf.constant([
+            ['2008-12-25 23:30:00.0 +0000', ''],
+            ['', '2023-11-11 22:30:00.0 +0000'],
+        ]),
+    )
+    self.assertAllEqual(
+        tf.not_equal(error_codes, 0), [[False, True], [True, False]]
+    )
+    self.assertLen(error_messages, 1)
+    self.assertRegex(
+        error_messages[0].numpy().decode(),
+        'Failed to parse input string "Thu Dec 25 15:30:00 abc"',
+    )
+
+  def test_parse_timestamp_with_errors_invalid_zone(self):
+    timestamp = tf.constant(['Thu Dec 25 15:30:00 2008'])
+    with self.assertRaisesRegex(
+        (tf.errors.OutOfRangeError, ValueError),
+        'Invalid time zone: uTc',
+    ):
+      self.evaluate(
+          timestamp_ops.parse_timestamp_with_errors('%c', timestamp, 'uTc')
+      )
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -43,6 +43,18 @@ class SafeParseDateTest(tf.test.TestCase):
         tf.constant(['1970-01-01', '1970-01-01']),
     )
 
+  def test_safe_parse_date_with_validity(self):
+    date = tf.constant(['Thursday Jan  1 1970', 'invalid_date'])
+    output, valid = date_ops.safe_parse_date_with_validity('%A %b %e %Y', date)
+    self.assertAllEqual(output, tf.constant(['1970-01-01', '']))
+    self.assertAllEqual(valid, tf.constant([True, False]))
+
+    output, valid = date_ops.safe_parse_date_with_validity(
+        'invalid_format', date
+    )
+    self.assertAllEqual(output, tf.constant(['', '']))
+    self.assertAllEqual(valid, tf.constant([False, False]))
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -74,6 +74,14 @@ class SafeParseDatetimeTest(tf.test.TestCase):
         ]),
     )
 
+  def test_safe_parse_datetime_with_validity(self):
+    output, valid = datetime_ops.safe_parse_datetime_with_validity(
+        '%m/%d/%Y %I:%M:%S %p',
+        tf.constant([['8/30/2018 2:23:38 pm'], ['8/30/2018 2:23:38']]),
+    )
+    self.assertAllEqual(output, tf.constant([['2018-08-30 14:23:38'], ['']]))
+    self.assertAllEqual(valid, tf.constant([[True], [False]]))
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -41,6 +41,12 @@ class SafeParseTimeTest(tf.test.TestCase):
         tf.constant(['12:34:56.123456', '12:34:56.123456']),
     )
 
+  def test_safe_parse_time_with_validity(self):
+    time = tf.constant(['07:31:15', 'invalid_time'])
+    output, valid = time_ops.safe_parse_time_with_validity('%I:%M:%S', time)
+    self.assertAllEqual(output, tf.constant(['07:31:15', '']))
+    self.assertAllEqual(valid, tf.constant([True, False]))
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -69,6 +69,22 @@ class ParseTimestampTest(tf.test.TestCase):
         ),
     )
 
+  def test_safe_parse_timestamp_with_validity(self):
+    timestamp = tf.constant(['Thu Dec 25 15:30:00 2008', 'invalid_timestamp'])
+    output, valid = timestamp_ops.safe_parse_timestamp_with_validity(
+        '%c', timestamp, 'America/Los_Angeles'
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2008-12-25 23:30:00.0 +0000', ''])
+    )
+    self.assertAllEqual(valid, tf.constant([True, False]))
+
+    output, valid = timestamp_ops.safe_parse_timestamp_with_validity(
+        '%c', timestamp, 'invalid_time_zone'
+    )
+    self.assertAllEqual(output, tf.constant(['', '']))
+    self.assertAllEqual(valid, tf.constant([False, False]))
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -57,6 +57,35 @@ class StringFromTimestampTest(tf.test.TestCase):
     ):
       self.evaluate(timestamp_ops.string_from_timestamp(timestamp))
 
+  def test_string_from_timestamp_per_element_time_zone(self):
+    timestamp = tf.constant([
+        '2023-01-10 12:34:56.7 +1234',
+        '2023-03-14 23:45:12.3 +1234',
+        '2023-03-14 23:45:12.3 +1234',
+    ])
+    self.assertAllEqual(
+        timestamp_ops.string_from_timestamp(
+            timestamp, tf.constant(['UTC', 'America/Los_Angeles', 'UTC'])
+        ),
+        tf.constant([
+            '2023-01-10 00:00:56.700+00',
+            '2023-03-14 04:11:12.300-07',
+            '2023-03-14 11:11:12.300+00',
+        ]),
+    )
+
+  def test_string_from_timestamp_with_errors(self):
+    timestamp = tf.constant(
+        ['2023-01-10 12:34:56.7 +1234', 'invalid_timestamp']
+    )
+    output, error_codes, _ = timestamp_ops.string_from_timestamp_with_errors(
+        timestamp
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2023-01-10 00:00:56.700+00', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -78,6 +78,15 @@ class TimeAddTest(tf.test.TestCase):
     ):
       self.evaluate(time_ops.time_add(time, interval, 'HOUR'))
 
+  def test_time_add_with_errors(self):
+    time = tf.constant(['07:30:00.000000', 'invalid_time'])
+    interval = tf.constant([2, 2], dtype=tf.int64)
+    output, error_codes, _ = time_ops.time_add_with_errors(
+        time, interval, 'SECOND'
+    )
+    self.assertAllEqual(output, tf.constant(['07:30:02', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
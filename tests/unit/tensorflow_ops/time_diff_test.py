@@ -79,6 +79,15 @@ class TimeDiffTest(tf.test.TestCase):
     ):
       self.evaluate(time_ops.time_diff(time_a, time_b, 'HOUR'))
 
+  def test_time_diff_with_errors(self):
+    time_a = tf.constant(['07:30:00.000000', 'invalid_time'])
+    time_b = tf.constant(['06:30:00.000000', '07:30:00.000000'])
+    output, error_codes, _ = time_ops.time_diff_with_errors(
+        time_a, time_b, 'SECOND'
+    )
+    self.assertAllEqual(output, tf.constant([3600, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
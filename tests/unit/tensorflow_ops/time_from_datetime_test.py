@@ -39,6 +39,12 @@ class TimeFromDatetimeTest(tf.test.TestCase):
     ):
       self.evaluate(time_ops.time_from_datetime(datetime))
 
+  def test_time_from_datetime_with_errors(self):
+    datetime = tf.constant(['2023-02-02 02:02:01.152903', 'invalid_datetime'])
+    output, error_codes, _ = time_ops.time_from_datetime_with_errors(datetime)
+    self.assertAllEqual(output, tf.constant(['02:02:01.152903', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -53,6 +53,14 @@ class TimeFromTimestampTest(tf.test.TestCase):
     ):
       self.evaluate(time_ops.time_from_timestamp(timestamp, 'UtC'))
 
+  def test_time_from_timestamp_with_errors(self):
+    timestamp = tf.constant(['2008-12-25 15:30:00+00', 'invalid_timestamp'])
+    output, error_codes, _ = time_ops.time_from_timestamp_with_errors(
+        timestamp, 'America/Los_Angeles'
+    )
+    self.assertAllEqual(output, tf.constant(['07:30:00', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
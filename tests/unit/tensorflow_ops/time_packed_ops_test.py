@@ -0,0 +1,92 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BigQuery TIME custom ops on packed int64 times."""
+
+from bigquery_ml_utils.tensorflow_ops import time_ops
+import tensorflow as tf
+
+
+class TimePackedOpsTest(tf.test.TestCase):
+
+  def setUp(self):
+    super().setUp()
+    self.time = tf.constant(['07:30:00.000000', '15:30:00.123456'])
+
+  def test_packed_from_time(self):
+    self.assertAllEqual(
+        time_ops.packed_from_time(tf.constant(['15:30:00.123456'])),
+        tf.constant([66437898816], dtype=tf.int64),
+    )
+    self.assertAllEqual(
+        time_ops.time_from_packed(time_ops.packed_from_time(self.time)),
+        tf.constant(['07:30:00', '15:30:00.123456']),
+    )
+
+  def test_time_add_sub_packed(self):
+    packed = time_ops.packed_from_time(self.time)
+    interval = tf.constant([2, 2], dtype=tf.int64)
+    added = time_ops.time_add_packed(packed, interval, 'HOUR')
+    self.assertAllEqual(
+        time_ops.time_from_packed(added),
+        time_ops.time_add(self.time, interval, 'HOUR'),
+    )
+    self.assertAllEqual(
+        time_ops.time_sub_packed(added, interval, 'HOUR'), packed
+    )
+
+  def test_time_diff_packed(self):
+    packed = time_ops.packed_from_time(self.time)
+    self.assertAllEqual(
+        time_ops.time_diff_packed(
+            packed,
+            time_ops.packed_from_time(tf.constant(['06:30:00', '12:00:00'])),
+            'MINUTE',
+        ),
+        tf.constant([60, 210], dtype=tf.int64),
+    )
+
+  def test_time_trunc_packed(self):
+    packed = time_ops.packed_from_time(self.time)
+    self.assertAllEqual(
+        time_ops.time_from_packed(time_ops.time_trunc_packed(packed, 'SECOND')),
+        tf.constant(['07:30:00', '15:30:00']),
+    )
+
+  def test_extract_from_time_packed(self):
+    packed = time_ops.packed_from_time(self.time)
+    self.assertAllEqual(
+        time_ops.extract_from_time_packed(packed, 'MICROSECOND'),
+        tf.constant([0, 123456], dtype=tf.int64),
+    )
+
+  def test_invalid_packed_time(self):
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Invalid packed time in TimeFromPacked: -1',
+    ):
+      self.evaluate(
+          time_ops.time_from_packed(tf.constant([-1], dtype=tf.int64))
+      )
+
+  def test_packed_from_time_with_errors(self):
+    output, error_codes, _ = time_ops.packed_from_time_with_errors(
+        tf.constant(['15:30:00.123456', 'invalid_time'])
+    )
+    self.assertAllEqual(output, tf.constant([66437898816, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
+
+if __name__ == '__main__':
+  tf.test.main()
@@ -71,6 +71,15 @@ class TimeSubTest(tf.test.TestCase):
     ):
       self.evaluate(time_ops.time_sub(time, interval, 'HOUR'))
 
+  def test_time_sub_with_errors(self):
+    time = tf.constant(['07:30:00.000000', 'invalid_time'])
+    interval = tf.constant([2, 2], dtype=tf.int64)
+    output, error_codes, _ = time_ops.time_sub_with_errors(
+        time, interval, 'SECOND'
+    )
+    self.assertAllEqual(output, tf.constant(['07:29:58', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
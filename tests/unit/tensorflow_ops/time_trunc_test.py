@@ -59,6 +59,12 @@ class TimeTruncTest(tf.test.TestCase):
     ):
       self.evaluate(time_ops.time_trunc(time, 'DAY'))
 
+  def test_time_trunc_with_errors(self):
+    time = tf.constant(['07:31:15.123456', 'invalid_time'])
+    output, error_codes, _ = time_ops.time_trunc_with_errors(time, 'SECOND')
+    self.assertAllEqual(output, tf.constant(['07:31:15', '']))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
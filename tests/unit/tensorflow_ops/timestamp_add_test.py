@@ -89,6 +89,17 @@ class TimestampAddTest(tf.test.TestCase):
     ):
       self.evaluate(timestamp_ops.timestamp_add(timestamp, diff, 'DAY'))
 
+  def test_timestamp_add_with_errors(self):
+    timestamp = tf.constant(['2008-12-25 15:30:00+00', 'invalid_timestamp'])
+    diff = tf.constant([500000, 500000], dtype=tf.int64)
+    output, error_codes, _ = timestamp_ops.timestamp_add_with_errors(
+        timestamp, diff, 'MICROSECOND'
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2008-12-25 15:30:00.5 +0000', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -88,6 +88,19 @@ class TimestampDiffTest(tf.test.TestCase):
           timestamp_ops.timestamp_diff(timestamp_a, timestamp_b, 'DAY')
       )
 
+  def test_timestamp_diff_with_errors(self):
+    timestamp_a = tf.constant(['2023-11-11 14:30:00+00', 'invalid_timestamp'])
+    timestamp_b = tf.constant(
+        ['2008-12-25 15:30:00+00', '2023-11-11 14:30:00+00']
+    )
+    output, error_codes, _ = timestamp_ops.timestamp_diff_with_errors(
+        timestamp_a, timestamp_b, 'MICROSECOND'
+    )
+    self.assertAllEqual(
+        output, tf.constant([469494000000000, 0], dtype=tf.int64)
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -54,6 +54,14 @@ class TimestampFromDateTest(tf.test.TestCase):
     ):
       self.evaluate(timestamp_ops.timestamp_from_date(date))
 
+  def test_timestamp_from_date_with_errors(self):
+    date = tf.constant(['2023-02-02', 'invalid_date'])
+    output, error_codes, _ = timestamp_ops.timestamp_from_date_with_errors(date)
+    self.assertAllEqual(
+        output, tf.constant(['2023-02-02 00:00:00.0 +0000', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -62,6 +62,16 @@ class TimestampFromDatetimeTest(tf.test.TestCase):
     ):
       self.evaluate(timestamp_ops.timestamp_from_datetime(datetime))
 
+  def test_timestamp_from_datetime_with_errors(self):
+    datetime = tf.constant(['2023-02-02 02:02:01.152903', 'invalid_datetime'])
+    output, error_codes, _ = timestamp_ops.timestamp_from_datetime_with_errors(
+        datetime
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2023-02-02 02:02:01.1 +0000', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
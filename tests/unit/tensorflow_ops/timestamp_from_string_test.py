@@ -56,6 +56,17 @@ class TimestampFromStringTest(tf.test.TestCase):
     ):
       self.evaluate(timestamp_ops.timestamp_from_string(timestamp))
 
+  def test_timestamp_from_string_with_errors(self):
+    timestamp = tf.constant(['2008-12-25 15:30:00+00', 'invalid_timestamp'])
+    output, error_codes, error_messages = (
+        timestamp_ops.timestamp_from_string_with_errors(timestamp)
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2008-12-25 15:30:00.0 +0000', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+    self.assertLen(error_messages, 1)
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -0,0 +1,130 @@
+# Copyright 2023 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Tests for BQML TIMESTAMP custom ops on int64 micros."""
+
+from bigquery_ml_utils.tensorflow_ops import timestamp_ops
+import tensorflow as tf
+
+
+class TimestampMicrosOpsTest(tf.test.TestCase):
+
+  def setUp(self):
+    super().setUp()
+    # 2008-12-25 15:30:00 UTC and 2023-11-11 14:30:00 UTC.
+    self.timestamp = tf.constant(
+        [1230219000000000, 1699713000000000], dtype=tf.int64
+    )
+
+  def test_extract_from_timestamp_micros(self):
+    self.assertAllEqual(
+        timestamp_ops.extract_from_timestamp_micros('YEAR', self.timestamp),
+        tf.constant([2008, 2023], dtype=tf.int64),
+    )
+    self.assertAllEqual(
+        timestamp_ops.extract_from_timestamp_micros(
+            'HOUR', self.timestamp, 'America/Los_Angeles'
+        ),
+        tf.constant([7, 6], dtype=tf.int64),
+    )
+
+  def test_timestamp_add_sub_micros(self):
+    interval = tf.constant([2, 2], dtype=tf.int64)
+    added = timestamp_ops.timestamp_add_micros(
+        self.timestamp, interval, 'HOUR'
+    )
+    self.assertAllEqual(
+        added,
+        tf.constant([1230226200000000, 1699720200000000], dtype=tf.int64),
+    )
+    self.assertAllEqual(
+        timestamp_ops.timestamp_sub_micros(added, interval, 'HOUR'),
+        self.timestamp,
+    )
+
+  def test_timestamp_diff_micros(self):
+    self.assertAllEqual(
+        timestamp_ops.timestamp_diff_micros(
+            self.timestamp,
+            tf.constant([1230132600000000, 1699713000000000], dtype=tf.int64),
+            'DAY',
+        ),
+        tf.constant([1, 0], dtype=tf.int64),
+    )
+
+  def test_timestamp_trunc_micros(self):
+    self.assertAllEqual(
+        timestamp_ops.timestamp_trunc_micros(self.timestamp, 'DAY'),
+        tf.constant([1230163200000000, 1699660800000000], dtype=tf.int64),
+    )
+
+  def test_timestamp_micros_across_dst_transitions(self):
+    # 01:30 PST, 03:30 PDT, 01:30 PDT and 01:30 PST in America/Los_Angeles.
+    timestamp = tf.constant(
+        [1678613400000000, 1678617000000000, 1699173000000000,
+         1699176600000000],
+        dtype=tf.int64,
+    )
+    self.assertAllEqual(
+        timestamp_ops.extract_from_timestamp_micros(
+            'HOUR', timestamp, 'America/Los_Angeles'
+        ),
+        tf.constant([1, 3, 1, 1], dtype=tf.int64),
+    )
+    self.assertAllEqual(
+        timestamp_ops.timestamp_trunc_micros(
+            timestamp, 'HOUR', 'America/Los_Angeles'
+        ),
+        tf.constant(
+            [1678611600000000, 1678615200000000, 1699171200000000,
+             1699174800000000],
+            dtype=tf.int64,
+        ),
+    )
+    self.assertAllEqual(
+        timestamp_ops.timestamp_trunc_micros(
+            timestamp, 'DAY', 'America/Los_Angeles'
+        ),
+        tf.constant(
+            [1678608000000000, 1678608000000000, 1699167600000000,
+             1699167600000000],
+            dtype=tf.int64,
+        ),
+    )
+
+  def test_matches_string_ops(self):
+    timestamp = tf.constant(
+        ['2008-12-25 15:30:00+00', '2023-11-11 14:30:00+00']
+    )
+    interval = tf.constant([3, 3], dtype=tf.int64)
+    self.assertAllEqual(
+        timestamp_ops.timestamp_micros(
+            timestamp_ops.timestamp_add_micros(
+                timestamp_ops.unix_micros(timestamp), interval, 'DAY'
+            )
+        ),
+        timestamp_ops.timestamp_add(timestamp, interval, 'DAY'),
+    )
+
+  def test_timestamp_micros_out_of_range(self):
+    timestamp = tf.constant([253402300800000000], dtype=tf.int64)
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Invalid timestamp micros in TimestampTruncMicros: 253402300800000000',
+    ):
+      self.evaluate(timestamp_ops.timestamp_trunc_micros(timestamp, 'DAY'))
+
+
+if __name__ == '__main__':
+  tf.test.main()
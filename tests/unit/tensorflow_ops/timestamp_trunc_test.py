@@ -133,6 +133,113 @@ class TimestampTruncTest(tf.test.TestCase):
     ):
       self.evaluate(timestamp_ops.timestamp_trunc(timestamp, 'YEAR', 'UtC'))
 
+  def test_timestamp_trunc_per_element_inputs(self):
+    timestamp = tf.constant(
+        ['2008-12-25 15:30:00+00', '2023-11-11 14:30:00+00']
+    )
+    self.assertAllEqual(
+        timestamp_ops.timestamp_trunc(
+            timestamp, 'DAY', tf.constant(['UTC', 'Asia/Tokyo'])
+        ),
+        tf.constant(
+            ['2008-12-25 00:00:00.0 +0000', '2023-11-10 15:00:00.0 +0000']
+        ),
+    )
+    self.assertAllEqual(
+        timestamp_ops.timestamp_trunc(
+            timestamp, tf.constant(['DAY', 'HOUR']), 'Asia/Tokyo'
+        ),
+        tf.constant(
+            ['2008-12-25 15:00:00.0 +0000', '2023-11-11 14:00:00.0 +0000']
+        ),
+    )
+
+  def test_timestamp_trunc_invalid_time_zone_shape(self):
+    timestamp = tf.constant([
+        '2008-12-25 15:30:00+00',
+        '2023-11-11 14:30:00+00',
+        '2023-11-11 14:30:00+00',
+    ])
+    with self.assertRaisesRegex(
+        (tf.errors.InvalidArgumentError, ValueError),
+        'Invalid time_zone shape in TimestampTrunc',
+    ):
+      self.evaluate(
+          timestamp_ops.timestamp_trunc(
+              timestamp, 'DAY', tf.constant(['UTC', 'Asia/Tokyo'])
+          )
+      )
+
+  def test_timestamp_trunc_with_errors(self):
+    timestamp = tf.constant(['2008-12-25 15:30:00+00', 'invalid_timestamp'])
+    output, error_codes, error_messages = (
+        timestamp_ops.timestamp_trunc_with_errors(timestamp, 'DAY')
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2008-12-25 00:00:00.0 +0000', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+    self.assertLen(error_messages, 1)
+
+  def test_timestamp_trunc_with_errors_per_row_parts(self):
+    timestamp = tf.constant([
+        '2008-12-25 15:30:00+00',
+        'invalid_timestamp',
+        '2023-11-11 14:30:00+00',
+    ])
+    output, error_codes, _ = timestamp_ops.timestamp_trunc_with_errors(
+        timestamp, tf.constant(['DAY', 'DAY', 'YEAR'])
+    )
+    self.assertAllEqual(
+        output,
+        tf.constant(
+            ['2008-12-25 00:00:00.0 +0000', '', '2023-01-01 00:00:00.0 +0000']
+        ),
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True, False])
+
+  def test_timestamp_trunc_with_errors_invalid_part_row(self):
+    timestamp = tf.constant(
+        ['2008-12-25 15:30:00+00', '2023-11-11 14:30:00+00']
+    )
+    output, error_codes, error_messages = (
+        timestamp_ops.timestamp_trunc_with_errors(
+            timestamp, tf.constant(['DAY', 'DAYOFWEEK'])
+        )
+    )
+    self.assertAllEqual(
+        output, tf.constant(['2008-12-25 00:00:00.0 +0000', ''])
+    )
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+    self.assertLen(error_messages, 1)
+    self.assertRegex(
+        error_messages[0].numpy().decode(),
+        'Unsupported part in TimestampTrunc: DAYOFWEEK',
+    )
+
+  def test_timestamp_trunc_with_errors_sorted_timestamps(self):
+    timestamp = tf.constant([
+        '2023-03-12 06:59:59+00',
+        '2023-03-12 07:00:00+00',
+        'invalid_timestamp',
+        '2023-03-12 07:30:00+00',
+    ])
+    output, error_codes, _ = timestamp_ops.timestamp_trunc_with_errors(
+        timestamp, 'HOUR', 'America/Los_Angeles'
+    )
+    self.assertAllEqual(
+        output,
+        tf.constant([
+            '2023-03-12 06:00:00.0 +0000',
+            '2023-03-12 07:00:00.0 +0000',
+            '',
+            '2023-03-12 07:00:00.0 +0000',
+        ]),
+    )
+    self.assertAllEqual(
+        tf.not_equal(error_codes, 0), [False, False, True, False]
+    )
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -35,6 +35,12 @@ class UnixDateTest(tf.test.TestCase):
     ):
       self.evaluate(date_ops.unix_date(date))
 
+  def test_unix_date_with_errors(self):
+    date = tf.constant(['2008-12-25', 'invalid_date'])
+    output, error_codes, _ = date_ops.unix_date_with_errors(date)
+    self.assertAllEqual(output, tf.constant([14238, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()
@@ -39,6 +39,14 @@ class UnixMillisTest(tf.test.TestCase):
     ):
       self.evaluate(timestamp_ops.unix_millis(timestamp_int))
 
+  def test_unix_millis_with_errors(self):
+    timestamp = tf.constant(
+        ['2008-12-25 15:30:00.0 +0000', 'invalid_timestamp']
+    )
+    output, error_codes, _ = timestamp_ops.unix_millis_with_errors(timestamp)
+    self.assertAllEqual(output, tf.constant([1230219000000, 0], dtype=tf.int64))
+    self.assertAllEqual(tf.not_equal(error_codes, 0), [False, True])
+
 
 if __name__ == '__main__':
   tf.test.main()